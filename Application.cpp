@@ -13,6 +13,7 @@
 #include "MemoryLogger.hpp"
 #include "MultiLogger.hpp"
 #include "PanelStreamer.hpp"
+#include "PanelRecorder.hpp"
 #include "AnimationsModule.hpp"
 #include "CountdownModule.hpp"
 #include "Version.hpp"
@@ -239,6 +240,15 @@ void Application::begin() {
     _panelManager->registerModule(_themeParkMod);
     _panelManager->registerModule(_animationsMod);
     _panelManager->registerModule(_countdownMod);
+
+    // Datenmodule werden nur noch bei neuen Daten bzw. im Sekundentakt angestoßen, statt jede Loop zu pollen
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _tankerkoenigMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _dartsMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _sofascoreMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _calendarMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _curiousMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _weatherMod->onResourceUpdate(event); });
+    webClient->addUpdateListener([this](const ResourceUpdateEvent& event) { _themeParkMod->onResourceUpdate(event); });
     LOG_MEM_OP_FORCE("All modules registered");
 
     _panelManager->displayStatus("Verbinde zu\nWLAN...");
@@ -313,7 +323,8 @@ void Application::begin() {
         
         // Initialize Panel Streamer after WiFi is connected
         _panelManager->displayStatus("Starte\nPanel-Streamer...");
-        _panelStreamer = new PanelStreamer(_panelManager);
+        _panelStreamer = new PanelStreamer(_panelManager, deviceConfig->streamMaxClients);
+        _panelStreamer->getRecorder()->setConfig(deviceConfig->recorderEnabled, deviceConfig->recorderIntervalSec, deviceConfig->recorderMaxKBPerHour);
         _panelStreamer->begin();
         Log.println("[Application] PanelStreamer initialized and started");
         
@@ -395,23 +406,8 @@ void Application::update() {
 
     ArduinoOTA.handle();
 
-    // KORREKTUR: Aufrufe für das Wetter-Modul hinzugefügt
-    if(_tankerkoenigMod) _tankerkoenigMod->queueData();
-    if(_dartsMod) _dartsMod->queueData();
-    if(_sofascoreMod) _sofascoreMod->queueData();
-    if(_calendarMod) _calendarMod->queueData();
-    if(_curiousMod) _curiousMod->queueData();
-    if(_weatherMod) _weatherMod->queueData(); // HINZUGEFÜGT
-    if(_themeParkMod) _themeParkMod->queueData(); // HINZUGEFÜGT
-    
-    // KORREKTUR: Aufrufe für das Wetter-Modul hinzugefügt
-    if(_tankerkoenigMod) _tankerkoenigMod->processData();
-    if(_dartsMod) _dartsMod->processData();
-    if(_sofascoreMod) _sofascoreMod->processData();
-    if(_calendarMod) _calendarMod->processData();
-    if(_curiousMod) _curiousMod->processData();
-    if(_weatherMod) _weatherMod->processData(); // HINZUGEFÜGT
-    if(_themeParkMod) _themeParkMod->processData(); // HINZUGEFÜGT
+    // Neue Daten der Module (und der Sekundentick für zeitgesteuerte Abrufe)
+    if (webClient) webClient->dispatchUpdateEvents();
 
     if (_panelManager) _panelManager->tick();
 
@@ -436,6 +432,7 @@ void Application::update() {
     
     if (needsRedraw) {
         if (_panelManager) _panelManager->render();
+        if (_panelStreamer) _panelStreamer->notifyFrameRendered();
     }
   
     delay(10);
@@ -449,6 +446,11 @@ void Application::executeApplyLiveConfig() {
     // Apply debug file logging setting (immediately active)
     Log.setDebugFileEnabled(deviceConfig->debugFileEnabled);
     
+    // Apply flight recorder setting (immediately active)
+    if (_panelStreamer && _panelStreamer->getRecorder()) {
+        _panelStreamer->getRecorder()->setConfig(deviceConfig->recorderEnabled, deviceConfig->recorderIntervalSec, deviceConfig->recorderMaxKBPerHour);
+    }
+    
     if (!timeConverter->setTimezone(deviceConfig->timezone.c_str())) {
         timeConverter->setTimezone("UTC");
     }
@@ -96,6 +96,13 @@ public:
      * @return BackupManager* Ein Zeiger auf die BackupManager-Instanz.
      */
     BackupManager* getBackupManager() { return _backupManager; }
+    
+    /**
+     * @brief Gibt einen Zeiger auf den PanelStreamer zurück.
+     * 
+     * @return PanelStreamer* Ein Zeiger auf die PanelStreamer-Instanz (nullptr ohne WLAN).
+     */
+    PanelStreamer* getPanelStreamer() { return _panelStreamer; }
 
     /// @brief Statischer Zeiger auf die einzige Instanz der Application-Klasse (Singleton).
     static Application* _instance;
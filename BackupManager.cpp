@@ -4,6 +4,7 @@
 #include "MultiLogger.hpp"
 #include "webconfig.hpp"
 #include "HardwareConfig.hpp"
+#include "WebClientModule.hpp"
 #include <time.h>
 #include <sys/stat.h>
 #include <algorithm>
@@ -19,6 +20,7 @@ struct SpiRamAllocator : ArduinoJson::Allocator {
 extern DeviceConfig* deviceConfig;
 extern HardwareConfig* hardwareConfig;
 extern GeneralTimeConverter* timeConverter;
+extern WebClientModule* webClient;
 
 #define BACKUP_DIR "/backups"
 #define LAST_BACKUP_TIME_FILE "/last_backup_time.txt"
@@ -379,6 +381,8 @@ bool BackupManager::restoreFromBackup(const PsramString& filename) {
                 Log.printf("[BackupManager] Certificate restored: %s\n", certPath.c_str());
             }
         }
+        // Restored files replace what the WebClient has cached
+        if (webClient) webClient->invalidateCertCache();
     }
     
     // Restore JSON files
@@ -12,7 +12,8 @@ uint16_t hexColorTo565(const PsramString& hex) {
 }
 
 CalendarModule::CalendarModule(U8G2_FOR_ADAFRUIT_GFX &u8g2, GFXcanvas16 &canvas, const GeneralTimeConverter& converter, WebClientModule* webClient, DeviceConfig* config)
-    : u8g2(u8g2), canvas(canvas), timeConverter(converter), webClient(webClient), _deviceConfig(config), last_processed_update(0) {
+    : u8g2(u8g2), canvas(canvas), timeConverter(converter), webClient(webClient), _deviceConfig(config),
+      _icsStream(&converter) {
     dataMutex = xSemaphoreCreateMutex();
     
     // PixelScroller in PSRAM erstellen
@@ -29,7 +30,6 @@ CalendarModule::CalendarModule(U8G2_FOR_ADAFRUIT_GFX &u8g2, GFXcanvas16 &canvas,
 
 CalendarModule::~CalendarModule() {
     if (dataMutex) vSemaphoreDelete(dataMutex);
-    if (pending_buffer) free(pending_buffer);
     if (_pixelScroller) {
         _pixelScroller->~PixelScroller();
         free(_pixelScroller);
@@ -69,7 +69,7 @@ void CalendarModule::setConfig(const PsramString& url, unsigned long fetchMinute
     }
 
     if (_isEnabled) {
-        webClient->registerResource(String(icsUrl.c_str()), fetchIntervalMinutes, nullptr);
+        webClient->registerStreamingResource(String(icsUrl.c_str()), fetchIntervalMinutes, this, nullptr);
     }
 }
 
@@ -90,32 +90,57 @@ void CalendarModule::setUrgentParams(int fastBlinkHours, int urgentThresholdHour
     }
 }
 
-void CalendarModule::queueData() {
-    LOG_MEM_OP("CalendarModule::queueData");
-    if (icsUrl.empty() || !webClient) return;
-    webClient->accessResource(String(icsUrl.c_str()), [this](const char* buffer, size_t size, time_t last_update, bool is_stale){
-        if (buffer && size > 0 && last_update > this->last_processed_update) {
-            if (pending_buffer) free(pending_buffer);
-            pending_buffer = (char*)ps_malloc(size + 1);
-            if (pending_buffer) {
-                memcpy(pending_buffer, buffer, size);
-                pending_buffer[size] = '\0';
-                buffer_size = size;
-                last_processed_update = last_update;
-                data_pending = true;
-            }
+void CalendarModule::onStreamBegin(int contentLength) {
+    _icsStream.reset();
+    _icsStream.events().reserve(512);
+}
+
+bool CalendarModule::onStreamChunk(const char* data, size_t len) {
+    _icsStream.feed(data, len);
+    return true;
+}
+
+void CalendarModule::onStreamEnd(bool complete) {
+    if (!complete) {
+        // Abgebrochener Download: bisherige Termine bleiben
+        _icsStream.reset();
+        return;
+    }
+    _icsStream.finish();
+    if (xSemaphoreTake(dataMutex, portMAX_DELAY) == pdTRUE) {
+        pending_events.swap(_icsStream.events());
+        _pendingSummaries.swap(_icsStream.summaries());
+        data_pending = true;
+        xSemaphoreGive(dataMutex);
+    }
+    _icsStream.reset();
+}
+
+void CalendarModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    // Events anderer Ressourcen ignorieren; der Tick holt ein verlorenes Event nach
+    if (!event.isTick()) {
+        uint32_t generation = webClient->getRegistryGeneration();
+        if (generation != _resourceGeneration) {
+            _resourceId = webClient->getResourceId(icsUrl.c_str());
+            _resourceGeneration = generation;
         }
-    });
+        if (event.resource_id != _resourceId) return;
+    }
+    // Der Consumer legt fertige Events selbst ab, processData() prüft nur das Flag
+    processData();
 }
 
 void CalendarModule::processData() {
     LOG_MEM_OP("CalendarModule::processData");
     if (data_pending) {
         if (xSemaphoreTake(dataMutex, portMAX_DELAY) == pdTRUE) {
-            this->parseICS(pending_buffer, buffer_size);
+            this->buildEvents(pending_events);
             this->onSuccessfulUpdate();
-            free(pending_buffer);
-            pending_buffer = nullptr;
+            // Die neuen Termine zeigen in die Texte des Downloads, die alten werden freigegeben
+            _eventSummaries.swap(_pendingSummaries);
+            _pendingSummaries.clear();
+            pending_events.clear();
+            pending_events.shrink_to_fit();
             data_pending = false;
             xSemaphoreGive(dataMutex);
             if (this->updateCallback) this->updateCallback();
@@ -484,84 +509,75 @@ uint32_t CalendarModule::getScrollStepInterval() const {
     return scrollStepInterval; 
 }
 
-void CalendarModule::parseICS(char* icsBuffer, size_t size) {
-    if (!icsBuffer || size == 0) return;
-    PsramString ics(icsBuffer, size);
-    
+void CalendarModule::buildEvents(PsramEventVector& parsedEvents) {
     raw_events.clear();
     raw_events.reserve(1024);
-
-    PsramEventVector parsedEvents;
-    parsedEvents.reserve(512);
-    size_t idx = 0;
-    const PsramString beginTag("BEGIN:VEVENT"), endTag("END:VEVENT");
-    while (true) {
-        size_t pos = ics.find(beginTag, idx); if (pos == PsramString::npos) break;
-        size_t endPos = ics.find(endTag, pos); if (endPos == PsramString::npos) break;
-        PsramString veventBlock = ics.substr(pos, (endPos + endTag.length()) - pos);
-        Event parsedEvent;
-        parseVEvent(veventBlock.c_str(), veventBlock.length(), parsedEvent, &timeConverter);
-        if(parsedEvent.dtstart > 0) parsedEvents.push_back(std::move(parsedEvent));
-        idx = endPos + endTag.length();
-        if (parsedEvents.size() % 50 == 0) delay(1);
-    }
     if (parsedEvents.empty()) return;
     
     std::sort(parsedEvents.begin(), parsedEvents.end(), [](const Event& a, const Event& b){ return a.uid < b.uid; });
     delay(1);
     
+    // Serientermin: Sortierschlüssel (Vorkommen bzw. RECURRENCE-ID), Anzeigestart und Quelle
+    struct SeriesEntry {
+        time_t key;
+        time_t start;
+        const Event* event;
+    };
+
     size_t i = 0;
     while (i < parsedEvents.size()) {
         if (i > 0 && i % 50 == 0) delay(1);
         size_t j = i;
         while (j < parsedEvents.size() && parsedEvents[j].uid == parsedEvents[i].uid) j++;
         
-        Event masterEvent;
-        bool masterFound = false;
-        PsramEventVector exceptions;
-        PsramEventVector singleEvents;
+        // Nur Verweise in parsedEvents, keine Kopien der Events
+        const Event* masterEvent = nullptr;
+        PsramVector<const Event*> exceptions;
+        PsramVector<const Event*> singleEvents;
 
         for(size_t k = i; k < j; ++k) {
             if(!parsedEvents[k].rrule.empty()) {
-                masterEvent = parsedEvents[k];
-                masterFound = true;
+                masterEvent = &parsedEvents[k];
             } else if(parsedEvents[k].recurrence_id != 0) {
-                exceptions.push_back(parsedEvents[k]);
+                exceptions.push_back(&parsedEvents[k]);
             } else {
-                singleEvents.push_back(parsedEvents[k]);
+                singleEvents.push_back(&parsedEvents[k]);
             }
         }
 
-        if (!masterFound) {
-            for(const auto& single : singleEvents) addSingleEvent(single);
+        if (!masterEvent) {
+            for(const Event* single : singleEvents) addSingleEvent(*single, single->dtstart);
         } else {
             // Check if this is a daily recurring event
-            if (isDailyRecurring(masterEvent.rrule)) {
+            if (isDailyRecurring(masterEvent->rrule)) {
                 // For daily recurring events, add just one entry instead of expanding all occurrences
-                addDailyRecurringEvent(masterEvent);
+                addDailyRecurringEvent(*masterEvent);
             } else {
                 // For other recurrence types (weekly, monthly, yearly), expand as before
                 PsramTimeVector occurrences;
                 occurrences.reserve(128);
-                parseRRule(masterEvent, occurrences, 15, &timeConverter);
+                parseRRule(*masterEvent, occurrences, 15, &timeConverter);
                 
-                PsramEventPairVector final_series_vec;
-                final_series_vec.reserve(occurrences.size() + exceptions.size());
+                PsramVector<SeriesEntry> series;
+                series.reserve(occurrences.size() + exceptions.size());
                 for (time_t start : occurrences) {
-                    Event series_event = masterEvent;
-                    series_event.dtstart = start;
-                    final_series_vec.emplace_back(start, std::move(series_event));
+                    series.push_back({start, start, masterEvent});
                 }
-                for (const auto& ex : exceptions) {
+                for (const Event* ex : exceptions) {
                     bool replaced = false;
-                    for (auto &pr : final_series_vec) {
-                        if (pr.first == ex.recurrence_id) { pr.second = ex; replaced = true; break; }
+                    for (auto& entry : series) {
+                        if (entry.key == ex->recurrence_id) {
+                            entry.start = ex->dtstart;
+                            entry.event = ex;
+                            replaced = true;
+                            break;
+                        }
                     }
-                    if (!replaced) final_series_vec.emplace_back((ex.recurrence_id != 0) ? ex.recurrence_id : ex.dtstart, ex);
+                    if (!replaced) series.push_back({(ex->recurrence_id != 0) ? ex->recurrence_id : ex->dtstart, ex->dtstart, ex});
                 }
-                std::sort(final_series_vec.begin(), final_series_vec.end(), [](const PsramEventPair& a, const PsramEventPair& b){ return a.first < b.first; });
-                final_series_vec.erase(std::unique(final_series_vec.begin(), final_series_vec.end(), [](const PsramEventPair& a, const PsramEventPair& b){ return a.first == b.first; }), final_series_vec.end());
-                for (auto const& pr : final_series_vec) addSingleEvent(pr.second);
+                std::sort(series.begin(), series.end(), [](const SeriesEntry& a, const SeriesEntry& b){ return a.key < b.key; });
+                series.erase(std::unique(series.begin(), series.end(), [](const SeriesEntry& a, const SeriesEntry& b){ return a.key == b.key; }), series.end());
+                for (const auto& entry : series) addSingleEvent(*entry.event, entry.start);
             }
         }
         i = j;
@@ -579,16 +595,17 @@ void CalendarModule::onSuccessfulUpdate() {
         return a.startEpoch < b.startEpoch;
     });
     
-    events = raw_events;
+    events.swap(raw_events);
+    raw_events.clear();
     resetScroll();
 }
 
-void CalendarModule::addSingleEvent(const Event& ev) {
-    if (ev.dtstart == 0) return;
+void CalendarModule::addSingleEvent(const Event& ev, time_t startEpoch) {
+    if (startEpoch == 0) return;
     
     CalendarEvent ce;
-    ce.summary = ev.summary.c_str();
-    ce.startEpoch = ev.dtstart;
+    ce.summary = ev.summary;
+    ce.startEpoch = startEpoch;
     ce.duration = ev.duration;
     ce.isAllDay = ev.isAllDay;
     ce.isDailyRecurring = false;
@@ -629,7 +646,7 @@ void CalendarModule::addDailyRecurringEvent(const Event& ev) {
     time_t todayOccurrenceUTC = localTimeAsUTC - offset;
     
     CalendarEvent ce;
-    ce.summary = ev.summary.c_str();
+    ce.summary = ev.summary;
     ce.startEpoch = todayOccurrenceUTC;
     ce.duration = ev.duration;
     ce.isAllDay = ev.isAllDay;
@@ -25,7 +25,7 @@
 #define URGENT_EVENT_UID_BASE 1000              // Basis-UID für dringende Termine
 
 struct CalendarEvent {
-  PsramString summary;
+  const char* summary = "";  // Interniert im IcsStringPool der aktuellen Termine (_eventSummaries)
   time_t startEpoch;
   time_t duration;
   bool isAllDay;
@@ -39,15 +39,19 @@ struct CalendarEvent {
 
 using PsramEventVector = std::vector<Event, PsramAllocator<Event>>;
 using PsramTimeVector = std::vector<time_t, PsramAllocator<time_t>>;
-using PsramEventPair = std::pair<time_t, Event>;
-using PsramEventPairVector = std::vector<PsramEventPair, PsramAllocator<PsramEventPair>>;
 using PsramCalendarEventVector = std::vector<CalendarEvent, PsramAllocator<CalendarEvent>>;
 
 struct DeviceConfig;
 
 uint16_t hexColorTo565(const PsramString& hex);
 
-class CalendarModule : public DrawableModule {
+/**
+ * @brief Kalender-Modul: zeigt die nächsten Termine eines ICS-Kalenders.
+ *
+ * Der ICS-Download wird gestreamt (ResourceStreamConsumer): jeder VEVENT-Block wird geparst,
+ * sobald er vollständig empfangen ist, die Datei selbst liegt nie komplett im Speicher.
+ */
+class CalendarModule : public DrawableModule, public ResourceStreamConsumer {
 public:
     CalendarModule(U8G2_FOR_ADAFRUIT_GFX &u8g2, GFXcanvas16 &canvas, const GeneralTimeConverter& converter, WebClientModule* webClient, DeviceConfig* config);
     ~CalendarModule();
@@ -58,8 +62,8 @@ public:
     // Neue Funktion, um Urgent-View-Parameter zu setzen (von Anwendung / Webinterface)
     void setUrgentParams(int fastBlinkHours, int urgentThresholdHours, int urgentDurationSec, int urgentRepeatMin);
     
-    void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
     uint32_t getScrollStepInterval() const;
 
     // DrawableModule Interface
@@ -73,6 +77,11 @@ public:
     bool isEnabled() override;
     void resetPaging() override;
 
+    // ResourceStreamConsumer Interface (läuft im WebClient-Worker)
+    void onStreamBegin(int contentLength) override;
+    bool onStreamChunk(const char* data, size_t len) override;
+    void onStreamEnd(bool complete) override;
+
 private:
     U8G2_FOR_ADAFRUIT_GFX &u8g2;
     GFXcanvas16 &canvas;
@@ -82,6 +91,8 @@ private:
     std::function<void()> updateCallback;
     PsramString icsUrl;
     uint32_t fetchIntervalMinutes = 60;
+    uint32_t _resourceId = 0;           // Id der Stream-Ressource, zum Filtern der Update-Events
+    uint32_t _resourceGeneration = 0;
     PsramCalendarEventVector events;
     PsramCalendarEventVector raw_events;
     
@@ -92,11 +103,15 @@ private:
 
     uint16_t dateColor = 0xFFE0;
     uint16_t textColor = 0xFFFF;
-    time_t last_processed_update;
     SemaphoreHandle_t dataMutex;
 
-    char* pending_buffer = nullptr;
-    size_t buffer_size = 0;
+    // Streaming: bisher geparste VEVENTs des laufenden Downloads (nur im Worker benutzt)
+    IcsStreamParser _icsStream;
+    // Fertig geparste VEVENTs des letzten vollständigen Downloads, Übergabe an processData() (dataMutex)
+    PsramEventVector pending_events;
+    IcsStringPool _pendingSummaries;
+    // Texte der angezeigten Termine (events), wird mit ihnen zusammen getauscht (dataMutex)
+    IcsStringPool _eventSummaries;
     volatile bool data_pending = false;
 
     bool _isEnabled = false;
@@ -120,9 +135,9 @@ private:
     bool _hasPulsingEvents = false;
     unsigned long _lastPulseUpdate = 0;
 
-    void parseICS(char* icsBuffer, size_t size);
+    void buildEvents(PsramEventVector& parsedEvents);
     void onSuccessfulUpdate();
-    void addSingleEvent(const Event& ev);
+    void addSingleEvent(const Event& ev, time_t startEpoch);
     void addDailyRecurringEvent(const Event& ev);
     bool isDailyRecurring(const PsramString& rrule);
     PsramCalendarEventVector getUpcomingEvents(int maxCount);
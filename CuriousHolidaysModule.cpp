@@ -282,7 +282,6 @@ CuriousHolidaysModule::CuriousHolidaysModule(U8G2_FOR_ADAFRUIT_GFX& u8g2, GFXcan
 
 CuriousHolidaysModule::~CuriousHolidaysModule() {
     if (dataMutex) vSemaphoreDelete(dataMutex);
-    if (pendingBuffer) free(pendingBuffer);
 }
 
 void CuriousHolidaysModule::begin() {
@@ -309,6 +308,7 @@ void CuriousHolidaysModule::setConfig() {
     if (webClient) {
         webClient->registerResource(String(resourceUrl.c_str()), 720, nullptr);
     }
+    resourceSub.setUrl(resourceUrl);
 }
 
 void CuriousHolidaysModule::queueData() {
@@ -330,19 +330,10 @@ void CuriousHolidaysModule::queueData() {
         setConfig(); 
     }
 
-    webClient->accessResource(String(resourceUrl.c_str()), [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-        if (buffer && size > 0 && last_update > this->lastProcessedUpdate) {
-            if (pendingBuffer) free(pendingBuffer);
-            pendingBuffer = (char*)ps_malloc(size + 1);
-            if (pendingBuffer) {
-                memcpy(pendingBuffer, buffer, size);
-                pendingBuffer[size] = '\0';
-                bufferSize = size;
-                lastProcessedUpdate = last_update;
-                dataPending = true;
-            }
-        }
-    });
+    if (webClient->takeNewData(resourceSub, pendingData)) {
+        lastProcessedUpdate = pendingData.lastUpdate();
+        dataPending = true;
+    }
 }
 
 void CuriousHolidaysModule::handleDayChange() {
@@ -364,12 +355,18 @@ void CuriousHolidaysModule::handleDayChange() {
     }
 }
 
+void CuriousHolidaysModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    // Der Tick deckt auch den Tages- und Monatswechsel in queueData() ab
+    if (!resourceSub.concerns(event)) return;
+    queueData();
+    processData();
+}
+
 void CuriousHolidaysModule::processData() {
     LOG_MEM_OP("CuriousHolidaysModule::processData");
     if (dataPending) {
-        parseAndProcessHtml(pendingBuffer, bufferSize);
-        free(pendingBuffer);
-        pendingBuffer = nullptr;
+        parseAndProcessHtml(pendingData.data(), pendingData.size());
+        pendingData.reset();
         dataPending = false;
         if (updateCallback) this->updateCallback();
     }
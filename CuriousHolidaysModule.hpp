@@ -24,6 +24,7 @@ public:
     void setConfig();
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
     void onUpdate(std::function<void()> callback);
 
     const char* getModuleName() const override { return "CuriousHolidaysModule"; }
@@ -53,8 +54,8 @@ private:
     PsramString resourceUrl;
     SemaphoreHandle_t dataMutex;
     std::function<void()> updateCallback;
-    char* pendingBuffer = nullptr;
-    size_t bufferSize = 0;
+    ResourceSubscription resourceSub;
+    ResourceDataRef pendingData;
     time_t lastProcessedUpdate = 0;
     bool dataPending = false;
 
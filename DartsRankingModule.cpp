@@ -63,6 +63,8 @@ DartsPlayer::~DartsPlayer() {
 DartsRankingModule::DartsRankingModule(U8G2_FOR_ADAFRUIT_GFX& u8g2_ref, GFXcanvas16& canvas_ref, WebClientModule* webClient_ptr, DeviceConfig* config)
     : u8g2(u8g2_ref), canvas(canvas_ref), webClient(webClient_ptr), config(config) {
     dataMutex = xSemaphoreCreateMutex();
+    oom_sub.setUrl("https://www.dartsrankings.com/");
+    protour_sub.setUrl("https://www.dartsrankings.com/protour");
     
     // PixelScroller für Spielernamen
     _pixelScroller = new (ps_malloc(sizeof(PixelScroller))) PixelScroller(u8g2, 50);
@@ -82,8 +84,6 @@ DartsRankingModule::DartsRankingModule(U8G2_FOR_ADAFRUIT_GFX& u8g2_ref, GFXcanva
 
 DartsRankingModule::~DartsRankingModule() {
     if (dataMutex) vSemaphoreDelete(dataMutex);
-    if (oom_pending_buffer) free(oom_pending_buffer);
-    if (protour_pending_buffer) free(protour_pending_buffer);
     if (_pixelScroller) {
         _pixelScroller->~PixelScroller();
         free(_pixelScroller);
@@ -412,45 +412,32 @@ void DartsRankingModule::queueData() {
     if (!webClient) return;
     
     if (_oomEnabled) {
-        webClient->accessResource("https://www.dartsrankings.com/", [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-            if (buffer && size > 0 && last_update > this->oom_last_processed_update) {
-                if (oom_pending_buffer) free(oom_pending_buffer);
-                oom_pending_buffer = (char*)ps_malloc(size + 1);
-                if (oom_pending_buffer) {
-                    memcpy(oom_pending_buffer, buffer, size);
-                    oom_pending_buffer[size] = '\0';
-                    oom_buffer_size = size;
-                    oom_last_processed_update = last_update;
-                    oom_data_pending = true;
-                }
-            }
-        });
+        if (webClient->takeNewData(oom_sub, oom_pending_data)) {
+            oom_last_processed_update = oom_pending_data.lastUpdate();
+            oom_data_pending = true;
+        }
     }
     
     if (_proTourEnabled) {
-        webClient->accessResource("https://www.dartsrankings.com/protour", [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-            if (buffer && size > 0 && last_update > this->protour_last_processed_update) {
-                if (protour_pending_buffer) free(protour_pending_buffer);
-                protour_pending_buffer = (char*)ps_malloc(size + 1);
-                if (protour_pending_buffer) {
-                    memcpy(protour_pending_buffer, buffer, size);
-                    protour_pending_buffer[size] = '\0';
-                    protour_buffer_size = size;
-                    protour_last_processed_update = last_update;
-                    protour_data_pending = true;
-                }
-            }
-        });
+        if (webClient->takeNewData(protour_sub, protour_pending_data)) {
+            protour_last_processed_update = protour_pending_data.lastUpdate();
+            protour_data_pending = true;
+        }
     }
 }
 
+void DartsRankingModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    if (!(oom_sub.concerns(event) || protour_sub.concerns(event))) return;
+    queueData();
+    processData();
+}
+
 void DartsRankingModule::processData() {
     LOG_MEM_OP("DartsRankingModule::processData");
     if (oom_data_pending) {
         if (xSemaphoreTake(dataMutex, portMAX_DELAY) == pdTRUE) {
-            parseHtml(oom_pending_buffer, oom_buffer_size, DartsRankingType::ORDER_OF_MERIT);
-            free(oom_pending_buffer);
-            oom_pending_buffer = nullptr;
+            parseHtml(oom_pending_data.data(), oom_pending_data.size(), DartsRankingType::ORDER_OF_MERIT);
+            oom_pending_data.reset();
             oom_data_pending = false;
             xSemaphoreGive(dataMutex);
             if (updateCallback) updateCallback(DartsRankingType::ORDER_OF_MERIT);
@@ -458,9 +445,8 @@ void DartsRankingModule::processData() {
     }
     if (protour_data_pending) {
         if (xSemaphoreTake(dataMutex, portMAX_DELAY) == pdTRUE) {
-            parseHtml(protour_pending_buffer, protour_buffer_size, DartsRankingType::PRO_TOUR);
-            free(protour_pending_buffer);
-            protour_pending_buffer = nullptr;
+            parseHtml(protour_pending_data.data(), protour_pending_data.size(), DartsRankingType::PRO_TOUR);
+            protour_pending_data.reset();
             protour_data_pending = false;
             xSemaphoreGive(dataMutex);
             if (updateCallback) updateCallback(DartsRankingType::PRO_TOUR);
@@ -8,9 +8,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "DrawableModule.hpp"
+#include "WebClientModule.hpp"
 #include "PixelScroller.hpp"
 
-class WebClientModule;
 
 struct DartsDisplayColors {
     uint16_t rankColor = 0xFFFF;
@@ -56,6 +56,7 @@ public:
     void setConfig(bool oomEnabled, bool proTourEnabled, uint32_t fetchIntervalMinutes, unsigned long displaySec, const PsramString& trackedPlayers);
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
 
     // DrawableModule Interface
     const char* getModuleName() const override { return "DartsRankingModule"; }
@@ -78,11 +79,11 @@ private:
     SemaphoreHandle_t dataMutex;
     DartsDisplayColors colors;
 
-    char* oom_pending_buffer = nullptr;
-    size_t oom_buffer_size = 0;
+    ResourceSubscription oom_sub;
+    ResourceDataRef oom_pending_data;
     volatile bool oom_data_pending = false;
-    char* protour_pending_buffer = nullptr;
-    size_t protour_buffer_size = 0;
+    ResourceSubscription protour_sub;
+    ResourceDataRef protour_pending_data;
     volatile bool protour_data_pending = false;
     
     static const int PLAYERS_PER_PAGE = 5;
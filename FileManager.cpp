@@ -32,6 +32,11 @@ static String sanitizePathParam(const String& raw) {
     return p;
 }
 
+// Helper: the WebClient caches certificates from /certs, drop that cache when something below it changed
+static void notifyCertChange(const String& path) {
+    if (webClient && path.indexOf("certs") != -1) webClient->invalidateCertCache();
+}
+
 // Helper: compute parent path, e.g. "/a/b/c" -> "/a/b", "/a" -> "/", "/" -> "/"
 static String parentPath(const String& path) {
     if (path == "/" || path.length() == 0) return "/";
@@ -1153,6 +1158,7 @@ static void uploadHandlerFs() {
                 LittleFS.remove(tmpPath);
             }
             Log.printf("[WebFS] Upload finished -> %s\n", targetPath.c_str());
+            notifyCertChange(targetPath);
         } else {
             Log.println("[WebFS] Upload finished but no file was opened (probably refused)");
         }
@@ -1551,12 +1557,18 @@ void setupFileManagerRoutes() {
     server->on("/fs/list", HTTP_GET, handleFsList);
     server->on("/fs/download", HTTP_GET, handleFsDownload);
     server->on("/fs/downloadall", HTTP_GET, handleFsDownloadAll);
-    server->on("/fs/delete", HTTP_DELETE, handleFsDelete);
+    server->on("/fs/delete", HTTP_DELETE, []() {
+        handleFsDelete();
+        notifyCertChange(server->arg("path"));
+    });
     server->on("/fs/upload", HTTP_POST, handleFsUploadBegin, uploadHandlerFs);
     server->onFileUpload(uploadHandlerFs);
     // Accept GET for mkdir and keep POST not needed (client uses GET)
     server->on("/fs/mkdir", HTTP_GET, handleFsMkdir);
     // accept GET for rename (query params) - POST not required
-    server->on("/fs/rename", HTTP_GET, handleFsRename);
+    server->on("/fs/rename", HTTP_GET, []() {
+        handleFsRename();
+        notifyCertChange(server->arg("src") + " " + server->arg("dest") + " " + server->arg("cwd"));
+    });
     server->on("/fs/info", HTTP_GET, handleFsInfo);
 }
\ No newline at end of file
@@ -202,7 +202,8 @@ void FritzboxModule::queryCallerInfo(const PsramString& number) {
             } else {
                 Log.println("[Fritzbox] Keine oder leere Antwort bei der Namensabfrage.");
             }
-        }
+        },
+        JOB_PRIORITY_LIVE
     );
 }
 
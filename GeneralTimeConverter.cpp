@@ -205,4 +205,11 @@ int GeneralTimeConverter::getStdOffsetSec() const {
 
 int GeneralTimeConverter::getDstOffsetSec() const {
     return dstOffsetSec;
-}
\ No newline at end of file
+}
+
+bool GeneralTimeConverter::getDstTransitions(int year, time_t& dstStartUtc, time_t& dstEndUtc) const {
+    if (!isValid || dstOffsetSec == stdOffsetSec) return false;
+    dstStartUtc = calculateRuleDate(year, dstStartRule, stdOffsetSec);
+    dstEndUtc = calculateRuleDate(year, dstEndRule, dstOffsetSec);
+    return true;
+}
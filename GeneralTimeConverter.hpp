@@ -34,6 +34,9 @@ public:
     int getStdOffsetSec() const;
     int getDstOffsetSec() const;
 
+    // NEU: Umschaltzeitpunkte (UTC) eines Jahres, wie isDST() sie verwendet; false ohne Sommerzeit
+    bool getDstTransitions(int year, time_t& dstStartUtc, time_t& dstEndUtc) const;
+
 private:
     struct Rule {
         int month = 0;
@@ -11,7 +11,8 @@ MultiLogger Log;
 extern SemaphoreHandle_t serialMutex;
 
 MultiLogger::MultiLogger(size_t bufferSize) 
-    : _bufferSize(bufferSize), _writeIndex(0), _readIndex(0), _bufferFull(false), _debugFileEnabled(false) {
+    : _bufferSize(bufferSize), _writeIndex(0), _readIndex(0), _bufferFull(false),
+      _readOffset(0), _partialLineCut(false), _droppedLines(0), _debugFileEnabled(false) {
     
     // Pre-allocate ring buffer in PSRAM
     _ringBuffer.reserve(bufferSize);
@@ -109,13 +110,13 @@ void MultiLogger::_finalizeLine() {
         snprintf(timeStr, sizeof(timeStr), "[%lu] ", timestamp);
     }
     
-    PsramString finalLine = PsramString(timeStr) + _currentLine;
+    // Build the line in place, the slot keeps its capacity so steady-state logging does not allocate
+    PsramString& slot = _ringBuffer[_writeIndex];
+    slot.assign(timeStr);
+    slot += _currentLine;
     
     // Write to debug file if enabled
-    _writeToDebugFile(finalLine);
-    
-    // Add to ring buffer
-    _ringBuffer[_writeIndex] = finalLine;
+    _writeToDebugFile(slot);
     
     // Update write index
     _writeIndex = (_writeIndex + 1) % _bufferSize;
@@ -124,7 +125,8 @@ void MultiLogger::_finalizeLine() {
     if (_writeIndex == _readIndex) {
         _bufferFull = true;
         // Move read index forward to maintain ring buffer behavior
-        _readIndex = (_readIndex + 1) % _bufferSize;
+        _abandonReadLine();
+        _droppedLines++;
     }
     
     // Clear current line for next message
@@ -153,7 +155,7 @@ size_t MultiLogger::getNewLines(PsramVector<PsramString>& outLines) {
                 count++;
             }
             
-            _readIndex = (_readIndex + 1) % _bufferSize;
+            _abandonReadLine();
             _bufferFull = false; // Once we start reading, it's no longer full
         }
         
@@ -163,6 +165,68 @@ size_t MultiLogger::getNewLines(PsramVector<PsramString>& outLines) {
     return count;
 }
 
+size_t MultiLogger::readNewRecords(uint8_t* buffer, size_t capacity, uint32_t& droppedLines) {
+    droppedLines = 0;
+    if (!buffer || capacity <= 3) return 0;
+    
+    size_t outPos = 0;
+    
+    if (xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+        droppedLines = _droppedLines;
+        _droppedLines = 0;
+        
+        // Close the line the reader got only the beginning of, otherwise the next record would be appended to it
+        if (_partialLineCut) {
+            buffer[outPos++] = LOG_RECORD_TRUNCATED;
+            buffer[outPos++] = 0;
+            buffer[outPos++] = 0;
+            _partialLineCut = false;
+        }
+        
+        while ((_readIndex != _writeIndex || _bufferFull) && outPos + 3 < capacity) {
+            const PsramString& line = _ringBuffer[_readIndex];
+            size_t remaining = line.size() > _readOffset ? line.size() - _readOffset : 0;
+            size_t space = min(capacity - outPos - 3, (size_t)0xFFFF);
+            
+            // Start a line that fits completely in a fresh buffer with the next call instead of splitting it
+            if (remaining > space && outPos > 0 && remaining <= capacity - 3) {
+                break;
+            }
+            
+            if (remaining > 0) {
+                size_t chunk = min(remaining, space);
+                bool continued = chunk < remaining;
+                buffer[outPos++] = continued ? LOG_RECORD_CONTINUED : 0;
+                buffer[outPos++] = (chunk >> 8) & 0xFF;
+                buffer[outPos++] = chunk & 0xFF;
+                memcpy(buffer + outPos, line.data() + _readOffset, chunk);
+                outPos += chunk;
+                
+                if (continued) {
+                    _readOffset += chunk;
+                    break;
+                }
+            }
+            
+            _readIndex = (_readIndex + 1) % _bufferSize;
+            _readOffset = 0;
+            _bufferFull = false;
+        }
+        
+        xSemaphoreGive(_mutex);
+    }
+    
+    return outPos;
+}
+
+void MultiLogger::_abandonReadLine() {
+    if (_readOffset > 0) {
+        _partialLineCut = true;
+    }
+    _readIndex = (_readIndex + 1) % _bufferSize;
+    _readOffset = 0;
+}
+
 size_t MultiLogger::getAllLines(PsramVector<PsramString>& outLines) {
     size_t count = 0;
     
@@ -192,6 +256,9 @@ void MultiLogger::clearBuffer() {
         _writeIndex = 0;
         _readIndex = 0;
         _bufferFull = false;
+        _partialLineCut = _partialLineCut || _readOffset > 0;
+        _readOffset = 0;
+        _droppedLines = 0;
         _currentLine.clear();
         
         xSemaphoreGive(_mutex);
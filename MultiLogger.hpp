@@ -57,6 +57,22 @@ public:
      */
     size_t getNewLines(PsramVector<PsramString>& outLines);
     
+    /**
+     * @brief Copy new log lines as length-prefixed records directly into a caller buffer
+     * 
+     * Record format: [flags][len high][len low][text], flags bit 0 (LOG_RECORD_CONTINUED)
+     * marks a line that continues in the next record. Lines that no longer fit are left
+     * for the next call, lines longer than the whole buffer are split into several records.
+     * If a line was handed out partly and is lost before its last record (overwritten by the
+     * ring, cleared, or taken by getNewLines()), the next call starts with an empty record
+     * flagged LOG_RECORD_TRUNCATED that terminates it.
+     * @param buffer Destination buffer
+     * @param capacity Capacity of the destination buffer
+     * @param droppedLines Receives the number of unread lines overwritten since the last call
+     * @return Number of bytes written (0 if nothing new)
+     */
+    size_t readNewRecords(uint8_t* buffer, size_t capacity, uint32_t& droppedLines);
+    
     /**
      * @brief Get all log lines in the buffer
      * @param outLines Output vector to store the log lines
@@ -89,6 +105,15 @@ private:
     size_t _readIndex;
     bool _bufferFull;
     
+    // Position inside the line at _readIndex already handed out by readNewRecords()
+    size_t _readOffset;
+    
+    // A partly handed out line was lost, readNewRecords() owes the reader a terminating record
+    bool _partialLineCut;
+    
+    // Unread lines overwritten since the last readNewRecords() call
+    uint32_t _droppedLines;
+    
     // Current line being built
     PsramString _currentLine;
     
@@ -110,8 +135,18 @@ private:
      * @brief Write line to debug file if enabled
      */
     void _writeToDebugFile(const PsramString& line);
+    
+    /**
+     * @brief Move the reader to the next line, remembering if the current one was partly handed out
+     */
+    void _abandonReadLine();
 };
 
+// Record flag: the line continues in the next record (see readNewRecords)
+#define LOG_RECORD_CONTINUED 0x01
+// Record flag: empty record ending a continued line whose remaining records were lost
+#define LOG_RECORD_TRUNCATED 0x02
+
 // Serial mutex (from main application) - external declaration
 extern SemaphoreHandle_t serialMutex;
 
@@ -884,3 +884,35 @@ bool PanelManager::copyFullPanelBuffer(uint16_t* destinationBuffer, size_t buffe
     
     return false;
 }
+
+bool PanelManager::copyPanelRows(uint16_t* destinationBuffer, int firstRow, int rowCount) {
+    if (!destinationBuffer || firstRow < 0 || rowCount <= 0 || firstRow + rowCount > FULL_HEIGHT) {
+        return false;
+    }
+    
+    // Lock canvas access
+    if (_canvasMutex && xSemaphoreTake(_canvasMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        bool ok = true;
+        if (_fullscreenActive && _fullCanvas && _fullCanvas->getBuffer()) {
+            // Fullscreen-Modus: Zeilen liegen zusammenhängend im Fullscreen-Canvas
+            memcpy(destinationBuffer, _fullCanvas->getBuffer() + (size_t)firstRow * FULL_WIDTH,
+                   (size_t)rowCount * FULL_WIDTH * sizeof(uint16_t));
+        } else if (_canvasTime && _canvasData && _canvasTime->getBuffer() && _canvasData->getBuffer()) {
+            // Normaler Modus: Zeilen aus Time- bzw. Data-Canvas
+            for (int row = firstRow; row < firstRow + rowCount; row++) {
+                const uint16_t* source = (row < TIME_AREA_H)
+                    ? _canvasTime->getBuffer() + (size_t)row * FULL_WIDTH
+                    : _canvasData->getBuffer() + (size_t)(row - TIME_AREA_H) * FULL_WIDTH;
+                memcpy(destinationBuffer, source, FULL_WIDTH * sizeof(uint16_t));
+                destinationBuffer += FULL_WIDTH;
+            }
+        } else {
+            ok = false;
+        }
+        
+        xSemaphoreGive(_canvasMutex);
+        return ok;
+    }
+    
+    return false;
+}
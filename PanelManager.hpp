@@ -189,6 +189,9 @@ public:
     // NEW: Thread-safe panel buffer copy for streaming
     bool copyFullPanelBuffer(uint16_t* destinationBuffer, size_t bufferSize);
     
+    // Thread-safe copy of a range of panel rows (rowCount * FULL_WIDTH pixels), for snapshots
+    bool copyPanelRows(uint16_t* destinationBuffer, int firstRow, int rowCount);
+    
     // NEU: Fullscreen Canvas Support
     /**
      * @brief Gibt zurück ob gerade ein Modul im Fullscreen-Modus angezeigt wird.
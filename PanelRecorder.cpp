@@ -0,0 +1,378 @@
+#include "PanelRecorder.hpp"
+#include "MultiLogger.hpp"
+#include <LittleFS.h>
+#include <time.h>
+
+static const uint8_t PANEL_RECORDER_MAGIC[4] = { 'P', 'C', 'R', '2' };
+
+static inline void writeU16(uint8_t* p, uint16_t v) {
+    p[0] = (v >> 8) & 0xFF;
+    p[1] = v & 0xFF;
+}
+
+static inline void writeU32(uint8_t* p, uint32_t v) {
+    p[0] = (v >> 24) & 0xFF;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+static inline uint32_t readU32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+PanelRecorder::PanelRecorder(PanelManager* panelManager)
+    : _panelManager(panelManager), _enabled(false), _intervalMs(2000), _maxBytesPerHour(512 * 1024),
+      _captureBuffer(nullptr), _referenceBuffer(nullptr), _tileBuffer(nullptr), _needsKeyframe(true), _recordSequence(0),
+      _recordBuffer(nullptr), _recordBufferSize(0), _pendingBuffer(nullptr), _pendingLen(0),
+      _currentSegment(-1), _segmentOpen(false), _nextSeq(1),
+      _lastCaptureMs(0), _lastFlushMs(0), _budgetWindowStartMs(0), _bytesThisHour(0), _budgetExhausted(false),
+      _readers(0), _framesRecorded(0), _framesSkipped(0), _bytesFlushed(0), _encodeUs(0) {
+
+    _mutex = xSemaphoreCreateMutex();
+    if (!_mutex) {
+        Log.println("[PanelRecorder] FATAL: Failed to create mutex!");
+    }
+
+    size_t panelBytes = FULL_WIDTH * FULL_HEIGHT * sizeof(PanelStreamPixelType);
+    _recordBufferSize = PANEL_RECORDER_RECORD_HEADER_SIZE + PANEL_STREAM_HEADER_SIZE +
+                        PANEL_STREAM_TILE_COUNT * (3 + _codec.maxEncodedSize(PANEL_STREAM_TILE_PIXELS));
+
+    // Allocate buffers in PSRAM
+    _captureBuffer = (PanelStreamPixelType*)ps_malloc(panelBytes);
+    _referenceBuffer = (PanelStreamPixelType*)ps_malloc(panelBytes);
+    _tileBuffer = (PanelStreamPixelType*)ps_malloc(PANEL_STREAM_TILE_PIXELS * sizeof(PanelStreamPixelType));
+    _recordBuffer = (uint8_t*)ps_malloc(_recordBufferSize);
+    _pendingBuffer = (uint8_t*)ps_malloc(PANEL_RECORDER_SEGMENT_SIZE);
+
+    if (!_captureBuffer || !_referenceBuffer || !_tileBuffer || !_recordBuffer || !_pendingBuffer) {
+        Log.println("[PanelRecorder] FATAL: Failed to allocate buffers in PSRAM!");
+    } else {
+        memset(_referenceBuffer, 0, panelBytes);
+    }
+
+    scanSegments();
+}
+
+PanelRecorder::~PanelRecorder() {
+    if (_mutex && xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE) {
+        flushPending();
+        xSemaphoreGive(_mutex);
+    }
+
+    if (_captureBuffer) free(_captureBuffer);
+    if (_referenceBuffer) free(_referenceBuffer);
+    if (_tileBuffer) free(_tileBuffer);
+    if (_recordBuffer) free(_recordBuffer);
+    if (_pendingBuffer) free(_pendingBuffer);
+
+    if (_mutex) {
+        vSemaphoreDelete(_mutex);
+    }
+}
+
+void PanelRecorder::segmentPath(uint8_t index, char* out, size_t outSize) {
+    snprintf(out, outSize, "%s/seg%u.bin", PANEL_RECORDER_DIR, index);
+}
+
+void PanelRecorder::scanSegments() {
+    if (!LittleFS.exists(PANEL_RECORDER_DIR)) {
+        LittleFS.mkdir(PANEL_RECORDER_DIR);
+    }
+
+    uint32_t newestSeq = 0;
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < PANEL_RECORDER_SEGMENTS; i++) {
+        _segmentSeq[i] = 0;
+        _segmentSize[i] = 0;
+
+        char path[32];
+        segmentPath(i, path, sizeof(path));
+        if (!LittleFS.exists(path)) continue;
+
+        File file = LittleFS.open(path, "r");
+        if (!file) continue;
+        uint8_t header[PANEL_RECORDER_HEADER_SIZE];
+        if (file.read(header, sizeof(header)) == sizeof(header) && memcmp(header, PANEL_RECORDER_MAGIC, 4) == 0) {
+            _segmentSeq[i] = readU32(header + 4);
+            _segmentSize[i] = file.size();
+            found++;
+            if (_segmentSeq[i] > newestSeq) {
+                newestSeq = _segmentSeq[i];
+                _currentSegment = i;
+            }
+        }
+        file.close();
+    }
+
+    // Continue after the newest segment, the next recording always starts a fresh one
+    _nextSeq = newestSeq + 1;
+    _segmentOpen = false;
+    Log.printf("[PanelRecorder] %u Segmente gefunden, nächste Sequenz %lu\n", found, (unsigned long)_nextSeq);
+}
+
+void PanelRecorder::setConfig(bool enabled, int intervalSec, int maxKBPerHour) {
+    if (!_mutex || xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return;
+
+    _intervalMs = (uint32_t)max(intervalSec, 1) * 1000;
+    _maxBytesPerHour = (uint32_t)max(maxKBPerHour, 16) * 1024;
+
+    if (enabled && !_enabled) {
+        // The reference frame is stale after a pause
+        _needsKeyframe = true;
+        _lastCaptureMs = millis() - _intervalMs;
+        Log.printf("[PanelRecorder] Aufnahme aktiviert (alle %lu s, max. %lu KB/h)\n",
+                   (unsigned long)(_intervalMs / 1000), (unsigned long)(_maxBytesPerHour / 1024));
+    } else if (!enabled && _enabled) {
+        flushPending();
+        Log.println("[PanelRecorder] Aufnahme deaktiviert");
+    }
+    _enabled = enabled;
+
+    xSemaphoreGive(_mutex);
+}
+
+void PanelRecorder::tick() {
+    if (!_enabled || !_captureBuffer || !_referenceBuffer || !_tileBuffer || !_recordBuffer || !_pendingBuffer) {
+        return;
+    }
+
+    unsigned long now = millis();
+    if (now - _lastCaptureMs < _intervalMs) {
+        return;
+    }
+
+    // Never wait here: while the configuration changes or a download runs this frame is skipped
+    if (xSemaphoreTake(_mutex, 0) != pdTRUE) {
+        return;
+    }
+    _lastCaptureMs = now;
+
+    if (now - _budgetWindowStartMs >= 3600000UL) {
+        _budgetWindowStartMs = now;
+        _bytesThisHour = 0;
+        _budgetExhausted = false;
+    }
+
+    // Time-based flush, so a quiet panel still reaches the flash
+    if (_pendingLen > 0 && now - _lastFlushMs >= PANEL_RECORDER_FLUSH_INTERVAL_MS) {
+        flushPending();
+    }
+
+    if (_readers > 0 || _budgetExhausted) {
+        _framesSkipped++;
+        xSemaphoreGive(_mutex);
+        return;
+    }
+
+    // Copy panel buffer (thread-safe, render() is only blocked for the memcpy)
+    if (!_panelManager || !_panelManager->copyFullPanelBuffer(_captureBuffer, FULL_WIDTH * FULL_HEIGHT)) {
+        xSemaphoreGive(_mutex);
+        return;
+    }
+
+    bool changedTiles[PANEL_STREAM_TILE_COUNT];
+    uint16_t changedCount = 0;
+    for (uint8_t tileIndex = 0; tileIndex < PANEL_STREAM_TILE_COUNT; tileIndex++) {
+        changedTiles[tileIndex] = PanelStreamer::tileDiffers(_captureBuffer, _referenceBuffer,
+                                                              tileIndex % PANEL_STREAM_TILES_X,
+                                                              tileIndex / PANEL_STREAM_TILES_X);
+        if (changedTiles[tileIndex]) changedCount++;
+    }
+
+    if (changedCount == 0 && !_needsKeyframe) {
+        xSemaphoreGive(_mutex);
+        return;
+    }
+
+    bool keyframe = _needsKeyframe || !_segmentOpen;
+    size_t recordLen = encodeRecord(keyframe, changedTiles);
+
+    // Every segment starts with a keyframe, so each one can be replayed on its own
+    bool rotate = !_segmentOpen || _segmentSize[_currentSegment] + _pendingLen + recordLen > PANEL_RECORDER_SEGMENT_SIZE;
+    if (rotate && !keyframe) {
+        keyframe = true;
+        recordLen = encodeRecord(true, changedTiles);
+    }
+    size_t writeLen = recordLen + (rotate ? PANEL_RECORDER_HEADER_SIZE : 0);
+
+    // Budget and size are checked before rotating: startSegment() truncates the oldest segment,
+    // which must only happen for a frame that is actually recorded
+    if (_bytesThisHour + writeLen > _maxBytesPerHour) {
+        _budgetExhausted = true;
+        _framesSkipped++;
+        Log.printf("[PanelRecorder] Schreibbudget von %lu KB/h erreicht, Aufnahme pausiert bis zum nächsten Stundenfenster\n",
+                   (unsigned long)(_maxBytesPerHour / 1024));
+        xSemaphoreGive(_mutex);
+        return;
+    }
+
+    if (rotate) {
+        if (writeLen > PANEL_RECORDER_SEGMENT_SIZE) {
+            Log.printf("[PanelRecorder] Keyframe (%u Bytes) passt nicht in ein Segment\n", (unsigned)recordLen);
+            _framesSkipped++;
+            xSemaphoreGive(_mutex);
+            return;
+        }
+        if (!startSegment()) {
+            xSemaphoreGive(_mutex);
+            return;
+        }
+    }
+
+    memcpy(_pendingBuffer + _pendingLen, _recordBuffer, recordLen);
+    _pendingLen += recordLen;
+    _bytesThisHour += writeLen;
+    _framesRecorded++;
+    if (keyframe) {
+        _needsKeyframe = false;
+    }
+
+    // The recorded frame becomes the reference for the next delta
+    PanelStreamPixelType* recorded = _captureBuffer;
+    _captureBuffer = _referenceBuffer;
+    _referenceBuffer = recorded;
+
+    if (_pendingLen >= PANEL_RECORDER_WRITE_BLOCK) {
+        flushPending();
+    }
+
+    xSemaphoreGive(_mutex);
+}
+
+size_t PanelRecorder::encodeRecord(bool keyframe, const bool* changedTiles) {
+    unsigned long startUs = micros();
+
+    size_t pos = PANEL_RECORDER_RECORD_HEADER_SIZE;
+    pos += PanelStreamer::writeFrameHeader(_recordBuffer + pos, keyframe ? PANEL_STREAM_FRAME_KEY : PANEL_STREAM_FRAME_DELTA,
+                                           _recordSequence++, millis(), _codec.id());
+
+    for (uint8_t tileIndex = 0; tileIndex < PANEL_STREAM_TILE_COUNT; tileIndex++) {
+        if (!keyframe && !changedTiles[tileIndex]) continue;
+
+        // Tile record: [index][len high][len low][payload], same as the live stream
+        PanelStreamer::copyTile(_captureBuffer, tileIndex % PANEL_STREAM_TILES_X, tileIndex / PANEL_STREAM_TILES_X, _tileBuffer);
+        size_t payloadSize = _codec.encode(_tileBuffer, PANEL_STREAM_TILE_PIXELS,
+                                           _recordBuffer + pos + 3, _recordBufferSize - pos - 3);
+        _recordBuffer[pos] = tileIndex;
+        writeU16(_recordBuffer + pos + 1, (uint16_t)payloadSize);
+        pos += 3 + payloadSize;
+    }
+
+    writeU32(_recordBuffer, (uint32_t)time(nullptr));
+    writeU16(_recordBuffer + 4, (uint16_t)(pos - PANEL_RECORDER_RECORD_HEADER_SIZE));
+
+    _encodeUs += micros() - startUs;
+    return pos;
+}
+
+bool PanelRecorder::startSegment() {
+    if (_segmentOpen && !flushPending()) {
+        return false;
+    }
+
+    // Overwrite the oldest segment
+    uint8_t index = (uint8_t)((_currentSegment + 1) % PANEL_RECORDER_SEGMENTS);
+    char path[32];
+    segmentPath(index, path, sizeof(path));
+    File file = LittleFS.open(path, "w");
+    if (!file) {
+        Log.printf("[PanelRecorder] Segment %s kann nicht angelegt werden\n", path);
+        return false;
+    }
+    file.close();
+
+    _currentSegment = index;
+    _segmentOpen = true;
+    _segmentSeq[index] = _nextSeq++;
+    _segmentSize[index] = 0;
+
+    memcpy(_pendingBuffer, PANEL_RECORDER_MAGIC, 4);
+    writeU32(_pendingBuffer + 4, _segmentSeq[index]);
+    writeU16(_pendingBuffer + 8, FULL_WIDTH);
+    writeU16(_pendingBuffer + 10, FULL_HEIGHT);
+    _pendingBuffer[12] = PANEL_STREAM_TILE_SIZE;
+    _pendingBuffer[13] = _codec.id();
+    _pendingBuffer[14] = 0;
+    _pendingBuffer[15] = 0;
+    _pendingLen = PANEL_RECORDER_HEADER_SIZE;
+    _needsKeyframe = true;
+    return true;
+}
+
+bool PanelRecorder::flushPending() {
+    _lastFlushMs = millis();
+    if (!_segmentOpen || _pendingLen == 0) {
+        return true;
+    }
+
+    char path[32];
+    segmentPath(_currentSegment, path, sizeof(path));
+    File file = LittleFS.open(path, "a");
+    size_t written = 0;
+    if (file) {
+        written = file.write(_pendingBuffer, _pendingLen);
+        file.close();
+    }
+
+    _segmentSize[_currentSegment] += written;
+    _bytesFlushed += written;
+    bool ok = (written == _pendingLen);
+    _pendingLen = 0;
+
+    if (!ok) {
+        // The segment ends with a truncated record, the reader stops there; continue in a new one
+        Log.printf("[PanelRecorder] Schreiben von %s fehlgeschlagen\n", path);
+        _segmentOpen = false;
+    }
+    return ok;
+}
+
+bool PanelRecorder::beginRead(uint8_t* order, uint32_t* sizes, uint8_t& count) {
+    count = 0;
+    if (!_mutex || xSemaphoreTake(_mutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        return false;
+    }
+
+    flushPending();
+    _readers++;
+
+    // Oldest segment first
+    for (uint8_t i = 0; i < PANEL_RECORDER_SEGMENTS; i++) {
+        if (_segmentSeq[i] == 0 || _segmentSize[i] <= PANEL_RECORDER_HEADER_SIZE) continue;
+        uint8_t pos = count++;
+        while (pos > 0 && _segmentSeq[order[pos - 1]] > _segmentSeq[i]) {
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = i;
+    }
+    for (uint8_t k = 0; k < count; k++) {
+        sizes[k] = _segmentSize[order[k]];
+    }
+
+    xSemaphoreGive(_mutex);
+    return true;
+}
+
+void PanelRecorder::endRead() {
+    if (!_mutex || xSemaphoreTake(_mutex, portMAX_DELAY) != pdTRUE) return;
+    if (_readers > 0) {
+        _readers--;
+    }
+    xSemaphoreGive(_mutex);
+}
+
+void PanelRecorder::logStats() {
+    if (!_enabled && _framesRecorded == 0) return;
+
+    Log.printf("[PanelRecorder] %lu Frames aufgezeichnet, %lu übersprungen, %lu Bytes geschrieben, %lu us/Frame, "
+               "Budget %lu/%lu KB diese Stunde\n",
+               (unsigned long)_framesRecorded, (unsigned long)_framesSkipped, (unsigned long)_bytesFlushed,
+               _framesRecorded > 0 ? (unsigned long)(_encodeUs / _framesRecorded) : 0UL,
+               (unsigned long)(_bytesThisHour / 1024), (unsigned long)(_maxBytesPerHour / 1024));
+    _framesRecorded = 0;
+    _framesSkipped = 0;
+    _bytesFlushed = 0;
+    _encodeUs = 0;
+}
@@ -0,0 +1,142 @@
+#ifndef PANEL_RECORDER_HPP
+#define PANEL_RECORDER_HPP
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "PanelManager.hpp"
+#include "PanelStreamer.hpp"
+
+// Ring of fixed-size segment files on LittleFS, the oldest segment is overwritten first
+#define PANEL_RECORDER_DIR "/recorder"
+#define PANEL_RECORDER_SEGMENTS 8
+#define PANEL_RECORDER_SEGMENT_SIZE (64 * 1024)
+#define PANEL_RECORDER_HEADER_SIZE 16
+#define PANEL_RECORDER_RECORD_HEADER_SIZE 6
+
+// Flash writes are collected and written in blocks, at the latest after the flush interval
+#define PANEL_RECORDER_WRITE_BLOCK 4096
+#define PANEL_RECORDER_FLUSH_INTERVAL_MS 60000
+
+/**
+ * @brief Flight recorder: keeps a rolling, delta-compressed recording of the panel on LittleFS.
+ *
+ * Runs in the PanelStreamer task (tick()), independent of connected viewers. Frames are
+ * captured at a low rate, only changed tiles are stored, encoded with the QOI stream codec
+ * as complete stream messages (versioned header included), so the browser reuses its
+ * stream decoder for replay.
+ *
+ * Segment file layout (/recorder/segN.bin, N = 0..PANEL_RECORDER_SEGMENTS-1):
+ *   Header (16 bytes): "PCR2", sequence (uint32), width (uint16), height (uint16),
+ *                      tile size, codec id, 2 reserved bytes
+ *   Records: [unix time (uint32)][frame length (uint16)][stream message, see PanelStreamer.hpp]
+ * All integers big-endian. The first record of a segment is always a keyframe.
+ *
+ * Flash wear is bounded twice: records are buffered in PSRAM and appended in blocks,
+ * and no more than the configured number of bytes per hour is recorded.
+ */
+class PanelRecorder {
+public:
+    /**
+     * @brief Constructor, scans existing segments to continue the sequence
+     * @param panelManager Pointer to the PanelManager for accessing panel data
+     */
+    PanelRecorder(PanelManager* panelManager);
+
+    /**
+     * @brief Destructor, writes pending data
+     */
+    ~PanelRecorder();
+
+    /**
+     * @brief Apply the configuration (thread-safe)
+     * @param enabled Recording on/off
+     * @param intervalSec Capture interval in seconds
+     * @param maxKBPerHour Write budget in KB per hour
+     */
+    void setConfig(bool enabled, int intervalSec, int maxKBPerHour);
+
+    /**
+     * @brief Capture, encode and buffer a frame if due. Called from the streamer task.
+     */
+    void tick();
+
+    /**
+     * @brief Flush pending data and pause recording for a download (thread-safe)
+     * @param order Receives the segment indices from oldest to newest
+     * @param sizes Receives the size of each listed segment at the time of the call
+     * @param count Receives the number of segments listed
+     * @return false if the recorder is busy (nothing paused, do not call endRead())
+     */
+    bool beginRead(uint8_t* order, uint32_t* sizes, uint8_t& count);
+
+    /**
+     * @brief Resume recording after a successful beginRead()
+     */
+    void endRead();
+
+    /**
+     * @brief Build the file path of a segment
+     */
+    static void segmentPath(uint8_t index, char* out, size_t outSize);
+
+    /**
+     * @brief Log statistics (reset afterwards)
+     */
+    void logStats();
+
+    bool isEnabled() const { return _enabled; }
+
+private:
+    PanelManager* _panelManager;
+    SemaphoreHandle_t _mutex;
+    QoiStreamCodec<PanelStreamPixel> _codec;
+
+    // Configuration
+    bool _enabled;
+    uint32_t _intervalMs;
+    uint32_t _maxBytesPerHour;
+
+    // Capture and reference frame (in PSRAM)
+    PanelStreamPixelType* _captureBuffer;
+    PanelStreamPixelType* _referenceBuffer;
+    PanelStreamPixelType* _tileBuffer;
+    bool _needsKeyframe;
+    uint32_t _recordSequence;
+
+    // One encoded record (in PSRAM)
+    uint8_t* _recordBuffer;
+    size_t _recordBufferSize;
+
+    // Data of the current segment not yet written to flash (in PSRAM)
+    uint8_t* _pendingBuffer;
+    size_t _pendingLen;
+
+    // Segment ring state
+    uint32_t _segmentSeq[PANEL_RECORDER_SEGMENTS];
+    uint32_t _segmentSize[PANEL_RECORDER_SEGMENTS];
+    int8_t _currentSegment;
+    bool _segmentOpen;
+    uint32_t _nextSeq;
+
+    // Timing and write budget
+    unsigned long _lastCaptureMs;
+    unsigned long _lastFlushMs;
+    unsigned long _budgetWindowStartMs;
+    uint32_t _bytesThisHour;
+    bool _budgetExhausted;
+    uint8_t _readers;
+
+    // Statistics (reset with every logStats())
+    uint32_t _framesRecorded;
+    uint32_t _framesSkipped;
+    uint32_t _bytesFlushed;
+    uint32_t _encodeUs;
+
+    void scanSegments();
+    bool startSegment();
+    bool flushPending();
+    size_t encodeRecord(bool keyframe, const bool* changedTiles);
+};
+
+#endif // PANEL_RECORDER_HPP
@@ -0,0 +1,203 @@
+#include "PanelSnapshot.hpp"
+
+static const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static const size_t PNG_CHUNK_OVERHEAD = 12;     // length + type + CRC
+static const size_t PNG_IHDR_SIZE = 13;
+static const size_t ZLIB_HEADER_SIZE = 2;
+static const size_t STORED_BLOCK_HEADER_SIZE = 5;
+static const size_t ADLER_SIZE = 4;
+static const size_t BMP_HEADER_SIZE = 54;
+
+static inline void writeBE32(uint8_t* p, uint32_t v) {
+    p[0] = (v >> 24) & 0xFF;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+static inline void writeLE16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+}
+
+static inline void writeLE32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+// RGB565 -> RGB888 with the high bits replicated into the low bits (0x1F -> 0xFF)
+static inline void expandRgb565(uint16_t pixel, uint8_t& r, uint8_t& g, uint8_t& b) {
+    uint8_t r5 = (pixel >> 11) & 0x1F;
+    uint8_t g6 = (pixel >> 5) & 0x3F;
+    uint8_t b5 = pixel & 0x1F;
+    r = (r5 << 3) | (r5 >> 2);
+    g = (g6 << 2) | (g6 >> 4);
+    b = (b5 << 3) | (b5 >> 2);
+}
+
+PanelSnapshotEncoder::PanelSnapshotEncoder(Format format, uint16_t width, uint16_t height)
+    : _format(format), _width(width), _height(height), _row(0), _adler(1) {}
+
+size_t PanelSnapshotEncoder::rowBytes() const {
+    if (_format == FORMAT_PNG) {
+        // Filter type byte + RGB
+        return 1 + (size_t)_width * 3;
+    }
+    // BGR, padded to a multiple of 4
+    return ((size_t)_width * 3 + 3) & ~(size_t)3;
+}
+
+size_t PanelSnapshotEncoder::pngRowChunkSize(uint16_t row) const {
+    size_t data = STORED_BLOCK_HEADER_SIZE + rowBytes();
+    if (row == 0) data += ZLIB_HEADER_SIZE;
+    if (row == _height - 1) data += ADLER_SIZE;
+    return PNG_CHUNK_OVERHEAD + data;
+}
+
+size_t PanelSnapshotEncoder::contentLength() const {
+    if (_format == FORMAT_BMP) {
+        return BMP_HEADER_SIZE + rowBytes() * _height;
+    }
+    size_t total = sizeof(PNG_SIGNATURE) + PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE;
+    for (uint16_t row = 0; row < _height; row++) {
+        total += pngRowChunkSize(row);
+    }
+    return total + PNG_CHUNK_OVERHEAD;  // IEND
+}
+
+size_t PanelSnapshotEncoder::maxPartSize() const {
+    if (_format == FORMAT_BMP) {
+        return max(BMP_HEADER_SIZE, rowBytes());
+    }
+    size_t rowChunk = PNG_CHUNK_OVERHEAD + ZLIB_HEADER_SIZE + STORED_BLOCK_HEADER_SIZE + rowBytes() + ADLER_SIZE;
+    return max(sizeof(PNG_SIGNATURE) + PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE, rowChunk);
+}
+
+size_t PanelSnapshotEncoder::header(uint8_t* out) {
+    _row = 0;
+    _adler = 1;
+
+    if (_format == FORMAT_BMP) {
+        size_t imageSize = rowBytes() * _height;
+        memset(out, 0, BMP_HEADER_SIZE);
+        out[0] = 'B';
+        out[1] = 'M';
+        writeLE32(out + 2, BMP_HEADER_SIZE + imageSize);
+        writeLE32(out + 10, BMP_HEADER_SIZE);
+        writeLE32(out + 14, 40);                         // BITMAPINFOHEADER
+        writeLE32(out + 18, _width);
+        writeLE32(out + 22, (uint32_t)(-(int32_t)_height)); // negative = top-down rows
+        writeLE16(out + 26, 1);                          // planes
+        writeLE16(out + 28, 24);                         // bits per pixel
+        writeLE32(out + 34, imageSize);
+        writeLE32(out + 38, 2835);                       // 72 dpi
+        writeLE32(out + 42, 2835);
+        return BMP_HEADER_SIZE;
+    }
+
+    memcpy(out, PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+    uint8_t* chunk = out + sizeof(PNG_SIGNATURE);
+    uint8_t* ihdr = chunk + 8;
+    writeBE32(ihdr, _width);
+    writeBE32(ihdr + 4, _height);
+    ihdr[8] = 8;    // bit depth
+    ihdr[9] = 2;    // color type: truecolor RGB
+    ihdr[10] = 0;   // compression: deflate
+    ihdr[11] = 0;   // filter method
+    ihdr[12] = 0;   // no interlace
+    return sizeof(PNG_SIGNATURE) + finishPngChunk(chunk, "IHDR", PNG_IHDR_SIZE);
+}
+
+size_t PanelSnapshotEncoder::encodeRow(const uint16_t* rgb565, uint8_t* out) {
+    if (_row >= _height) {
+        return 0;
+    }
+
+    if (_format == FORMAT_BMP) {
+        size_t pos = 0;
+        for (uint16_t x = 0; x < _width; x++) {
+            uint8_t r, g, b;
+            expandRgb565(rgb565[x], r, g, b);
+            out[pos++] = b;
+            out[pos++] = g;
+            out[pos++] = r;
+        }
+        while (pos < rowBytes()) {
+            out[pos++] = 0;
+        }
+        _row++;
+        return pos;
+    }
+
+    // One IDAT chunk per row holding one stored deflate block
+    uint8_t* data = out + 8;
+    size_t pos = 0;
+    if (_row == 0) {
+        data[pos++] = 0x78;   // zlib: deflate, 32K window
+        data[pos++] = 0x01;   // no preset dictionary, fastest; (0x7801 % 31 == 0)
+    }
+
+    bool last = (_row == _height - 1);
+    uint16_t len = (uint16_t)rowBytes();
+    data[pos++] = last ? 0x01 : 0x00;   // BFINAL, BTYPE=00 (stored)
+    writeLE16(data + pos, len);
+    writeLE16(data + pos + 2, (uint16_t)~len);
+    pos += 4;
+
+    uint8_t* raw = data + pos;
+    raw[0] = 0;   // filter: none
+    for (uint16_t x = 0; x < _width; x++) {
+        expandRgb565(rgb565[x], raw[1 + x * 3], raw[2 + x * 3], raw[3 + x * 3]);
+    }
+
+    // Adler-32 over the uncompressed data, reduced once per row
+    uint32_t a = _adler & 0xFFFF;
+    uint32_t b = _adler >> 16;
+    for (size_t i = 0; i < len; i++) {
+        a += raw[i];
+        b += a;
+    }
+    _adler = ((b % 65521) << 16) | (a % 65521);
+    pos += len;
+
+    if (last) {
+        writeBE32(data + pos, _adler);
+        pos += ADLER_SIZE;
+    }
+
+    _row++;
+    return finishPngChunk(out, "IDAT", pos);
+}
+
+size_t PanelSnapshotEncoder::trailer(uint8_t* out) {
+    if (_format == FORMAT_BMP) {
+        return 0;
+    }
+    return finishPngChunk(out, "IEND", 0);
+}
+
+size_t PanelSnapshotEncoder::finishPngChunk(uint8_t* out, const char* type, size_t dataLength) {
+    // Data is already at out + 8
+    writeBE32(out, dataLength);
+    memcpy(out + 4, type, 4);
+    uint32_t crc = crc32Update(0, out + 4, dataLength + 4);
+    writeBE32(out + 8 + dataLength, crc);
+    return PNG_CHUNK_OVERHEAD + dataLength;
+}
+
+uint32_t PanelSnapshotEncoder::crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+    // Nibble table: 64 bytes instead of 1 KB, fast enough for a few KB per snapshot
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
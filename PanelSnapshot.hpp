@@ -0,0 +1,72 @@
+#ifndef PANEL_SNAPSHOT_HPP
+#define PANEL_SNAPSHOT_HPP
+
+#include <Arduino.h>
+
+/**
+ * @brief Row-by-row image encoder for panel snapshots (PNG or BMP, 24 bit RGB).
+ *
+ * The output is produced in three parts - header(), one encodeRow() per row from
+ * top to bottom, trailer() - so the caller only ever holds a few rows in memory.
+ * The total size is known up front (contentLength()), which allows an exact
+ * Content-Length without buffering the image.
+ *
+ * PNG uses uncompressed ("stored") deflate blocks, one per row, each wrapped in its
+ * own IDAT chunk. CRC32 and Adler-32 are computed on the fly.
+ * BMP is written top-down (negative height), rows padded to 4 bytes.
+ */
+class PanelSnapshotEncoder {
+public:
+    enum Format : uint8_t {
+        FORMAT_PNG,
+        FORMAT_BMP
+    };
+
+    PanelSnapshotEncoder(Format format, uint16_t width, uint16_t height);
+
+    /**
+     * @brief Exact size of the encoded image in bytes
+     */
+    size_t contentLength() const;
+
+    /**
+     * @brief Upper bound of the bytes produced by header(), encodeRow() or trailer()
+     */
+    size_t maxPartSize() const;
+
+    /**
+     * @brief Write the image header
+     * @return Number of bytes written
+     */
+    size_t header(uint8_t* out);
+
+    /**
+     * @brief Encode the next row (rows must be passed top to bottom)
+     * @param rgb565 Pixels of the row
+     * @param out Destination, at least maxPartSize() bytes
+     * @return Number of bytes written
+     */
+    size_t encodeRow(const uint16_t* rgb565, uint8_t* out);
+
+    /**
+     * @brief Write everything after the last row
+     * @return Number of bytes written
+     */
+    size_t trailer(uint8_t* out);
+
+    const char* mimeType() const { return _format == FORMAT_PNG ? "image/png" : "image/bmp"; }
+
+private:
+    Format _format;
+    uint16_t _width;
+    uint16_t _height;
+    uint16_t _row;
+    uint32_t _adler;
+
+    size_t rowBytes() const;
+    size_t pngRowChunkSize(uint16_t row) const;
+    size_t finishPngChunk(uint8_t* out, const char* type, size_t dataLength);
+    static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length);
+};
+
+#endif // PANEL_SNAPSHOT_HPP
@@ -0,0 +1,203 @@
+#include "PanelStreamCodec.hpp"
+
+// Signed difference a - b, wrapped into the range of a component with the given bit width
+template<uint8_t Bits>
+static inline int wrapDiff(int a, int b) {
+    const int range = 1 << Bits;
+    const int half = range / 2;
+    return ((a - b + half) & (range - 1)) - half;
+}
+
+// --- RleStreamCodec ---
+
+template<typename Pixel>
+size_t RleStreamCodec<Pixel>::encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) {
+    const size_t reserve = 2 + Pixel::bytesPerPixel + 1;
+    if (!input || !output || pixelCount == 0 || outputMaxSize <= reserve) {
+        return 0;
+    }
+
+    size_t outPos = 0;
+    size_t inPos = 0;
+
+    while (inPos < pixelCount && outPos < outputMaxSize - reserve) {
+        PixelType pixel = input[inPos];
+
+        // Skip black pixels (0x0000) - they stay dark in the visualization
+        // We need to track position, so we'll encode skips too
+        if (pixel == 0x0000) {
+            // Count consecutive black pixels
+            uint16_t skipCount = 0;
+            while (inPos < pixelCount && input[inPos] == 0x0000 && skipCount < 65535) {
+                skipCount++;
+                inPos++;
+            }
+
+            // Encode skip: [0x00][skip_count_high][skip_count_low]
+            output[outPos++] = 0x00;  // Marker for skip
+            output[outPos++] = (skipCount >> 8) & 0xFF;
+            output[outPos++] = skipCount & 0xFF;
+            continue;
+        }
+
+        // Count consecutive same-colored pixels (max 255)
+        uint8_t count = 1;
+        while (inPos + count < pixelCount &&
+               input[inPos + count] == pixel &&
+               count < 255) {
+            count++;
+        }
+
+        // Encode: [count][pixel, big-endian]
+        output[outPos++] = count;
+        writePixel<Pixel>(output + outPos, pixel);
+        outPos += Pixel::bytesPerPixel;
+
+        inPos += count;
+    }
+
+    return outPos;
+}
+
+// --- QoiStreamCodec ---
+
+template<typename Pixel>
+size_t QoiStreamCodec<Pixel>::encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) {
+    if (!input || !output || pixelCount == 0) {
+        return 0;
+    }
+
+    PixelType index[64];
+    memset(index, 0, sizeof(index));
+    PixelType prev = 0;
+    uint8_t run = 0;
+    size_t outPos = 0;
+
+    for (size_t i = 0; i < pixelCount; i++) {
+        // Largest op is the raw pixel, a pending run needs at most 1 more
+        if (outPos + 2 + Pixel::bytesPerPixel > outputMaxSize) {
+            return 0;
+        }
+
+        PixelType pixel = input[i];
+        if (pixel == prev) {
+            run++;
+            if (run == 62 || i == pixelCount - 1) {
+                output[outPos++] = 0xC0 | (run - 1);
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            output[outPos++] = 0xC0 | (run - 1);
+            run = 0;
+        }
+
+        uint8_t hash = hashPixel(pixel);
+        if (index[hash] == pixel) {
+            output[outPos++] = hash;
+        } else {
+            index[hash] = pixel;
+
+            // Modular component differences
+            int dr = wrapDiff<Pixel::redBits>(Pixel::red(pixel), Pixel::red(prev));
+            int dg = wrapDiff<Pixel::greenBits>(Pixel::green(pixel), Pixel::green(prev));
+            int db = wrapDiff<Pixel::blueBits>(Pixel::blue(pixel), Pixel::blue(prev));
+            int drDg = dr - dg;
+            int dbDg = db - dg;
+
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                output[outPos++] = 0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+            } else if (dg >= -32 && dg <= 31 && drDg >= -8 && drDg <= 7 && dbDg >= -8 && dbDg <= 7) {
+                output[outPos++] = 0x80 | (dg + 32);
+                output[outPos++] = ((drDg + 8) << 4) | (dbDg + 8);
+            } else {
+                output[outPos++] = 0xFE;
+                writePixel<Pixel>(output + outPos, pixel);
+                outPos += Pixel::bytesPerPixel;
+            }
+        }
+        prev = pixel;
+    }
+
+    return outPos;
+}
+
+// --- LzStreamCodec ---
+
+template<typename Pixel>
+size_t LzStreamCodec<Pixel>::encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) {
+    if (!input || !output || pixelCount == 0) {
+        return 0;
+    }
+
+    // Last position of a color (by QOI hash), 0xFFFF = none
+    uint16_t lastPos[64];
+    memset(lastPos, 0xFF, sizeof(lastPos));
+
+    size_t outPos = 0;
+    size_t literalStart = 0;
+    size_t i = 0;
+
+    auto flushLiterals = [&](size_t upTo) -> bool {
+        while (literalStart < upTo) {
+            size_t n = upTo - literalStart;
+            if (n > 128) n = 128;
+            if (outPos + 1 + n * Pixel::bytesPerPixel > outputMaxSize) return false;
+            output[outPos++] = (uint8_t)(n - 1);
+            for (size_t k = 0; k < n; k++) {
+                writePixel<Pixel>(output + outPos, input[literalStart + k]);
+                outPos += Pixel::bytesPerPixel;
+            }
+            literalStart += n;
+        }
+        return true;
+    };
+
+    while (i < pixelCount) {
+        uint8_t hash = QoiStreamCodec<Pixel>::hashPixel(input[i]);
+        size_t candidates[3] = { 1, _rowStride, (lastPos[hash] != 0xFFFF) ? i - lastPos[hash] : 0 };
+
+        size_t bestLen = 0;
+        size_t bestOffset = 0;
+        for (size_t offset : candidates) {
+            if (offset == 0 || offset > i || offset > 256) continue;
+            size_t len = 0;
+            while (i + len < pixelCount && len < 129 && input[i + len] == input[i + len - offset]) {
+                len++;
+            }
+            if (len > bestLen) {
+                bestLen = len;
+                bestOffset = offset;
+            }
+        }
+
+        // A match of two pixels costs 2 bytes, the same pixels as literals at least 4
+        if (bestLen >= 2) {
+            if (!flushLiterals(i)) return 0;
+            if (outPos + 2 > outputMaxSize) return 0;
+            output[outPos++] = 0x80 | (uint8_t)(bestLen - 2);
+            output[outPos++] = (uint8_t)(bestOffset - 1);
+            for (size_t k = i; k < i + bestLen; k++) {
+                lastPos[QoiStreamCodec<Pixel>::hashPixel(input[k])] = (uint16_t)k;
+            }
+            i += bestLen;
+            literalStart = i;
+        } else {
+            lastPos[hash] = (uint16_t)i;
+            i++;
+        }
+    }
+
+    if (!flushLiterals(pixelCount)) return 0;
+    return outPos;
+}
+
+// Both canvas formats share the implementation above
+template class RleStreamCodec<PixelRGB565>;
+template class RleStreamCodec<PixelRGB888>;
+template class QoiStreamCodec<PixelRGB565>;
+template class QoiStreamCodec<PixelRGB888>;
+template class LzStreamCodec<PixelRGB565>;
+template class LzStreamCodec<PixelRGB888>;
@@ -0,0 +1,180 @@
+#ifndef PANEL_STREAM_CODEC_HPP
+#define PANEL_STREAM_CODEC_HPP
+
+#include <Arduino.h>
+
+/**
+ * @brief Codec IDs used on the wire (codec field of every panel frame header).
+ *
+ * The browser announces the codecs it can decode in order of preference,
+ * the streamer picks the first one it supports for that client.
+ */
+enum PanelStreamCodecId : uint8_t {
+    CODEC_RLE = 0,   ///< Run-length encoding with black-skip marker (original format)
+    CODEC_QOI = 1,   ///< QOI-style encoding
+    CODEC_LZ  = 2,   ///< LZ77-style pixel matches (row above, last occurrence)
+    CODEC_COUNT
+};
+
+/**
+ * @brief Pixel format IDs used on the wire (pixel format field of the frame header).
+ */
+enum PanelPixelFormatId : uint8_t {
+    PIXEL_FORMAT_RGB565 = 0,
+    PIXEL_FORMAT_RGB888 = 1
+};
+
+/**
+ * @brief Pixel traits for 16 bit RGB565 canvases (GFXcanvas16).
+ *
+ * Pixels are written big-endian with bytesPerPixel bytes; components are
+ * the raw 5/6/5 bit values.
+ */
+struct PixelRGB565 {
+    typedef uint16_t Storage;
+    static constexpr PanelPixelFormatId formatId = PIXEL_FORMAT_RGB565;
+    static constexpr uint8_t bytesPerPixel = 2;
+    static constexpr uint8_t redBits = 5;
+    static constexpr uint8_t greenBits = 6;
+    static constexpr uint8_t blueBits = 5;
+
+    static inline uint8_t red(Storage p) { return (p >> 11) & 0x1F; }
+    static inline uint8_t green(Storage p) { return (p >> 5) & 0x3F; }
+    static inline uint8_t blue(Storage p) { return p & 0x1F; }
+    static inline Storage pack(uint8_t r, uint8_t g, uint8_t b) {
+        return (Storage)(((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F));
+    }
+};
+
+/**
+ * @brief Pixel traits for 24 bit RGB888 canvases, stored as 0x00RRGGBB.
+ */
+struct PixelRGB888 {
+    typedef uint32_t Storage;
+    static constexpr PanelPixelFormatId formatId = PIXEL_FORMAT_RGB888;
+    static constexpr uint8_t bytesPerPixel = 3;
+    static constexpr uint8_t redBits = 8;
+    static constexpr uint8_t greenBits = 8;
+    static constexpr uint8_t blueBits = 8;
+
+    static inline uint8_t red(Storage p) { return (p >> 16) & 0xFF; }
+    static inline uint8_t green(Storage p) { return (p >> 8) & 0xFF; }
+    static inline uint8_t blue(Storage p) { return p & 0xFF; }
+    static inline Storage pack(uint8_t r, uint8_t g, uint8_t b) {
+        return ((Storage)r << 16) | ((Storage)g << 8) | b;
+    }
+};
+
+/**
+ * @brief Write a pixel big-endian with the format's byte count
+ */
+template<typename Pixel>
+inline void writePixel(uint8_t* out, typename Pixel::Storage pixel) {
+    for (int i = Pixel::bytesPerPixel - 1; i >= 0; i--) {
+        *out++ = (pixel >> (i * 8)) & 0xFF;
+    }
+}
+
+/**
+ * @brief Interface for panel stream codecs.
+ *
+ * A codec encodes one tile (a contiguous block of pixels) independently of all
+ * other tiles, so every tile of a frame can be decoded on its own. Codecs are
+ * templated on the pixel traits, RGB565 and RGB888 share the same implementation.
+ */
+template<typename Pixel>
+class PanelStreamCodec {
+public:
+    typedef typename Pixel::Storage PixelType;
+
+    virtual ~PanelStreamCodec() = default;
+
+    /**
+     * @brief Wire ID of the codec
+     */
+    virtual PanelStreamCodecId id() const = 0;
+
+    /**
+     * @brief Short name for logs and the stream page
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Upper bound of the encoded size for the given number of pixels
+     */
+    virtual size_t maxEncodedSize(size_t pixelCount) const = 0;
+
+    /**
+     * @brief Encode pixels
+     * @param input Pixels in the codec's pixel format
+     * @param pixelCount Number of pixels
+     * @param output Destination buffer
+     * @param outputMaxSize Capacity of the destination buffer
+     * @return Number of bytes written (0 on error)
+     */
+    virtual size_t encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) = 0;
+};
+
+/**
+ * @brief Original format: [count][pixel] for colored runs, [0x00][skipHigh][skipLow] for black runs.
+ */
+template<typename Pixel>
+class RleStreamCodec : public PanelStreamCodec<Pixel> {
+public:
+    typedef typename Pixel::Storage PixelType;
+    PanelStreamCodecId id() const override { return CODEC_RLE; }
+    const char* name() const override { return "RLE"; }
+    size_t maxEncodedSize(size_t pixelCount) const override { return pixelCount * (1 + Pixel::bytesPerPixel) + 5; }
+    size_t encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) override;
+};
+
+/**
+ * @brief QOI-style codec.
+ *
+ * Byte-aligned ops, decoder state (previous pixel, 64-entry color index) is reset per tile:
+ * - 0b00iiiiii           INDEX: pixel from color index slot i
+ * - 0b01rrggbb           DIFF:  r/g/b differ by -2..1 from the previous pixel
+ * - 0b10gggggg rrrrbbbb  LUMA:  g differs by -32..31, r-g and b-g by -8..7
+ * - 0b11llllll           RUN:   repeat previous pixel l+1 times (l = 0..61)
+ * - 0xFE pixel           RGB:   raw pixel
+ * Component differences wrap around modulo the component range (32/64/32 or 256).
+ */
+template<typename Pixel>
+class QoiStreamCodec : public PanelStreamCodec<Pixel> {
+public:
+    typedef typename Pixel::Storage PixelType;
+    PanelStreamCodecId id() const override { return CODEC_QOI; }
+    const char* name() const override { return "QOI"; }
+    size_t maxEncodedSize(size_t pixelCount) const override { return pixelCount * (1 + Pixel::bytesPerPixel) + 1; }
+    size_t encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) override;
+
+    static inline uint8_t hashPixel(PixelType pixel) {
+        return (uint8_t)((Pixel::red(pixel) * 3 + Pixel::green(pixel) * 5 + Pixel::blue(pixel) * 7) & 63);
+    }
+};
+
+/**
+ * @brief LZ77-style codec working on whole pixels.
+ *
+ * - 0b0nnnnnnn followed by n+1 raw pixels: literal run
+ * - 0b1lllllll oooooooo: copy l+2 pixels starting o+1 pixels back (may overlap)
+ * Match candidates are the previous pixel, the pixel one row above and the
+ * last occurrence of the current color, which covers text, icons and flat areas.
+ */
+template<typename Pixel>
+class LzStreamCodec : public PanelStreamCodec<Pixel> {
+public:
+    typedef typename Pixel::Storage PixelType;
+    explicit LzStreamCodec(uint16_t rowStride) : _rowStride(rowStride) {}
+    PanelStreamCodecId id() const override { return CODEC_LZ; }
+    const char* name() const override { return "LZ"; }
+    size_t maxEncodedSize(size_t pixelCount) const override {
+        return pixelCount * Pixel::bytesPerPixel + pixelCount / 128 + 1;
+    }
+    size_t encode(const PixelType* input, size_t pixelCount, uint8_t* output, size_t outputMaxSize) override;
+
+private:
+    uint16_t _rowStride;
+};
+
+#endif // PANEL_STREAM_CODEC_HPP
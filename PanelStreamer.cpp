@@ -1,18 +1,36 @@
 #include "PanelStreamer.hpp"
+#include "PanelRecorder.hpp"
 #include "MultiLogger.hpp"
 #include <ArduinoJson.h>
 
 // Static instance for callback
 PanelStreamer* PanelStreamer::_instance = nullptr;
 
-// Constants for streaming
-#define PANEL_STREAM_FPS 4
-#define PANEL_STREAM_INTERVAL_MS (1000 / PANEL_STREAM_FPS)
-#define MAX_CLIENTS 2
+// Adaptive per-client frame rate
+#define PANEL_STREAM_MIN_INTERVAL_MS 50      // 20 fps upper limit per client
+#define PANEL_STREAM_MAX_INTERVAL_MS 1000    // 1 fps lower limit per client
+#define PANEL_STREAM_SLOW_SEND_US 30000      // sendBIN blocking longer than this counts as backpressure
+#define PANEL_STREAM_FAST_SEND_US 5000       // sendBIN returning faster than this counts as headroom
+#define PANEL_STREAM_FAST_STREAK 10          // fast sends in a row before the rate is raised again
 
-PanelStreamer::PanelStreamer(PanelManager* panelManager) 
+#define PANEL_STREAM_KEYFRAME_INTERVAL_MS 5000
+
+// WebSocketsServer has no event notification, its loop() is polled at this period while clients are connected
+#define PANEL_STREAM_SOCKET_POLL_MS 100
+
+// Log batching: one binary frame carries many lines, at most a few frames per tick
+#define PANEL_STREAM_LOG_BATCH_SIZE 4096
+#define PANEL_STREAM_LOG_MAX_BATCHES 4
+
+static_assert(FULL_WIDTH % PANEL_STREAM_TILE_SIZE == 0 && FULL_HEIGHT % PANEL_STREAM_TILE_SIZE == 0,
+              "Panel dimensions must be a multiple of the stream tile size");
+static_assert(PANEL_STREAM_TILE_COUNT <= 256, "Tile index must fit into one byte");
+
+PanelStreamer::PanelStreamer(PanelManager* panelManager, uint8_t maxClients) 
     : _panelManager(panelManager), _wsServer(nullptr), _taskHandle(nullptr), 
-      _running(false), _panelBuffer(nullptr), _compressedBuffer(nullptr) {
+      _running(false), _captureBuffer(nullptr), _frameBuffer(nullptr), _tileBuffer(nullptr),
+      _captureNumber(0), _captureMs(0), _compressedBuffer(nullptr), _logBuffer(nullptr), _logSequence(0),
+      _recorder(nullptr) {
     
     Log.println("[PanelStreamer] Constructor starting...");
     
@@ -23,26 +41,59 @@ PanelStreamer::PanelStreamer(PanelManager* panelManager)
         Log.println("[PanelStreamer] FATAL: Failed to create control mutex!");
     }
     
+    // Create codecs (indexed by wire ID)
+    _codecs[CODEC_RLE] = new RleStreamCodec<PanelStreamPixel>();
+    _codecs[CODEC_QOI] = new QoiStreamCodec<PanelStreamPixel>();
+    _codecs[CODEC_LZ] = new LzStreamCodec<PanelStreamPixel>(PANEL_STREAM_TILE_SIZE);
+    
+    _maxClients = maxClients < 1 ? 1 : min<uint8_t>(maxClients, WEBSOCKETS_SERVER_CLIENT_MAX);
+    Log.printf("[PanelStreamer] Max. %u gleichzeitige Clients\n", _maxClients);
+    
     // Calculate buffer sizes
     _panelBufferSize = FULL_WIDTH * FULL_HEIGHT;
-    _compressedBufferSize = _panelBufferSize * 3; // Worst case: control byte + 2 bytes per pixel
+    // Worst case of the least efficient codec per tile, plus 3 bytes per tile record and the message header
+    _tileSlotSize = 0;
+    for (uint8_t i = 0; i < CODEC_COUNT; i++) {
+        _tileSlotSize = max(_tileSlotSize, _codecs[i]->maxEncodedSize(PANEL_STREAM_TILE_PIXELS));
+    }
+    _compressedBufferSize = (_tileSlotSize + 3) * PANEL_STREAM_TILE_COUNT + PANEL_STREAM_HEADER_SIZE;
     
-    Log.printf("[PanelStreamer] Allocating buffers: Panel=%d bytes, Compressed=%d bytes\n", 
-                   _panelBufferSize * sizeof(uint16_t), _compressedBufferSize);
+    Log.printf("[PanelStreamer] Allocating buffers: Panel=%d bytes, Compressed=%d bytes, Tile cache=%d bytes\n", 
+                   _panelBufferSize * sizeof(PanelStreamPixelType), _compressedBufferSize,
+                   _tileSlotSize * PANEL_STREAM_TILE_COUNT * CODEC_COUNT);
     
     // Allocate buffers in PSRAM
-    _panelBuffer = (uint16_t*)ps_malloc(_panelBufferSize * sizeof(uint16_t));
+    _captureBuffer = (PanelStreamPixelType*)ps_malloc(_panelBufferSize * sizeof(PanelStreamPixelType));
+    _frameBuffer = (PanelStreamPixelType*)ps_malloc(_panelBufferSize * sizeof(PanelStreamPixelType));
+    _tileBuffer = (PanelStreamPixelType*)ps_malloc(PANEL_STREAM_TILE_PIXELS * sizeof(PanelStreamPixelType));
     _compressedBuffer = (uint8_t*)ps_malloc(_compressedBufferSize);
+    _logBuffer = (uint8_t*)ps_malloc(PANEL_STREAM_LOG_BATCH_SIZE);
+    bool tileCacheOk = true;
+    for (uint8_t i = 0; i < CODEC_COUNT; i++) {
+        _tileCache[i] = (uint8_t*)ps_malloc(_tileSlotSize * PANEL_STREAM_TILE_COUNT);
+        if (!_tileCache[i]) tileCacheOk = false;
+    }
     
-    if (!_panelBuffer || !_compressedBuffer) {
+    // Nothing captured yet: all tiles at version 0, no cache slot valid
+    memset(_tileVersion, 0, sizeof(_tileVersion));
+    memset(_tileCacheLen, 0, sizeof(_tileCacheLen));
+    memset(_tileCacheVersion, 0xFF, sizeof(_tileCacheVersion));
+    if (_frameBuffer) {
+        memset(_frameBuffer, 0, _panelBufferSize * sizeof(PanelStreamPixelType));
+    }
+    
+    if (!_captureBuffer || !_frameBuffer || !_tileBuffer || !_compressedBuffer || !_logBuffer || !tileCacheOk) {
         Log.println("[PanelStreamer] FATAL: Failed to allocate buffers in PSRAM!");
         Log.println("[PanelStreamer] FATAL: Failed to allocate buffers in PSRAM!");
     } else {
         Log.printf("[PanelStreamer] Buffers allocated successfully\n");
         Log.printf("[PanelStreamer] Buffers allocated: Panel=%d bytes, Compressed=%d bytes\n", 
-                   _panelBufferSize * sizeof(uint16_t), _compressedBufferSize);
+                   _panelBufferSize * sizeof(PanelStreamPixelType), _compressedBufferSize);
     }
     
+    // Flight recorder, stays idle until enabled via setConfig()
+    _recorder = new PanelRecorder(panelManager);
+    
     // Create WebSocket server on port 81
     Log.println("[PanelStreamer] Creating WebSocket server on port 81...");
     _wsServer = new WebSocketsServer(81);
@@ -69,14 +120,37 @@ PanelStreamer::~PanelStreamer() {
         delete _wsServer;
     }
     
-    if (_panelBuffer) {
-        free(_panelBuffer);
+    if (_recorder) {
+        delete _recorder;
+    }
+    
+    if (_captureBuffer) {
+        free(_captureBuffer);
+    }
+    
+    if (_frameBuffer) {
+        free(_frameBuffer);
+    }
+    
+    if (_tileBuffer) {
+        free(_tileBuffer);
     }
     
     if (_compressedBuffer) {
         free(_compressedBuffer);
     }
     
+    if (_logBuffer) {
+        free(_logBuffer);
+    }
+    
+    for (uint8_t i = 0; i < CODEC_COUNT; i++) {
+        if (_tileCache[i]) {
+            free(_tileCache[i]);
+        }
+        delete _codecs[i];
+    }
+    
     if (_controlMutex) {
         vSemaphoreDelete(_controlMutex);
     }
@@ -144,7 +218,7 @@ uint8_t PanelStreamer::getClientCount() {
     if (!_wsServer) return 0;
     
     uint8_t count = 0;
-    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
         if (_wsServer->clientIsConnected(i)) {
             count++;
         }
@@ -161,7 +235,6 @@ void PanelStreamer::streamerTask() {
     Log.printf("[PanelStreamer::streamerTask] Task running on core %d\n", xPortGetCoreID());
     Log.printf("[PanelStreamer] Task running on core %d\n", xPortGetCoreID());
     
-    unsigned long lastPanelStreamMs = 0;
     unsigned long lastDebugMs = 0;
     unsigned long loopCount = 0;
     
@@ -187,38 +260,44 @@ void PanelStreamer::streamerTask() {
             
             // Also log individual client status for debugging
             if (clientCount > 0) {
-                for (uint8_t i = 0; i < 8; i++) {  // Check first 8 slots
+                for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
                     if (_wsServer->clientIsConnected(i)) {
-                        Log.printf("[PanelStreamer::streamerTask] - Client #%d connected\n", i);
+                        const StreamClient& client = _clients[i];
+                        Log.printf("[PanelStreamer::streamerTask] - Client #%d connected (Codec: %s, %u ms/Frame, "
+                                   "gesendet=%lu, zusammengefasst=%lu, Fehler=%lu, letzter Send %lu us)\n",
+                                   i, _codecs[client.codec]->name(), client.intervalMs,
+                                   (unsigned long)client.framesSent, (unsigned long)client.framesCoalesced,
+                                   (unsigned long)client.sendFailures, (unsigned long)client.lastSendUs);
                     }
                 }
+                logCodecStats();
+            }
+            if (_recorder) {
+                _recorder->logStats();
             }
             
             lastDebugMs = now;
         }
         
+        // Flight recorder runs at its own low rate, independent of viewers
+        if (_recorder) {
+            _recorder->tick();
+        }
+        
         if (clientCount == 0) {
             // No clients, sleep longer
             vTaskDelay(pdMS_TO_TICKS(500));
             continue;
         }
         
-        // Only log when actually streaming (every 10 seconds when clients are connected)
-        if (now - lastDebugMs >= 10000) {
-            Log.printf("[PanelStreamer::streamerTask] Clients connected: %d\n", clientCount);
-        }
-        
         // Stream log messages
         sendLogMessages();
         
-        // Stream panel snapshot at defined FPS
-        if (now - lastPanelStreamMs >= PANEL_STREAM_INTERVAL_MS) {
-            sendPanelSnapshot();
-            lastPanelStreamMs = now;
-        }
+        // Send a frame to every client whose own interval has elapsed
+        sendPanelFrames();
         
-        // Small delay to prevent task hogging
-        vTaskDelay(pdMS_TO_TICKS(50));
+        // Sleep until a new frame is rendered or the next client is due (bounded, so socket events are still serviced)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(msUntilNextFrame(millis())));
     }
     
     Log.println("[PanelStreamer::streamerTask] Task exiting");
@@ -226,116 +305,307 @@ void PanelStreamer::streamerTask() {
     vTaskDelete(nullptr);
 }
 
-void PanelStreamer::sendPanelSnapshot() {
-    if (!_panelManager || !_panelBuffer || !_compressedBuffer || !_wsServer) {
+void PanelStreamer::sendPanelFrames() {
+    if (!_panelManager || !_captureBuffer || !_frameBuffer || !_tileBuffer || !_compressedBuffer || !_wsServer) {
         return;
     }
     
-    // Copy panel buffer (thread-safe)
-    if (!_panelManager->copyFullPanelBuffer(_panelBuffer, _panelBufferSize)) {
+    unsigned long now = millis();
+    bool framePending = _framePending.load();
+    bool anyDue = false;
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        if (_clients[i].active && now - _clients[i].lastSendMs >= _clients[i].intervalMs &&
+            (framePending || clientHasWork(_clients[i], now))) {
+            anyDue = true;
+            break;
+        }
+    }
+    if (!anyDue) {
         return;
     }
     
-    // Compress with RLE
-    size_t compressedSize = compressRLE(_panelBuffer, _panelBufferSize, 
-                                        _compressedBuffer, _compressedBufferSize);
+    // One capture serves all clients that are due, the others merge the changes into their dirty set.
+    // Without a new render the last capture is still current.
+    if (framePending || _captureNumber == 0) {
+        _framePending = false;
+        if (!captureFrame()) {
+            _framePending = true;
+            return;
+        }
+    }
     
-    if (compressedSize > 0) {
-        // Send as binary WebSocket message to all connected clients
-        _wsServer->broadcastBIN(_compressedBuffer, compressedSize);
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        StreamClient& client = _clients[i];
+        if (!client.active || now - client.lastSendMs < client.intervalMs) continue;
+        
+        if (!_wsServer->clientIsConnected(i)) {
+            resetClient(i);
+            continue;
+        }
+        
+        bool keyframe = client.needsKeyframe || (now - client.lastKeyframeMs >= PANEL_STREAM_KEYFRAME_INTERVAL_MS);
+        
+        // Nothing changed for this viewer - save the airtime
+        if (!keyframe && client.dirtyCount == 0) {
+            client.lastSendMs = now;
+            continue;
+        }
+        
+        size_t frameSize = buildFrame(client, keyframe);
+        unsigned long startUs = micros();
+        bool sent = _wsServer->sendBIN(i, _compressedBuffer, frameSize);
+        uint32_t sendUs = micros() - startUs;
+        
+        // A failed send may have disconnected (and reset) the client
+        if (!client.active) continue;
+        
+        client.lastSendMs = now;
+        if (sent) {
+            memset(client.dirty, 0, sizeof(client.dirty));
+            client.dirtyCount = 0;
+            client.framesSent++;
+            if (keyframe) {
+                client.needsKeyframe = false;
+                client.lastKeyframeMs = now;
+            }
+        } else {
+            // Unknown how much arrived, resynchronize with a full picture
+            client.sendFailures++;
+            client.needsKeyframe = true;
+        }
+        adaptClientRate(client, sent, sendUs);
     }
 }
 
-void PanelStreamer::sendLogMessages() {
-    if (!_wsServer) {
-        // Use Serial directly to avoid recursive logging
-        Serial.println("[PanelStreamer::sendLogMessages] No WebSocket server!");
-        return;
+bool PanelStreamer::captureFrame() {
+    // Copy panel buffer (thread-safe)
+    if (!_panelManager->copyFullPanelBuffer(_captureBuffer, _panelBufferSize)) {
+        return false;
+    }
+    
+    // The new capture becomes the current frame, the old one stays as reference until the next capture
+    PanelStreamPixelType* previous = _frameBuffer;
+    _frameBuffer = _captureBuffer;
+    _captureBuffer = previous;
+    _captureNumber++;
+    _captureMs = millis();
+    
+    bool pending[WEBSOCKETS_SERVER_CLIENT_MAX];
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        pending[i] = _clients[i].dirtyCount > 0;
     }
     
-    // Get new log lines
-    PsramVector<PsramString> newLines;
-    size_t count = Log.getNewLines(newLines);
+    bool anyChanged = false;
+    for (uint8_t tileIndex = 0; tileIndex < PANEL_STREAM_TILE_COUNT; tileIndex++) {
+        if (!tileDiffers(_frameBuffer, _captureBuffer, tileIndex % PANEL_STREAM_TILES_X, tileIndex / PANEL_STREAM_TILES_X)) continue;
+        
+        anyChanged = true;
+        _tileVersion[tileIndex] = _captureNumber;
+        for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+            StreamClient& client = _clients[i];
+            if (client.active && !client.dirty[tileIndex]) {
+                client.dirty[tileIndex] = true;
+                client.dirtyCount++;
+            }
+        }
+    }
     
-    if (count == 0) return;
+    // Clients that still had unsent changes now receive both in one frame
+    if (anyChanged) {
+        for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+            if (_clients[i].active && pending[i]) {
+                _clients[i].framesCoalesced++;
+            }
+        }
+    }
+    return true;
+}
+
+const uint8_t* PanelStreamer::encodedTile(uint8_t codecId, uint8_t tileIndex, uint16_t& length) {
+    CodecStats& stats = _codecStats[codecId];
+    uint8_t* slot = _tileCache[codecId] + (size_t)tileIndex * _tileSlotSize;
+    
+    if (_tileCacheVersion[codecId][tileIndex] == _tileVersion[tileIndex]) {
+        stats.cacheHits++;
+        length = _tileCacheLen[codecId][tileIndex];
+        return slot;
+    }
     
-    // Use Serial directly to avoid recursive logging (these debug messages would create infinite loop)
-    // Serial.printf("[PanelStreamer::sendLogMessages] Sending %d log lines\n", count);
+    unsigned long startUs = micros();
+    copyTile(_frameBuffer, tileIndex % PANEL_STREAM_TILES_X, tileIndex / PANEL_STREAM_TILES_X, _tileBuffer);
+    size_t payloadSize = _codecs[codecId]->encode(_tileBuffer, PANEL_STREAM_TILE_PIXELS, slot, _tileSlotSize);
+    _tileCacheLen[codecId][tileIndex] = (uint16_t)payloadSize;
+    _tileCacheVersion[codecId][tileIndex] = _tileVersion[tileIndex];
     
-    // Send each line as JSON text message using PSRAM allocator
-    struct SpiRamAllocator : ArduinoJson::Allocator {
-        void* allocate(size_t size) override { return ps_malloc(size); }
-        void deallocate(void* pointer) override { free(pointer); }
-        void* reallocate(void* ptr, size_t new_size) override { return ps_realloc(ptr, new_size); }
-    };
+    stats.tilesEncoded++;
+    stats.rawBytes += PANEL_STREAM_TILE_PIXELS * sizeof(PanelStreamPixelType);
+    stats.encodedBytes += payloadSize;
+    stats.encodeUs += micros() - startUs;
     
-    for (const auto& line : newLines) {
-        // Create JSON wrapper with PSRAM allocator
-        SpiRamAllocator allocator;
-        JsonDocument doc(&allocator);
-        doc["type"] = "log";
-        doc["data"] = line.c_str();
-        
-        // Use stack buffer for serialization
-        char jsonBuffer[512];
-        size_t len = serializeJson(doc, jsonBuffer, sizeof(jsonBuffer));
+    length = (uint16_t)payloadSize;
+    return slot;
+}
+
+size_t PanelStreamer::buildFrame(StreamClient& client, bool keyframe) {
+    size_t outPos = writeFrameHeader(_compressedBuffer, keyframe ? PANEL_STREAM_FRAME_KEY : PANEL_STREAM_FRAME_DELTA,
+                                     client.sequence++, _captureMs, client.codec);
+    
+    for (uint8_t tileIndex = 0; tileIndex < PANEL_STREAM_TILE_COUNT; tileIndex++) {
+        if (!keyframe && !client.dirty[tileIndex]) continue;
         
-        if (len > 0 && len < sizeof(jsonBuffer)) {
-            // Send as text message to all connected clients
-            _wsServer->broadcastTXT(jsonBuffer, len);
+        // Tile record: [index][len high][len low][payload]
+        uint16_t payloadSize = 0;
+        const uint8_t* payload = encodedTile(client.codec, tileIndex, payloadSize);
+        _compressedBuffer[outPos++] = tileIndex;
+        _compressedBuffer[outPos++] = (payloadSize >> 8) & 0xFF;
+        _compressedBuffer[outPos++] = payloadSize & 0xFF;
+        memcpy(_compressedBuffer + outPos, payload, payloadSize);
+        outPos += payloadSize;
+    }
+    
+    return outPos;
+}
+
+void PanelStreamer::adaptClientRate(StreamClient& client, bool sent, uint32_t sendUs) {
+    client.lastSendUs = sendUs;
+    
+    if (!sent || sendUs > PANEL_STREAM_SLOW_SEND_US) {
+        // Backpressure: the TCP window is full, back off quickly
+        client.fastStreak = 0;
+        client.intervalMs = min<uint16_t>(PANEL_STREAM_MAX_INTERVAL_MS, client.intervalMs * 3 / 2 + 10);
+    } else if (sendUs < PANEL_STREAM_FAST_SEND_US) {
+        // Headroom: raise the rate again, but only slowly
+        if (++client.fastStreak >= PANEL_STREAM_FAST_STREAK) {
+            client.fastStreak = 0;
+            client.intervalMs = max<uint16_t>(PANEL_STREAM_MIN_INTERVAL_MS, client.intervalMs * 7 / 8);
+        }
+    } else {
+        client.fastStreak = 0;
+    }
+}
+
+bool PanelStreamer::clientHasWork(const StreamClient& client, unsigned long now) const {
+    return client.needsKeyframe || client.dirtyCount > 0 || now - client.lastKeyframeMs >= PANEL_STREAM_KEYFRAME_INTERVAL_MS;
+}
+
+uint32_t PanelStreamer::msUntilNextFrame(unsigned long now) const {
+    uint32_t wait = PANEL_STREAM_SOCKET_POLL_MS;
+    bool framePending = _framePending.load();
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        const StreamClient& client = _clients[i];
+        if (!client.active) continue;
+        unsigned long elapsed = now - client.lastSendMs;
+        uint32_t remaining = elapsed >= client.intervalMs ? 0 : client.intervalMs - elapsed;
+        if (!framePending && !clientHasWork(client, now)) {
+            // Nothing to send before the next render (which notifies the task) or the next keyframe
+            unsigned long sinceKeyframe = now - client.lastKeyframeMs;
+            remaining = max<uint32_t>(remaining, PANEL_STREAM_KEYFRAME_INTERVAL_MS - sinceKeyframe);
         }
+        wait = min(wait, remaining);
     }
+    // A failed capture leaves the frame pending, do not spin on it
+    return max<uint32_t>(wait, 5);
 }
 
-size_t PanelStreamer::compressRLE(const uint16_t* input, size_t inputSize, 
-                                   uint8_t* output, size_t outputMaxSize) {
-    if (!input || !output || inputSize == 0 || outputMaxSize == 0) {
-        return 0;
+void PanelStreamer::notifyFrameRendered() {
+    _framePending = true;
+    if (_taskHandle) xTaskNotifyGive(_taskHandle);
+}
+
+void PanelStreamer::resetClient(uint8_t num) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) {
+        _clients[num] = StreamClient();
     }
+}
+
+void PanelStreamer::logCodecStats() {
+    for (uint8_t i = 0; i < CODEC_COUNT; i++) {
+        CodecStats& stats = _codecStats[i];
+        if (stats.tilesEncoded == 0 && stats.cacheHits == 0) continue;
+        Log.printf("[PanelStreamer] Codec %s: %lu Tiles kodiert, %lu aus Cache, Ratio %.1f:1, %lu us/Tile\n",
+                   _codecs[i]->name(), (unsigned long)stats.tilesEncoded, (unsigned long)stats.cacheHits,
+                   stats.encodedBytes > 0 ? (float)stats.rawBytes / stats.encodedBytes : 0.0f,
+                   stats.tilesEncoded > 0 ? (unsigned long)(stats.encodeUs / stats.tilesEncoded) : 0UL);
+        stats = CodecStats();
+    }
+}
+
+void PanelStreamer::handleClientMessage(uint8_t num, const uint8_t* payload, size_t length) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !payload || length == 0) return;
     
-    size_t outPos = 0;
-    size_t inPos = 0;
+    JsonDocument doc;
+    if (deserializeJson(doc, (const char*)payload, length)) {
+        Log.printf("[WebSocket] Client #%u: Ungültige Nachricht ignoriert\n", num);
+        return;
+    }
     
-    while (inPos < inputSize && outPos < outputMaxSize - 5) {
-        uint16_t pixel = input[inPos];
-        
-        // Skip black pixels (0x0000) - they stay dark in the visualization
-        // We need to track position, so we'll encode skips too
-        if (pixel == 0x0000) {
-            // Count consecutive black pixels
-            uint16_t skipCount = 0;
-            while (inPos < inputSize && input[inPos] == 0x0000 && skipCount < 65535) {
-                skipCount++;
-                inPos++;
+    const char* type = doc["type"] | "";
+    if (strcmp(type, "codecs") == 0) {
+        // Pick the first codec of the client's preference list that we support
+        for (JsonVariant v : doc["accept"].as<JsonArray>()) {
+            int id = v | -1;
+            if (id >= 0 && id < CODEC_COUNT) {
+                _clients[num].codec = (uint8_t)id;
+                _clients[num].needsKeyframe = true;
+                Log.printf("[WebSocket] Client #%u verwendet Codec %s\n", num, _codecs[id]->name());
+                return;
             }
-            
-            // If we have skips, encode them: [0x00][skip_count_high][skip_count_low]
-            if (skipCount > 0) {
-                output[outPos++] = 0x00;  // Marker for skip
-                output[outPos++] = (skipCount >> 8) & 0xFF;
-                output[outPos++] = skipCount & 0xFF;
-            }
-            continue;
         }
-        
-        // Count consecutive same-colored pixels (max 255)
-        uint8_t count = 1;
-        while (inPos + count < inputSize && 
-               input[inPos + count] == pixel && 
-               input[inPos + count] != 0x0000 &&  // Don't include blacks
-               count < 255) {
-            count++;
+    }
+}
+
+size_t PanelStreamer::writeFrameHeader(uint8_t* out, uint8_t messageType, uint32_t sequence,
+                                       uint32_t captureMs, uint8_t codecId) {
+    out[0] = 'P';
+    out[1] = 'C';
+    out[2] = PANEL_STREAM_PROTOCOL_VERSION;
+    out[3] = PANEL_STREAM_HEADER_SIZE;
+    out[4] = messageType;
+    out[5] = (sequence >> 24) & 0xFF;
+    out[6] = (sequence >> 16) & 0xFF;
+    out[7] = (sequence >> 8) & 0xFF;
+    out[8] = sequence & 0xFF;
+    out[9] = (captureMs >> 24) & 0xFF;
+    out[10] = (captureMs >> 16) & 0xFF;
+    out[11] = (captureMs >> 8) & 0xFF;
+    out[12] = captureMs & 0xFF;
+    out[13] = PanelStreamPixel::formatId;
+    out[14] = (FULL_WIDTH >> 8) & 0xFF;
+    out[15] = FULL_WIDTH & 0xFF;
+    out[16] = (FULL_HEIGHT >> 8) & 0xFF;
+    out[17] = FULL_HEIGHT & 0xFF;
+    out[18] = PANEL_STREAM_TILE_SIZE;
+    out[19] = codecId;
+    return PANEL_STREAM_HEADER_SIZE;
+}
+
+void PanelStreamer::sendLogMessages() {
+    if (!_wsServer || !_logBuffer) {
+        // Use Serial directly to avoid recursive logging
+        Serial.println("[PanelStreamer::sendLogMessages] No WebSocket server!");
+        return;
+    }
+    
+    // Bounded per tick so a log burst cannot starve the panel stream, the rest waits in the ring buffer
+    for (uint8_t batch = 0; batch < PANEL_STREAM_LOG_MAX_BATCHES; batch++) {
+        const size_t payloadStart = PANEL_STREAM_HEADER_SIZE + 2;
+        uint32_t droppedLines = 0;
+        size_t recordBytes = Log.readNewRecords(_logBuffer + payloadStart, PANEL_STREAM_LOG_BATCH_SIZE - payloadStart, droppedLines);
+        if (recordBytes == 0 && droppedLines == 0) {
+            break;
         }
         
-        // Encode: [count][high_byte][low_byte]
-        output[outPos++] = count;
-        output[outPos++] = (pixel >> 8) & 0xFF;  // High byte
-        output[outPos++] = pixel & 0xFF;         // Low byte
+        // Log frame: header, [dropped high][dropped low], then the records
+        uint16_t dropped = (uint16_t)min<uint32_t>(droppedLines, 0xFFFF);
+        writeFrameHeader(_logBuffer, PANEL_STREAM_FRAME_LOG, _logSequence++, millis(), 0);
+        _logBuffer[PANEL_STREAM_HEADER_SIZE] = (dropped >> 8) & 0xFF;
+        _logBuffer[PANEL_STREAM_HEADER_SIZE + 1] = dropped & 0xFF;
+        _wsServer->broadcastBIN(_logBuffer, recordBytes + payloadStart);
         
-        inPos += count;
+        if (!Log.hasNewLines()) {
+            break;
+        }
     }
-    
-    return outPos;
 }
 
 void PanelStreamer::webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
@@ -344,6 +614,7 @@ void PanelStreamer::webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload,
     switch (type) {
         case WStype_DISCONNECTED:
             Log.printf("[WebSocket] Client #%u disconnected\n", num);
+            _instance->resetClient(num);
             break;
             
         case WStype_CONNECTED:
@@ -353,16 +624,21 @@ void PanelStreamer::webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload,
                           num, ip[0], ip[1], ip[2], ip[3]);
                 
                 // Check max clients
-                if (_instance->getClientCount() > MAX_CLIENTS) {
+                if (_instance->getClientCount() > _instance->_maxClients) {
                     Log.printf("[WebSocket] Max clients reached, disconnecting #%u\n", num);
                     _instance->_wsServer->disconnect(num);
+                } else if (num < WEBSOCKETS_SERVER_CLIENT_MAX) {
+                    // New viewer starts at the default rate and needs a full picture before deltas make sense
+                    _instance->resetClient(num);
+                    _instance->_clients[num].active = true;
                 }
             }
             break;
             
         case WStype_TEXT:
-            // Client sent text message (could be control commands in future)
+            // Client sent text message (codec negotiation)
             Log.printf("[WebSocket] Client #%u sent: %s\n", num, payload);
+            _instance->handleClientMessage(num, payload, length);
             break;
             
         case WStype_BIN:
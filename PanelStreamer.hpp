@@ -6,29 +6,90 @@
 #include "PanelManager.hpp"
 #include "MultiLogger.hpp"
 #include "PsramUtils.hpp"
+#include "PanelStreamCodec.hpp"
+#include <atomic>
+
+class PanelRecorder;
+
+// Default frame rate, each client starts at this rate and adapts from there
+#define PANEL_STREAM_FPS 15
+#define PANEL_STREAM_INTERVAL_MS (1000 / PANEL_STREAM_FPS)
+
+// Delta protocol: the panel is split into square tiles, only changed tiles are sent
+#define PANEL_STREAM_TILE_SIZE 16
+#define PANEL_STREAM_TILES_X (FULL_WIDTH / PANEL_STREAM_TILE_SIZE)
+#define PANEL_STREAM_TILES_Y (FULL_HEIGHT / PANEL_STREAM_TILE_SIZE)
+#define PANEL_STREAM_TILE_COUNT (PANEL_STREAM_TILES_X * PANEL_STREAM_TILES_Y)
+#define PANEL_STREAM_TILE_PIXELS (PANEL_STREAM_TILE_SIZE * PANEL_STREAM_TILE_SIZE)
+
+// Versioned message header, see the class comment for the layout
+#define PANEL_STREAM_PROTOCOL_VERSION 1
+#define PANEL_STREAM_HEADER_SIZE 20
+#define PANEL_STREAM_FRAME_KEY 0x01
+#define PANEL_STREAM_FRAME_DELTA 0x02
+#define PANEL_STREAM_FRAME_LOG 0x10
+
+// Pixel format of the panel canvas (GFXcanvas16). Switching the canvas to RGB888 means
+// switching this typedef (and the PanelManager copy functions), the codecs, the tile
+// helpers and the browser decoder already handle both formats.
+typedef PixelRGB565 PanelStreamPixel;
+typedef PanelStreamPixel::Storage PanelStreamPixelType;
 
 /**
  * @brief Manages WebSocket streaming of panel data and log messages
  * 
  * This class runs a FreeRTOS task on the non-Arduino core that:
- * 1. Streams compressed panel snapshots at ~2 FPS
- * 2. Streams log messages as they arrive
- * 3. Handles WebSocket client connections (max 2 clients)
+ * 1. Streams panel updates as delta frames (only changed tiles, compressed with
+ *    the codec negotiated per client, see PanelStreamCodec.hpp)
+ * 2. Sends a keyframe periodically and whenever a client connects
+ * 3. Streams log messages in batches (one binary frame per tick holding many lines)
+ * 4. Feeds the flight recorder (PanelRecorder), also when nobody is watching
+ * 5. Handles WebSocket client connections (limit configurable, DeviceConfig::streamMaxClients)
+ * 
+ * The task sleeps until notifyFrameRendered() reports a new frame or the next keyframe is
+ * due. WebSocketsServer can only be polled, so socket events and log lines are serviced
+ * every PANEL_STREAM_SOCKET_POLL_MS in between, without capturing the panel.
+ * 
+ * Every client has its own frame interval that adapts to how long sendBIN() blocks
+ * for it: slow or failing sends stretch the interval, a streak of fast sends shortens
+ * it again. Changes captured while a client is not due are merged into its dirty tile
+ * set, so a slow viewer receives fewer, coalesced frames and never delays the others.
+ * Encoded tiles are cached per codec and frame, each tile is encoded at most once no
+ * matter how many clients receive it.
+ * 
+ * Message header (all binary WebSocket messages, integers big-endian):
+ *   [0..1]   magic "PC"
+ *   [2]      protocol version (PANEL_STREAM_PROTOCOL_VERSION)
+ *   [3]      header length in bytes (payload starts there, allows appending fields)
+ *   [4]      message type: 0x01 keyframe, 0x02 delta frame, 0x10 log batch
+ *   [5..8]   sequence number (per client for panel frames, per stream for logs),
+ *            a gap tells the client that frames were lost
+ *   [9..12]  capture timestamp (millis() of the device when the frame was captured)
+ *   [13]     pixel format (PanelPixelFormatId, 0 = RGB565, 1 = RGB888)
+ *   [14..15] width, [16..17] height
+ *   [18]     tile size, [19] codec id
+ * 
+ * Panel frame payload: one record per transmitted tile
+ *   [tileIndex][payloadLen high][payloadLen low][encoded payload]
+ *   Keyframes contain all tiles, delta frames only the changed ones.
+ *   Tiles are numbered row-major over the panel, pixels inside a tile as well.
  * 
- * RGB888 Compatibility Note:
- * Currently uses RGB565 (16-bit) format matching GFXcanvas16.
- * For RGB888 canvas support, modify:
- * - _panelBuffer type from uint16_t* to uint32_t* or use template
- * - compressRLE to handle 24/32-bit pixels
- * - Client-side decoder to handle RGB888 format
+ * Log frame payload:
+ *   [droppedLines high][droppedLines low] followed by MultiLogger records
+ *   [flags][len high][len low][UTF-8 text], flags bit 0 = line continues in the next record.
+ * 
+ * Codec negotiation: after connecting, the client sends a text message
+ *   {"type":"codecs","accept":[1,2,0]}
+ * listing the codec IDs it can decode in order of preference. Until then RLE is used.
  */
 class PanelStreamer {
 public:
     /**
      * @brief Constructor
      * @param panelManager Pointer to the PanelManager for accessing panel data
+     * @param maxClients Maximum number of simultaneous viewers (clamped to the WebSocket slots)
      */
-    PanelStreamer(PanelManager* panelManager);
+    PanelStreamer(PanelManager* panelManager, uint8_t maxClients = 4);
     
     /**
      * @brief Destructor
@@ -51,12 +112,58 @@ public:
      * @return Number of connected clients
      */
     uint8_t getClientCount();
+
+    /**
+     * @brief Tell the streamer task that the panel canvas has a new frame (call after PanelManager::render())
+     */
+    void notifyFrameRendered();
     
     /**
      * @brief Get the WebSocket server instance
      * @return Pointer to the WebSocketsServer
      */
     WebSocketsServer* getWebSocketServer() { return _wsServer; }
+    
+    /**
+     * @brief Get the flight recorder running in the streamer task
+     * @return Pointer to the PanelRecorder
+     */
+    PanelRecorder* getRecorder() { return _recorder; }
+    
+    /**
+     * @brief Check whether a tile differs between two full panel buffers
+     */
+    template<typename PixelType>
+    static bool tileDiffers(const PixelType* a, const PixelType* b, int tileX, int tileY) {
+        size_t offset = (size_t)tileY * PANEL_STREAM_TILE_SIZE * FULL_WIDTH + (size_t)tileX * PANEL_STREAM_TILE_SIZE;
+        for (int row = 0; row < PANEL_STREAM_TILE_SIZE; row++) {
+            if (memcmp(a + offset, b + offset, PANEL_STREAM_TILE_SIZE * sizeof(PixelType)) != 0) {
+                return true;
+            }
+            offset += FULL_WIDTH;
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Copy the pixels of one tile from a full panel buffer in row-major order
+     */
+    template<typename PixelType>
+    static void copyTile(const PixelType* src, int tileX, int tileY, PixelType* dest) {
+        size_t offset = (size_t)tileY * PANEL_STREAM_TILE_SIZE * FULL_WIDTH + (size_t)tileX * PANEL_STREAM_TILE_SIZE;
+        for (int row = 0; row < PANEL_STREAM_TILE_SIZE; row++) {
+            memcpy(dest, src + offset, PANEL_STREAM_TILE_SIZE * sizeof(PixelType));
+            dest += PANEL_STREAM_TILE_SIZE;
+            offset += FULL_WIDTH;
+        }
+    }
+    
+    /**
+     * @brief Write the versioned message header
+     * @return Number of bytes written (PANEL_STREAM_HEADER_SIZE)
+     */
+    static size_t writeFrameHeader(uint8_t* out, uint8_t messageType, uint32_t sequence,
+                                   uint32_t captureMs, uint8_t codecId);
 
 private:
     // Panel manager reference
@@ -72,21 +179,91 @@ private:
     bool _running;
     SemaphoreHandle_t _controlMutex;
     
-    // Panel buffer for copying (in PSRAM)
-    uint16_t* _panelBuffer;
+    // Maximum number of simultaneous viewers
+    uint8_t _maxClients;
+    
+    // Capture buffer the panel is copied into (in PSRAM)
+    PanelStreamPixelType* _captureBuffer;
     size_t _panelBufferSize;
     
-    // Compressed data buffer (in PSRAM)
+    // Most recent captured frame, source for encoding and reference for change detection (in PSRAM)
+    PanelStreamPixelType* _frameBuffer;
+    
+    // Scratch buffer holding the pixels of one tile in row-major order
+    PanelStreamPixelType* _tileBuffer;
+    
+    // Set by notifyFrameRendered(), cleared when the streamer task captures the frame
+    std::atomic<bool> _framePending{true};
+    
+    // Capture counter, time of the last capture and the capture in which each tile last changed
+    uint32_t _captureNumber;
+    uint32_t _captureMs;
+    uint32_t _tileVersion[PANEL_STREAM_TILE_COUNT];
+    
+    // Encoded tiles per codec (fixed slot per tile, in PSRAM) and the tile version each slot holds
+    uint8_t* _tileCache[CODEC_COUNT];
+    uint16_t _tileCacheLen[CODEC_COUNT][PANEL_STREAM_TILE_COUNT];
+    uint32_t _tileCacheVersion[CODEC_COUNT][PANEL_STREAM_TILE_COUNT];
+    size_t _tileSlotSize;
+    
+    // Outgoing message buffer (in PSRAM)
     uint8_t* _compressedBuffer;
     size_t _compressedBufferSize;
     
+    // Outgoing log batch buffer (in PSRAM) and log message sequence
+    uint8_t* _logBuffer;
+    uint32_t _logSequence;
+    
+    // Available codecs, indexed by PanelStreamCodecId
+    PanelStreamCodec<PanelStreamPixel>* _codecs[CODEC_COUNT];
+    
+    // Per-client stream state, indexed by WebSocket client slot
+    struct StreamClient {
+        bool active = false;
+        uint8_t codec = CODEC_RLE;
+        uint16_t intervalMs = PANEL_STREAM_INTERVAL_MS;
+        unsigned long lastSendMs = 0;
+        unsigned long lastKeyframeMs = 0;
+        bool needsKeyframe = true;
+        bool dirty[PANEL_STREAM_TILE_COUNT] = {};
+        uint8_t dirtyCount = 0;
+        uint8_t fastStreak = 0;
+        uint32_t sequence = 0;
+        uint32_t framesSent = 0;
+        uint32_t framesCoalesced = 0;
+        uint32_t sendFailures = 0;
+        uint32_t lastSendUs = 0;
+    };
+    StreamClient _clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+    
+    // Per-codec statistics (reset with every debug output)
+    struct CodecStats {
+        uint32_t tilesEncoded = 0;
+        uint32_t cacheHits = 0;
+        uint32_t rawBytes = 0;
+        uint32_t encodedBytes = 0;
+        uint32_t encodeUs = 0;
+    };
+    CodecStats _codecStats[CODEC_COUNT];
+    
     // Task function
     static void streamerTaskWrapper(void* param);
     void streamerTask();
     
+    // Flight recorder, fed from the streamer task
+    PanelRecorder* _recorder;
+    
     // Helper functions
-    size_t compressRLE(const uint16_t* input, size_t inputSize, uint8_t* output, size_t outputMaxSize);
-    void sendPanelSnapshot();
+    bool captureFrame();
+    const uint8_t* encodedTile(uint8_t codecId, uint8_t tileIndex, uint16_t& length);
+    size_t buildFrame(StreamClient& client, bool keyframe);
+    void sendPanelFrames();
+    void adaptClientRate(StreamClient& client, bool sent, uint32_t sendUs);
+    bool clientHasWork(const StreamClient& client, unsigned long now) const;
+    uint32_t msUntilNextFrame(unsigned long now) const;
+    void resetClient(uint8_t num);
+    void handleClientMessage(uint8_t num, const uint8_t* payload, size_t length);
+    void logCodecStats();
     void sendLogMessages();
     
     // WebSocket event handler
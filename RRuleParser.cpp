@@ -13,35 +13,251 @@ static inline int parseDecimal(const char* p, size_t len) {
     return v;
 }
 
-time_t parseICalDateTime(const char* line, size_t len, bool& isAllDay, const GeneralTimeConverter* converter) {
-    isAllDay = false;
-    if (!line || len == 0) return 0;
+// --- IcsProperty ---
+
+static bool equalsIgnoreCase(const char* a, size_t aLen, const char* b) {
+    size_t bLen = strlen(b);
+    return aLen == bLen && strncasecmp(a, b, bLen) == 0;
+}
+
+bool IcsProperty::is(const char* propertyName) const {
+    return equalsIgnoreCase(name, nameLen, propertyName);
+}
 
-    const char* value_ptr = line;
-    const char* colon = (const char*)memchr(line, ':', len);
-    if (colon) {
-        value_ptr = colon + 1;
+bool IcsProperty::hasParam(const char* token) const {
+    size_t tokenLen = strlen(token);
+    if (!params || tokenLen == 0 || paramsLen <= tokenLen) return false;
+    // Nur ganze Parameter: "VALUE=DATE" passt nicht auf "VALUE=DATE-TIME", "TZID=" auf jeden Wert
+    bool prefixOnly = token[tokenLen - 1] == '=';
+    for (size_t i = 0; i + tokenLen <= paramsLen; ++i) {
+        if (params[i] != ';' || i + 1 + tokenLen > paramsLen) continue;
+        if (strncasecmp(params + i + 1, token, tokenLen) != 0) continue;
+        size_t after = i + 1 + tokenLen;
+        if (prefixOnly || after == paramsLen || params[after] == ';') return true;
     }
+    return false;
+}
+
+// --- IcsTokenizer ---
+
+bool IcsTokenizer::next(IcsProperty& prop) {
+    while (_pos < _len) {
+        size_t start = _pos;
+        size_t searchFrom = start;
+        size_t lineEnd = 0;
+        size_t nextPos = 0;
+        bool folded = false;
+
+        // Logisches Zeilenende: '\n', auf das kein Leerzeichen/Tab folgt
+        for (;;) {
+            const char* nl = (const char*)memchr(_data + searchFrom, '\n', _len - searchFrom);
+            if (!nl) {
+                if (!_final) return false;
+                lineEnd = _len;
+                nextPos = _len;
+                break;
+            }
+            size_t nlPos = nl - _data;
+            if (nlPos + 1 >= _len) {
+                // Ob die Zeile fortgesetzt wird, entscheidet erst das nächste Zeichen
+                if (!_final) return false;
+                lineEnd = nlPos;
+                nextPos = _len;
+                break;
+            }
+            char following = _data[nlPos + 1];
+            if (following == ' ' || following == '\t') {
+                folded = true;
+                searchFrom = nlPos + 1;
+                continue;
+            }
+            lineEnd = nlPos;
+            nextPos = nlPos + 1;
+            break;
+        }
+
+        _pos = nextPos;
+        size_t lineLen = lineEnd - start;
+        if (lineLen > 0 && _data[start + lineLen - 1] == '\r') --lineLen;
+        if (lineLen == 0) continue;
+
+        splitLine(_data + start, lineLen, prop);
+        prop.folded = folded;
+        return true;
+    }
+    return false;
+}
+
+void IcsTokenizer::splitLine(const char* line, size_t len, IcsProperty& prop) {
+    prop = IcsProperty();
+    size_t i = 0;
+    while (i < len && line[i] != ';' && line[i] != ':') ++i;
+    prop.name = line;
+    prop.nameLen = i;
+
+    if (i < len && line[i] == ';') {
+        // Parameter bis zum ersten ':' außerhalb von Anführungszeichen (TZID="Europe/Berlin:X")
+        size_t paramStart = i;
+        bool quoted = false;
+        while (i < len && (quoted || line[i] != ':')) {
+            if (line[i] == '"') quoted = !quoted;
+            ++i;
+        }
+        prop.params = line + paramStart;
+        prop.paramsLen = i - paramStart;
+    }
+
+    if (i < len) ++i;  // ':'
+    prop.value = line + i;
+    prop.valueLen = len - i;
+}
+
+static void appendUnfolded(const char* text, size_t len, PsramString& out) {
+    for (size_t i = 0; i < len; ++i) {
+        char c = text[i];
+        if (c == '\r' && i + 1 < len && text[i + 1] == '\n') continue;
+        if (c == '\n') {
+            ++i;  // Das folgende Leerzeichen/Tab gehört zur Faltung
+            continue;
+        }
+        out += c;
+    }
+}
 
-    // Check for property parameters (TZID, VALUE=DATE)
-    bool hasTZID = false;
-    const char* semicolon = (const char*)memchr(line, ';', len);
-    if (semicolon && semicolon < colon) { // Property parameter
-        const char* value_date = strstr(semicolon, "VALUE=DATE");
-        if (value_date) {
-            isAllDay = true;
+void IcsTokenizer::unfold(IcsProperty& prop) {
+    if (!prop.folded) return;
+    _unfolded.clear();
+    appendUnfolded(prop.params, prop.paramsLen, _unfolded);
+    size_t paramsLen = _unfolded.size();
+    appendUnfolded(prop.value, prop.valueLen, _unfolded);
+
+    prop.params = paramsLen > 0 ? _unfolded.data() : nullptr;
+    prop.paramsLen = paramsLen;
+    prop.value = _unfolded.data() + paramsLen;
+    prop.valueLen = _unfolded.size() - paramsLen;
+    prop.folded = false;
+}
+
+void IcsTokenizer::unescapeText(const char* text, size_t len, PsramString& out) {
+    out.clear();
+    out.reserve(len);
+    for (size_t i = 0; i < len; ++i) {
+        char c = text[i];
+        if (c == '\\' && i + 1 < len) {
+            char e = text[++i];
+            // Zeilenumbrüche werden auf dem Panel einzeilig dargestellt
+            out += (e == 'n' || e == 'N') ? ' ' : e;
+        } else {
+            out += c;
         }
-        // Check if there's a TZID parameter
-        // TZID format is "TZID=timezone_name" followed by colon
-        const char* tzid = strstr(semicolon, "TZID=");
-        if (tzid && tzid < colon && tzid >= semicolon) {
-            hasTZID = true;
+    }
+}
+
+// --- IcsStringPool ---
+
+#define ICS_STRING_POOL_BLOCK_SIZE 4096
+
+static uint32_t hashText(const char* text, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+const char* IcsStringPool::intern(const char* text, size_t len) {
+    if (!text || len == 0) return "";
+    if (_slots.empty()) _slots.resize(64, Slot{0, nullptr});
+
+    uint32_t hash = hashText(text, len);
+    size_t mask = _slots.size() - 1;
+    size_t idx = hash & mask;
+    while (_slots[idx].text) {
+        const Slot& slot = _slots[idx];
+        if (slot.hash == hash && strncmp(slot.text, text, len) == 0 && slot.text[len] == '\0') {
+            return slot.text;
         }
+        idx = (idx + 1) & mask;
+    }
+
+    if (_blocks.empty() || _blockUsed + len + 1 > _blockSize) {
+        size_t size = std::max((size_t)ICS_STRING_POOL_BLOCK_SIZE, len + 1);
+        char* block = (char*)ps_malloc(size);
+        if (!block) return "";
+        _blocks.push_back(block);
+        _blockSize = size;
+        _blockUsed = 0;
+    }
+    char* copy = _blocks.back() + _blockUsed;
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+    _blockUsed += len + 1;
+    _bytes += len + 1;
+
+    _slots[idx] = Slot{hash, copy};
+    if (++_count * 4 > _slots.size() * 3) grow();
+    return copy;
+}
+
+void IcsStringPool::grow() {
+    PsramVector<Slot> old;
+    old.swap(_slots);
+    _slots.resize(old.size() * 2, Slot{0, nullptr});
+    size_t mask = _slots.size() - 1;
+    for (const Slot& slot : old) {
+        if (!slot.text) continue;
+        size_t idx = slot.hash & mask;
+        while (_slots[idx].text) idx = (idx + 1) & mask;
+        _slots[idx] = slot;
     }
+}
+
+void IcsStringPool::clear() {
+    for (char* block : _blocks) free(block);
+    _blocks.clear();
+    _blocks.shrink_to_fit();
+    _slots.clear();
+    _slots.shrink_to_fit();
+    _blockSize = 0;
+    _blockUsed = 0;
+    _count = 0;
+    _bytes = 0;
+}
+
+void IcsStringPool::swap(IcsStringPool& other) {
+    _blocks.swap(other._blocks);
+    _slots.swap(other._slots);
+    std::swap(_blockSize, other._blockSize);
+    std::swap(_blockUsed, other._blockUsed);
+    std::swap(_count, other._count);
+    std::swap(_bytes, other._bytes);
+}
+
+// --- Datum/Zeit ---
+
+time_t parseICalDateTime(const char* line, size_t len, bool& isAllDay, const GeneralTimeConverter* converter) {
+    isAllDay = false;
+    if (!line || len == 0) return 0;
+    IcsProperty prop;
+    IcsTokenizer::splitLine(line, len, prop);
+    return parseICalDateTime(prop, isAllDay, converter);
+}
+
+time_t parseICalDateTime(const IcsProperty& prop, bool& isAllDay, const GeneralTimeConverter* converter,
+                         IcsTimeCache* cache) {
+    isAllDay = false;
+    if (!prop.value || prop.valueLen == 0) return 0;
+
+    // Property-Parameter (TZID, VALUE=DATE), nur innerhalb der Zeile gesucht
+    if (prop.hasParam("VALUE=DATE")) {
+        isAllDay = true;
+    }
+    bool hasTZID = prop.hasParam("TZID=");
+
+    const char* dt_str = prop.value;
+    size_t dt_len = prop.valueLen;
 
-    const char* dt_str = value_ptr;
-    size_t dt_len = strlen(dt_str);
-    
     while (dt_len > 0 && !isalnum(dt_str[dt_len - 1])) {
         dt_len--;
     }
@@ -76,22 +292,23 @@ time_t parseICalDateTime(const char* line, size_t len, bool& isAllDay, const Gen
 
     if (isUTC) {
         // Time ends with 'Z' - it's explicitly UTC
-        return timegm(&t);
+        return cache ? cache->asUtc(year, month, day, hour, minute, second) : timegm(&t);
     } else if (hasTZID && converter) {
         // Time has TZID parameter - it's in that local timezone
         // Parse as if it's a time, then subtract the timezone offset to get UTC
         // timegm treats the tm struct as UTC, giving us the epoch if it were UTC
-        time_t as_if_utc = timegm(&t);
+        time_t as_if_utc = cache ? cache->asUtc(year, month, day, hour, minute, second) : timegm(&t);
+        auto isDST = [&](time_t utc) { return cache ? cache->isDST(utc, converter) : converter->isDST(utc); };
         
         // To check DST correctly, we need to approximate the UTC time first
         // Use a simplified approach: check DST based on the approximate UTC time
         // This works because DST transitions don't happen at the same time in local and UTC
-        int initial_offset = converter->isDST(as_if_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
+        int initial_offset = isDST(as_if_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
         time_t approx_utc = as_if_utc - initial_offset;
         
         // Now check DST again with the approximated UTC time
         // This handles edge cases around DST transitions
-        int final_offset = converter->isDST(approx_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
+        int final_offset = isDST(approx_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
         return as_if_utc - final_offset;
     } else {
         // No timezone specified - treat as local time using system timezone
@@ -99,56 +316,210 @@ time_t parseICalDateTime(const char* line, size_t len, bool& isAllDay, const Gen
     }
 }
 
-void parseVEvent(const char* veventBlock, size_t len, Event& event, const GeneralTimeConverter* converter) {
-    if (!veventBlock || len == 0) return;
-    const char* p = veventBlock;
-    const char* end = veventBlock + len;
+// --- IcsTimeCache ---
 
-    bool dtstart_is_allday = false;
-    bool dtend_is_allday = false;
+time_t IcsTimeCache::asUtc(int year, int month, int day, int hour, int minute, int second) {
+    static const int cumDays[2][12] = {
+        {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334},
+        {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335}};
+    if (year < 1970 || month < 1 || month > 12) {
+        // Randfälle rechnet timegm() selbst (es verhält sich dort nicht wie die Formel unten)
+        struct tm t = {0};
+        t.tm_year = year - 1900;
+        t.tm_mon = month - 1;
+        t.tm_mday = day;
+        t.tm_hour = hour;
+        t.tm_min = minute;
+        t.tm_sec = second;
+        return timegm(&t);
+    }
+    time_t days = cumDays[is_leap(year)][month - 1] + day - 1;
+    return yearInfo(year).start + ((days * 24 + hour) * 60 + minute) * 60 + second;
+}
 
-    while (p < end) {
-        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
-        size_t lineLen = 0;
-        if (lineEnd) {
-            lineLen = lineEnd - p;
+bool IcsTimeCache::isDST(time_t utc, const GeneralTimeConverter* converter) {
+    if (!converter) return false;
+    if (converter != _converter) {
+        clear();
+        _converter = converter;
+    }
+    Year* y = nullptr;
+    for (size_t i = 0; i < _count; ++i) {
+        if (utc >= _years[i].start && utc < _years[i].end) {
+            y = &_years[i];
+            break;
+        }
+    }
+    if (!y) {
+        struct tm t;
+        gmtime_r(&utc, &t);
+        y = &yearInfo(t.tm_year + 1900);
+    }
+    if (!y->dstKnown) {
+        y->hasDst = converter->getDstTransitions(y->year, y->dstStart, y->dstEnd);
+        y->dstKnown = true;
+    }
+    if (!y->hasDst) return false;
+    if (y->dstStart < y->dstEnd) {
+        return (utc >= y->dstStart && utc < y->dstEnd);
+    }
+    return (utc >= y->dstStart || utc < y->dstEnd);
+}
+
+IcsTimeCache::Year& IcsTimeCache::yearInfo(int year) {
+    for (size_t i = 0; i < _count; ++i) {
+        if (_years[i].year == year) return _years[i];
+    }
+    size_t slot = _count < kYears ? _count++ : _next;
+    _next = (slot + 1) % kYears;
+    Year& y = _years[slot];
+    y.year = year;
+    struct tm t = {0};
+    t.tm_year = year - 1900;
+    t.tm_mday = 1;
+    y.start = timegm(&t);
+    t.tm_year++;
+    y.end = timegm(&t);
+    y.dstKnown = false;
+    y.hasDst = false;
+    return y;
+}
+
+// --- IcsEventParser ---
+
+void IcsEventParser::reset() {
+    _event = Event();
+    _inEvent = false;
+    _nested = 0;
+    _dtstartIsAllDay = false;
+    _times.clear();
+}
+
+size_t IcsEventParser::parse(const char* data, size_t len, bool final, PsramVector<Event>& events) {
+    if (!data || len == 0) return 0;
+    IcsTokenizer tokenizer(data, len, final);
+    IcsProperty prop;
+    while (tokenizer.next(prop)) {
+        handleProperty(tokenizer, prop, events);
+    }
+    return tokenizer.consumed();
+}
+
+void IcsEventParser::handleProperty(IcsTokenizer& tokenizer, IcsProperty& prop, PsramVector<Event>& events) {
+    if (prop.is("BEGIN")) {
+        if (_inEvent) {
+            _nested++;  // VALARM o.ä. innerhalb des Events
+        } else if (equalsIgnoreCase(prop.value, prop.valueLen, "VEVENT")) {
+            reset();
+            _inEvent = true;
+        }
+        return;
+    }
+    if (prop.is("END")) {
+        if (!_inEvent) return;
+        if (_nested > 0) {
+            _nested--;
+            return;
+        }
+
+        _event.isAllDay = _dtstartIsAllDay;
+        if (_event.dtend > _event.dtstart) {
+            _event.duration = _event.dtend - _event.dtstart;
+        } else if (_event.isAllDay) {
+            _event.duration = 86400;
         } else {
-            lineLen = end - p;
-            lineEnd = end;
+            _event.duration = 0;
         }
-        if (lineLen > 0 && p[lineLen - 1] == '\r') --lineLen;
-
-        if (lineLen > 8 && strncmp(p, "SUMMARY:", 8) == 0) {
-            const char* val = p + 8;
-            event.summary = PsramString(val, lineLen - 8);
-        } else if (lineLen > 6 && strncmp(p, "RRULE:", 6) == 0) {
-            const char* val = p + 6;
-            event.rrule = PsramString(val, lineLen - 6);
-        } else if (lineLen > 4 && strncmp(p, "UID:", 4) == 0) {
-            const char* val = p + 4;
-            event.uid = PsramString(val, lineLen - 4);
-        } else if (strncmp(p, "DTSTART", 7) == 0) {
-            event.dtstart = parseICalDateTime(p, lineLen, dtstart_is_allday, converter);
-        } else if (strncmp(p, "DTEND", 5) == 0) {
-            event.dtend = parseICalDateTime(p, lineLen, dtend_is_allday, converter);
-        } else if (strncmp(p, "EXDATE", 6) == 0) {
-            bool dummy;
-            time_t ex = parseICalDateTime(p, lineLen, dummy, converter);
-            if (ex != 0) event.exdates.push_back(ex);
-        } else if (strncmp(p, "RECURRENCE-ID", 13) == 0) {
+        if (_event.dtstart > 0) {
+            events.push_back(std::move(_event));
+            if (events.size() % 50 == 0) delay(1);
+        }
+        reset();
+        return;
+    }
+    if (!_inEvent || _nested > 0) return;
+
+    if (prop.is("SUMMARY")) {
+        tokenizer.unfold(prop);
+        IcsTokenizer::unescapeText(prop.value, prop.valueLen, _text);
+        _event.summary = _summaries ? _summaries->intern(_text.data(), _text.size()) : "";
+    } else if (prop.is("RRULE")) {
+        tokenizer.unfold(prop);
+        _event.rrule.assign(prop.value, prop.valueLen);
+    } else if (prop.is("UID")) {
+        tokenizer.unfold(prop);
+        _event.uid.assign(prop.value, prop.valueLen);
+    } else if (prop.is("DTSTART")) {
+        tokenizer.unfold(prop);
+        _event.dtstart = parseICalDateTime(prop, _dtstartIsAllDay, _converter, &_times);
+    } else if (prop.is("DTEND")) {
+        tokenizer.unfold(prop);
+        bool dtendIsAllDay;
+        _event.dtend = parseICalDateTime(prop, dtendIsAllDay, _converter, &_times);
+    } else if (prop.is("EXDATE")) {
+        tokenizer.unfold(prop);
+        // EXDATE kann mehrere, durch Komma getrennte Werte enthalten
+        IcsProperty single = prop;
+        const char* p = prop.value;
+        const char* end = prop.value + prop.valueLen;
+        while (p < end) {
+            const char* comma = (const char*)memchr(p, ',', end - p);
+            const char* valueEnd = comma ? comma : end;
+            single.value = p;
+            single.valueLen = valueEnd - p;
             bool dummy;
-            event.recurrence_id = parseICalDateTime(p, lineLen, dummy, converter);
+            time_t ex = parseICalDateTime(single, dummy, _converter, &_times);
+            if (ex != 0) _event.exdates.push_back(ex);
+            p = valueEnd + 1;
         }
-        
-        p = lineEnd + 1;
+    } else if (prop.is("RECURRENCE-ID")) {
+        tokenizer.unfold(prop);
+        bool dummy;
+        _event.recurrence_id = parseICalDateTime(prop, dummy, _converter, &_times);
     }
+}
 
-    event.isAllDay = dtstart_is_allday;
-    if (event.dtend > event.dtstart) {
-        event.duration = event.dtend - event.dtstart;
-    } else if (event.isAllDay) {
-        event.duration = 86400;
-    } else {
-        event.duration = 0;
+// --- IcsStreamParser ---
+
+void IcsStreamParser::reset() {
+    _carry.clear();
+    _carry.shrink_to_fit();
+    _events.clear();
+    _summaries.clear();
+    _parser.reset();
+}
+
+void IcsStreamParser::feed(const char* data, size_t len) {
+    if (!data || len == 0) return;
+    if (!_carry.empty()) {
+        // Angefangene Zeile aus dem letzten Chunk: bis zum nächsten Zeilenumbruch plus ein Zeichen
+        // anhängen (das entscheidet, ob die Zeile gefaltet weitergeht)
+        const char* nl = (const char*)memchr(data, '\n', len);
+        size_t take = nl ? std::min(len, (size_t)(nl - data) + 2) : len;
+        size_t carried = _carry.length();
+        _carry.append(data, take);
+        size_t consumed = _parser.parse(_carry.c_str(), _carry.length(), false, _events);
+        if (consumed < carried) {
+            // Gefaltete Zeile reicht weiter: selten, dann den Rest des Chunks über den Puffer parsen
+            _carry.append(data + take, len - take);
+            consumed = _parser.parse(_carry.c_str(), _carry.length(), false, _events);
+            _carry.erase(0, consumed);
+            return;
+        }
+        size_t offset = consumed - carried;
+        data += offset;
+        len -= offset;
+        _carry.clear();
     }
-}
\ No newline at end of file
+
+    // Vollständige Zeilen direkt im Chunk parsen, nur die angefangene letzte Zeile wird kopiert
+    size_t consumed = _parser.parse(data, len, false, _events);
+    if (consumed < len) _carry.assign(data + consumed, len - consumed);
+}
+
+void IcsStreamParser::finish() {
+    if (!_carry.empty()) _parser.parse(_carry.c_str(), _carry.length(), true, _events);
+    _carry.clear();
+    _carry.shrink_to_fit();
+    _parser.reset();
+}
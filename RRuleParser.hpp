@@ -11,10 +11,13 @@
 
 // Vorwärtsdeklaration, da die Implementierung in die .cpp-Datei umzieht
 struct Event; 
+struct IcsProperty;
+class IcsTimeCache;
 
 // Funktionsdeklarationen
 time_t parseICalDateTime(const char* line, size_t len, bool& isAllDay, const GeneralTimeConverter* converter = nullptr);
-void parseVEvent(const char* veventBlock, size_t len, Event& event, const GeneralTimeConverter* converter = nullptr);
+time_t parseICalDateTime(const IcsProperty& prop, bool& isAllDay, const GeneralTimeConverter* converter = nullptr,
+                         IcsTimeCache* cache = nullptr);
 
 template<typename Allocator>
 void parseRRule(const Event& masterEvent, std::vector<time_t, Allocator>& occurrences, int numFutureEventsToFind = 15, const GeneralTimeConverter* converter = nullptr);
@@ -22,7 +25,7 @@ void parseRRule(const Event& masterEvent, std::vector<time_t, Allocator>& occurr
 
 // Struct-Definition bleibt im Header, da sie von anderen Dateien benötigt wird
 struct Event {
-    PsramString summary;
+    const char* summary = "";  // Interniert (IcsStringPool des Parsers), gültig solange der Pool lebt
     PsramString rrule;
     PsramString uid;
     time_t dtstart = 0;
@@ -33,6 +36,187 @@ struct Event {
     time_t duration = 0;
 };
 
+/**
+ * @brief Eine Inhaltszeile einer ICS-Datei als Views in die Eingabe (keine Kopie).
+ *
+ * Parameter beginnen mit dem ';' nach dem Namen. Bei gefalteten Zeilen (RFC 5545 3.1:
+ * Zeilenumbruch gefolgt von Leerzeichen oder Tab) enthalten params und value noch die
+ * Faltungen, IcsTokenizer::unfold() entfernt sie bei Bedarf.
+ */
+struct IcsProperty {
+    const char* name = nullptr;
+    size_t nameLen = 0;
+    const char* params = nullptr;
+    size_t paramsLen = 0;
+    const char* value = nullptr;
+    size_t valueLen = 0;
+    bool folded = false;
+
+    bool is(const char* propertyName) const;           // Name ohne Beachtung der Groß-/Kleinschreibung
+    bool hasParam(const char* token) const;             // z.B. "VALUE=DATE", "TZID="
+};
+
+/**
+ * @brief Tokenizer über einen const char*-Bereich, ein Durchlauf, ohne Kopien.
+ *
+ * next() liefert nur vollständige Zeilen: ein Zeilenumbruch beendet die Zeile erst, wenn das
+ * nächste Zeichen bekannt ist und keine Fortsetzung anzeigt (oder die Eingabe final ist).
+ * consumed() ist damit immer eine Zeilengrenze, der Rest kann mit dem nächsten Chunk erneut
+ * übergeben werden.
+ */
+class IcsTokenizer {
+public:
+    IcsTokenizer(const char* data, size_t len, bool final) : _data(data), _len(len), _final(final) {}
+
+    bool next(IcsProperty& prop);
+    size_t consumed() const { return _pos; }
+
+    // Entfernt die Faltungen aus params und value; die Views zeigen danach in einen internen
+    // Puffer, der bis zum nächsten unfold() gültig ist
+    void unfold(IcsProperty& prop);
+
+    static void splitLine(const char* line, size_t len, IcsProperty& prop);
+    // TEXT-Werte (RFC 5545 3.3.11): \, \; \\ und \n auflösen
+    static void unescapeText(const char* text, size_t len, PsramString& out);
+
+private:
+    const char* _data;
+    size_t _len;
+    bool _final;
+    size_t _pos = 0;
+    PsramString _unfolded;
+};
+
+/**
+ * @brief Pool internierter Strings: gleiche Texte werden nur einmal gespeichert (PSRAM-Blöcke).
+ *
+ * Die Zeiger bleiben bis clear() oder zur Zerstörung des Pools gültig.
+ */
+class IcsStringPool {
+public:
+    IcsStringPool() = default;
+    ~IcsStringPool() { clear(); }
+    IcsStringPool(const IcsStringPool&) = delete;
+    IcsStringPool& operator=(const IcsStringPool&) = delete;
+
+    const char* intern(const char* text, size_t len);
+    void clear();
+    void swap(IcsStringPool& other);
+    size_t size() const { return _count; }
+    size_t bytes() const { return _bytes; }
+
+private:
+    struct Slot {
+        uint32_t hash;
+        const char* text;
+    };
+    PsramVector<char*> _blocks;
+    size_t _blockSize = 0;   // Größe des letzten Blocks
+    size_t _blockUsed = 0;   // Belegte Bytes im letzten Block
+    PsramVector<Slot> _slots;  // Offene Adressierung, Zweierpotenz, wächst bei 3/4 Füllung
+    size_t _count = 0;
+    size_t _bytes = 0;
+
+    void grow();
+};
+
+/**
+ * @brief Jahresdaten für parseICalDateTime: Jahresanfang und DST-Umschaltungen (UTC).
+ *
+ * timegm() zählt die Jahre ab 1970 einzeln durch, isDST() rechnet bei jedem Aufruf beide
+ * Umschaltzeitpunkte neu. Ein Kalender enthält Termine aus wenigen Jahren, deshalb wird pro
+ * Jahr nur einmal gerechnet. Die Ergebnisse sind identisch mit timegm() bzw. converter->isDST().
+ */
+class IcsTimeCache {
+public:
+    // Verwerfen, z.B. wenn sich die Zeitzone geändert haben kann
+    void clear() { _count = 0; _next = 0; _converter = nullptr; }
+
+    // Wie timegm() für die angegebenen Felder (month 1-12)
+    time_t asUtc(int year, int month, int day, int hour, int minute, int second);
+    // Wie converter->isDST(utc)
+    bool isDST(time_t utc, const GeneralTimeConverter* converter);
+
+private:
+    struct Year {
+        int year;
+        time_t start;     // 1. Januar 00:00 UTC
+        time_t end;       // 1. Januar des Folgejahres
+        bool dstKnown;    // Umschaltungen erst beim ersten isDST() berechnet
+        bool hasDst;
+        time_t dstStart;
+        time_t dstEnd;
+    };
+    static const size_t kYears = 8;
+    Year _years[kYears];
+    size_t _count = 0;
+    size_t _next = 0;
+    const GeneralTimeConverter* _converter = nullptr;
+
+    Year& yearInfo(int year);
+};
+
+/**
+ * @brief Baut Events in einem Durchlauf aus den Zeilen des Tokenizers.
+ *
+ * Der Zustand (angefangenes VEVENT, Verschachtelung) bleibt zwischen parse()-Aufrufen erhalten,
+ * ein Download kann also in beliebigen Stücken übergeben werden. Eigenschaften von
+ * Unterkomponenten (VALARM) überschreiben das Event nicht.
+ */
+class IcsEventParser {
+public:
+    IcsEventParser(const GeneralTimeConverter* converter, IcsStringPool* summaries)
+        : _converter(converter), _summaries(summaries) {}
+
+    void reset();
+
+    /**
+     * @brief Vollständige Zeilen verarbeiten, fertige Events anhängen
+     * @param final true beim letzten Aufruf (letzte Zeile ohne Zeilenumbruch)
+     * @return Anzahl verarbeiteter Bytes; der Rest ist eine unvollständige Zeile
+     */
+    size_t parse(const char* data, size_t len, bool final, PsramVector<Event>& events);
+
+private:
+    const GeneralTimeConverter* _converter;
+    IcsStringPool* _summaries;
+    Event _event;
+    bool _inEvent = false;
+    uint8_t _nested = 0;
+    bool _dtstartIsAllDay = false;
+    PsramString _text;  // Puffer für unescapete Texte
+    IcsTimeCache _times;
+
+    void handleProperty(IcsTokenizer& tokenizer, IcsProperty& prop, PsramVector<Event>& events);
+};
+
+/**
+ * @brief Parst einen Download, der in Stücken ankommt (Stream-Consumer des Kalenders).
+ *
+ * Vollständige Zeilen werden direkt im Chunk geparst, kopiert wird nur eine über die Chunkgrenze
+ * reichende Zeile. Die fertigen Events und ihre Texte bleiben bis reset() in events() und
+ * summaries(), der Aufrufer kann sie per swap übernehmen.
+ */
+class IcsStreamParser {
+public:
+    explicit IcsStreamParser(const GeneralTimeConverter* converter) : _parser(converter, &_summaries) {}
+
+    // Events, Texte und angefangene Zeile verwerfen (neuer oder abgebrochener Download)
+    void reset();
+    void feed(const char* data, size_t len);
+    // Letzte Zeile ohne abschließenden Zeilenumbruch parsen, den Zeilenpuffer freigeben
+    void finish();
+
+    PsramVector<Event>& events() { return _events; }
+    IcsStringPool& summaries() { return _summaries; }
+
+private:
+    IcsStringPool _summaries;
+    IcsEventParser _parser;
+    PsramVector<Event> _events;
+    PsramString _carry;
+};
+
 // Die Template-Implementierung muss im Header bleiben.
 template<typename Allocator>
 void parseRRule(const Event& masterEvent, std::vector<time_t, Allocator>& occurrences, int numFutureEventsToFind, const GeneralTimeConverter* converter) {
@@ -667,6 +667,8 @@ void SofaScoreLiveModule::queueData() {
         
         // Register only if URL changed (new day)
         if (dailyUrl != _lastRegisteredDailyUrl) {
+            // Der Plan von gestern wird nicht mehr abgerufen
+            if (!_lastRegisteredDailyUrl.empty()) webClient->unregisterResource(_lastRegisteredDailyUrl.c_str());
             uint32_t fetchInterval = config->dartsSofascoreFetchIntervalMin > 0 ? config->dartsSofascoreFetchIntervalMin : 60;
             // Convert minutes to seconds and use registerResourceSeconds for consistency with live events
             webClient->registerResourceSeconds(dailyUrl.c_str(), fetchInterval * 60, false, false);
@@ -817,6 +819,37 @@ void SofaScoreLiveModule::updateLiveMatchStats() {
     }
 }
 
+void SofaScoreLiveModule::unregisterStatsResources() {
+    // Jede Partie hat eine eigene Statistik-URL (force_new), ohne Abmelden bliebe jede Ressource samt Puffer bestehen
+    for (int eventId : _registeredEventIds) {
+        char statsUrl[128];
+        snprintf(statsUrl, sizeof(statsUrl), "https://api.sofascore.com/api/v1/event/%d/statistics", eventId);
+        webClient->unregisterResource(statsUrl);
+    }
+    _registeredEventIds.clear();
+}
+
+void SofaScoreLiveModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    if (!webClient) return;
+    if (event.isTick()) {
+        // Registrierungen (Tageswechsel, Live-Modus) und verlorene Events holt der Tick nach
+        unsigned long now = millis();
+        if (_lastTickWorkTime != 0 && now - _lastTickWorkTime < TICK_WORK_INTERVAL_MS) return;
+        _lastTickWorkTime = now;
+    } else {
+        // Die Ids ändern sich nur mit der Registrierung, danach genügt der Vergleich
+        uint32_t generation = webClient->getRegistryGeneration();
+        if (generation != _resourceGeneration) {
+            _liveResourceId = webClient->getResourceId("https://api.sofascore.com/api/v1/sport/darts/events/live");
+            _dailyResourceId = _lastRegisteredDailyUrl.empty() ? 0 : webClient->getResourceId(_lastRegisteredDailyUrl.c_str());
+            _resourceGeneration = generation;
+        }
+        if (event.resource_id != _liveResourceId && event.resource_id != _dailyResourceId) return;
+    }
+    queueData();
+    processData();
+}
+
 void SofaScoreLiveModule::processData() {
     LOG_MEM_OP("SofaScore::processData");
     // Process pending live events data FIRST (higher priority)
@@ -1117,7 +1150,7 @@ void SofaScoreLiveModule::parseLiveEventsJson(const char* json, size_t len) {
             webClient->registerResourceSeconds(liveUrl, 60, false, false);
             
             // Clear registered event IDs for statistics
-            _registeredEventIds.clear();
+            unregisterStatsResources();
             
             Log.println("[SofaScore] Live events ended - Resuming daily schedules, switched to 60s polling");
         }
@@ -1270,7 +1303,7 @@ void SofaScoreLiveModule::parseLiveEventsJson(const char* json, size_t len) {
         webClient->registerResourceSeconds(liveUrl, _liveCheckIntervalMs / 1000, false, false);
         
         // Clear registered event IDs
-        _registeredEventIds.clear();
+        unregisterStatsResources();
         
         // Reset mode to DAILY_RESULTS to avoid showing empty live page
         _currentMode = SofaScoreDisplayMode::DAILY_RESULTS;
@@ -12,6 +12,7 @@
 #include "GeneralTimeConverter.hpp"
 
 class WebClientModule;
+struct ResourceUpdateEvent;
 struct DeviceConfig;
 
 // UID für SofaScore Live-Match Interrupts
@@ -109,6 +110,7 @@ public:
                    bool excludeMode = false);
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
 
     // DrawableModule Interface
     const char* getModuleName() const override { return "SofaScoreLiveModule"; }
@@ -164,6 +166,13 @@ private:
     const unsigned long LIVE_DISPLAY_REPEAT_MS = 60000;  // Repeat live display every 60 seconds
     const unsigned long LIVE_MIN_DISPLAY_MS = 20000;  // Minimum 20 seconds display for live stats
     bool _liveEventsRegistered = false;  // Track if live events endpoint is registered to prevent spam
+
+    // Update-Events: nur die eigenen Ressourcen, der Tick für Tageswechsel und Live-Modus genügt alle 10 s
+    uint32_t _liveResourceId = 0;
+    uint32_t _dailyResourceId = 0;
+    uint32_t _resourceGeneration = 0;
+    unsigned long _lastTickWorkTime = 0;
+    const unsigned long TICK_WORK_INTERVAL_MS = 10000;
     
     // Paging
     int _currentPage = 0;
@@ -236,6 +245,7 @@ private:
     void parseLiveEventsJson(const char* json, size_t len);  // NEW: Parse live events endpoint
     void parseMatchStatistics(int eventId, const char* json, size_t len);
     void updateLiveMatchStats();
+    void unregisterStatsResources();  // Statistik-Ressourcen der beendeten Live-Phase freigeben
     void checkAndFetchLiveEvents();  // NEW: Check for live events every minute
     void fetchLiveData();  // NEW: Fetch live events + statistics
     void switchToNextMode();
@@ -21,7 +21,6 @@ TankerkoenigModule::TankerkoenigModule(U8G2_FOR_ADAFRUIT_GFX &u8g2, GFXcanvas16
 
 TankerkoenigModule::~TankerkoenigModule() {
     if (dataMutex) vSemaphoreDelete(dataMutex);
-    if (pending_buffer) free(pending_buffer);
 }
 
 // =================================================================
@@ -134,6 +133,7 @@ void TankerkoenigModule::setConfig(const PsramString& apiKey, const PsramString&
     } else {
         this->resource_url.clear();
     }
+    resource_sub.setUrl(this->resource_url);
 
     updateFailsafeTimeout();
 
@@ -221,28 +221,24 @@ bool TankerkoenigModule::isEnabled() { return _isEnabled; }
 void TankerkoenigModule::queueData() {
     LOG_MEM_OP("Tankerkoenig::queueData");
     if (resource_url.empty() || !webClient) return;
-    webClient->accessResource(String(resource_url.c_str()), [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-        if (buffer && size > 0 && last_update > this->last_processed_update) {
-            if (pending_buffer) free(pending_buffer);
-            pending_buffer = (char*)ps_malloc(size + 1);
-            if (pending_buffer) {
-                memcpy(pending_buffer, buffer, size);
-                pending_buffer[size] = '\0';
-                buffer_size = size;
-                last_processed_update = last_update;
-                data_pending = true;
-            }
-        }
-    });
+    if (webClient->takeNewData(resource_sub, pending_data)) {
+        last_processed_update = pending_data.lastUpdate();
+        data_pending = true;
+    }
+}
+
+void TankerkoenigModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    if (!resource_sub.concerns(event)) return;
+    queueData();
+    processData();
 }
 
 void TankerkoenigModule::processData() {
     LOG_MEM_OP("Tankerkoenig::processData");
     if (data_pending) {
         if (xSemaphoreTake(dataMutex, pdMS_TO_TICKS(5000)) == pdTRUE) {
-            parseAndProcessJson(pending_buffer, buffer_size);
-            free(pending_buffer);
-            pending_buffer = nullptr;
+            parseAndProcessJson(pending_data.data(), pending_data.size());
+            pending_data.reset();
             data_pending = false;
             xSemaphoreGive(dataMutex);
             if (this->updateCallback) this->updateCallback();
@@ -4,10 +4,10 @@
 #include <U8g2_for_Adafruit_GFX.h>
 #include "PsramUtils.hpp"
 #include "DrawableModule.hpp"
+#include "WebClientModule.hpp"
 #include <functional>
 
 class GeneralTimeConverter;
-class WebClientModule;
 struct DeviceConfig;
 
 #define STATION_PRICE_STATS_VERSION 1
@@ -71,6 +71,7 @@ public:
     void setConfig(const PsramString& apiKey, const PsramString& stationIds, int fetchIntervalMinutes, unsigned long pageDisplaySec);
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
     void onUpdate(std::function<void()> callback);
     
     // DrawableModule Interface
@@ -118,8 +119,8 @@ private:
     PsramVector<TrendStatus> _trendStatusCache;
     
     std::function<void()> updateCallback;
-    char* pending_buffer = nullptr;
-    size_t buffer_size = 0;
+    ResourceSubscription resource_sub;
+    ResourceDataRef pending_data;
     time_t last_processed_update = 0;
     bool data_pending = false;
     bool _initialCleanupDone = false;  // Track if cleanup has run after first data fetch
@@ -70,6 +70,7 @@ void ThemeParkModule::setConfig(const DeviceConfig* config) {
     // Parse park IDs from config
     if (xSemaphoreTake(_dataMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
         _parkIds.clear();
+        _resourceGeneration = 0;  // Ressourcen-Ids mit der neuen Parkliste neu ermitteln
         if (!_config->themeParkIds.empty()) {
             PsramString parkIds = _config->themeParkIds;
             size_t pos = 0;
@@ -172,7 +173,7 @@ void ThemeParkModule::queueData() {
         
         // Access the resource - this will use cached data if still fresh,
         // or trigger a new fetch if the update interval has passed
-        _webClient->accessResource(String(waitTimesUrl.c_str()), String(waitTimesHeaders.c_str()),
+        _webClient->accessResource(waitTimesUrl.c_str(), waitTimesHeaders.c_str(),
             [this, parkId](const char* buffer, size_t size, time_t last_update, bool is_stale) {
                 if (buffer && size > 0) {
                     // Only process if this is new data (not already processed)
@@ -216,7 +217,7 @@ void ThemeParkModule::queueData() {
         PsramString openingTimesUrl = "https://api.wartezeiten.app/v1/openingtimes";
         PsramString openingTimesHeaders = "accept: application/json\npark: " + parkId;
         
-        _webClient->accessResource(String(openingTimesUrl.c_str()), String(openingTimesHeaders.c_str()),
+        _webClient->accessResource(openingTimesUrl.c_str(), openingTimesHeaders.c_str(),
             [this, parkId](const char* buffer, size_t size, time_t last_update, bool is_stale) {
                 if (buffer && size > 0) {
                     // Only process if this is new data (not already processed)
@@ -259,7 +260,7 @@ void ThemeParkModule::queueData() {
         PsramString crowdLevelUrl = "https://api.wartezeiten.app/v1/crowdlevel";
         PsramString crowdLevelHeaders = "accept: application/json\npark: " + parkId + "\nlanguage: de";
         
-        _webClient->accessResource(String(crowdLevelUrl.c_str()), String(crowdLevelHeaders.c_str()),
+        _webClient->accessResource(crowdLevelUrl.c_str(), crowdLevelHeaders.c_str(),
             [this, parkId](const char* buffer, size_t size, time_t last_update, bool is_stale) {
                 if (buffer && size > 0) {
                     // Only process if this is new data (not already processed)
@@ -300,6 +301,43 @@ void ThemeParkModule::queueData() {
     }
 }
 
+void ThemeParkModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    if (!_webClient) return;
+    if (event.isTick()) {
+        unsigned long now = millis();
+        if (_lastTickWorkTime != 0 && now - _lastTickWorkTime < TICK_WORK_INTERVAL_MS) return;
+        _lastTickWorkTime = now;
+    } else if (!concernsParks(event)) {
+        return;
+    }
+    // Wartezeiten werden in den accessResource()-Callbacks verarbeitet
+    queueData();
+    processData();
+}
+
+bool ThemeParkModule::concernsParks(const ResourceUpdateEvent& event) {
+    // Die Ids ändern sich nur mit der Registrierung, danach genügt der Vergleich
+    uint32_t generation = _webClient->getRegistryGeneration();
+    if (generation != _resourceGeneration) {
+        PsramVector<PsramString> parkIdsCopy;
+        if (xSemaphoreTake(_dataMutex, pdMS_TO_TICKS(50)) != pdTRUE) return true;
+        parkIdsCopy = _parkIds;
+        xSemaphoreGive(_dataMutex);
+
+        _resourceIds.clear();
+        for (const auto& parkId : parkIdsCopy) {
+            PsramString waitTimesHeaders = "accept: application/json\npark: " + parkId + "\nlanguage: de";
+            PsramString openingTimesHeaders = "accept: application/json\npark: " + parkId;
+            PsramString crowdLevelHeaders = "accept: application/json\npark: " + parkId + "\nlanguage: de";
+            _resourceIds.push_back(_webClient->getResourceId("https://api.wartezeiten.app/v1/waitingtimes", waitTimesHeaders.c_str()));
+            _resourceIds.push_back(_webClient->getResourceId("https://api.wartezeiten.app/v1/openingtimes", openingTimesHeaders.c_str()));
+            _resourceIds.push_back(_webClient->getResourceId("https://api.wartezeiten.app/v1/crowdlevel", crowdLevelHeaders.c_str()));
+        }
+        _resourceGeneration = generation;
+    }
+    return std::find(_resourceIds.begin(), _resourceIds.end(), event.resource_id) != _resourceIds.end();
+}
+
 void ThemeParkModule::processData() {
     LOG_MEM_OP("ThemeParkModule::processData");
     // Data processing is now handled directly in queueData() callback
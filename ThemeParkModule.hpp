@@ -8,6 +8,7 @@
 #include "PixelScroller.hpp"
 
 class WebClientModule;
+struct ResourceUpdateEvent;
 struct DeviceConfig;
 
 struct Attraction {
@@ -54,6 +55,7 @@ public:
     void setConfig(const DeviceConfig* config);
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
     void onUpdate(std::function<void()> callback);
     
     // DrawableModule Interface
@@ -111,6 +113,13 @@ private:
     time_t _lastParksListUpdate;  // Track when parks list was last updated
     time_t _lastParkDetailsUpdate;  // Track when park details (name, hours) were updated
     std::function<void()> _updateCallback;
+
+    // Update-Events: nur die Ressourcen der Parks, der Tick (Parkliste, verlorene Events) genügt jede Minute
+    PsramVector<uint32_t> _resourceIds;
+    uint32_t _resourceGeneration = 0;
+    unsigned long _lastTickWorkTime = 0;
+    const unsigned long TICK_WORK_INTERVAL_MS = 60000;
+    bool concernsParks(const ResourceUpdateEvent& event);
     
     // PixelScroller für pixelweises Scrolling
     PixelScroller* _parkNameScroller = nullptr;  // Scroller für Parknamen
@@ -102,8 +102,6 @@ WeatherModule::WeatherModule(U8G2_FOR_ADAFRUIT_GFX& u8g2, GFXcanvas16& canvas, c
 
 WeatherModule::~WeatherModule() {
     if (_dataMutex) vSemaphoreDelete(_dataMutex);
-    if (_pendingForecastBuffer) free(_pendingForecastBuffer);
-    if (_pendingClimateBuffer) free(_pendingClimateBuffer);
 }
 
 void WeatherModule::begin() {
@@ -163,51 +161,37 @@ void WeatherModule::queueData() {
         }
     }
     
-    _webClient->accessResource(String(_forecastApiUrl.c_str()), [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-        if (xSemaphoreTake(_dataMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            if (buffer && size > 0 && last_update > this->_lastForecastUpdate) {
-                if (_pendingForecastBuffer) free(_pendingForecastBuffer);
-                _pendingForecastBuffer = (char*)ps_malloc(size + 1);
-                if (_pendingForecastBuffer) {
-                    memcpy(_pendingForecastBuffer, buffer, size);
-                    _pendingForecastBuffer[size] = '\0';
-                    _forecastBufferSize = size;
-                    _lastForecastUpdate = last_update;
-                    _forecastDataPending = true;
-                }
-            }
-            xSemaphoreGive(_dataMutex);
+    // Die Subscription merkt sich Version und Ressource, neue URLs (Tageswechsel) setzen sie zurück
+    _forecastSub.setUrl(_forecastApiUrl);
+    _climateSub.setUrl(_climateApiUrl);
+
+    if (xSemaphoreTake(_dataMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
+        if (_webClient->takeNewData(_forecastSub, _pendingForecast)) {
+            _lastForecastUpdate = _pendingForecast.lastUpdate();
+            _forecastDataPending = true;
         }
-    });
-    
-    if (now_utc - _lastClimateUpdate > (60 * 60 * 24)) {
-        _webClient->accessResource(String(_climateApiUrl.c_str()), [this](const char* buffer, size_t size, time_t last_update, bool is_stale) {
-            if (xSemaphoreTake(_dataMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                if (buffer && size > 0 && last_update > this->_lastClimateUpdate) {
-                    if (_pendingClimateBuffer) free(_pendingClimateBuffer);
-                    _pendingClimateBuffer = (char*)ps_malloc(size + 1);
-                    if (_pendingClimateBuffer) {
-                        memcpy(_pendingClimateBuffer, buffer, size);
-                        _pendingClimateBuffer[size] = '\0';
-                        _climateBufferSize = size;
-                        _lastClimateUpdate = last_update;
-                        _climateDataPending = true;
-                    }
-                }
-                xSemaphoreGive(_dataMutex);
-            }
-        });
+        if (now_utc - _lastClimateUpdate > (60 * 60 * 24) && _webClient->takeNewData(_climateSub, _pendingClimate)) {
+            _lastClimateUpdate = _pendingClimate.lastUpdate();
+            _climateDataPending = true;
+        }
+        xSemaphoreGive(_dataMutex);
     }
 }
 
+void WeatherModule::onResourceUpdate(const ResourceUpdateEvent& event) {
+    // Der Tick deckt auch den Neuaufbau der URLs beim Tageswechsel ab
+    if (!(_forecastSub.concerns(event) || _climateSub.concerns(event))) return;
+    queueData();
+    processData();
+}
+
 void WeatherModule::processData() {
     LOG_MEM_OP("WeatherModule::processData");
     bool something_processed = false;
     if (_forecastDataPending) {
         if (xSemaphoreTake(_dataMutex, portMAX_DELAY) == pdTRUE) {
-            parseForecastData(_pendingForecastBuffer, _forecastBufferSize);
-            free(_pendingForecastBuffer);
-            _pendingForecastBuffer = nullptr;
+            parseForecastData(_pendingForecast.data(), _pendingForecast.size());
+            _pendingForecast.reset();
             _forecastDataPending = false;
             something_processed = true;
             xSemaphoreGive(_dataMutex);
@@ -215,9 +199,8 @@ void WeatherModule::processData() {
     }
     if (_climateDataPending) {
         if (xSemaphoreTake(_dataMutex, portMAX_DELAY) == pdTRUE) {
-            parseClimateData(_pendingClimateBuffer, _climateBufferSize);
-            free(_pendingClimateBuffer);
-            _pendingClimateBuffer = nullptr;
+            parseClimateData(_pendingClimate.data(), _pendingClimate.size());
+            _pendingClimate.reset();
             _climateDataPending = false;
             something_processed = true;
             xSemaphoreGive(_dataMutex);
@@ -374,11 +357,11 @@ void WeatherModule::buildApiUrls() {
     _lastUrlBuildTime = now_utc;
 }
 
-void WeatherModule::parseForecastData(char* jsonBuffer, size_t size) {
+void WeatherModule::parseForecastData(const char* jsonBuffer, size_t size) {
     using namespace ArduinoJson;
     SpiRamAllocator allocator;
     JsonDocument doc(&allocator);
-    DeserializationError error = deserializeJson(doc, jsonBuffer);
+    DeserializationError error = deserializeJson(doc, jsonBuffer, size);
     if (error) { return; }
 
     JsonObject current = doc["current"];
@@ -496,11 +479,11 @@ void WeatherModule::parseForecastData(char* jsonBuffer, size_t size) {
     buildPages();
 }
 
-void WeatherModule::parseClimateData(char* jsonBuffer, size_t size) {
+void WeatherModule::parseClimateData(const char* jsonBuffer, size_t size) {
     using namespace ArduinoJson;
     SpiRamAllocator allocator;
     JsonDocument doc(&allocator);
-    DeserializationError error = deserializeJson(doc, jsonBuffer);
+    DeserializationError error = deserializeJson(doc, jsonBuffer, size);
     if (error) { return; }
     JsonArray daily_temps = doc["daily"]["temperature_2m_mean"];
     if (daily_temps.size() > 0) {
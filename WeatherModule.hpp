@@ -4,12 +4,12 @@
 #include <U8g2_for_Adafruit_GFX.h>
 #include "PsramUtils.hpp"
 #include "GeneralTimeConverter.hpp"
+#include "WebClientModule.hpp"
 #include "WeatherIcons_Main.hpp"
 #include "WeatherIcons_Special.hpp"
 #include "WeatherIconCache.hpp" // NEU: für globalWeatherIconCache
 #include <set>
 
-class WebClientModule;
 struct DeviceConfig;
 
 struct WeatherCurrentData {
@@ -73,6 +73,7 @@ public:
     void setConfig(const DeviceConfig* config);
     void queueData();
     void processData();
+    void onResourceUpdate(const ResourceUpdateEvent& event);
     void periodicTick();
 
 private:
@@ -87,12 +88,12 @@ private:
     PsramString _forecastApiUrl;
     PsramString _climateApiUrl;
 
-    char* _pendingForecastBuffer = nullptr;
-    size_t _forecastBufferSize = 0;
+    ResourceSubscription _forecastSub;
+    ResourceDataRef _pendingForecast;
     bool _forecastDataPending = false;
     
-    char* _pendingClimateBuffer = nullptr;
-    size_t _climateBufferSize = 0;
+    ResourceSubscription _climateSub;
+    ResourceDataRef _pendingClimate;
     bool _climateDataPending = false;
     
     float _historicalMonthlyAvgTemp = 10.0;
@@ -121,8 +122,8 @@ private:
     std::set<PsramString, std::less<PsramString>, PsramAllocator<PsramString>> _loggedMissingIcons;
 
     void buildApiUrls();
-    void parseForecastData(char* jsonBuffer, size_t size);
-    void parseClimateData(char* jsonBuffer, size_t size);
+    void parseForecastData(const char* jsonBuffer, size_t size);
+    void parseClimateData(const char* jsonBuffer, size_t size);
 
     uint16_t getClimateColorSmooth(float temp);
     PsramString mapWeatherCodeToIcon(int code, bool is_day);
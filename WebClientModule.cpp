@@ -9,6 +9,9 @@
 #include <WiFi.h>
 #include <LittleFS.h>
 #include <esp_heap_caps.h>
+#include <esp_system.h> // für esp_random()
+#include "rom/miniz.h"
+#include <algorithm>
 
 // MODIFIKATION: Flag zum Deaktivieren der Datenübergabe an Module (für Test der Fragmentierung)
 static bool disableModuleDataAccess = false; // Setze auf true, um Module "keine Daten" denken zu lassen
@@ -36,164 +39,867 @@ static PsramString findCertFilenameForHost(const PsramString& hostWithOptionalPo
     return PsramString(); // not found
 }
 
+// --- Helper: host part of a URL without scheme, port and path (points into url, no copy) ---
+static const char* hostSpan(const char* url, size_t& length) {
+    const char* scheme = strstr(url, "://");
+    const char* host = scheme ? scheme + 3 : url;
+    length = strcspn(host, "/:");
+    return host;
+}
+
+static PsramString hostFromUrl(const PsramString& url) {
+    size_t length = 0;
+    const char* host = hostSpan(url.c_str(), length);
+    return PsramString(host, length);
+}
+
+// --- Helper: 64-bit FNV-1a, resource keys hash url and headers separated by a 0 byte ---
+static uint64_t fnv1a64(const char* text, uint64_t hash = 14695981039346656037ULL) {
+    while (*text) {
+        hash ^= (uint8_t)*text++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t resourceKey(const char* url, const char* headers) {
+    uint64_t hash = fnv1a64(url);
+    hash *= 1099511628211ULL;  // separator (xor with 0)
+    return fnv1a64(headers, hash);
+}
+
+// Same hash over binary data (content hash of bodies for the flash cache)
+static uint64_t fnv1a64Data(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// --- Helper: host, port and scheme of a URL ---
+static RequestTarget parseTarget(const PsramString& url) {
+    RequestTarget target;
+    target.https = (url.rfind("https://", 0) == 0);
+    target.port = target.https ? 443 : 80;
+    int hostStart = indexOf(url, "://");
+    if (hostStart != -1) hostStart += 3; else hostStart = 0;
+    int pathStart = indexOf(url, "/", hostStart);
+    target.host = (pathStart != -1) ? url.substr(hostStart, pathStart - hostStart) : url.substr(hostStart);
+    // if host contains ":port", try to parse (simple)
+    int colonPos = indexOf(target.host, ":");
+    if (colonPos != -1) {
+        PsramString portStr = target.host.substr(colonPos + 1);
+        target.port = (uint16_t)atoi(portStr.c_str());
+        target.host = target.host.substr(0, colonPos);
+    }
+    return target;
+}
+
+// --- Helper: add custom request headers (format: "Header1: Value1\nHeader2: Value2") ---
+static void addCustomHeaders(HTTPClient& http, const PsramString& headers) {
+    size_t pos = 0;
+    while (pos < headers.length()) {
+        size_t newlinePos = headers.find('\n', pos);
+        if (newlinePos == PsramString::npos) newlinePos = headers.length();
+        
+        PsramString headerLine = headers.substr(pos, newlinePos - pos);
+        size_t colonPos = headerLine.find(':');
+        if (colonPos != PsramString::npos) {
+            PsramString name = headerLine.substr(0, colonPos);
+            PsramString value = headerLine.substr(colonPos + 1);
+            // Trim leading/trailing whitespace from value
+            while (!value.empty() && (value[0] == ' ' || value[0] == '\t')) {
+                value = value.substr(1);
+            }
+            while (!value.empty() && (value[value.length()-1] == ' ' || value[value.length()-1] == '\t' || value[value.length()-1] == '\r')) {
+                value = value.substr(0, value.length()-1);
+            }
+            http.addHeader(name.c_str(), value.c_str());
+            Log.printf("[WebDataManager] Added header: %s: %s\n", name.c_str(), value.c_str());
+        }
+        pos = newlinePos + 1;
+    }
+}
+
+// Helper function to safely calculate elapsed time in milliseconds, handling millis() rollover
+static inline unsigned long millisElapsed(unsigned long start, unsigned long now) {
+    // This handles rollover correctly because unsigned arithmetic wraps around
+    return now - start;
+}
+
 // --- PsramBufferStream Implementierung ---
 
 PsramBufferStream::PsramBufferStream() = default;
 
-void PsramBufferStream::begin(char* buffer, size_t capacity) {
-    _buffer = buffer;
-    _capacity = capacity;
-    reset();
+PsramBufferStream::~PsramBufferStream() {
+    trim(0);
+}
+
+bool PsramBufferStream::reserve(size_t capacity) {
+    while (getCapacity() < capacity) {
+        char* segment = (char*)ps_malloc(WEBCLIENT_SEGMENT_SIZE);
+        if (!segment) return false;
+        _segments.push_back(segment);
+    }
+    return true;
 }
 
 void PsramBufferStream::reset() {
     _position = 0;
     _overflowed = false;
+    _growths = 0;
 }
 
-size_t PsramBufferStream::write(uint8_t data) {
-    if (_overflowed || !_buffer) return 0;
-    if (_position >= _capacity) {
-        _overflowed = true;
-        return 0;
+void PsramBufferStream::trim(size_t keepCapacity) {
+    reset();
+    size_t keep = (keepCapacity + WEBCLIENT_SEGMENT_SIZE - 1) / WEBCLIENT_SEGMENT_SIZE;
+    while (_segments.size() > keep) {
+        free(_segments.back());
+        _segments.pop_back();
     }
-    _buffer[_position++] = data;
-    return 1;
+}
+
+size_t PsramBufferStream::write(uint8_t data) {
+    return write(&data, 1);
 }
 
 size_t PsramBufferStream::write(const uint8_t *buffer, size_t size) {
-    if (_overflowed || !_buffer) return 0;
-    size_t bytes_to_write = size;
-    if (_position + size > _capacity) {
-        _overflowed = true;
-        bytes_to_write = (_capacity > _position) ? _capacity - _position : 0;
-        Log.printf("[PsramBufferStream] WARNUNG: Pufferüberlauf! Schreibe nur die letzten %u von %u Bytes.\n", bytes_to_write, size);
-    }
-    if (bytes_to_write > 0) {
-        const size_t chunkSize = 4096;
-        size_t bytesCopied = 0;
-        while(bytesCopied < bytes_to_write) {
-            size_t currentChunkSize = bytes_to_write - bytesCopied;
-            if (currentChunkSize > chunkSize) currentChunkSize = chunkSize;
-            memcpy(_buffer + _position + bytesCopied, buffer + bytesCopied, currentChunkSize);
-            bytesCopied += currentChunkSize;
-            vTaskDelay(1); 
+    if (_overflowed) return 0;
+    size_t bytesCopied = 0;
+    while (bytesCopied < size) {
+        size_t segmentIndex = _position / WEBCLIENT_SEGMENT_SIZE;
+        size_t offset = _position % WEBCLIENT_SEGMENT_SIZE;
+        if (segmentIndex >= _segments.size()) {
+            // Next segment; the segments already filled stay where they are
+            char* segment = (_position < WEBCLIENT_MAX_BODY_KB * 1024UL) ? (char*)ps_malloc(WEBCLIENT_SEGMENT_SIZE) : nullptr;
+            if (!segment) {
+                _overflowed = true;
+                Log.printf("[PsramBufferStream] WARNUNG: Puffer kann nicht über %u Bytes wachsen (Limit %u KB).\n", (unsigned)_position, (unsigned)WEBCLIENT_MAX_BODY_KB);
+                return bytesCopied;
+            }
+            _segments.push_back(segment);
+            if (_growths < 255) _growths++;
         }
-        _position += bytes_to_write;
+        // Copy in small steps, the other tasks get a turn in between
+        size_t chunk = min((size_t)4096, min(size - bytesCopied, (size_t)WEBCLIENT_SEGMENT_SIZE - offset));
+        memcpy(_segments[segmentIndex] + offset, buffer + bytesCopied, chunk);
+        bytesCopied += chunk;
+        _position += chunk;
+        vTaskDelay(1);
     }
-    return bytes_to_write;
+    return bytesCopied;
 }
 
 bool PsramBufferStream::hasOverflowed() const { return _overflowed; }
-size_t PsramBufferStream::getCapacity() const { return _capacity; }
+size_t PsramBufferStream::getCapacity() const { return _segments.size() * WEBCLIENT_SEGMENT_SIZE; }
 int PsramBufferStream::available() { return 0; }
 int PsramBufferStream::read() { return -1; }
 int PsramBufferStream::peek() { return -1; }
 void PsramBufferStream::flush() {}
-char* PsramBufferStream::getBuffer() { return _buffer; }
 size_t PsramBufferStream::getSize() { return _position; }
 
+uint8_t PsramBufferStream::growthCount() const { return _growths; }
+
+size_t PsramBufferStream::segmentCount() const {
+    return (_position + WEBCLIENT_SEGMENT_SIZE - 1) / WEBCLIENT_SEGMENT_SIZE;
+}
+
+const char* PsramBufferStream::segment(size_t index, size_t& length) const {
+    size_t start = index * WEBCLIENT_SEGMENT_SIZE;
+    length = (start < _position) ? min((size_t)WEBCLIENT_SEGMENT_SIZE, _position - start) : 0;
+    return length ? _segments[index] : nullptr;
+}
+
+void PsramBufferStream::copyTo(char* dest) const {
+    for (size_t i = 0; i < segmentCount(); i++) {
+        size_t length;
+        const char* data = segment(i, length);
+        memcpy(dest, data, length);
+        dest += length;
+    }
+}
+
+
+// --- Telemetry ---
+
+const uint16_t LatencyHistogram::bucketLimitsMs[WEBCLIENT_HISTOGRAM_BUCKETS - 1] = { 10, 25, 50, 100, 250, 500, 1000, 2500, 5000 };
+
+void LatencyHistogram::add(uint32_t ms) {
+    uint8_t bucket = 0;
+    while (bucket < WEBCLIENT_HISTOGRAM_BUCKETS - 1 && ms > bucketLimitsMs[bucket]) bucket++;
+    counts[bucket]++;
+    total_ms += ms;
+    if (ms > max_ms) max_ms = ms;
+}
+
+uint32_t LatencyHistogram::samples() const {
+    uint32_t total = 0;
+    for (uint32_t count : counts) total += count;
+    return total;
+}
+
+void FetchTelemetry::add(const FetchSample& sample) {
+    fetches++;
+    for (uint8_t phase = 0; phase < FETCH_PHASE_COUNT; phase++) {
+        if (sample.phase_ms[phase] >= 0) phases[phase].add(sample.phase_ms[phase]);
+    }
+    wire_bytes += sample.wire_bytes;
+    body_bytes += sample.body_bytes;
+    int status_class = (sample.http_code >= 100 && sample.http_code < 600) ? sample.http_code / 100 : 0;
+    status_classes[status_class]++;
+    retries += sample.retries;
+    buffer_growths += sample.buffer_growths;
+}
+
+const char* FetchTelemetry::phaseName(FetchPhase phase) {
+    switch (phase) {
+        case FETCH_PHASE_DNS: return "dns";
+        case FETCH_PHASE_CONNECT: return "connect";
+        case FETCH_PHASE_TLS: return "tls";
+        case FETCH_PHASE_TTFB: return "ttfb";
+        case FETCH_PHASE_BODY: return "body";
+        default: return "?";
+    }
+}
+
+
+// --- ResourceData Implementierung ---
+
+ResourceData* ResourceData::create(size_t size, uint32_t version, time_t lastUpdate) {
+    void* mem = ps_malloc(sizeof(ResourceData) + size + 1);
+    if (!mem) return nullptr;
+    ResourceData* block = new (mem) ResourceData();
+    block->refs.store(1);
+    block->version = version;
+    block->last_update = lastUpdate;
+    block->size = size;
+    block->data()[size] = '\0';
+    return block;
+}
+
+void ResourceData::retain() {
+    refs.fetch_add(1);
+}
+
+void ResourceData::release() {
+    if (refs.fetch_sub(1) == 1) {
+        this->~ResourceData();
+        free(this);
+    }
+}
+
+ResourceDataRef::ResourceDataRef(ResourceData* data) : _data(data) {
+    if (_data) _data->retain();
+}
+
+ResourceDataRef::ResourceDataRef(const ResourceDataRef& other) : _data(other._data) {
+    if (_data) _data->retain();
+}
+
+ResourceDataRef::ResourceDataRef(ResourceDataRef&& other) noexcept : _data(other._data) {
+    other._data = nullptr;
+}
+
+ResourceDataRef& ResourceDataRef::operator=(const ResourceDataRef& other) {
+    if (this != &other) {
+        if (other._data) other._data->retain();
+        reset();
+        _data = other._data;
+    }
+    return *this;
+}
+
+ResourceDataRef& ResourceDataRef::operator=(ResourceDataRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        _data = other._data;
+        other._data = nullptr;
+    }
+    return *this;
+}
+
+ResourceDataRef::~ResourceDataRef() {
+    reset();
+}
+
+void ResourceDataRef::reset() {
+    if (_data) {
+        _data->release();
+        _data = nullptr;
+    }
+}
+
+
+// --- ConsumerStream Implementierung ---
+
+ConsumerStream::ConsumerStream(ResourceStreamConsumer* consumer) : _consumer(consumer) {}
+
+size_t ConsumerStream::write(uint8_t data) { return write(&data, 1); }
+
+size_t ConsumerStream::write(const uint8_t *buffer, size_t size) {
+    if (_aborted) return 0;
+    if (!_consumer->onStreamChunk((const char*)buffer, size)) {
+        _aborted = true;
+        return 0;
+    }
+    _total += size;
+    return size;
+}
+
+int ConsumerStream::available() { return 0; }
+int ConsumerStream::read() { return -1; }
+int ConsumerStream::peek() { return -1; }
+void ConsumerStream::flush() {}
+bool ConsumerStream::aborted() const { return _aborted; }
+size_t ConsumerStream::total() const { return _total; }
+
+
+
+// --- InflateStream Implementierung ---
+
+// gzip header flags (RFC 1952)
+#define GZIP_FLAG_HCRC 0x02
+#define GZIP_FLAG_EXTRA 0x04
+#define GZIP_FLAG_NAME 0x08
+#define GZIP_FLAG_COMMENT 0x10
+
+InflateStream::InflateStream(Stream* target, Encoding encoding)
+    : _target(target), _encoding(encoding), _state(encoding == ENCODING_GZIP ? STATE_GZIP_HEADER : STATE_ZLIB_PROBE) {
+    // The decompressor is touched for every input byte: internal RAM if there is room
+    _decompressor = (tinfl_decompressor_tag*)heap_caps_malloc(sizeof(tinfl_decompressor), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!_decompressor) _decompressor = (tinfl_decompressor_tag*)ps_malloc(sizeof(tinfl_decompressor));
+    _window = (uint8_t*)ps_malloc(TINFL_LZ_DICT_SIZE);
+    if (!_decompressor || !_window) {
+        Log.println("[WebDataManager] FEHLER: Kein Speicher zum Entpacken der Antwort.");
+        _state = STATE_FAILED;
+        return;
+    }
+    tinfl_init((tinfl_decompressor*)_decompressor);
+    // Raw deflate for gzip; the zlib probe adds TINFL_FLAG_PARSE_ZLIB_HEADER when it sees one
+    _flags = TINFL_FLAG_HAS_MORE_INPUT;
+}
+
+InflateStream::~InflateStream() {
+    if (_decompressor) free(_decompressor);
+    if (_window) free(_window);
+}
+
+size_t InflateStream::write(uint8_t data) { return write(&data, 1); }
+
+size_t InflateStream::write(const uint8_t *buffer, size_t size) {
+    if (_state == STATE_FAILED) return 0;
+    _compressed += size;
+    if (_encoding == ENCODING_GZIP) updateTail(buffer, size);
+    size_t pos = 0;
+    if (_state != STATE_BODY && _state != STATE_DONE) {
+        pos = consumeHeader(buffer, size);
+        if (_state == STATE_FAILED) return 0;
+    }
+    if (_state == STATE_BODY && pos < size && !inflateBody(buffer + pos, size - pos)) return 0;
+    if (_state == STATE_DONE && _encoding == ENCODING_GZIP) _trailerOk = checkGzipTrailer();
+    return size;
+}
+
+void InflateStream::updateTail(const uint8_t* data, size_t size) {
+    // tinfl may read a few bytes past the last deflate block, so the trailer is taken from the
+    // end of the input instead of from where the deflate data ended
+    if (size >= sizeof(_tail)) {
+        memcpy(_tail, data + size - sizeof(_tail), sizeof(_tail));
+        return;
+    }
+    memmove(_tail, _tail + size, sizeof(_tail) - size);
+    memcpy(_tail + sizeof(_tail) - size, data, size);
+}
+
+bool InflateStream::checkGzipTrailer() const {
+    // 10 header bytes, at least one deflate byte and the trailer must have arrived
+    if (_compressed < 10 + 1 + sizeof(_tail)) return false;
+    uint32_t crc = _tail[0] | (_tail[1] << 8) | (_tail[2] << 16) | ((uint32_t)_tail[3] << 24);
+    uint32_t isize = _tail[4] | (_tail[5] << 8) | (_tail[6] << 16) | ((uint32_t)_tail[7] << 24);
+    return crc == _crc && isize == (uint32_t)_inflated;
+}
+
+size_t InflateStream::consumeHeader(const uint8_t* data, size_t size) {
+    // Next optional gzip header field still to be skipped
+    auto nextGzipState = [this]() {
+        if (_gzipFlags & GZIP_FLAG_EXTRA) return STATE_GZIP_EXTRA_LEN;
+        if (_gzipFlags & GZIP_FLAG_NAME) return STATE_GZIP_NAME;
+        if (_gzipFlags & GZIP_FLAG_COMMENT) return STATE_GZIP_COMMENT;
+        if (_gzipFlags & GZIP_FLAG_HCRC) return STATE_GZIP_HCRC;
+        return STATE_BODY;
+    };
+
+    size_t pos = 0;
+    while (pos < size && _state != STATE_BODY && _state != STATE_DONE && _state != STATE_FAILED) {
+        uint8_t c = data[pos++];
+        switch (_state) {
+            case STATE_GZIP_HEADER:
+                _header[_headerLen++] = c;
+                if (_headerLen < 10) break;
+                // Magic bytes and method 8 (deflate)
+                if (_header[0] != 0x1F || _header[1] != 0x8B || _header[2] != 8) {
+                    _state = STATE_FAILED;
+                    break;
+                }
+                _gzipFlags = _header[3];
+                _headerLen = 0;
+                _state = nextGzipState();
+                break;
+            case STATE_GZIP_EXTRA_LEN:
+                _header[_headerLen++] = c;
+                if (_headerLen < 2) break;
+                _extraRemaining = _header[0] | (_header[1] << 8);
+                _headerLen = 0;
+                _gzipFlags &= ~GZIP_FLAG_EXTRA;
+                _state = _extraRemaining ? STATE_GZIP_EXTRA : nextGzipState();
+                break;
+            case STATE_GZIP_EXTRA:
+                if (--_extraRemaining == 0) _state = nextGzipState();
+                break;
+            case STATE_GZIP_NAME:
+            case STATE_GZIP_COMMENT:
+                // Zero-terminated strings
+                if (c == 0) {
+                    _gzipFlags &= (_state == STATE_GZIP_NAME) ? ~GZIP_FLAG_NAME : ~GZIP_FLAG_COMMENT;
+                    _state = nextGzipState();
+                }
+                break;
+            case STATE_GZIP_HCRC:
+                if (++_headerLen < 2) break;
+                _headerLen = 0;
+                _gzipFlags &= ~GZIP_FLAG_HCRC;
+                _state = STATE_BODY;
+                break;
+            case STATE_ZLIB_PROBE: {
+                _header[_headerLen++] = c;
+                if (_headerLen < 2) break;
+                // CMF/FLG of a zlib stream: method 8 and a header checksum divisible by 31
+                bool zlib = (_header[0] & 0x0F) == 8 && ((_header[0] << 8) | _header[1]) % 31 == 0;
+                if (zlib) _flags |= TINFL_FLAG_PARSE_ZLIB_HEADER;
+                _state = STATE_BODY;
+                // The probed bytes belong to the stream in both cases
+                if (!inflateBody(_header, 2)) return pos;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return pos;
+}
+
+bool InflateStream::inflateBody(const uint8_t* data, size_t size) {
+    tinfl_decompressor* decompressor = (tinfl_decompressor*)_decompressor;
+    size_t consumed = 0;
+    for (;;) {
+        size_t inSize = size - consumed;
+        // The output wraps around in the 32 KB window, which is at the same time the history deflate refers back to
+        size_t outSize = TINFL_LZ_DICT_SIZE - _windowPos;
+        tinfl_status status = tinfl_decompress(decompressor, data + consumed, &inSize, _window, _window + _windowPos, &outSize, _flags);
+        consumed += inSize;
+        if (outSize > 0) {
+            if (_target->write(_window + _windowPos, outSize) != outSize) {
+                _state = STATE_FAILED;
+                return false;
+            }
+            if (_encoding == ENCODING_GZIP) _crc = (uint32_t)mz_crc32(_crc, _window + _windowPos, outSize);
+            _inflated += outSize;
+            _windowPos = (_windowPos + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+        if (status == TINFL_STATUS_DONE) {
+            _state = STATE_DONE;
+            return true;
+        }
+        if (status < TINFL_STATUS_DONE) {
+            Log.printf("[WebDataManager] FEHLER: %s-Daten fehlerhaft (Status %d nach %u Bytes).\n", encodingName(), (int)status, (unsigned)_compressed);
+            _state = STATE_FAILED;
+            return false;
+        }
+        // TINFL_STATUS_NEEDS_MORE_INPUT: all input consumed, the rest arrives with the next write
+        if (status != TINFL_STATUS_HAS_MORE_OUTPUT) return true;
+    }
+}
+
+int InflateStream::available() { return 0; }
+int InflateStream::read() { return -1; }
+int InflateStream::peek() { return -1; }
+void InflateStream::flush() {}
+bool InflateStream::failed() const { return _state == STATE_FAILED; }
+bool InflateStream::complete() const { return _state == STATE_DONE && (_encoding != ENCODING_GZIP || _trailerOk); }
+size_t InflateStream::compressedBytes() const { return _compressed; }
+size_t InflateStream::inflatedBytes() const { return _inflated; }
+const char* InflateStream::encodingName() const { return _encoding == ENCODING_GZIP ? "gzip" : "deflate"; }
+
+bool InflateStream::fromHeader(const String& contentEncoding, Encoding& encoding) {
+    if (contentEncoding.equalsIgnoreCase("gzip") || contentEncoding.equalsIgnoreCase("x-gzip")) {
+        encoding = ENCODING_GZIP;
+        return true;
+    }
+    if (contentEncoding.equalsIgnoreCase("deflate")) {
+        encoding = ENCODING_DEFLATE;
+        return true;
+    }
+    return false;
+}
+
+// Response headers the HTTPClient has to keep for us (validators for conditional GET, body coding)
+static const char* RESOURCE_RESPONSE_HEADERS[] = { "ETag", "Last-Modified", "Content-Encoding" };
+// Accept-Encoding the HTTPClient sends by default (pooled clients are shared with jobs)
+static const char* HTTP_IDENTITY_ENCODING = "identity;q=1,chunked;q=0.1,*;q=0";
+
+// True if the response body has a content coding that has to be undone
+static bool hasContentCoding(HTTPClient& http) {
+    String coding = http.header("Content-Encoding");
+    coding.trim();
+    return coding.length() > 0 && !coding.equalsIgnoreCase("identity");
+}
+
+// Writes the response body to target, inflating it on the way if it came gzip or deflate coded.
+// wireBytes receives the number of body bytes received, error a message if false is returned.
+static bool writeResponseBody(HTTPClient& http, Stream* target, size_t& wireBytes, String& error) {
+    if (!hasContentCoding(http)) {
+        int written = http.writeToStream(target);
+        if (written < 0) {
+            error = HTTPClient::errorToString(written);
+            return false;
+        }
+        wireBytes = written;
+        return true;
+    }
+    String coding = http.header("Content-Encoding");
+    coding.trim();
+    InflateStream::Encoding encoding;
+    if (!InflateStream::fromHeader(coding, encoding)) {
+        error = "Content-Encoding '" + coding + "' nicht unterstützt";
+        return false;
+    }
+    InflateStream inflater(target, encoding);
+    int written = http.writeToStream(&inflater);
+    wireBytes = inflater.compressedBytes();
+    if (written < 0 && !inflater.failed()) {
+        error = HTTPClient::errorToString(written);
+        return false;
+    }
+    if (!inflater.complete()) {
+        error = String(inflater.encodingName()) + (inflater.failed() ? "-Daten konnten nicht entpackt werden" : "-Daten unvollständig oder Prüfsumme falsch");
+        return false;
+    }
+    return true;
+}
 
 // --- ManagedResource Implementierung ---
 
 ManagedResource::ManagedResource(const PsramString& u, uint32_t interval, const char* ca)
-    : url(u), customHeaders(""), update_interval_ms(interval), root_ca_fallback(ca) {
+    : url(u), host(hostFromUrl(u)), customHeaders(""), update_interval_ms(interval), root_ca_fallback(ca) {
+    key = resourceKey(url.c_str(), "");
+    host_key = fnv1a64(host.c_str());
     mutex = xSemaphoreCreateMutex();
 }
 
 ManagedResource::ManagedResource(const PsramString& u, const PsramString& headers, uint32_t interval, const char* ca)
-    : url(u), customHeaders(headers), update_interval_ms(interval), root_ca_fallback(ca) {
+    : url(u), host(hostFromUrl(u)), customHeaders(headers), update_interval_ms(interval), root_ca_fallback(ca) {
+    key = resourceKey(url.c_str(), customHeaders.c_str());
+    host_key = fnv1a64(host.c_str());
     mutex = xSemaphoreCreateMutex();
 }
 
 ManagedResource::~ManagedResource() {
-    if (data_buffer) free(data_buffer);
+    if (data) data->release();
     if (mutex) vSemaphoreDelete(mutex);
 }
 
 ManagedResource::ManagedResource(ManagedResource&& other) noexcept
-    : url(std::move(other.url)), customHeaders(std::move(other.customHeaders)), update_interval_ms(other.update_interval_ms), root_ca_fallback(other.root_ca_fallback),
-      cert_filename(std::move(other.cert_filename)), data_buffer(other.data_buffer), data_size(other.data_size), 
+    : id(other.id), key(other.key), host_key(other.host_key), url(std::move(other.url)), host(std::move(other.host)), customHeaders(std::move(other.customHeaders)), update_interval_ms(other.update_interval_ms), root_ca_fallback(other.root_ca_fallback),
+      cert_filename(std::move(other.cert_filename)), cert_file_used(std::move(other.cert_file_used)), data(other.data), data_version(other.data_version.load()), data_size(other.data_size), wire_size(other.wire_size), 
       last_successful_update(other.last_successful_update), last_check_attempt(other.last_check_attempt), 
-      last_check_attempt_ms(other.last_check_attempt_ms),
-      mutex(other.mutex), retry_count(other.retry_count), is_in_retry_mode(other.is_in_retry_mode), is_data_stale(other.is_data_stale),
-      is_paused(other.is_paused), has_priority(other.has_priority), use_ms_timing(other.use_ms_timing)
+      last_check_attempt_ms(other.last_check_attempt_ms), next_due_ms(other.next_due_ms),
+      mutex(other.mutex), failure_count(other.failure_count), retry_delay_ms(other.retry_delay_ms), is_data_stale(other.is_data_stale),
+      is_paused(other.is_paused), is_dormant(other.is_dormant), removed(other.removed), last_access_ms(other.last_access_ms),
+      priority(other.priority), scheduled(other.scheduled), in_flight(other.in_flight),
+      etag(std::move(other.etag)), last_modified(std::move(other.last_modified)), not_modified_count(other.not_modified_count),
+      cache_hash(other.cache_hash), cache_written_ms(other.cache_written_ms), from_cache(other.from_cache), telemetry(other.telemetry),
+      stream_consumer(other.stream_consumer)
 {
-    other.data_buffer = nullptr; other.mutex = nullptr;
+    other.data = nullptr; other.mutex = nullptr;
 }
 
 
 // --- WebClientModule Implementierung ---
 
-WebClientModule::WebClientModule() : workerTaskHandle(NULL), jobQueue(NULL), _startMs(0), _lastDownloadMs(0) {}
+WebClientModule::WebClientModule() : _scheduleMutex(NULL), _updateQueue(NULL), _certMutex(NULL), _cacheMutex(NULL), _startMs(0) {
+    _scheduleMutex = xSemaphoreCreateMutex();
+    _certMutex = xSemaphoreCreateMutex();
+    _cacheMutex = xSemaphoreCreateMutex();
+    // Created here already, so listeners can be dispatched before begin()
+    _updateQueue = xQueueCreate(WEBCLIENT_UPDATE_QUEUE_LEN, sizeof(ResourceUpdateEvent));
+}
 
 WebClientModule::~WebClientModule() {
-    if (workerTaskHandle) vTaskDelete(workerTaskHandle);
-    if (_downloadBuffer) free(_downloadBuffer);
-    if (jobQueue) vQueueDelete(jobQueue);
+    for (uint8_t i = 0; i < _workerCount; i++) {
+        if (_workers[i].taskHandle) vTaskDelete(_workers[i].taskHandle);
+    }
+    for (ManagedResource* resource : resources) {
+        resource->~ManagedResource();
+        free(resource);
+    }
+    for (size_t i = _connections.size(); i > 0; i--) {
+        destroyConnection(_connections[i - 1]);
+    }
+    for (auto& queue : _jobQueues) {
+        for (WebJob* job : queue) {
+            job->~WebJob();
+            free(job);
+        }
+    }
+    if (_updateQueue) vQueueDelete(_updateQueue);
+    if (_scheduleMutex) vSemaphoreDelete(_scheduleMutex);
+    if (_certMutex) vSemaphoreDelete(_certMutex);
+    if (_cacheMutex) vSemaphoreDelete(_cacheMutex);
 }
 
 void WebClientModule::begin() {
-    // Keep original behavior: use deviceConfig->webClientBufferSize as before
-    reallocateBuffer(deviceConfig->webClientBufferSize);
-    jobQueue = xQueueCreate(10, sizeof(WebJob*));
+    // Pool size from the TLS memory budget: every worker may hold one TLS session at a time
+    int budgetKB = deviceConfig->webClientTlsBudgetKB;
+    _workerCount = (uint8_t)constrain(budgetKB / WEBCLIENT_TLS_SESSION_KB, 1, WEBCLIENT_MAX_WORKERS);
+    // Kept-alive sessions count against the same budget, but every worker needs at least one
+    _maxSessions = max((size_t)_workerCount, (size_t)(budgetKB / WEBCLIENT_TLS_SESSION_KB));
+
+    // Keep original behavior: the first worker gets deviceConfig->webClientBufferSize right away,
+    // the others allocate their segments while downloading
+    if (!_workers[0].stream.reserve(deviceConfig->webClientBufferSize)) {
+        Log.printf("[WebClientModule] FEHLER: Konnte Download-Puffer (%u Bytes) nicht reservieren!\n", (unsigned)deviceConfig->webClientBufferSize);
+    }
     BaseType_t app_core = xPortGetCoreID();
     BaseType_t network_core = (app_core == 0) ? 1 : 0;
     // record start time so we can delay the very first download by 10s
     _startMs = millis();
-    _lastDownloadMs = 0;
-    xTaskCreatePinnedToCore(webWorkerTask, "WebDataManager", 8192, this, 2, &workerTaskHandle, network_core);
+    for (uint8_t i = 0; i < _workerCount; i++) {
+        FetchWorker& worker = _workers[i];
+        worker.owner = this;
+        worker.index = i;
+        char taskName[20];
+        snprintf(taskName, sizeof(taskName), "WebDataManager%u", i);
+        xTaskCreatePinnedToCore(webWorkerTask, taskName, 8192, &worker, 2, &worker.taskHandle, network_core);
+    }
+    Log.printf("[WebDataManager] %u Fetch-Worker gestartet (TLS-Budget %d KB, max. %u Verbindungen)\n", _workerCount, budgetKB, (unsigned)_maxSessions);
 }
 
-void WebClientModule::registerResource(const String& url, uint32_t update_interval_minutes, const char* root_ca) {
-    if (url.isEmpty() || update_interval_minutes == 0) return;
-    
-    // Extract host from URL for comparison
-    String host;
-    int hostStart = url.indexOf("://");
-    if (hostStart != -1) hostStart += 3; else hostStart = 0;
-    int pathStart = url.indexOf("/", hostStart);
-    host = (pathStart != -1) ? url.substring(hostStart, pathStart) : url.substring(hostStart);
-    int colonPos = host.indexOf(":");
-    if (colonPos != -1) {
-        host = host.substring(0, colonPos);
+ManagedResource* WebClientModule::addResource(const PsramString& url, const PsramString& headers, uint32_t interval_ms, ResourcePriority priority, const char* root_ca) {
+    // Allocate ManagedResource in PSRAM; its address must not change while a worker fetches it
+    void* mem = ps_malloc(sizeof(ManagedResource));
+    if (!mem) {
+        Log.printf("[WebDataManager] FEHLER: Konnte keine Ressource für %s allozieren.\n", url.c_str());
+        return nullptr;
     }
-    
-    // Check if a resource with the same host already exists
-    for(auto& res : resources) {
-        // Extract host from existing resource URL
-        PsramString existingHost;
-        int existingHostStart = indexOf(res.url, "://");
-        if (existingHostStart != -1) existingHostStart += 3; else existingHostStart = 0;
-        int existingPathStart = indexOf(res.url, "/", existingHostStart);
-        existingHost = (existingPathStart != -1) ? res.url.substr(existingHostStart, existingPathStart - existingHostStart) : res.url.substr(existingHostStart);
-        int existingColonPos = indexOf(existingHost, ":");
-        if (existingColonPos != -1) {
-            existingHost = existingHost.substr(0, existingColonPos);
+    ManagedResource* resource = new (mem) ManagedResource(url, headers, interval_ms, root_ca);
+    resource->priority = priority;
+    resource->last_access_ms = millis();  // Registering counts as access
+    // Not visible to the workers yet, so a fresh download cannot be overwritten by the cached body
+    bool cached = deviceConfig->webCacheEnabled && loadCachedBody(*resource);
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+        resource->id = _nextResourceId++;
+        resources.push_back(resource);
+        indexInsert(resource);
+        _registryGeneration++;
+        // New resources are due right away
+        scheduleResource(*resource, millis());
+        xSemaphoreGive(_scheduleMutex);
+    }
+    if (cached) {
+        postUpdateEvent(*resource);
+        if (_dataBytes.load() > WEBCLIENT_DATA_BUDGET_KB * 1024UL) enforceDataBudget(resource);
+    }
+    wakeWorkers();
+    return resource;
+}
+
+void WebClientModule::setResourceUrl(ManagedResource& resource, const char* url) {
+    // The scheduler compares hosts, so url and host change together under both mutexes
+    uint64_t old_key = resource.key;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        indexRemove(&resource);
+        resource.url = url;
+        resource.host = hostFromUrl(resource.url);
+        resource.key = resourceKey(resource.url.c_str(), resource.customHeaders.c_str());
+        resource.host_key = fnv1a64(resource.host.c_str());
+        indexInsert(&resource);
+        _registryGeneration++;
+        // Validators belong to the old URL
+        resource.etag.clear();
+        resource.last_modified.clear();
+        resource.cache_hash = 0;
+        xSemaphoreGive(resource.mutex);
+    }
+    xSemaphoreGive(_scheduleMutex);
+    // The cached body of the old URL will never be served again
+    if (resource.key != old_key) removeCachedBody(old_key);
+}
+
+ManagedResource* WebClientModule::findResource(const char* url, const char* headers) const {
+    if (_index.empty()) return nullptr;
+    uint64_t key = resourceKey(url, headers);
+    size_t mask = _index.size() - 1;
+    for (size_t i = key & mask, probes = 0; probes < _index.size(); i = (i + 1) & mask, probes++) {
+        const ResourceIndexSlot& slot = _index[i];
+        if (!slot.resource) {
+            if (!slot.tombstone) return nullptr;
+            continue;
         }
-        
-        // If same host, update the URL but keep other parameters
-        if (existingHost.compare(host.c_str()) == 0) {
-            if (xSemaphoreTake(res.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                res.url = url.c_str();
-                Log.printf("[WebDataManager] URL aktualisiert für Host %s: %s\n", host.c_str(), url.c_str());
-                xSemaphoreGive(res.mutex);
+        // The strings are compared as well, so a hash collision never returns the wrong resource
+        if (slot.key == key && slot.resource->url == url && slot.resource->customHeaders == headers) {
+            return slot.resource;
+        }
+    }
+    return nullptr;
+}
+
+ManagedResource* WebClientModule::findResourceByHost(const char* host, size_t length) const {
+    if (_hostIndex.empty()) return nullptr;
+    uint64_t host_key = fnv1a64Data(host, length);
+    size_t mask = _hostIndex.size() - 1;
+    for (size_t i = host_key & mask, probes = 0; probes < _hostIndex.size(); i = (i + 1) & mask, probes++) {
+        const ResourceIndexSlot& slot = _hostIndex[i];
+        if (!slot.resource) {
+            if (!slot.tombstone) return nullptr;
+            continue;
+        }
+        if (slot.key == host_key && slot.resource->host.compare(0, PsramString::npos, host, length) == 0) {
+            return slot.resource;
+        }
+    }
+    return nullptr;
+}
+
+void WebClientModule::hostIndexInsert(ManagedResource* resource) {
+    // The first resource of a host keeps the entry
+    if (findResourceByHost(resource->host.c_str(), resource->host.length())) return;
+    if ((_hostIndexUsed + 1) * 4 > _hostIndex.size() * 3) {
+        size_t slots = WEBCLIENT_INDEX_MIN_SLOTS;
+        while (slots * 3 < resources.size() * 8) slots *= 2;
+        rebuildHostIndex(slots);
+        return;
+    }
+    size_t mask = _hostIndex.size() - 1;
+    for (size_t i = resource->host_key & mask; ; i = (i + 1) & mask) {
+        ResourceIndexSlot& slot = _hostIndex[i];
+        if (slot.resource) continue;
+        if (!slot.tombstone) _hostIndexUsed++;
+        slot.key = resource->host_key;
+        slot.resource = resource;
+        slot.tombstone = false;
+        return;
+    }
+}
+
+void WebClientModule::hostIndexRemove(ManagedResource* resource) {
+    if (_hostIndex.empty()) return;
+    size_t mask = _hostIndex.size() - 1;
+    for (size_t i = resource->host_key & mask, probes = 0; probes < _hostIndex.size(); i = (i + 1) & mask, probes++) {
+        ResourceIndexSlot& slot = _hostIndex[i];
+        if (slot.resource == resource) {
+            // The entry moves on to the next resource of the same host (in registration order)
+            ManagedResource* next = nullptr;
+            for (ManagedResource* other : resources) {
+                if (other != resource && other->host_key == resource->host_key && other->host == resource->host) {
+                    next = other;
+                    break;
+                }
             }
+            slot.resource = next;
+            slot.tombstone = next == nullptr;
+            return;
+        }
+        if (!slot.resource && !slot.tombstone) return;
+    }
+}
+
+void WebClientModule::rebuildHostIndex(size_t slots) {
+    _hostIndex.assign(slots, ResourceIndexSlot());
+    _hostIndexUsed = 0;
+    for (ManagedResource* resource : resources) {
+        if (findResourceByHost(resource->host.c_str(), resource->host.length())) continue;
+        size_t mask = slots - 1;
+        size_t i = resource->host_key & mask;
+        while (_hostIndex[i].resource) i = (i + 1) & mask;
+        _hostIndex[i].key = resource->host_key;
+        _hostIndex[i].resource = resource;
+        _hostIndexUsed++;
+    }
+}
+
+void WebClientModule::indexInsert(ManagedResource* resource) {
+    hostIndexInsert(resource);
+    if ((_indexUsed + 1) * 4 > _index.size() * 3) {
+        size_t slots = WEBCLIENT_INDEX_MIN_SLOTS;
+        while (slots * 3 < resources.size() * 8) slots *= 2;  // at most 3/8 full after the rebuild
+        // Callers add the resource to the list first, so the rebuild covers it
+        rebuildIndex(slots);
+        return;
+    }
+    size_t mask = _index.size() - 1;
+    for (size_t i = resource->key & mask; ; i = (i + 1) & mask) {
+        ResourceIndexSlot& slot = _index[i];
+        if (slot.resource) continue;
+        if (!slot.tombstone) _indexUsed++;
+        slot.key = resource->key;
+        slot.resource = resource;
+        slot.tombstone = false;
+        return;
+    }
+}
+
+void WebClientModule::indexRemove(ManagedResource* resource) {
+    hostIndexRemove(resource);
+    if (_index.empty()) return;
+    size_t mask = _index.size() - 1;
+    for (size_t i = resource->key & mask, probes = 0; probes < _index.size(); i = (i + 1) & mask, probes++) {
+        ResourceIndexSlot& slot = _index[i];
+        if (slot.resource == resource) {
+            slot.resource = nullptr;
+            slot.tombstone = true;
             return;
         }
+        if (!slot.resource && !slot.tombstone) return;
+    }
+}
+
+void WebClientModule::rebuildIndex(size_t slots) {
+    _index.assign(slots, ResourceIndexSlot());
+    _indexUsed = 0;
+    size_t mask = slots - 1;
+    for (ManagedResource* resource : resources) {
+        size_t i = resource->key & mask;
+        while (_index[i].resource) i = (i + 1) & mask;
+        _index[i].key = resource->key;
+        _index[i].resource = resource;
+        _indexUsed++;
     }
+}
+
+void WebClientModule::registerResource(const String& url, uint32_t update_interval_minutes, const char* root_ca) {
+    if (url.isEmpty() || update_interval_minutes == 0) return;
     
-    // No existing resource with same host, check for exact URL match
-    for(const auto& res : resources) {
-        if (res.url.compare(url.c_str()) == 0) return;
+    // A resource of the same host takes the new URL and keeps its other parameters
+    size_t hostLength = 0;
+    const char* host = hostSpan(url.c_str(), hostLength);
+    ManagedResource* res = findResourceByHost(host, hostLength);
+    if (res) {
+        if (res->url != url.c_str()) {
+            setResourceUrl(*res, url.c_str());
+            Log.printf("[WebDataManager] URL aktualisiert für Host %s: %s\n", res->host.c_str(), url.c_str());
+        }
+        return;
     }
 
     uint32_t interval_ms = update_interval_minutes * 60 * 1000UL;
-    resources.emplace_back(url.c_str(), interval_ms, root_ca);
-    ManagedResource& new_res = resources.back();
+    ManagedResource* new_res = addResource(url.c_str(), "", interval_ms, RESOURCE_PRIORITY_NORMAL, root_ca);
+    if (!new_res) return;
 
     // remove the old deviceConfig-based cert selection here (we'll discover certs dynamically)
-    Log.printf("[WebDataManager] Ressource registriert: %s (initial Cert-File: '%s')\n", new_res.url.c_str(), new_res.cert_filename.c_str());
+    Log.printf("[WebDataManager] Ressource registriert: %s (initial Cert-File: '%s')\n", new_res->url.c_str(), new_res->cert_filename.c_str());
 }
 
 void WebClientModule::registerResourceWithHeaders(const String& url, const String& customHeaders, uint32_t update_interval_minutes, const char* root_ca) {
@@ -203,19 +909,17 @@ void WebClientModule::registerResourceWithHeaders(const String& url, const Strin
     // This allows multiple resources with the same URL but different headers (e.g., different park IDs)
     
     // Check if exact URL+headers combination already exists
-    for(const auto& res : resources) {
-        if (res.url.compare(url.c_str()) == 0 && res.customHeaders.compare(customHeaders.c_str()) == 0) {
-            Log.printf("[WebDataManager] Ressource mit Headers bereits registriert: %s\n", url.c_str());
-            return; // Already exists
-        }
+    if (findResource(url.c_str(), customHeaders.c_str())) {
+        Log.printf("[WebDataManager] Ressource mit Headers bereits registriert: %s\n", url.c_str());
+        return; // Already exists
     }
     
     uint32_t interval_ms = update_interval_minutes * 60 * 1000UL;
-    resources.emplace_back(url.c_str(), customHeaders.c_str(), interval_ms, root_ca);
-    ManagedResource& new_res = resources.back();
+    ManagedResource* new_res = addResource(url.c_str(), customHeaders.c_str(), interval_ms, RESOURCE_PRIORITY_NORMAL, root_ca);
+    if (!new_res) return;
     
     Log.printf("[WebDataManager] Ressource mit Headers registriert: %s (Headers: %s, Cert-File: '%s')\n", 
-               new_res.url.c_str(), new_res.customHeaders.c_str(), new_res.cert_filename.c_str());
+               new_res->url.c_str(), new_res->customHeaders.c_str(), new_res->cert_filename.c_str());
 }
 
 void WebClientModule::registerResourceSeconds(const String& url, uint32_t update_interval_seconds, bool with_priority, bool force_new, const char* root_ca) {
@@ -227,30 +931,30 @@ void WebClientModule::registerResourceSeconds(const String& url, uint32_t update
     // If force_new is FALSE: normal logic - check if URL exists and update it
     if (!force_new) {
         // Check if a resource with the exact same URL already exists - if so, update its parameters
-        for(auto& res : resources) {
-            if (res.url.compare(url.c_str()) == 0) {
-                if (xSemaphoreTake(res.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                    res.update_interval_ms = interval_ms;
-                    res.has_priority = with_priority;
-                    res.use_ms_timing = true;  // Enable millisecond-precise timing
-                    Log.printf("[WebDataManager] Resource parameters updated: %s (Intervall: %u Sek, Priorität: %d)\n", 
-                              url.c_str(), update_interval_seconds, with_priority);
-                    xSemaphoreGive(res.mutex);
-                }
-                return;
+        ManagedResource* res = findResource(url.c_str(), "");
+        if (res) {
+            // Interval and class are scheduler state, the resource moves to its new deadline
+            if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+                unscheduleResource(*res);
+                res->update_interval_ms = interval_ms;
+                res->priority = with_priority ? RESOURCE_PRIORITY_HIGH : RESOURCE_PRIORITY_NORMAL;
+                scheduleResource(*res, nextDueMs(*res, millis()));
+                xSemaphoreGive(_scheduleMutex);
+                Log.printf("[WebDataManager] Resource parameters updated: %s (Intervall: %u Sek, Priorität: %d)\n", 
+                          url.c_str(), update_interval_seconds, with_priority);
+                wakeWorkers();
             }
+            return;
         }
     }
     
     // If force_new is TRUE: always create new resource, even if URL already exists
     // This allows multiple resources with same URL (e.g., for different live events)
-    resources.emplace_back(url.c_str(), interval_ms, root_ca);
-    ManagedResource& new_res = resources.back();
-    new_res.has_priority = with_priority;
-    new_res.use_ms_timing = true;  // Enable millisecond-precise timing
+    ManagedResource* new_res = addResource(url.c_str(), "", interval_ms, with_priority ? RESOURCE_PRIORITY_HIGH : RESOURCE_PRIORITY_NORMAL, root_ca);
+    if (!new_res) return;
 
     Log.printf("[WebDataManager] Ressource registriert (Sekunden-genau): %s, Intervall: %u Sek, Priorität: %d, ForceNew: %d (Cert-File: '%s')\n", 
-               new_res.url.c_str(), update_interval_seconds, with_priority, force_new, new_res.cert_filename.c_str());
+               new_res->url.c_str(), update_interval_seconds, with_priority, force_new, new_res->cert_filename.c_str());
 }
 
 void WebClientModule::registerResourceSecondsWithHeaders(const String& url, const String& customHeaders, uint32_t update_interval_seconds, bool with_priority, const char* root_ca) {
@@ -260,449 +964,998 @@ void WebClientModule::registerResourceSecondsWithHeaders(const String& url, cons
     // This allows multiple resources with the same URL but different headers (e.g., different park IDs)
     
     // Check if exact URL+headers combination already exists
-    for(const auto& res : resources) {
-        if (res.url.compare(url.c_str()) == 0 && res.customHeaders.compare(customHeaders.c_str()) == 0) {
-            Log.printf("[WebDataManager] Ressource mit Headers bereits registriert: %s\n", url.c_str());
-            return; // Already exists
-        }
+    if (findResource(url.c_str(), customHeaders.c_str())) {
+        Log.printf("[WebDataManager] Ressource mit Headers bereits registriert: %s\n", url.c_str());
+        return; // Already exists
     }
     
     uint32_t interval_ms = update_interval_seconds * 1000UL;
-    resources.emplace_back(url.c_str(), customHeaders.c_str(), interval_ms, root_ca);
-    ManagedResource& new_res = resources.back();
-    new_res.has_priority = with_priority;
-    new_res.use_ms_timing = true;  // Enable millisecond-precise timing
+    ManagedResource* new_res = addResource(url.c_str(), customHeaders.c_str(), interval_ms, with_priority ? RESOURCE_PRIORITY_HIGH : RESOURCE_PRIORITY_NORMAL, root_ca);
+    if (!new_res) return;
     
     Log.printf("[WebDataManager] Ressource mit Headers registriert (Sekunden-genau): %s, Intervall: %u Sek, Priorität: %d (Headers: %s, Cert-File: '%s')\n", 
-               new_res.url.c_str(), update_interval_seconds, with_priority, new_res.customHeaders.c_str(), new_res.cert_filename.c_str());
+               new_res->url.c_str(), update_interval_seconds, with_priority, new_res->customHeaders.c_str(), new_res->cert_filename.c_str());
 }
 
-void WebClientModule::updateResourceUrl(const String& old_url, const String& new_url) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(old_url.c_str()) == 0) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.url = new_url.c_str();
-                Log.printf("[WebDataManager] URL für Ressource aktualisiert: %s -> %s\n", old_url.c_str(), new_url.c_str());
-                xSemaphoreGive(resource.mutex);
-            }
-            return;
+void WebClientModule::registerStreamingResource(const String& url, uint32_t update_interval_minutes, ResourceStreamConsumer* consumer, const char* root_ca) {
+    if (url.isEmpty() || update_interval_minutes == 0 || !consumer) return;
+    uint32_t interval_ms = update_interval_minutes * 60 * 1000UL;
+
+    // One resource per consumer: a new URL replaces the previous one
+    for (ManagedResource* res : resources) {
+        if (res->stream_consumer != consumer) continue;
+        if (res->url.compare(url.c_str()) != 0) {
+            setResourceUrl(*res, url.c_str());
+            Log.printf("[WebDataManager] URL der Stream-Ressource aktualisiert: %s\n", url.c_str());
+        }
+        if (res->update_interval_ms != interval_ms && xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            unscheduleResource(*res);
+            res->update_interval_ms = interval_ms;
+            scheduleResource(*res, nextDueMs(*res, millis()));
+            xSemaphoreGive(_scheduleMutex);
+            wakeWorkers();
         }
+        return;
     }
+
+    ManagedResource* new_res = addResource(url.c_str(), "", interval_ms, RESOURCE_PRIORITY_NORMAL, root_ca);
+    if (!new_res) return;
+    new_res->stream_consumer = consumer;
+    Log.printf("[WebDataManager] Stream-Ressource registriert: %s\n", new_res->url.c_str());
+}
+
+void WebClientModule::updateResourceUrl(const String& old_url, const String& new_url) {
+    ManagedResource* resource = findResource(old_url.c_str(), "");
+    if (!resource) return;
+    setResourceUrl(*resource, new_url.c_str());
+    Log.printf("[WebDataManager] URL für Ressource aktualisiert: %s -> %s\n", old_url.c_str(), new_url.c_str());
 }
 
 void WebClientModule::pauseResource(const String& url) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.empty()) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.is_paused = true;
-                Log.printf("[WebDataManager] Ressource pausiert: %s\n", url.c_str());
-                xSemaphoreGive(resource.mutex);
-            }
-            return;
-        }
+    pauseResource(url.c_str());
+}
+
+void WebClientModule::pauseResource(const char* url) {
+    ManagedResource* resource = findResource(url, "");
+    if (resource && xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        resource->is_paused = true;
+        Log.printf("[WebDataManager] Ressource pausiert: %s\n", url);
+        xSemaphoreGive(resource->mutex);
     }
 }
 
 void WebClientModule::pauseResourceWithHeaders(const String& url, const String& customHeaders) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.compare(customHeaders.c_str()) == 0) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.is_paused = true;
-                Log.printf("[WebDataManager] Ressource mit Headers pausiert: %s\n", url.c_str());
-                xSemaphoreGive(resource.mutex);
-            }
-            return;
-        }
+    pauseResourceWithHeaders(url.c_str(), customHeaders.c_str());
+}
+
+void WebClientModule::pauseResourceWithHeaders(const char* url, const char* customHeaders) {
+    ManagedResource* resource = findResource(url, customHeaders);
+    if (resource && xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        resource->is_paused = true;
+        Log.printf("[WebDataManager] Ressource mit Headers pausiert: %s\n", url);
+        xSemaphoreGive(resource->mutex);
     }
 }
 
 void WebClientModule::resumeResource(const String& url) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.empty()) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.is_paused = false;
-                Log.printf("[WebDataManager] Ressource fortgesetzt: %s\n", url.c_str());
-                xSemaphoreGive(resource.mutex);
-            }
-            return;
-        }
+    resumeResource(url.c_str());
+}
+
+void WebClientModule::resumeResource(const char* url) {
+    ManagedResource* resource = findResource(url, "");
+    if (!resource) return;
+    if (xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        resource->is_paused = false;
+        Log.printf("[WebDataManager] Ressource fortgesetzt: %s\n", url);
+        xSemaphoreGive(resource->mutex);
     }
+    resumeScheduling(*resource);
 }
 
 void WebClientModule::resumeResourceWithHeaders(const String& url, const String& customHeaders) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.compare(customHeaders.c_str()) == 0) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.is_paused = false;
-                Log.printf("[WebDataManager] Ressource mit Headers fortgesetzt: %s\n", url.c_str());
-                xSemaphoreGive(resource.mutex);
-            }
-            return;
-        }
+    resumeResourceWithHeaders(url.c_str(), customHeaders.c_str());
+}
+
+void WebClientModule::resumeResourceWithHeaders(const char* url, const char* customHeaders) {
+    ManagedResource* resource = findResource(url, customHeaders);
+    if (!resource) return;
+    if (xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        resource->is_paused = false;
+        Log.printf("[WebDataManager] Ressource mit Headers fortgesetzt: %s\n", url);
+        xSemaphoreGive(resource->mutex);
     }
+    resumeScheduling(*resource);
+}
+
+void WebClientModule::resumeScheduling(ManagedResource& resource) {
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    // Still queued if the worker did not reach it while paused
+    if (!resource.scheduled) scheduleResource(resource, nextDueMs(resource, millis()));
+    xSemaphoreGive(_scheduleMutex);
+    wakeWorkers();
 }
 
 void WebClientModule::accessResource(const String& url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    accessResource(url.c_str(), "", std::move(callback));
+}
+
+void WebClientModule::accessResource(const String& url, const String& customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    accessResource(url.c_str(), customHeaders.c_str(), std::move(callback));
+}
+
+void WebClientModule::accessResource(const char* url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    accessResource(url, "", std::move(callback));
+}
+
+void WebClientModule::accessResource(const char* url, const char* customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
     LOG_MEM_OP("WebClient::accessResource");
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.empty()) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                // MODIFIKATION: Wenn disableModuleDataAccess true, gebe leere Daten zurück
-                if (disableModuleDataAccess) {
-                    callback(nullptr, 0, resource.last_successful_update, true); // "keine Daten" simulieren
-                } else {
-                    callback(resource.data_buffer, resource.data_size, resource.last_successful_update, resource.is_data_stale);
-                }
-                xSemaphoreGive(resource.mutex);
-            } else {
-                Log.printf("[WebDataManager] Timeout beim Warten auf Mutex für %s\n", url.c_str());
+    _resourceReads++;
+    ManagedResource* resource = findResource(url, customHeaders);
+    if (!resource) return;
+    touchResource(*resource);
+    if (xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        // MODIFIKATION: Wenn disableModuleDataAccess true, gebe leere Daten zurück
+        if (disableModuleDataAccess) {
+            callback(nullptr, 0, resource->last_successful_update, true); // "keine Daten" simulieren
+        } else {
+            callback(resource->data ? resource->data->data() : nullptr, resource->data ? resource->data->size : 0, resource->last_successful_update, resource->is_data_stale);
+        }
+        xSemaphoreGive(resource->mutex);
+    } else {
+        Log.printf("[WebDataManager] Timeout beim Warten auf Mutex für %s%s\n", url, *customHeaders ? " (mit Headers)" : "");
+    }
+}
+
+bool WebClientModule::takeNewData(ResourceSubscription& subscription, ResourceDataRef& out) {
+    _resourceReads++;
+    if (disableModuleDataAccess) return false;
+
+    // Resolve (again) if resources were added or renamed, or the module changed its URL
+    uint32_t generation = _registryGeneration.load();
+    if (subscription.registry_generation != generation) {
+        if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+        ManagedResource* found = findResource(subscription.url.c_str(), subscription.customHeaders.c_str());
+        xSemaphoreGive(_scheduleMutex);
+        // Versions only compare within one resource
+        if (found != subscription.resource) subscription.version = 0;
+        subscription.resource = found;
+        subscription.resource_id = found ? found->id : 0;
+        subscription.registry_generation = generation;
+    }
+
+    ManagedResource* resource = subscription.resource;
+    if (!resource) return false;
+    touchResource(*resource);
+    if (resource->data_version.load() == subscription.version) return false;
+
+    if (xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) != pdTRUE) return false;
+    ResourceDataRef current(resource->data);
+    xSemaphoreGive(resource->mutex);
+    if (!current || current.version() == subscription.version) return false;
+
+    subscription.version = current.version();
+    out = std::move(current);
+    return true;
+}
+
+uint32_t WebClientModule::getResourceId(const char* url, const char* customHeaders) {
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return 0;
+    ManagedResource* resource = findResource(url, customHeaders);
+    uint32_t id = resource ? resource->id : 0;
+    xSemaphoreGive(_scheduleMutex);
+    return id;
+}
+
+void WebClientModule::addUpdateListener(ResourceUpdateListener listener) {
+    UpdateListener entry;
+    entry.callback = std::move(listener);
+    _updateListeners.push_back(std::move(entry));
+}
+
+void WebClientModule::postUpdateEvent(const ManagedResource& resource) {
+    ResourceUpdateEvent event = { resource.id, resource.data_version.load() };
+    // Never block a worker: a lost event is picked up by the next tick
+    if (_updateQueue && xQueueSend(_updateQueue, &event, 0) == pdTRUE) {
+        _updateEventsPosted++;
+    } else {
+        _updateEventsDropped++;
+    }
+}
+
+uint32_t WebClientModule::dispatchUpdateEvents() {
+    uint32_t delivered = 0;
+    ResourceUpdateEvent event;
+    while (_updateQueue && xQueueReceive(_updateQueue, &event, 0) == pdTRUE) {
+        deliverUpdateEvent(event);
+        delivered++;
+    }
+
+    unsigned long nowMs = millis();
+    if (nowMs - _lastUpdateTickMs >= WEBCLIENT_UPDATE_TICK_MS) {
+        _lastUpdateTickMs = nowMs;
+        ResourceUpdateEvent tick = { RESOURCE_UPDATE_TICK, 0 };
+        deliverUpdateEvent(tick);
+        delivered++;
+    }
+
+    // After the listeners ran, so resources accessed on the tick count as used
+    if (nowMs - _lastIdleCheckMs >= WEBCLIENT_IDLE_CHECK_MS) {
+        _lastIdleCheckMs = nowMs;
+        evictIdleResources(nowMs);
+    }
+    return delivered;
+}
+
+void WebClientModule::deliverUpdateEvent(const ResourceUpdateEvent& event) {
+    for (auto& listener : _updateListeners) {
+        uint32_t reads = _resourceReads.load();
+        listener.callback(event);
+        if (_resourceReads.load() != reads) {
+            listener.readsResources = true;
+        } else if (listener.readsResources) {
+            // The module filtered the event out instead of reading its resources
+            _pollsAvoided++;
+        }
+    }
+}
+
+void WebClientModule::touchResource(ManagedResource& resource) {
+    resource.last_access_ms = millis();
+    if (!resource.is_dormant) return;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    resource.is_dormant = false;
+    // Due right away, the module is waiting for data again
+    scheduleResource(resource, resource.last_access_ms);
+    xSemaphoreGive(_scheduleMutex);
+    wakeWorkers();
+    Log.printf("[WebDataManager] Ressource reaktiviert: %s\n", resource.url.c_str());
+}
+
+void WebClientModule::releaseResourceData(ManagedResource& resource) {
+    ResourceData* old_data = nullptr;
+    if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    old_data = resource.data;
+    resource.data = nullptr;
+    resource.data_size = 0;
+    resource.wire_size = 0;
+    resource.is_data_stale = true;
+    // Without a body a 304 would leave the module empty-handed
+    resource.etag.clear();
+    resource.last_modified.clear();
+    xSemaphoreGive(resource.mutex);
+    if (old_data) {
+        _dataBytes -= old_data->size;
+        old_data->release();
+    }
+}
+
+void WebClientModule::evictIdleResources(unsigned long nowMs) {
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    for (ManagedResource* resource : resources) {
+        // Streaming resources are consumed by the worker itself
+        if (resource->is_dormant || resource->in_flight || resource->stream_consumer) continue;
+        unsigned long limit = max((unsigned long)WEBCLIENT_IDLE_EVICT_MIN_MS, (unsigned long)resource->update_interval_ms * WEBCLIENT_IDLE_EVICT_INTERVALS);
+        if (millisElapsed(resource->last_access_ms, nowMs) < limit) continue;
+        unscheduleResource(*resource);
+        resource->is_dormant = true;
+        releaseResourceData(*resource);
+        _idleEvictions++;
+        Log.printf("[WebDataManager] Ressource ruht (seit %lu s ungenutzt): %s\n", millisElapsed(resource->last_access_ms, nowMs) / 1000, resource->url.c_str());
+    }
+    xSemaphoreGive(_scheduleMutex);
+}
+
+void WebClientModule::enforceDataBudget(const ManagedResource* keep) {
+    const size_t budget = WEBCLIENT_DATA_BUDGET_KB * 1024UL;
+    // The schedule mutex keeps victims from being unregistered meanwhile (order: schedule, then resource mutex)
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    unsigned long nowMs = millis();
+    while (_dataBytes.load() > budget) {
+        // Stale bodies first, then the least recently accessed
+        ManagedResource* victim = nullptr;
+        for (ManagedResource* resource : resources) {
+            if (resource == keep || !resource->data || resource->in_flight) continue;
+            if (!victim || (resource->is_data_stale && !victim->is_data_stale) ||
+                (resource->is_data_stale == victim->is_data_stale &&
+                 millisElapsed(resource->last_access_ms, nowMs) > millisElapsed(victim->last_access_ms, nowMs))) {
+                victim = resource;
             }
-            return;
         }
+        if (!victim) break;
+        Log.printf("[WebDataManager] Speicherbudget überschritten, verwerfe %u Bytes von %s\n", (unsigned)victim->data_size, victim->url.c_str());
+        releaseResourceData(*victim);
+        _budgetEvictions++;
     }
+    xSemaphoreGive(_scheduleMutex);
 }
 
-void WebClientModule::accessResource(const String& url, const String& customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
-    for (auto& resource : resources) {
-        if (resource.url.compare(url.c_str()) == 0 && resource.customHeaders.compare(customHeaders.c_str()) == 0) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                // MODIFIKATION: Wenn disableModuleDataAccess true, gebe leere Daten zurück
-                if (disableModuleDataAccess) {
-                    callback(nullptr, 0, resource.last_successful_update, true); // "keine Daten" simulieren
-                } else {
-                    callback(resource.data_buffer, resource.data_size, resource.last_successful_update, resource.is_data_stale);
-                }
-                xSemaphoreGive(resource.mutex);
-            } else {
-                Log.printf("[WebDataManager] Timeout beim Warten auf Mutex für %s (mit Headers)\n", url.c_str());
+void WebClientModule::destroyResource(ManagedResource* resource) {
+    if (resource->data) _dataBytes -= resource->data->size;
+    resource->~ManagedResource();
+    free(resource);
+}
+
+void WebClientModule::unregisterResource(const String& url) {
+    unregisterResourceWithHeaders(url.c_str(), "");
+}
+
+void WebClientModule::unregisterResource(const char* url) {
+    unregisterResourceWithHeaders(url, "");
+}
+
+void WebClientModule::unregisterResourceWithHeaders(const String& url, const String& customHeaders) {
+    unregisterResourceWithHeaders(url.c_str(), customHeaders.c_str());
+}
+
+void WebClientModule::unregisterResourceWithHeaders(const char* url, const char* customHeaders) {
+    ManagedResource* resource = findResource(url, customHeaders);
+    if (!resource) return;
+    removeCachedBody(resource->key);
+    bool destroyNow = false;
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) != pdTRUE) return;
+    unscheduleResource(*resource);
+    indexRemove(resource);
+    for (auto it = resources.begin(); it != resources.end(); ++it) {
+        if (*it == resource) {
+            resources.erase(it);
+            break;
+        }
+    }
+    // Cached subscription pointers must not be used any more
+    _registryGeneration++;
+    if (resource->in_flight) {
+        resource->removed = true;
+    } else {
+        destroyNow = true;
+    }
+    xSemaphoreGive(_scheduleMutex);
+    Log.printf("[WebDataManager] Ressource entfernt: %s\n", url);
+    if (destroyNow) destroyResource(resource);
+}
+
+// --- Flash cache of resource bodies ---
+
+// File layout: header, etag, last_modified, zlib stream of the body (the Adler-32 trailer checks it on load)
+#define WEBCLIENT_CACHE_FORMAT 1
+struct CacheFileHeader {
+    char magic[4];          // "PCWC"
+    uint8_t format;
+    uint8_t etag_len;
+    uint8_t last_modified_len;
+    uint8_t reserved;
+    uint64_t key;           // ManagedResource::key, guards against a stale file after a hash collision
+    uint64_t content_hash;
+    uint32_t last_update;   // Unix time of the download
+    uint32_t body_size;
+};
+
+static void cacheFilePath(uint64_t key, char* out, size_t outSize) {
+    snprintf(out, outSize, "%s/%08lx%08lx.bin", WEBCLIENT_CACHE_DIR, (unsigned long)(key >> 32), (unsigned long)(key & 0xFFFFFFFF));
+}
+
+// Inflated cache bodies are written straight into the ResourceData block
+class BlockWriteStream : public Stream {
+public:
+    BlockWriteStream(char* block, size_t size) : _block(block), _size(size) {}
+    size_t write(uint8_t data) override { return write(&data, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override {
+        if (size > _size - _position) return 0;
+        memcpy(_block + _position, buffer, size);
+        _position += size;
+        return size;
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+    size_t position() const { return _position; }
+
+private:
+    char* _block;
+    size_t _size;
+    size_t _position = 0;
+};
+
+static mz_bool cacheFileWrite(const void* data, int len, void* user) {
+    return ((File*)user)->write((const uint8_t*)data, len) == (size_t)len;
+}
+
+bool WebClientModule::loadCachedBody(ManagedResource& resource) {
+    char path[48];
+    cacheFilePath(resource.key, path, sizeof(path));
+    if (!LittleFS.exists(path)) return false;
+    File file = LittleFS.open(path, "r");
+    if (!file) return false;
+
+    CacheFileHeader header;
+    char etag[256];
+    char last_modified[256];
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                 memcmp(header.magic, "PCWC", 4) == 0 && header.format == WEBCLIENT_CACHE_FORMAT &&
+                 header.key == resource.key && header.body_size > 0 &&
+                 file.read((uint8_t*)etag, header.etag_len) == header.etag_len &&
+                 file.read((uint8_t*)last_modified, header.last_modified_len) == header.last_modified_len;
+    // Without NTP time yet the age is unknown, the body is served anyway (it is marked stale)
+    time_t now = time(nullptr);
+    if (valid && now > 1600000000 && (uint32_t)now - header.last_update > WEBCLIENT_CACHE_MAX_AGE_S) {
+        Log.printf("[WebDataManager] Cache für %s ist veraltet, wird verworfen.\n", resource.url.c_str());
+        valid = false;
+    }
+    ResourceData* data = valid ? ResourceData::create(header.body_size, 1, header.last_update) : nullptr;
+    if (data) {
+        BlockWriteStream block(data->data(), header.body_size);
+        InflateStream inflater(&block, InflateStream::ENCODING_DEFLATE);
+        uint8_t chunk[1024];
+        while (!inflater.failed() && !inflater.complete()) {
+            size_t n = file.read(chunk, sizeof(chunk));
+            if (n == 0 || inflater.write(chunk, n) != n) break;
+        }
+        if (!inflater.complete() || block.position() != header.body_size) {
+            data->release();
+            data = nullptr;
+        }
+    }
+    file.close();
+    if (!data) {
+        // Damaged, foreign or expired: make room for the next good body
+        if (valid) Log.printf("[WebDataManager] Cache-Datei %s fehlerhaft, wird gelöscht.\n", path);
+        LittleFS.remove(path);
+        return false;
+    }
+
+    // Served as stale data until the first refresh; the validators allow a 304 for it
+    resource.data = data;
+    resource.data_size = header.body_size;
+    resource.data_version.store(data->version);
+    resource.etag.assign(etag, header.etag_len);
+    resource.last_modified.assign(last_modified, header.last_modified_len);
+    resource.last_successful_update = header.last_update;
+    resource.is_data_stale = true;
+    resource.cache_hash = header.content_hash;
+    resource.cache_written_ms = millis();
+    resource.from_cache = true;
+    _dataBytes += header.body_size;
+    _cacheLoads++;
+    Log.printf("[WebDataManager] %s aus Flash-Cache geladen (%u Bytes, Stand %u).\n", resource.url.c_str(), (unsigned)header.body_size, (unsigned)header.last_update);
+    return true;
+}
+
+void WebClientModule::persistResource(ManagedResource& resource, ResourceData* data) {
+    // Unregistered meanwhile: its cache file was just deleted and must not come back
+    if (resource.removed) return;
+    uint64_t content_hash = fnv1a64Data(data->data(), data->size);
+    if (deviceConfig->webCacheSkipUnchanged && content_hash == resource.cache_hash) {
+        _cacheSkippedUnchanged++;
+        return;
+    }
+    if (xSemaphoreTake(_cacheMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    unsigned long nowMs = millis();
+    if (millisElapsed(_cacheWindowStartMs, nowMs) >= 3600000UL) {
+        _cacheWindowStartMs = nowMs;
+        _cacheBytesThisHour = 0;
+    }
+    if ((resource.cache_written_ms != 0 && millisElapsed(resource.cache_written_ms, nowMs) < WEBCLIENT_CACHE_MIN_WRITE_INTERVAL_MS) ||
+        _cacheBytesThisHour >= WEBCLIENT_CACHE_WRITE_KB_PER_HOUR * 1024UL ||
+        LittleFS.totalBytes() - LittleFS.usedBytes() < WEBCLIENT_CACHE_MIN_FREE_KB * 1024UL) {
+        _cacheRateLimited++;
+        xSemaphoreGive(_cacheMutex);
+        return;
+    }
+
+    CacheFileHeader header = {};
+    memcpy(header.magic, "PCWC", 4);
+    header.format = WEBCLIENT_CACHE_FORMAT;
+    header.key = resource.key;
+    header.content_hash = content_hash;
+    header.last_update = (uint32_t)data->last_update;
+    header.body_size = data->size;
+    PsramString etag, last_modified;
+    if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        etag = resource.etag;
+        last_modified = resource.last_modified;
+        xSemaphoreGive(resource.mutex);
+    }
+    // Validators longer than 255 characters are dropped, the body alone is still useful
+    if (etag.length() > 255) etag.clear();
+    if (last_modified.length() > 255) last_modified.clear();
+    header.etag_len = etag.length();
+    header.last_modified_len = last_modified.length();
+
+    // The compressor (~300 KB) only exists for the duration of the write
+    tdefl_compressor* compressor = (tdefl_compressor*)ps_malloc(sizeof(tdefl_compressor));
+    if (!compressor) {
+        xSemaphoreGive(_cacheMutex);
+        return;
+    }
+    if (!LittleFS.exists(WEBCLIENT_CACHE_DIR)) LittleFS.mkdir(WEBCLIENT_CACHE_DIR);
+    char path[48];
+    char tmpPath[52];
+    cacheFilePath(resource.key, path, sizeof(path));
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    File file = LittleFS.open(tmpPath, "w");
+    bool ok = file &&
+              file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)etag.c_str(), etag.length()) == etag.length() &&
+              file.write((const uint8_t*)last_modified.c_str(), last_modified.length()) == last_modified.length();
+    if (ok) {
+        // Fast settings: greedy parsing with few probes, JSON and HTML still shrink to a fraction
+        tdefl_init(compressor, cacheFileWrite, &file, TDEFL_WRITE_ZLIB_HEADER | TDEFL_GREEDY_PARSING_FLAG | 16);
+        const size_t step = 16 * 1024;
+        for (size_t pos = 0; ok && pos < data->size; pos += step) {
+            size_t n = min(step, data->size - pos);
+            bool last = (pos + n >= data->size);
+            tdefl_status status = tdefl_compress_buffer(compressor, data->data() + pos, n, last ? TDEFL_FINISH : TDEFL_NO_FLUSH);
+            ok = last ? (status == TDEFL_STATUS_DONE) : (status == TDEFL_STATUS_OKAY);
+            vTaskDelay(1);
+        }
+    }
+    size_t written = file ? file.position() : 0;
+    if (file) file.close();
+    free(compressor);
+
+    if (ok) {
+        if (LittleFS.exists(path)) LittleFS.remove(path);
+        ok = LittleFS.rename(tmpPath, path);
+    }
+    if (ok) {
+        resource.cache_hash = content_hash;
+        resource.cache_written_ms = nowMs;
+        _cacheBytesThisHour += written;
+        _cacheWrites++;
+        Log.printf("[WebDataManager] %s im Flash-Cache gesichert (%u -> %u Bytes).\n", resource.url.c_str(), (unsigned)data->size, (unsigned)written);
+    } else {
+        LittleFS.remove(tmpPath);
+        Log.printf("[WebDataManager] FEHLER: %s konnte nicht im Flash-Cache gesichert werden.\n", resource.url.c_str());
+    }
+    xSemaphoreGive(_cacheMutex);
+}
+
+void WebClientModule::removeCachedBody(uint64_t key) {
+    char path[48];
+    cacheFilePath(key, path, sizeof(path));
+    if (LittleFS.exists(path)) LittleFS.remove(path);
+}
+
+// --- Capture mode (replay fixtures for the parsers) ---
+
+// One file per resource or job (/capture/<key>.http): header lines, an empty line, then the
+// request body (request-length bytes, POST only) and the decoded response body (length bytes).
+//   PCFX 1
+//   method: GET
+//   url: https://...
+//   header: Name: Value     (custom request headers, one line each)
+//   status: 200
+//   time: 1700000000        (unix time of the capture)
+//   request-length: 0
+//   length: 12345
+static void captureFilePath(uint64_t key, char* out, size_t outSize) {
+    snprintf(out, outSize, "%s/%08lx%08lx.http", WEBCLIENT_CAPTURE_DIR, (unsigned long)(key >> 32), (unsigned long)(key & 0xFFFFFFFF));
+}
+
+void WebClientModule::setCaptureEnabled(bool enabled) {
+    if (xSemaphoreTake(_cacheMutex, pdMS_TO_TICKS(5000)) != pdTRUE) return;
+    if (enabled && !_captureEnabled.load()) {
+        // New session: the fixtures of the previous one are removed
+        int deletedCount = 0;
+        File dir = LittleFS.open(WEBCLIENT_CAPTURE_DIR, "r");
+        if (dir && dir.isDirectory()) {
+            File file = dir.openNextFile();
+            while (file) {
+                char filename[64];
+                snprintf(filename, sizeof(filename), "%s/%s", WEBCLIENT_CAPTURE_DIR, file.name());
+                file.close();
+                if (LittleFS.remove(filename)) deletedCount++;
+                file = dir.openNextFile();
             }
-            return;
+            dir.close();
+        } else {
+            LittleFS.mkdir(WEBCLIENT_CAPTURE_DIR);
         }
+        _capturedKeys.clear();
+        _captureBytes = 0;
+        Log.printf("[WebDataManager] Mitschnitt gestartet (%d alte Dateien gelöscht).\n", deletedCount);
+    } else if (!enabled && _captureEnabled.load()) {
+        Log.printf("[WebDataManager] Mitschnitt beendet: %u Antworten, %u Bytes in %s.\n",
+                   (unsigned)_capturedKeys.size(), (unsigned)_captureBytes, WEBCLIENT_CAPTURE_DIR);
     }
+    _captureEnabled.store(enabled);
+    xSemaphoreGive(_cacheMutex);
+}
+
+void WebClientModule::getCaptureStats(uint32_t& files, size_t& bytes) {
+    files = 0;
+    bytes = 0;
+    if (xSemaphoreTake(_cacheMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    files = _capturedKeys.size();
+    bytes = _captureBytes;
+    xSemaphoreGive(_cacheMutex);
+}
+
+void WebClientModule::captureResponse(uint64_t key, const char* method, const PsramString& url, const PsramString& headers,
+                                      const PsramString& requestBody, int httpCode, const char* body, size_t size) {
+    // Flash writes of cache and capture are serialized; a busy cache write costs this capture, not the fetch
+    if (xSemaphoreTake(_cacheMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    if (!_captureEnabled.load() ||
+        std::find(_capturedKeys.begin(), _capturedKeys.end(), key) != _capturedKeys.end()) {
+        xSemaphoreGive(_cacheMutex);
+        return;
+    }
+    if (_captureBytes + size > WEBCLIENT_CAPTURE_MAX_KB * 1024UL ||
+        LittleFS.totalBytes() - LittleFS.usedBytes() < WEBCLIENT_CACHE_MIN_FREE_KB * 1024UL + size) {
+        Log.printf("[WebDataManager] Mitschnitt: %s übersprungen, Limit erreicht.\n", url.c_str());
+        xSemaphoreGive(_cacheMutex);
+        return;
+    }
+
+    PsramString head = "PCFX 1\nmethod: ";
+    head += method;
+    head += "\nurl: ";
+    head += url;
+    // Custom headers are stored one per line, as they were configured
+    size_t lineStart = 0;
+    while (lineStart < headers.length()) {
+        size_t lineEnd = headers.find('\n', lineStart);
+        if (lineEnd == PsramString::npos) lineEnd = headers.length();
+        if (lineEnd > lineStart) {
+            head += "\nheader: ";
+            head += headers.substr(lineStart, lineEnd - lineStart);
+        }
+        lineStart = lineEnd + 1;
+    }
+    char fields[96];
+    snprintf(fields, sizeof(fields), "\nstatus: %d\ntime: %lu\nrequest-length: %u\nlength: %u\n\n",
+             httpCode, (unsigned long)time(nullptr), (unsigned)requestBody.length(), (unsigned)size);
+    head += fields;
+
+    char path[48];
+    captureFilePath(key, path, sizeof(path));
+    File file = LittleFS.open(path, "w");
+    bool ok = file &&
+              file.write((const uint8_t*)head.c_str(), head.length()) == head.length() &&
+              file.write((const uint8_t*)requestBody.c_str(), requestBody.length()) == requestBody.length();
+    // Large bodies in blocks, so the other tasks get the CPU between the flash writes
+    const size_t step = 16 * 1024;
+    for (size_t pos = 0; ok && pos < size; pos += step) {
+        size_t n = min(step, size - pos);
+        ok = file.write((const uint8_t*)body + pos, n) == n;
+        vTaskDelay(1);
+    }
+    if (file) file.close();
+    if (ok) {
+        _capturedKeys.push_back(key);
+        _captureBytes += head.length() + requestBody.length() + size;
+        Log.printf("[WebDataManager] Mitschnitt: %s -> %s (%u Bytes).\n", url.c_str(), path, (unsigned)size);
+    } else {
+        LittleFS.remove(path);
+        Log.printf("[WebDataManager] FEHLER: Mitschnitt von %s konnte nicht geschrieben werden.\n", url.c_str());
+    }
+    xSemaphoreGive(_cacheMutex);
+}
+
+PsramVector<ResourceMemoryInfo> WebClientModule::getResourceMemoryStats() {
+    PsramVector<ResourceMemoryInfo> stats;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return stats;
+    unsigned long nowMs = millis();
+    stats.reserve(resources.size());
+    for (const ManagedResource* resource : resources) {
+        ResourceMemoryInfo info;
+        info.url = resource->url;
+        info.has_headers = !resource->customHeaders.empty();
+        info.bytes = resource->data_size;
+        info.wire_bytes = resource->wire_size;
+        info.version = resource->data_version.load();
+        info.idle_s = millisElapsed(resource->last_access_ms, nowMs) / 1000;
+        info.dormant = resource->is_dormant;
+        info.paused = resource->is_paused;
+        info.streaming = resource->stream_consumer != nullptr;
+        info.from_cache = resource->from_cache;
+        info.failures = resource->failure_count;
+        if (resource->retry_delay_ms && !resource->in_flight) {
+            long untilRetry = (long)(resource->last_check_attempt_ms + resource->retry_delay_ms - nowMs);
+            info.retry_in_s = untilRetry > 0 ? (uint32_t)untilRetry / 1000 : 0;
+        }
+        stats.push_back(info);
+    }
+    xSemaphoreGive(_scheduleMutex);
+    return stats;
+}
+
+void WebClientModule::getDataBudgetStats(size_t& usedBytes, size_t& budgetBytes, uint32_t& budgetEvictions, uint32_t& idleEvictions) {
+    usedBytes = _dataBytes.load();
+    budgetBytes = WEBCLIENT_DATA_BUDGET_KB * 1024UL;
+    budgetEvictions = _budgetEvictions.load();
+    idleEvictions = _idleEvictions;
+}
+
+void WebClientModule::recordTelemetry(ManagedResource* resource, const FetchSample& sample) {
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    (resource ? resource->telemetry : _jobTelemetry).add(sample);
+    xSemaphoreGive(_scheduleMutex);
+}
+
+PsramVector<ResourceTelemetryInfo> WebClientModule::getResourceTelemetry() {
+    PsramVector<ResourceTelemetryInfo> stats;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return stats;
+    stats.reserve(resources.size());
+    for (const ManagedResource* resource : resources) {
+        ResourceTelemetryInfo info;
+        info.url = resource->url;
+        info.has_headers = !resource->customHeaders.empty();
+        info.interval_s = resource->update_interval_ms / 1000;
+        info.telemetry = resource->telemetry;
+        stats.push_back(info);
+    }
+    xSemaphoreGive(_scheduleMutex);
+    return stats;
+}
+
+FetchTelemetry WebClientModule::getJobTelemetry() {
+    FetchTelemetry telemetry;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        telemetry = _jobTelemetry;
+        xSemaphoreGive(_scheduleMutex);
+    }
+    return telemetry;
+}
+
+void WebClientModule::getCacheStats(uint32_t& loads, uint32_t& writes, uint32_t& skippedUnchanged, uint32_t& rateLimited) {
+    loads = _cacheLoads;
+    writes = _cacheWrites.load();
+    skippedUnchanged = _cacheSkippedUnchanged.load();
+    rateLimited = _cacheRateLimited.load();
+}
+
+void WebClientModule::getUpdateEventStats(uint32_t& posted, uint32_t& dropped, uint32_t& pollsAvoided) {
+    posted = _updateEventsPosted.load();
+    dropped = _updateEventsDropped.load();
+    pollsAvoided = _pollsAvoided;
 }
 
 void WebClientModule::updateResourceCertificateByHost(const String& host, const String& cert_filename) {
-    for (auto& resource : resources) {
-        if (indexOf(resource.url, host.c_str()) != -1) {
-            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-                resource.cert_filename = cert_filename.c_str();
-                Log.printf("[WebDataManager] Zertifikat für Ressource '%s' (Host: %s) live aktualisiert auf Datei: '%s'\n", resource.url.c_str(), host.c_str(), cert_filename.c_str());
-                xSemaphoreGive(resource.mutex);
+    for (ManagedResource* resource : resources) {
+        if (indexOf(resource->url, host.c_str()) != -1) {
+            if (xSemaphoreTake(resource->mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+                resource->cert_filename = cert_filename.c_str();
+                Log.printf("[WebDataManager] Zertifikat für Ressource '%s' (Host: %s) live aktualisiert auf Datei: '%s'\n", resource->url.c_str(), host.c_str(), cert_filename.c_str());
+                xSemaphoreGive(resource->mutex);
             }
         }
     }
+    invalidateCertCache();
 }
 
-void WebClientModule::getRequest(const PsramString& url, std::function<void(const char* buffer, size_t size)> callback) {
-    if (WiFi.status() != WL_CONNECTED) {
-        Log.println("[WebClientModule] GET-Anfrage fehlgeschlagen: Keine WLAN-Verbindung.");
-        callback(nullptr, 0);
-        return;
+const char* JobQueueStats::className(JobPriority priority) {
+    switch (priority) {
+        case JOB_PRIORITY_INTERACTIVE: return "interactive";
+        case JOB_PRIORITY_LIVE: return "live";
+        case JOB_PRIORITY_BACKGROUND: return "background";
+        default: return "?";
+    }
+}
+
+bool WebClientModule::enqueueJob(WebJob::JobType type, const PsramString& url, const PsramString& body, const PsramString& contentType,
+                                 const PsramString& customHeaders, JobWaiter&& waiter, JobPriority priority, const char*& error) {
+    uint64_t key = fnv1a64(type == WebJob::GET ? "GET" : "POST", resourceKey(url.c_str(), customHeaders.c_str()));
+    key = fnv1a64(body.c_str(), key);
+    waiter.enqueued_ms = millis();
+
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        error = "Queue busy";
+        return false;
+    }
+    auto identical = [&](const WebJob* job) {
+        return job->key == key && !job->delivered && job->type == type && job->url == url &&
+               job->customHeaders == customHeaders && job->body == body && job->contentType == contentType;
+    };
+    WebJob* same = nullptr;
+    for (uint8_t cls = 0; cls < JOB_PRIORITY_COUNT && !same; cls++) {
+        for (WebJob* job : _jobQueues[cls]) {
+            if (identical(job)) { same = job; break; }
+        }
+    }
+    // A POST that is already on the wire may have had its effect, a new one is sent again
+    if (!same && type == WebJob::GET) {
+        for (WebJob* job : _runningJobs) {
+            if (identical(job)) { same = job; break; }
+        }
+    }
+
+    if (same) {
+        same->waiters.push_back(std::move(waiter));
+        _jobStats.submitted[priority]++;
+        _jobStats.coalesced[priority]++;
+        // A more urgent caller moves the queued job up to its class
+        if (!same->running && priority < same->priority) {
+            PsramVector<WebJob*>& from = _jobQueues[same->priority];
+            from.erase(std::find(from.begin(), from.end(), same));
+            _jobQueues[priority].push_back(same);
+            same->priority = priority;
+        }
+        Log.printf("[WebDataManager] %s-Job für %s mit %s Anfrage zusammengefasst (%u Empfänger).\n",
+                   (type == WebJob::GET ? "GET" : "POST"), url.c_str(), same->running ? "laufender" : "wartender", (unsigned)same->waiters.size());
+        xSemaphoreGive(_scheduleMutex);
+        return true;
     }
+
+    size_t queued = 0;
+    for (const auto& queue : _jobQueues) queued += queue.size();
     // Allocate WebJob in PSRAM to reduce heap fragmentation
-    void* jobMem = ps_malloc(sizeof(WebJob));
+    void* jobMem = (queued < WEBCLIENT_MAX_QUEUED_JOBS) ? ps_malloc(sizeof(WebJob)) : nullptr;
     if (!jobMem) {
-        Log.println("[WebClientModule] FEHLER: Konnte keinen WebJob für GET allozieren.");
+        if (queued >= WEBCLIENT_MAX_QUEUED_JOBS) _jobStats.rejected_full++;
+        xSemaphoreGive(_scheduleMutex);
+        error = (queued >= WEBCLIENT_MAX_QUEUED_JOBS) ? "Queue full" : "Malloc failed";
+        return false;
+    }
+    WebJob* job = new (jobMem) WebJob();
+    job->type = type;
+    job->url = url;
+    job->body = body;
+    job->contentType = contentType;
+    job->customHeaders = customHeaders;
+    job->priority = priority;
+    job->key = key;
+    job->waiters.push_back(std::move(waiter));
+    _jobQueues[priority].push_back(job);
+    _jobStats.submitted[priority]++;
+    xSemaphoreGive(_scheduleMutex);
+    wakeWorkers();
+    return true;
+}
+
+void WebClientModule::getRequest(const PsramString& url, std::function<void(const char* buffer, size_t size)> callback, JobPriority priority) {
+    if (WiFi.status() != WL_CONNECTED) {
+        Log.println("[WebClientModule] GET-Anfrage fehlgeschlagen: Keine WLAN-Verbindung.");
         callback(nullptr, 0);
         return;
     }
-    WebJob* job = new (jobMem) WebJob{WebJob::GET, url, "", "", "", callback, nullptr};
-    if (xQueueSend(jobQueue, &job, pdMS_TO_TICKS(100)) != pdTRUE) {
-        Log.println("[WebClientModule] FEHLER: Konnte GET-Job nicht zur Queue hinzufügen.");
-        job->~WebJob();  // Call destructor
-        free(jobMem);
+    JobWaiter waiter;
+    waiter.callback = callback;
+    const char* error = nullptr;
+    if (!enqueueJob(WebJob::GET, url, "", "", "", std::move(waiter), priority, error)) {
+        Log.printf("[WebClientModule] FEHLER: Konnte GET-Job nicht zur Queue hinzufügen (%s).\n", error);
         callback(nullptr, 0);
     }
 }
 
-void WebClientModule::getRequest(const PsramString& url, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback) {
+void WebClientModule::getRequest(const PsramString& url, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority priority) {
     if (WiFi.status() != WL_CONNECTED) {
         Log.println("[WebClientModule] GET-Anfrage (detailed) fehlgeschlagen: Keine WLAN-Verbindung.");
         detailed_callback(-1, "No WiFi", 7);
         return;
     }
-    // Allocate WebJob in PSRAM to reduce heap fragmentation
-    void* jobMem = ps_malloc(sizeof(WebJob));
-    if (!jobMem) {
-        Log.println("[WebClientModule] FEHLER: Konnte keinen WebJob für GET (detailed) allozieren.");
-        detailed_callback(-1, "Malloc failed", 12);
-        return;
-    }
-    WebJob* job = new (jobMem) WebJob{WebJob::GET, url, "", "", "", nullptr, detailed_callback};
-    if (xQueueSend(jobQueue, &job, pdMS_TO_TICKS(100)) != pdTRUE) {
-        Log.println("[WebDataManager] FEHLER: Konnte GET-Job (detailed) nicht zur Queue hinzufügen.");
-        job->~WebJob();  // Call destructor
-        free(jobMem);
-        detailed_callback(-1, "Queue full", 10);
+    JobWaiter waiter;
+    waiter.detailed_callback = detailed_callback;
+    const char* error = nullptr;
+    if (!enqueueJob(WebJob::GET, url, "", "", "", std::move(waiter), priority, error)) {
+        Log.printf("[WebDataManager] FEHLER: Konnte GET-Job (detailed) nicht zur Queue hinzufügen (%s).\n", error);
+        detailed_callback(-1, error, strlen(error));
     }
 }
 
-void WebClientModule::getRequest(const PsramString& url, const PsramString& customHeaders, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback) {
+void WebClientModule::getRequest(const PsramString& url, const PsramString& customHeaders, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority priority) {
     if (WiFi.status() != WL_CONNECTED) {
         Log.println("[WebClientModule] GET-Anfrage (detailed+headers) fehlgeschlagen: Keine WLAN-Verbindung.");
         detailed_callback(-1, "No WiFi", 7);
         return;
     }
-    // Allocate WebJob in PSRAM to reduce heap fragmentation
-    void* jobMem = ps_malloc(sizeof(WebJob));
-    if (!jobMem) {
-        Log.println("[WebClientModule] FEHLER: Konnte keinen WebJob für GET (detailed+headers) allozieren.");
-        detailed_callback(-1, "Malloc failed", 12);
-        return;
-    }
-    WebJob* job = new (jobMem) WebJob{WebJob::GET, url, "", "", customHeaders, nullptr, detailed_callback};
-    if (xQueueSend(jobQueue, &job, pdMS_TO_TICKS(100)) != pdTRUE) {
-        Log.println("[WebDataManager] FEHLER: Konnte GET-Job (detailed+headers) nicht zur Queue hinzufügen.");
-        job->~WebJob();  // Call destructor
-        free(jobMem);
-        detailed_callback(-1, "Queue full", 10);
+    JobWaiter waiter;
+    waiter.detailed_callback = detailed_callback;
+    const char* error = nullptr;
+    if (!enqueueJob(WebJob::GET, url, "", "", customHeaders, std::move(waiter), priority, error)) {
+        Log.printf("[WebDataManager] FEHLER: Konnte GET-Job (detailed+headers) nicht zur Queue hinzufügen (%s).\n", error);
+        detailed_callback(-1, error, strlen(error));
     }
 }
 
-void WebClientModule::postRequest(const PsramString& url, const PsramString& postBody, const PsramString& contentType, std::function<void(const char* buffer, size_t size)> callback) {
+void WebClientModule::postRequest(const PsramString& url, const PsramString& postBody, const PsramString& contentType, std::function<void(const char* buffer, size_t size)> callback, JobPriority priority) {
     if (WiFi.status() != WL_CONNECTED) {
         Log.println("[WebClientModule] POST-Anfrage fehlgeschlagen: Keine WLAN-Verbindung.");
         callback(nullptr, 0);
         return;
     }
-
-    // Allocate WebJob in PSRAM to reduce heap fragmentation
-    void* jobMem = ps_malloc(sizeof(WebJob));
-    if (!jobMem) {
-        Log.println("[WebClientModule] FEHLER: Konnte keinen WebJob für POST allozieren.");
-        callback(nullptr, 0);
-        return;
-    }
-
-    WebJob* job = new (jobMem) WebJob{WebJob::POST, url, postBody, contentType, "", callback, nullptr};
-    if (xQueueSend(jobQueue, &job, pdMS_TO_TICKS(100)) != pdTRUE) {
-        Log.println("[WebClientModule] FEHLER: Konnte POST-Job nicht zur Queue hinzufügen.");
-        job->~WebJob();  // Call destructor
-        free(jobMem);
+    JobWaiter waiter;
+    waiter.callback = callback;
+    const char* error = nullptr;
+    if (!enqueueJob(WebJob::POST, url, postBody, contentType, "", std::move(waiter), priority, error)) {
+        Log.printf("[WebClientModule] FEHLER: Konnte POST-Job nicht zur Queue hinzufügen (%s).\n", error);
         callback(nullptr, 0);
     }
 }
 
-bool WebClientModule::reallocateBuffer(size_t new_size) {
-    if (new_size <= _bufferCapacity) return true;
-    LOG_MEMORY_DETAILED("WebClient: Vor Puffer-Allokation");
-    char* new_buffer = (char*)ps_realloc(_downloadBuffer, new_size);
-    if (new_buffer) {
-        _downloadBuffer = new_buffer;
-        _bufferCapacity = new_size;
-        Log.printf("[WebClientModule] Download-Puffer alloziert/vergrößert auf: %u Bytes\n", new_size);
-        LOG_MEMORY_DETAILED("WebClient: Nach Puffer-Allokation");
-        return true;
-    } else {
-        Log.printf("[WebClientModule] FEHLER: Konnte Puffer nicht auf %u Bytes vergrößern!\n", new_size);
-        LOG_MEMORY_DETAILED("WebClient: Puffer-Allokation FEHLER");
-        return false;
+JobQueueStats WebClientModule::getJobQueueStats() {
+    JobQueueStats stats;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        stats = _jobStats;
+        for (uint8_t cls = 0; cls < JOB_PRIORITY_COUNT; cls++) stats.queued[cls] = _jobQueues[cls].size();
+        xSemaphoreGive(_scheduleMutex);
     }
+    return stats;
 }
 
-// --- Updated performJob: stream response into _downloadStream (avoid http.getString())
+// --- performJob: stream response into the worker's download stream (avoid http.getString())
 //     and make connect + download two distinct steps to reduce certificate issues and heap fragmentation.
-void WebClientModule::performJob(const WebJob& job) {
+//     The connection is kept alive for the next request to the same host.
+int WebClientModule::performJob(FetchWorker& worker, WebJob& job) {
     LOG_MEMORY_STRATEGIC("WebClient: Begin performJob");
     Log.printf("[WebDataManager] Führe %s-Job für %s aus...\n", (job.type == WebJob::GET ? "GET" : "POST"), job.url.c_str());
-    HTTPClient http;
     int httpCode = 0;
-    
-    WiFiClientSecure secure_client;
-    WiFiClient plain_client;
-
-    bool using_https = (job.url.rfind("https://", 0) == 0);
-    PsramString cert_data;
-    bool cert_loaded = false;
-    PsramString cert_filename;
 
     // Parse host and port (works for both http and https)
-    int hostStart = indexOf(job.url, "://");
-    if (hostStart != -1) hostStart += 3; else hostStart = 0;
-    int pathStart = indexOf(job.url, "/", hostStart);
-    PsramString host = (pathStart != -1) ? job.url.substr(hostStart, pathStart - hostStart) : job.url.substr(hostStart);
-
-    uint16_t port = using_https ? 443 : 80;
-    // if host contains ":port", try to parse (simple)
-    int colonPos = indexOf(host, ":");
-    if (colonPos != -1) {
-        PsramString portStr = host.substr(colonPos + 1);
-        port = (uint16_t)atoi(portStr.c_str());
-        host = host.substr(0, colonPos);
-    }
-
-    // determine cert filename by searching cert files in /certs (full host first, then progressively remove subdomains)
-    if (using_https) {
-        PsramString found = findCertFilenameForHost(host);
-        if (!found.empty()) {
-            cert_filename = found;
-            PsramString filepath = PsramString("/certs/") + found;
-            if (LittleFS.exists(filepath.c_str())) {
-                File certFile = LittleFS.open(filepath.c_str(), "r");
-                if (certFile) {
-                    cert_data = readFromStream(certFile);
-                    certFile.close();
-                    cert_loaded = true;
-                }
-            }
-        }
-
-        // fallback: if resource already has cert_filename configured, try it
-        if (!cert_loaded && !cert_filename.empty()) {
-            PsramString filepath = PsramString("/certs/") + cert_filename;
-            if (LittleFS.exists(filepath.c_str())) {
-                File certFile = LittleFS.open(filepath.c_str(), "r");
-                if (certFile) {
-                    cert_data = readFromStream(certFile);
-                    certFile.close();
-                    cert_loaded = true;
-                }
-            }
-        }
-
-        // fallback to resource.root_ca_fallback or insecure
-        if (!cert_loaded && job.detailed_callback == nullptr) {
-            // nothing special here — keep previous fallback behaviour but prefer resource.root_ca_fallback
-        }
-
-        if(cert_loaded) {
-            Log.printf("[WebDataManager] Job: Verwende Zertifikat '%s'\n", cert_filename.c_str());
-            secure_client.setCACert(cert_data.c_str());
-        } else if (job.detailed_callback == nullptr) {
-            // if no cert loaded, try resource.root_ca_fallback (if any)
-            // Note: performJob does not have access to ManagedResource here; rely on local behavior: if caller wants to set cert per resource, they can use updateResourceCertificateByHost()
-            Log.printf("[WebDataManager] Job: WARNUNG, kein Zertifikat für %s gefunden, benutze unsichere Verbindung.\n", job.url.c_str());
-            secure_client.setInsecure();
-        } else {
-            secure_client.setInsecure();
-        }
-    }
-
-    // Step 1: explicit connect using client
-    bool connected = false;
-    if (using_https) {
-        connected = secure_client.connect(host.c_str(), port);
-        if (!connected) {
+    RequestTarget target = parseTarget(job.url);
+    // One-shot jobs connect without certificate check (as before), so they share
+    // kept-alive connections only with other jobs to the same host.
+
+    // Step 1: explicit connect, or reuse of the kept-alive connection to this host
+    char errbuf[256];
+    errbuf[0] = '\0';
+    FetchSample sample;
+    PooledConnection* conn = nullptr;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (attempt > 0) sample.retries++;
+        conn = acquireConnection(target, nullptr, errbuf, sizeof(errbuf), sample);
+        if (!conn) {
             httpCode = -1; // connect failed
+            break;
         }
-    } else {
-        connected = plain_client.connect(host.c_str(), port);
-        if (!connected) {
-            httpCode = -1;
+        if (!conn->http->begin(conn->socket(), job.url.c_str())) {
+            httpCode = -10;
+            break;
         }
-    }
-
-    // If connected, start HTTP and perform request
-    if (connected) {
-        if (using_https) {
-            if (http.begin(secure_client, job.url.c_str())) {
-                // Set User-Agent header
-                http.setUserAgent(_userAgent.c_str());
-                
-                // Add custom headers if provided
-                if (!job.customHeaders.empty()) {
-                    // Parse and add headers (format: "Header1: Value1\nHeader2: Value2")
-                    PsramString headers = job.customHeaders;
-                    size_t pos = 0;
-                    while (pos < headers.length()) {
-                        size_t newlinePos = headers.find('\n', pos);
-                        if (newlinePos == PsramString::npos) newlinePos = headers.length();
-                        
-                        PsramString headerLine = headers.substr(pos, newlinePos - pos);
-                        size_t colonPos = headerLine.find(':');
-                        if (colonPos != PsramString::npos) {
-                            PsramString headerName = headerLine.substr(0, colonPos);
-                            PsramString headerValue = headerLine.substr(colonPos + 1);
-                            // Trim leading/trailing spaces
-                            while (!headerValue.empty() && headerValue[0] == ' ') headerValue = headerValue.substr(1);
-                            while (!headerValue.empty() && headerValue[headerValue.length()-1] == ' ') headerValue = headerValue.substr(0, headerValue.length()-1);
-                            http.addHeader(headerName.c_str(), headerValue.c_str());
-                            Log.printf("[WebDataManager] Added header: %s: %s\n", headerName.c_str(), headerValue.c_str());
-                        }
-                        pos = newlinePos + 1;
-                    }
-                }
-                
-                if (job.type == WebJob::GET) {
-                    httpCode = http.GET();
-                } else {
-                    http.addHeader("Content-Type", job.contentType.c_str());
-                    httpCode = http.POST(job.body.c_str());
-                }
-            } else {
-                httpCode = -10;
-            }
+        // If connected, start HTTP and perform request
+        HTTPClient& http = *conn->http;
+        // Set User-Agent header
+        http.setUserAgent(_userAgent.c_str());
+        // Job callbacks get the body as sent: no compression (the client may come from a resource fetch)
+        http.setAcceptEncoding(HTTP_IDENTITY_ENCODING);
+        // Add custom headers if provided
+        addCustomHeaders(http, job.customHeaders);
+
+        unsigned long requestMs = millis();
+        if (job.type == WebJob::GET) {
+            httpCode = http.GET();
         } else {
-            if (http.begin(plain_client, job.url.c_str())) {
-                // Set User-Agent header
-                http.setUserAgent(_userAgent.c_str());
-                
-                // Add custom headers if provided
-                if (!job.customHeaders.empty()) {
-                    // Parse and add headers (format: "Header1: Value1\nHeader2: Value2")
-                    PsramString headers = job.customHeaders;
-                    size_t pos = 0;
-                    while (pos < headers.length()) {
-                        size_t newlinePos = headers.find('\n', pos);
-                        if (newlinePos == PsramString::npos) newlinePos = headers.length();
-                        
-                        PsramString headerLine = headers.substr(pos, newlinePos - pos);
-                        size_t colonPos = headerLine.find(':');
-                        if (colonPos != PsramString::npos) {
-                            PsramString headerName = headerLine.substr(0, colonPos);
-                            PsramString headerValue = headerLine.substr(colonPos + 1);
-                            // Trim leading/trailing spaces
-                            while (!headerValue.empty() && headerValue[0] == ' ') headerValue = headerValue.substr(1);
-                            while (!headerValue.empty() && headerValue[headerValue.length()-1] == ' ') headerValue = headerValue.substr(0, headerValue.length()-1);
-                            http.addHeader(headerName.c_str(), headerValue.c_str());
-                            Log.printf("[WebDataManager] Added header: %s: %s\n", headerName.c_str(), headerValue.c_str());
-                        }
-                        pos = newlinePos + 1;
-                    }
-                }
-                
-                if (job.type == WebJob::GET) {
-                    httpCode = http.GET();
-                } else {
-                    http.addHeader("Content-Type", job.contentType.c_str());
-                    httpCode = http.POST(job.body.c_str());
-                }
-            } else {
-                httpCode = -10;
-            }
+            http.addHeader("Content-Type", job.contentType.c_str());
+            httpCode = http.POST(job.body.c_str());
         }
+        sample.phase_ms[FETCH_PHASE_TTFB] = millis() - requestMs;
+        // The server may have closed a kept-alive connection in the meantime: retry once on a new one
+        // (POST bodies are not sent twice)
+        if (httpCode >= 0 || !conn->reused || job.type != WebJob::GET) break;
+        releaseConnection(conn, false);
+        conn = nullptr;
     }
 
     // Now stream result into download buffer (avoid http.getString())
-    _downloadStream.begin(_downloadBuffer, _bufferCapacity);
+    worker.stream.reset();
 
     if (httpCode == HTTP_CODE_OK) {
         LOG_MEMORY_DETAILED("WebClient: Vor http.writeToStream");
-        http.writeToStream(&_downloadStream);
+        unsigned long bodyMs = millis();
+        conn->http->writeToStream(&worker.stream);
+        sample.phase_ms[FETCH_PHASE_BODY] = millis() - bodyMs;
+        sample.wire_bytes = sample.body_bytes = worker.stream.getSize();
+        sample.buffer_growths = worker.stream.growthCount();
         LOG_MEMORY_DETAILED("WebClient: Nach http.writeToStream");
-        if (_downloadStream.hasOverflowed()) {
-            Log.printf("[WebDataManager] LERNEN: Pufferüberlauf bei Job %s. Puffergröße=%u. Job liefert mehr Daten als erwartet.\n", job.url.c_str(), (unsigned)_downloadStream.getCapacity());
+        if (worker.stream.hasOverflowed()) {
+            Log.printf("[WebDataManager] FEHLER: Antwort von Job %s passt nicht in den Download-Puffer (%u Bytes).\n", job.url.c_str(), (unsigned)worker.stream.getSize());
             // Try to notify callbacks about failure / overflow
-            if (job.detailed_callback) {
-                job.detailed_callback(-2, "Buffer overflow", strlen("Buffer overflow"));
-            } else if (job.callback) {
-                job.callback(nullptr, 0);
-            }
+            deliverJobResult(job, false, -2, "Buffer overflow", strlen("Buffer overflow"));
         } else {
-            size_t downloaded_size = _downloadStream.getSize();
+            size_t downloaded_size = worker.stream.getSize();
             if (downloaded_size > 0) {
                 // allocate temporary buffer to hand to callback (synchronous only)
                 LOG_MEMORY_DETAILED("WebClient: Vor tmp_buf ps_malloc");
                 char* tmp_buf = (char*)ps_malloc(downloaded_size + 1);
                 LOG_MEMORY_DETAILED("WebClient: Nach tmp_buf ps_malloc");
                 if (tmp_buf) {
-                    memcpy(tmp_buf, _downloadStream.getBuffer(), downloaded_size);
+                    worker.stream.copyTo(tmp_buf);
                     tmp_buf[downloaded_size] = '\0';
 
-                    if (job.detailed_callback) {
-                        job.detailed_callback((int)httpCode, tmp_buf, downloaded_size);
-                    } else if (job.callback) {
-                        job.callback(tmp_buf, downloaded_size);
+                    deliverJobResult(job, true, httpCode, tmp_buf, downloaded_size);
+                    if (_captureEnabled.load()) {
+                        captureResponse(job.key, job.type == WebJob::GET ? "GET" : "POST", job.url, job.customHeaders,
+                                        job.body, httpCode, tmp_buf, downloaded_size);
                     }
 
                     LOG_MEMORY_DETAILED("WebClient: Vor tmp_buf free");
@@ -710,423 +1963,853 @@ void WebClientModule::performJob(const WebJob& job) {
                     LOG_MEMORY_DETAILED("WebClient: Nach tmp_buf free");
                 } else {
                     Log.printf("[WebDataManager] FEHLER: Konnte temporären Buffer (%u) für Job nicht allozieren.\n", (unsigned)downloaded_size);
-                    if (job.detailed_callback) {
-                        job.detailed_callback(-3, "Malloc failed", strlen("Malloc failed"));
-                    } else if (job.callback) {
-                        job.callback(nullptr, 0);
-                    }
+                    deliverJobResult(job, false, -3, "Malloc failed", strlen("Malloc failed"));
                 }
             } else {
                 // empty body but HTTP_OK - still call callback with zero size
-                if (job.detailed_callback) job.detailed_callback((int)httpCode, "", 0);
-                else if (job.callback) job.callback("", 0);
+                deliverJobResult(job, true, httpCode, "", 0);
             }
         }
     } else {
         // error path - prepare small error description
-        char errbuf[256];
-        if (httpCode == -1 && using_https) {
-            secure_client.lastError(errbuf, sizeof(errbuf));
+        if (httpCode == -1 && target.https) {
             size_t l = strnlen(errbuf, sizeof(errbuf));
-            if (job.detailed_callback) job.detailed_callback(httpCode, errbuf, l);
-            else if (job.callback) job.callback(nullptr, 0);
+            deliverJobResult(job, false, httpCode, errbuf, l);
         } else {
             // http.errorToString may allocate a String internally; use it but keep short-lived
-            String err = http.errorToString(httpCode);
+            String err = HTTPClient::errorToString(httpCode);
             size_t l = err.length();
             if (l >= sizeof(errbuf)) l = sizeof(errbuf) - 1;
             memcpy(errbuf, err.c_str(), l);
             errbuf[l] = '\0';
-            if (job.detailed_callback) job.detailed_callback(httpCode, errbuf, l);
-            else if (job.callback) job.callback(nullptr, 0);
+            deliverJobResult(job, false, httpCode, errbuf, l);
         }
     }
 
-    http.end();
-    // free cert_data (if any) as early as possible (will be freed on scope exit anyway)
-    cert_data.clear();
+    // Only a completely read body leaves the connection in a reusable state
+    releaseConnection(conn, httpCode == HTTP_CODE_OK && !worker.stream.hasOverflowed());
+    worker.stream.trim(deviceConfig->webClientBufferSize);
+    sample.http_code = httpCode;
+    recordTelemetry(nullptr, sample);
     LOG_MEMORY_STRATEGIC("WebClient: End performJob");
+    return httpCode;
 }
 
-// Helper function to safely calculate elapsed time in milliseconds, handling millis() rollover
-static inline unsigned long millisElapsed(unsigned long start, unsigned long now) {
-    // This handles rollover correctly because unsigned arithmetic wraps around
-    return now - start;
+void WebClientModule::rejectJob(WebJob& job) {
+    static const char message[] = "Host nicht erreichbar (Circuit Breaker offen)";
+    Log.printf("[WebDataManager] %s-Job für %s abgewiesen: Circuit Breaker offen.\n", (job.type == WebJob::GET ? "GET" : "POST"), job.url.c_str());
+    deliverJobResult(job, false, HTTPC_ERROR_CONNECTION_REFUSED, message, strlen(message));
 }
 
-void WebClientModule::webWorkerTask(void* param) {
-    WebClientModule* self = static_cast<WebClientModule*>(param);
-    Log.printf("[WebDataManager] Worker-Task gestartet auf Core %d.\n", xPortGetCoreID());
-    
-    WebJob* receivedJob;
-    const unsigned long MIN_PAUSE_BETWEEN_DOWNLOADS_MS = 10000UL; // 10 seconds
+void WebClientModule::deliverJobResult(WebJob& job, bool ok, int httpCode, const char* payload, size_t len) {
+    // From here on nobody joins: identical requests submitted later get their own download
+    PsramVector<JobWaiter> waiters;
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+        job.delivered = true;
+        waiters.swap(job.waiters);
+        xSemaphoreGive(_scheduleMutex);
+    }
+    for (const JobWaiter& waiter : waiters) {
+        if (waiter.detailed_callback) waiter.detailed_callback(httpCode, payload, len);
+        else if (waiter.callback) waiter.callback(ok ? payload : nullptr, ok ? len : 0);
+    }
+}
 
-    while (true) {
-        unsigned long nowMs = millis();
+// Heap order of the deadline heaps: earliest next_due_ms on top (wrap-safe)
+static bool resourceDueLater(const ManagedResource* a, const ManagedResource* b) {
+    return (long)(a->next_due_ms - b->next_due_ms) > 0;
+}
 
-        // enforce initial start delay of 10 seconds before any download happens
-        if (nowMs - self->_startMs < MIN_PAUSE_BETWEEN_DOWNLOADS_MS) {
-            vTaskDelay(pdMS_TO_TICKS(500));
-            continue;
+void WebClientModule::scheduleResource(ManagedResource& resource, unsigned long dueMs) {
+    PsramVector<ManagedResource*>& heap = _dueHeaps[resource.priority];
+    resource.next_due_ms = dueMs;
+    if (resource.scheduled) {
+        // Deadline of a queued resource changed
+        std::make_heap(heap.begin(), heap.end(), resourceDueLater);
+        return;
+    }
+    // Resources being fetched are scheduled again when the fetch finishes, paused ones on resume,
+    // dormant ones on their next access
+    if (resource.in_flight || resource.is_paused || resource.is_dormant) return;
+    heap.push_back(&resource);
+    std::push_heap(heap.begin(), heap.end(), resourceDueLater);
+    resource.scheduled = true;
+}
+
+void WebClientModule::unscheduleResource(ManagedResource& resource) {
+    if (!resource.scheduled) return;
+    PsramVector<ManagedResource*>& heap = _dueHeaps[resource.priority];
+    for (auto it = heap.begin(); it != heap.end(); ++it) {
+        if (*it == &resource) {
+            heap.erase(it);
+            std::make_heap(heap.begin(), heap.end(), resourceDueLater);
+            break;
         }
+    }
+    resource.scheduled = false;
+}
 
-        if (WiFi.status() == WL_CONNECTED) {
-            // Process queued jobs, but ensure minimum pause between downloads
-            if (xQueueReceive(self->jobQueue, &receivedJob, 0) == pdTRUE) {
-                // If last download happened too recently, push job back to front and wait
-                if (self->_lastDownloadMs != 0 && (nowMs - self->_lastDownloadMs) < MIN_PAUSE_BETWEEN_DOWNLOADS_MS) {
-                    // push back to queue front (so it will be retried)
-                    if (xQueueSendToFront(self->jobQueue, &receivedJob, pdMS_TO_TICKS(100)) != pdTRUE) {
-                        // if failed to put back, drop it gracefully after short wait
-                        Log.println("[WebDataManager] WARNUNG: Konnte Job nicht zurück in Queue einreihen, verwerfe.");
-                        receivedJob->~WebJob();  // Call destructor
-                        free(receivedJob);  // Free PSRAM memory
-                    }
-                    vTaskDelay(pdMS_TO_TICKS(200));
-                } else {
-                    // mark last download time and perform job
-                    self->_lastDownloadMs = millis();
-                    self->performJob(*receivedJob);
-                    receivedJob->~WebJob();  // Call destructor
-                    free(receivedJob);  // Free PSRAM memory
-                }
+unsigned long WebClientModule::nextDueMs(const ManagedResource& resource, unsigned long nowMs) const {
+    // Never fetched: due right away
+    if (resource.last_check_attempt_ms == 0) return nowMs;
+    return resource.last_check_attempt_ms + (resource.retry_delay_ms ? resource.retry_delay_ms : resource.update_interval_ms);
+}
+
+void WebClientModule::wakeWorkers() {
+    for (uint8_t i = 0; i < _workerCount; i++) {
+        if (_workers[i].taskHandle) xTaskNotifyGive(_workers[i].taskHandle);
+    }
+}
+
+HostLimiter& WebClientModule::hostLimiter(const PsramString& host) {
+    for (auto& limiter : _hosts) {
+        if (limiter.host == host) return limiter;
+    }
+    HostLimiter limiter;
+    limiter.host = host;
+    limiter.last_refill_ms = millis();
+    _hosts.push_back(limiter);
+    return _hosts.back();
+}
+
+bool WebClientModule::tryAcquireHost(const PsramString& host, unsigned long nowMs, bool bypassRateLimit, uint32_t& waitMs) {
+    HostLimiter& limiter = hostLimiter(host);
+    if (limiter.busy) {
+        // releaseHost() wakes the workers
+        limiter.contended = true;
+        return false;
+    }
+
+    // Open circuit: nothing goes to this host until the cool-down is over
+    if (limiter.circuit == HostLimiter::CIRCUIT_OPEN) {
+        long untilProbe = (long)(limiter.open_until_ms - nowMs);
+        if (untilProbe > 0) {
+            if ((uint32_t)untilProbe < waitMs) waitMs = (uint32_t)untilProbe;
+            return false;
+        }
+    }
+
+    // Refill the bucket
+    unsigned long elapsed = millisElapsed(limiter.last_refill_ms, nowMs);
+    limiter.tokens += (float)elapsed / WEBCLIENT_HOST_REFILL_MS;
+    if (limiter.tokens > WEBCLIENT_HOST_BURST) limiter.tokens = WEBCLIENT_HOST_BURST;
+    limiter.last_refill_ms = nowMs;
+
+    if (limiter.tokens < 1.0f && !bypassRateLimit) {
+        // Sleep until the next token is available
+        uint32_t untilToken = (uint32_t)((1.0f - limiter.tokens) * WEBCLIENT_HOST_REFILL_MS) + 1;
+        if (untilToken < waitMs) waitMs = untilToken;
+        return false;
+    }
+    if (limiter.tokens >= 1.0f) limiter.tokens -= 1.0f;
+    if (limiter.circuit == HostLimiter::CIRCUIT_OPEN) {
+        // Cool-down over: this request is the single probe (busy keeps everything else out)
+        limiter.circuit = HostLimiter::CIRCUIT_PROBING;
+        Log.printf("[WebDataManager] Circuit Breaker %s: Probe-Anfrage.\n", host.c_str());
+    }
+    limiter.busy = true;
+    return true;
+}
+
+// Failures that say something about the host rather than the request:
+// no connection, timeouts, server errors and throttling
+static bool isHostFailure(int httpCode) {
+    return httpCode < 0 || httpCode >= 500 || httpCode == 429;
+}
+
+bool WebClientModule::releaseHost(const PsramString& host, int httpCode) {
+    HostLimiter& limiter = hostLimiter(host);
+    limiter.busy = false;
+    if (!isHostFailure(httpCode)) {
+        if (limiter.circuit != HostLimiter::CIRCUIT_CLOSED) {
+            Log.printf("[WebDataManager] Circuit Breaker %s: geschlossen, Host antwortet wieder.\n", host.c_str());
+        }
+        limiter.circuit = HostLimiter::CIRCUIT_CLOSED;
+        limiter.failures = 0;
+        limiter.cooldown_ms = 0;
+    } else {
+        if (limiter.failures < UINT16_MAX) limiter.failures++;
+        bool probeFailed = (limiter.circuit == HostLimiter::CIRCUIT_PROBING);
+        if (probeFailed || limiter.failures >= WEBCLIENT_BREAKER_THRESHOLD) {
+            // A failed probe doubles the cool-down, a fresh opening starts with the base cool-down
+            uint32_t cooldown = WEBCLIENT_BREAKER_COOLDOWN_MS;
+            if (probeFailed && limiter.cooldown_ms > 0) {
+                cooldown = std::min<uint32_t>(limiter.cooldown_ms * 2, WEBCLIENT_BREAKER_MAX_COOLDOWN_MS);
             }
+            if (!probeFailed) limiter.trips++;
+            limiter.circuit = HostLimiter::CIRCUIT_OPEN;
+            limiter.cooldown_ms = cooldown;
+            limiter.open_until_ms = millis() + cooldown;
+            Log.printf("[WebDataManager] Circuit Breaker %s: offen nach %u Fehlern in Folge, Probe in %us.\n",
+                       host.c_str(), (unsigned)limiter.failures, (unsigned)(cooldown / 1000));
+        }
+    }
+    bool contended = limiter.contended;
+    limiter.contended = false;
+    return contended;
+}
 
-            // Periodic resource updates
-            time_t now;
-            time(&now);
-            unsigned long nowMs = millis();
-            
-            // First pass: find priority resources that are due
-            ManagedResource* priority_resource = nullptr;
-            for (auto& resource : self->resources) {
-                // Skip paused resources
-                if (resource.is_paused) continue;
-                
-                // Check if this priority resource is due
-                if (resource.has_priority) {
-                    bool should_run = false;
-                    if (resource.is_in_retry_mode) {
-                        // Use millisecond timing for retry consistency
-                        if (resource.use_ms_timing) {
-                            if (resource.last_check_attempt_ms == 0 || millisElapsed(resource.last_check_attempt_ms, nowMs) >= 30000UL) {
-                                should_run = true;
-                            }
-                        } else {
-                            if ((now - resource.last_check_attempt) * 1000UL >= 30000UL) {
-                                should_run = true;
-                            }
-                        }
-                    } else {
-                        if (resource.use_ms_timing) {
-                            if (resource.last_check_attempt_ms == 0 || millisElapsed(resource.last_check_attempt_ms, nowMs) >= resource.update_interval_ms) {
-                                should_run = true;
-                            }
-                        } else {
-                            if (resource.last_check_attempt == 0 || (now - resource.last_check_attempt) * 1000UL >= resource.update_interval_ms) {
-                                should_run = true;
-                            }
-                        }
-                    }
-                    
-                    if (should_run) {
-                        priority_resource = &resource;
-                        break;  // Execute first priority resource found
-                    }
-                }
+WebJob* WebClientModule::takeRunnableJob(unsigned long nowMs, uint32_t& waitMs, bool& rejected) {
+    // Classes in order, first come first served within a class; a job for a limited host
+    // does not hold up jobs for other hosts
+    for (uint8_t cls = 0; cls < JOB_PRIORITY_COUNT; cls++) {
+        PsramVector<WebJob*>& queue = _jobQueues[cls];
+        // Somebody in the web UI is waiting: not held back by the token bucket
+        bool bypassRateLimit = (cls == JOB_PRIORITY_INTERACTIVE);
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            WebJob* job = *it;
+            PsramString host = hostFromUrl(job->url);
+            HostLimiter& limiter = hostLimiter(host);
+            if (limiter.circuit == HostLimiter::CIRCUIT_OPEN && (long)(limiter.open_until_ms - nowMs) > 0) {
+                // Jobs have a caller waiting for the answer: fail fast instead of holding them for the cool-down
+                limiter.rejected++;
+                queue.erase(it);
+                rejected = true;
+                return job;
             }
-            
-            // If we found a priority resource that's due, execute it immediately (skip minimum pause)
-            if (priority_resource != nullptr) {
-                Log.printf("[WebDataManager] Prioritäts-Ressource wird ausgeführt: %s\n", priority_resource->url.c_str());
-                if (priority_resource->use_ms_timing) {
-                    priority_resource->last_check_attempt_ms = millis();
+            if (tryAcquireHost(host, nowMs, bypassRateLimit, waitMs)) {
+                queue.erase(it);
+                job->running = true;
+                _runningJobs.push_back(job);
+                for (const JobWaiter& waiter : job->waiters) {
+                    _jobStats.wait[cls].add(millisElapsed(waiter.enqueued_ms, nowMs));
                 }
-                self->_lastDownloadMs = millis();
-                self->performUpdate(*priority_resource);
-            } else {
-                // Normal resource processing
-                for (auto& resource : self->resources) {
-                    // Skip paused resources
-                    if (resource.is_paused) continue;
-                    
-                    bool should_run = false;
-                    if (resource.is_in_retry_mode) {
-                        // Use millisecond timing for retry consistency when available
-                        if (resource.use_ms_timing) {
-                            if (millisElapsed(resource.last_check_attempt_ms, nowMs) >= 30000UL) {
-                                should_run = true;
-                            }
-                        } else {
-                            if ((now - resource.last_check_attempt) * 1000UL >= 30000UL) {
-                                should_run = true;
-                            }
-                        }
-                    } else {
-                        // For resources with millisecond-precise tracking, use millisecond comparison
-                        if (resource.use_ms_timing) {
-                            if (resource.last_check_attempt_ms == 0 || millisElapsed(resource.last_check_attempt_ms, nowMs) >= resource.update_interval_ms) {
-                                should_run = true;
-                            }
-                        } else {
-                            // Fallback to second-based comparison for legacy resources
-                            if (resource.last_check_attempt == 0 || (now - resource.last_check_attempt) * 1000UL >= resource.update_interval_ms) {
-                                should_run = true;
-                            }
-                        }
-                    }
-
-                    if (should_run) {
-                        // Respect global minimum pause between downloads
-                        unsigned long nowMsInner = millis();
-                        if (self->_lastDownloadMs != 0 && millisElapsed(self->_lastDownloadMs, nowMsInner) < MIN_PAUSE_BETWEEN_DOWNLOADS_MS) {
-                            // skip this resource for now; next loop will retry
-                            continue;
-                        }
+                return job;
+            }
+        }
+    }
+    return nullptr;
+}
 
-                        // All good: perform update and record last download time
-                        // Set millisecond timestamp for resources using millisecond timing
-                        if (resource.use_ms_timing) {
-                            resource.last_check_attempt_ms = millis();
-                        }
-                        self->_lastDownloadMs = millis();
-                        self->performUpdate(resource);
-                        break;  // Process only one resource per iteration to avoid overload
-                    }
+ManagedResource* WebClientModule::takeDueResource(unsigned long nowMs, uint32_t& waitMs) {
+    // Classes in order, within a class the earliest deadline first
+    for (uint8_t cls = 0; cls < RESOURCE_PRIORITY_COUNT; cls++) {
+        PsramVector<ManagedResource*>& heap = _dueHeaps[cls];
+        // High priority resources are not held back by the token bucket
+        // (but still consume tokens and respect the one-request-per-host rule)
+        bool bypassRateLimit = (cls == RESOURCE_PRIORITY_HIGH);
+
+        // The heap is [0, heapSize), due resources whose host is not available are set aside behind it
+        size_t heapSize = heap.size();
+        ManagedResource* taken = nullptr;
+        while (heapSize > 0 && !taken) {
+            ManagedResource* top = heap.front();
+            if (!top->is_paused) {
+                long untilDue = (long)(top->next_due_ms - nowMs);
+                if (untilDue > 0) {
+                    if ((uint32_t)untilDue < waitMs) waitMs = (uint32_t)untilDue;
+                    break;
                 }
             }
+            std::pop_heap(heap.begin(), heap.begin() + heapSize, resourceDueLater);
+            heapSize--;
+            if (top->is_paused) {
+                // Paused resources leave the heap, resume schedules them again
+                heap.erase(heap.begin() + heapSize);
+                top->scheduled = false;
+            } else if (tryAcquireHost(top->host, nowMs, bypassRateLimit, waitMs)) {
+                heap.erase(heap.begin() + heapSize);
+                top->scheduled = false;
+                taken = top;
+            }
+        }
+        // Put the set-aside resources back
+        while (heapSize < heap.size()) {
+            heapSize++;
+            std::push_heap(heap.begin(), heap.begin() + heapSize, resourceDueLater);
+        }
+
+        if (taken) {
+            taken->in_flight = true;
+            taken->last_check_attempt_ms = nowMs;
+            return taken;
         }
-        vTaskDelay(pdMS_TO_TICKS(500));
     }
+    return nullptr;
 }
 
-// performUpdate unchanged except cert discovery replaces previous deviceConfig cert-field usage
-void WebClientModule::performUpdate(ManagedResource& resource) {
-    LOG_MEMORY_STRATEGIC("WebClient: Begin performUpdate");
-    Log.printf("[WebDataManager] Starte Update für %s...\n", resource.url.c_str());
-    resource.last_check_attempt = time(nullptr);
-    bool retry_with_larger_buffer;
-    int max_growth_retries = 3;
+void WebClientModule::webWorkerTask(void* param) {
+    FetchWorker* worker = static_cast<FetchWorker*>(param);
+    WebClientModule* self = worker->owner;
+    Log.printf("[WebDataManager] Worker %u gestartet auf Core %d.\n", worker->index, xPortGetCoreID());
 
-    do {
-        retry_with_larger_buffer = false;
-        HTTPClient http;
-        
-        int httpCode = 0;
-        WiFiClientSecure secure_client;
-        WiFiClient plain_client;
-
-        if (resource.url.rfind("https://", 0) == 0) {
-            PsramString cert_data;
-            bool cert_loaded = false;
-            PsramString filepath;
-
-            // determine host
-            PsramString host;
-            uint16_t port = 443;
-            int hostStart = indexOf(resource.url, "://") + 3;
-            int pathStart = indexOf(resource.url, "/", hostStart);
-            host = (pathStart != -1) ? resource.url.substr(hostStart, pathStart - hostStart) : resource.url.substr(hostStart);
-            int colonPos = indexOf(host, ":");
-            if (colonPos != -1) {
-                PsramString portStr = host.substr(colonPos + 1);
-                port = (uint16_t)atoi(portStr.c_str());
-                host = host.substr(0, colonPos);
+    while (true) {
+        unsigned long nowMs = millis();
+        // Sleep until the earliest deadline, a token refill or a notification (new job, registration, resume, host released)
+        uint32_t waitMs = WEBCLIENT_WAIT_FOREVER;
+
+        if (WiFi.status() != WL_CONNECTED) {
+            waitMs = WEBCLIENT_WIFI_POLL_MS;
+        } else if (millisElapsed(self->_startMs, nowMs) < WEBCLIENT_START_DELAY_MS) {
+            // enforce initial start delay before any download happens
+            waitMs = WEBCLIENT_START_DELAY_MS - millisElapsed(self->_startMs, nowMs);
+        } else {
+            WebJob* job = nullptr;
+            ManagedResource* resource = nullptr;
+            bool rejected = false;
+            if (xSemaphoreTake(self->_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+                job = self->takeRunnableJob(nowMs, waitMs, rejected);
+                if (!job) {
+                    resource = self->takeDueResource(nowMs, waitMs);
+                }
+                xSemaphoreGive(self->_scheduleMutex);
             }
 
-            // first try to find cert by host names in /certs
-            PsramString found = findCertFilenameForHost(host);
-            if (!found.empty()) {
-                filepath = PsramString("/certs/") + found;
-                if (LittleFS.exists(filepath.c_str())) {
-                    File certFile = LittleFS.open(filepath.c_str(), "r");
-                    if (certFile) {
-                        cert_data = readFromStream(certFile);
-                        certFile.close();
-                        cert_loaded = true;
-                        resource.cert_filename = found; // record which file was used
-                    }
-                }
+            if (job && rejected) {
+                // The host was not acquired, nothing to release
+                self->rejectJob(*job);
+                job->~WebJob();
+                free(job);
+                continue;
             }
 
-            // fallback: if resource already has cert_filename configured, try it
-            if (!cert_loaded && !resource.cert_filename.empty()) {
-                filepath = PsramString("/certs/") + resource.cert_filename;
-                if (LittleFS.exists(filepath.c_str())) {
-                    File certFile = LittleFS.open(filepath.c_str(), "r");
-                    if (certFile) {
-                        cert_data = readFromStream(certFile);
-                        certFile.close();
-                        cert_loaded = true;
-                    }
+            if (job) {
+                // Ad-hoc jobs go first
+                PsramString host = hostFromUrl(job->url);
+                int httpCode = self->performJob(*worker, *job);
+                bool wake = false;
+                if (xSemaphoreTake(self->_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+                    self->_runningJobs.erase(std::find(self->_runningJobs.begin(), self->_runningJobs.end(), job));
+                    wake = self->releaseHost(host, httpCode);
+                    xSemaphoreGive(self->_scheduleMutex);
                 }
+                job->~WebJob();  // Call destructor
+                free(job);  // Free PSRAM memory
+                if (wake) self->wakeWorkers();
+                continue;
             }
 
-            // fallback to root_ca_fallback in resource
-            if (!cert_loaded && resource.root_ca_fallback) {
-                Log.printf("[WebDataManager] Verwende Fallback-Zertifikat für %s.\n", resource.url.c_str());
-                secure_client.setCACert(resource.root_ca_fallback);
-            } else if (!cert_loaded) {
-                Log.printf("[WebDataManager] WARNUNG: Kein Zertifikat gefunden. Verwende unsichere Verbindung für %s.\n", resource.url.c_str());
-                secure_client.setInsecure();
-            } else {
-                Log.printf("[WebDataManager] Verwende Zertifikat aus Datei '%s' für %s.\n", filepath.c_str(), resource.url.c_str());
-                secure_client.setCACert(cert_data.c_str());
-            }
-            
-            if (!secure_client.connect(host.c_str(), port)) {
-                httpCode = -1;
-            } else {
-                if (http.begin(secure_client, resource.url.c_str())) {
-                     // Set User-Agent header
-                     http.setUserAgent(_userAgent.c_str());
-                     http.setTimeout(15000);
-                     // Add custom headers if present
-                     if (!resource.customHeaders.empty()) {
-                         PsramString headers = resource.customHeaders;
-                         size_t pos = 0;
-                         while (pos < headers.length()) {
-                             size_t newlinePos = headers.find('\n', pos);
-                             if (newlinePos == PsramString::npos) newlinePos = headers.length();
-                             
-                             PsramString headerLine = headers.substr(pos, newlinePos - pos);
-                             size_t colonPos = headerLine.find(':');
-                             if (colonPos != PsramString::npos) {
-                                 PsramString name = headerLine.substr(0, colonPos);
-                                 PsramString value = headerLine.substr(colonPos + 1);
-                                 // Trim leading/trailing whitespace from value
-                                 while (!value.empty() && (value[0] == ' ' || value[0] == '\t')) {
-                                     value = value.substr(1);
-                                 }
-                                 while (!value.empty() && (value[value.length()-1] == ' ' || value[value.length()-1] == '\t' || value[value.length()-1] == '\r')) {
-                                     value = value.substr(0, value.length()-1);
-                                 }
-                                 http.addHeader(name.c_str(), value.c_str());
-                                 Log.printf("[WebDataManager] Added header: %s: %s\n", name.c_str(), value.c_str());
-                             }
-                             pos = newlinePos + 1;
-                         }
-                     }
-                     httpCode = http.GET();
-                } else {
-                    httpCode = -10;
+            if (resource) {
+                if (resource->priority == RESOURCE_PRIORITY_HIGH) {
+                    Log.printf("[WebDataManager] Prioritäts-Ressource wird ausgeführt: %s\n", resource->url.c_str());
                 }
-            }
-        } else {
-            if (http.begin(plain_client, resource.url.c_str())) {
-                // Set User-Agent header
-                http.setUserAgent(_userAgent.c_str());
-                http.setTimeout(15000);
-                // Add custom headers if present
-                if (!resource.customHeaders.empty()) {
-                    PsramString headers = resource.customHeaders;
-                    size_t pos = 0;
-                    while (pos < headers.length()) {
-                        size_t newlinePos = headers.find('\n', pos);
-                        if (newlinePos == PsramString::npos) newlinePos = headers.length();
-                        
-                        PsramString headerLine = headers.substr(pos, newlinePos - pos);
-                        size_t colonPos = headerLine.find(':');
-                        if (colonPos != PsramString::npos) {
-                            PsramString name = headerLine.substr(0, colonPos);
-                            PsramString value = headerLine.substr(colonPos + 1);
-                            // Trim leading/trailing whitespace from value
-                            while (!value.empty() && (value[0] == ' ' || value[0] == '\t')) {
-                                value = value.substr(1);
-                            }
-                            while (!value.empty() && (value[value.length()-1] == ' ' || value[value.length()-1] == '\t' || value[value.length()-1] == '\r')) {
-                                value = value.substr(0, value.length()-1);
-                            }
-                            http.addHeader(name.c_str(), value.c_str());
-                            Log.printf("[WebDataManager] Added header: %s: %s\n", name.c_str(), value.c_str());
-                        }
-                        pos = newlinePos + 1;
-                    }
+                int httpCode = self->performUpdate(*worker, *resource);
+                bool wake = false;
+                bool destroy = false;
+                if (xSemaphoreTake(self->_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+                    resource->in_flight = false;
+                    wake = self->releaseHost(resource->host, httpCode);
+                    // Unregistered during the download: nobody else references it any more
+                    destroy = resource->removed;
+                    if (!destroy) self->scheduleResource(*resource, self->nextDueMs(*resource, millis()));
+                    xSemaphoreGive(self->_scheduleMutex);
                 }
-                httpCode = http.GET();
-            } else {
-                httpCode = -10;
+                if (destroy) self->destroyResource(resource);
+                if (wake) self->wakeWorkers();
+                continue;
             }
+
+            // Nothing to do: close kept-alive connections nobody used for a while
+            uint32_t idleWaitMs = self->closeIdleConnections(nowMs);
+            if (idleWaitMs < waitMs) waitMs = idleWaitMs;
         }
 
-        _downloadStream.begin(_downloadBuffer, _bufferCapacity);
+        TickType_t ticks = (waitMs == WEBCLIENT_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(waitMs);
+        ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+    }
+}
 
-        if (httpCode == HTTP_CODE_OK) {
-            LOG_MEMORY_DETAILED("WebClient: Vor http.writeToStream in performUpdate");
-            http.writeToStream(&_downloadStream);
-            LOG_MEMORY_DETAILED("WebClient: Nach http.writeToStream in performUpdate");
-            if (_downloadStream.hasOverflowed()) {
-                Log.printf("[WebClientModule] LERNEN: Pufferüberlauf bei %s. Puffer wird vergrößert.\n", resource.url.c_str());
-                size_t new_capacity = ((_downloadStream.getCapacity() / (128 * 1024)) + 1) * (128 * 1024);
-                if (reallocateBuffer(new_capacity)) {
-                    deviceConfig->webClientBufferSize = new_capacity;
-                    saveDeviceConfig();
-                    retry_with_larger_buffer = true;
-                } else {
-                    Log.println("[WebClientModule] FEHLER: Puffer konnte nicht vergrößert werden. Update für diese Ressource abgebrochen.");
-                }
-            } else {
-                size_t downloaded_size = _downloadStream.getSize();
-                if (downloaded_size > 0) {
-                    LOG_MEMORY_DETAILED("WebClient: Vor permanent ps_malloc in performUpdate");
-                    char* new_permanent_buffer = (char*)ps_malloc(downloaded_size + 1);
-                    LOG_MEMORY_DETAILED("WebClient: Nach permanent ps_malloc in performUpdate");
-                    if (new_permanent_buffer) {
-                        memcpy(new_permanent_buffer, _downloadStream.getBuffer(), downloaded_size);
-                        new_permanent_buffer[downloaded_size] = '\0';
-                        if (xSemaphoreTake(resource.mutex, portMAX_DELAY) == pdTRUE) {
-                            if (resource.data_buffer) {
-                                LOG_MEMORY_DETAILED("WebClient: Vor free old data_buffer");
-                                free(resource.data_buffer);
-                                LOG_MEMORY_DETAILED("WebClient: Nach free old data_buffer");
-                            }
-                            resource.data_buffer = new_permanent_buffer;
-                            resource.data_size = downloaded_size;
-                            time(&resource.last_successful_update);
-                            resource.is_data_stale = false;
-                            xSemaphoreGive(resource.mutex);
-                            Log.printf("[WebDataManager] ERFOLG: %s aktualisiert (%u Bytes).\n", resource.url.c_str(), (unsigned int)downloaded_size);
-                        } else {
-                            LOG_MEMORY_DETAILED("WebClient: Vor free new_permanent_buffer (failed mutex)");
-                            free(new_permanent_buffer);
-                            LOG_MEMORY_DETAILED("WebClient: Nach free new_permanent_buffer (failed mutex)");
-                        }
-                    } else {
-                        Log.printf("[WebClientModule] FEHLER: Konnte keinen passgenauen Puffer für %s allozieren.\n", resource.url.c_str());
-                    }
+// --- Connection pool ---
+
+WiFiClient& PooledConnection::socket() {
+    if (secure_client) return *secure_client;
+    return *plain_client;
+}
+
+PooledConnection* WebClientModule::createConnection(const RequestTarget& target, const char* caCert) {
+    // Allocate the pool entry, the HTTP client and the socket in PSRAM
+    void* mem = ps_malloc(sizeof(PooledConnection));
+    void* httpMem = ps_malloc(sizeof(HTTPClient));
+    void* clientMem = ps_malloc(target.https ? sizeof(WiFiClientSecure) : sizeof(WiFiClient));
+    if (!mem || !httpMem || !clientMem) {
+        if (mem) free(mem);
+        if (httpMem) free(httpMem);
+        if (clientMem) free(clientMem);
+        return nullptr;
+    }
+    PooledConnection* conn = new (mem) PooledConnection();
+    conn->host = target.host;
+    conn->port = target.port;
+    conn->secure = target.https;
+    if (caCert) conn->ca_cert = caCert;
+    conn->http = new (httpMem) HTTPClient();
+    conn->http->setReuse(true);
+    if (target.https) {
+        conn->secure_client = new (clientMem) WiFiClientSecure();
+    } else {
+        conn->plain_client = new (clientMem) WiFiClient();
+    }
+    _connections.push_back(conn);
+    return conn;
+}
+
+void WebClientModule::destroyConnection(PooledConnection* conn) {
+    for (auto it = _connections.begin(); it != _connections.end(); ++it) {
+        if (*it == conn) {
+            _connections.erase(it);
+            break;
+        }
+    }
+    // Stopping the socket frees the TLS context (internal heap)
+    conn->socket().stop();
+    conn->http->~HTTPClient();
+    free(conn->http);
+    if (conn->secure_client) {
+        conn->secure_client->~WiFiClientSecure();
+        free(conn->secure_client);
+    }
+    if (conn->plain_client) {
+        conn->plain_client->~WiFiClient();
+        free(conn->plain_client);
+    }
+    conn->~PooledConnection();
+    free(conn);
+}
+
+PooledConnection* WebClientModule::acquireConnection(const RequestTarget& target, const char* caCert, char* error, size_t errorSize, FetchSample& sample) {
+    PooledConnection* conn = nullptr;
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) != pdTRUE) return nullptr;
+
+    // Reuse an idle connection to the same host that was set up with the same CA
+    for (PooledConnection* candidate : _connections) {
+        if (!candidate->in_use && candidate->secure == target.https && candidate->port == target.port &&
+            candidate->host == target.host && (caCert ? candidate->ca_cert.compare(caCert) == 0 : candidate->ca_cert.empty())) {
+            conn = candidate;
+            break;
+        }
+    }
+
+    if (!conn) {
+        // Session cap: close the least recently used idle connection first
+        if (_connections.size() >= _maxSessions) {
+            unsigned long nowMs = millis();
+            PooledConnection* oldest = nullptr;
+            for (PooledConnection* candidate : _connections) {
+                if (candidate->in_use) continue;
+                if (!oldest || millisElapsed(candidate->last_used_ms, nowMs) > millisElapsed(oldest->last_used_ms, nowMs)) {
+                    oldest = candidate;
                 }
-                resource.retry_count = 0;
-                resource.is_in_retry_mode = false;
             }
+            if (oldest) destroyConnection(oldest);
+        }
+        conn = createConnection(target, caCert);
+    }
+    if (conn) conn->in_use = true;
+    xSemaphoreGive(_scheduleMutex);
+
+    if (!conn) {
+        snprintf(error, errorSize, "Keine Verbindung allozierbar");
+        return nullptr;
+    }
+
+    conn->reused = conn->socket().connected();
+    if (conn->reused) {
+        recordConnection(target.host, false, 0);
+        return conn;
+    }
+
+    // Full (TLS) handshake
+    if (conn->secure_client) {
+        if (!conn->ca_cert.empty()) {
+            conn->secure_client->setCACert(conn->ca_cert.c_str());
         } else {
-            resource.retry_count++;
-            resource.is_data_stale = true;
-            
-            String errorMsg;
-            if (httpCode > 0) {
-                errorMsg = "HTTP-Code " + String(httpCode);
-            } else if (httpCode == -1) {
-                char error_buf[128];
-                secure_client.lastError(error_buf, sizeof(error_buf));
-                errorMsg = "Connect-Fehler: " + String(error_buf);
+            conn->secure_client->setInsecure();
+        }
+    }
+    // Resolved separately only to time it; connect() below gets the answer from the lwIP DNS cache
+    unsigned long startMs = millis();
+    IPAddress address;
+    if (!WiFi.hostByName(target.host.c_str(), address)) {
+        snprintf(error, errorSize, "DNS-Auflösung von %s fehlgeschlagen", target.host.c_str());
+        if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+            destroyConnection(conn);
+            xSemaphoreGive(_scheduleMutex);
+        }
+        return nullptr;
+    }
+    sample.phase_ms[FETCH_PHASE_DNS] = millis() - startMs;
+    startMs = millis();
+    if (!conn->socket().connect(target.host.c_str(), target.port)) {
+        if (conn->secure_client) conn->secure_client->lastError(error, errorSize);
+        if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+            destroyConnection(conn);
+            xSemaphoreGive(_scheduleMutex);
+        }
+        return nullptr;
+    }
+    uint32_t handshakeMs = millis() - startMs;
+    sample.phase_ms[conn->secure_client ? FETCH_PHASE_TLS : FETCH_PHASE_CONNECT] = handshakeMs;
+    recordConnection(target.host, true, handshakeMs);
+    return conn;
+}
+
+void WebClientModule::releaseConnection(PooledConnection* conn, bool reusable) {
+    if (!conn) return;
+    // end() keeps the socket open if the server allows keep-alive
+    conn->http->end();
+    bool keep = reusable && conn->socket().connected();
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) == pdTRUE) {
+        if (keep) {
+            conn->in_use = false;
+            conn->last_used_ms = millis();
+        } else {
+            destroyConnection(conn);
+        }
+        xSemaphoreGive(_scheduleMutex);
+    }
+}
+
+uint32_t WebClientModule::closeIdleConnections(unsigned long nowMs) {
+    uint32_t waitMs = WEBCLIENT_WAIT_FOREVER;
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) != pdTRUE) return waitMs;
+    for (size_t i = _connections.size(); i > 0; i--) {
+        PooledConnection* conn = _connections[i - 1];
+        if (conn->in_use) continue;
+        unsigned long idleMs = millisElapsed(conn->last_used_ms, nowMs);
+        if (idleMs >= WEBCLIENT_SESSION_IDLE_MS) {
+            destroyConnection(conn);
+        } else if (WEBCLIENT_SESSION_IDLE_MS - idleMs < waitMs) {
+            waitMs = WEBCLIENT_SESSION_IDLE_MS - idleMs;
+        }
+    }
+    xSemaphoreGive(_scheduleMutex);
+    return waitMs;
+}
+
+void WebClientModule::recordConnection(const PsramString& host, bool handshake, uint32_t handshakeMs) {
+    if (xSemaphoreTake(_scheduleMutex, portMAX_DELAY) != pdTRUE) return;
+    HostLimiter& limiter = hostLimiter(host);
+    if (handshake) {
+        limiter.handshakes++;
+        limiter.handshake_ms_total += handshakeMs;
+        if (handshakeMs > limiter.handshake_ms_max) limiter.handshake_ms_max = handshakeMs;
+    } else {
+        limiter.reused++;
+    }
+    xSemaphoreGive(_scheduleMutex);
+}
+
+// --- CA certificate cache ---
+
+bool WebClientModule::loadCaCert(const PsramString& host, const PsramString& configuredFile, PsramString& certData, PsramString& usedFile) {
+    // Files in /certs matching the host (then its parent domains) first, then the configured file.
+    // The result - including "no certificate" - is cached until invalidateCertCache().
+    if (xSemaphoreTake(_certMutex, portMAX_DELAY) == pdTRUE) {
+        for (const CachedCert& entry : _certCache) {
+            if (entry.host == host && entry.configured_file == configuredFile) {
+                _certCacheHits++;
+                certData = entry.pem;
+                usedFile = entry.filename;
+                xSemaphoreGive(_certMutex);
+                return !certData.empty();
             }
-            else {
-                errorMsg = http.errorToString(httpCode);
+        }
+        _certCacheMisses++;
+        xSemaphoreGive(_certMutex);
+    }
+
+    CachedCert entry;
+    entry.host = host;
+    entry.configured_file = configuredFile;
+    PsramString found = findCertFilenameForHost(host);
+    if (found.empty()) found = configuredFile;
+    if (!found.empty()) {
+        PsramString filepath = PsramString("/certs/") + found;
+        if (LittleFS.exists(filepath.c_str())) {
+            File certFile = LittleFS.open(filepath.c_str(), "r");
+            if (certFile) {
+                entry.pem = readFromStream(certFile);
+                certFile.close();
+                if (!entry.pem.empty()) entry.filename = found;
             }
+        }
+    }
 
-            if (resource.retry_count >= 3) {
-                Log.printf("[WebDataManager] FEHLER bei %s: %s. Max. Retries (%d) erreicht.\n", resource.url.c_str(), errorMsg.c_str(), resource.retry_count);
-                resource.retry_count = 0;
-                resource.is_in_retry_mode = false;
-            } else {
-                Log.printf("[WebDataManager] FEHLER bei %s: %s. Versuch %d/3 in 30s.\n", resource.url.c_str(), errorMsg.c_str(), resource.retry_count);
-                resource.is_in_retry_mode = true;
+    certData = entry.pem;
+    usedFile = entry.filename;
+    if (xSemaphoreTake(_certMutex, portMAX_DELAY) == pdTRUE) {
+        _certCache.push_back(entry);
+        xSemaphoreGive(_certMutex);
+    }
+    return !certData.empty();
+}
+
+void WebClientModule::invalidateCertCache() {
+    if (xSemaphoreTake(_certMutex, portMAX_DELAY) != pdTRUE) return;
+    size_t entries = _certCache.size();
+    _certCache.clear();
+    _certCache.shrink_to_fit();
+    xSemaphoreGive(_certMutex);
+    if (entries > 0) {
+        Log.printf("[WebDataManager] Zertifikat-Cache geleert (%u Einträge).\n", (unsigned)entries);
+    }
+}
+
+void WebClientModule::getCertCacheStats(uint32_t& hits, uint32_t& misses, size_t& entries) {
+    hits = 0;
+    misses = 0;
+    entries = 0;
+    if (xSemaphoreTake(_certMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        hits = _certCacheHits;
+        misses = _certCacheMisses;
+        entries = _certCache.size();
+        xSemaphoreGive(_certMutex);
+    }
+}
+
+PsramVector<HostLimiter> WebClientModule::getHostStats() {
+    PsramVector<HostLimiter> stats;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        stats = _hosts;
+        xSemaphoreGive(_scheduleMutex);
+    }
+    return stats;
+}
+
+size_t WebClientModule::getOpenConnectionCount() {
+    size_t count = 0;
+    if (xSemaphoreTake(_scheduleMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        count = _connections.size();
+        xSemaphoreGive(_scheduleMutex);
+    }
+    return count;
+}
+
+void WebClientModule::prepareResourceRequest(HTTPClient& http, const ManagedResource& resource) {
+    // Set User-Agent header
+    http.setUserAgent(_userAgent.c_str());
+    http.setTimeout(15000);
+    // Add custom headers if present
+    addCustomHeaders(http, resource.customHeaders);
+    // Conditional GET: only useful while we (or the stream consumer) still hold the body the validators belong to
+    if (resource.data || (resource.stream_consumer && resource.last_successful_update != 0)) {
+        if (!resource.etag.empty()) http.addHeader("If-None-Match", resource.etag.c_str());
+        if (!resource.last_modified.empty()) http.addHeader("If-Modified-Since", resource.last_modified.c_str());
+    }
+    // Compressed bodies are inflated while they are received (InflateStream)
+    http.setAcceptEncoding("gzip, deflate");
+    http.collectHeaders(RESOURCE_RESPONSE_HEADERS, 3);
+}
+
+void WebClientModule::recordFailure(ManagedResource& resource, const String& errorMsg) {
+    if (resource.failure_count < UINT16_MAX) resource.failure_count++;
+    resource.is_data_stale = true;
+
+    // Exponential backoff, capped; resources with a longer interval back off up to their interval
+    uint32_t capMs = std::max<uint32_t>(WEBCLIENT_RETRY_MAX_MS, resource.update_interval_ms);
+    uint32_t delayMs = capMs;
+    if (resource.failure_count <= 16) {
+        uint64_t backoffMs = (uint64_t)WEBCLIENT_RETRY_BASE_MS << (resource.failure_count - 1);
+        if (backoffMs < capMs) delayMs = (uint32_t)backoffMs;
+    }
+    // +-25 % jitter, so resources of a failed host don't come back in lockstep
+    delayMs = delayMs - delayMs / 4 + esp_random() % (delayMs / 2 + 1);
+    resource.retry_delay_ms = delayMs;
+    Log.printf("[WebDataManager] FEHLER bei %s: %s. Fehler %u in Folge, nächster Versuch in %us.\n",
+               resource.url.c_str(), errorMsg.c_str(), (unsigned)resource.failure_count, (unsigned)(delayMs / 1000));
+}
+
+void WebClientModule::recordSuccess(ManagedResource& resource) {
+    if (resource.failure_count > 0) {
+        Log.printf("[WebDataManager] %s wieder erreichbar nach %u Fehlern.\n", resource.url.c_str(), (unsigned)resource.failure_count);
+    }
+    resource.failure_count = 0;
+    resource.retry_delay_ms = 0;
+}
+
+// performUpdate unchanged except cert discovery replaces previous deviceConfig cert-field usage
+int WebClientModule::performUpdate(FetchWorker& worker, ManagedResource& resource) {
+    LOG_MEMORY_STRATEGIC("WebClient: Begin performUpdate");
+    Log.printf("[WebDataManager] Worker %u: Starte Update für %s...\n", worker.index, resource.url.c_str());
+    resource.last_check_attempt = time(nullptr);
+
+    RequestTarget target = parseTarget(resource.url);
+
+    int httpCode = 0;
+    PsramString cert_data;
+    const char* ca_cert = nullptr;
+
+    if (target.https) {
+        // first try to find cert by host names in /certs, then the configured file
+        // (updateResourceCertificateByHost() may change it meanwhile, both sides hold the resource mutex)
+        PsramString configured;
+        if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            configured = resource.cert_filename;
+            xSemaphoreGive(resource.mutex);
+        }
+        PsramString found;
+        if (loadCaCert(target.host, configured, cert_data, found)) {
+            // The configured name stays the cache key, the file actually used is recorded separately
+            if (xSemaphoreTake(resource.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+                resource.cert_file_used = found;
+                xSemaphoreGive(resource.mutex);
             }
+            Log.printf("[WebDataManager] Verwende Zertifikat aus Datei '/certs/%s' für %s.\n", found.c_str(), resource.url.c_str());
+            ca_cert = cert_data.c_str();
+        } else if (resource.root_ca_fallback) {
+            // fallback to root_ca_fallback in resource
+            Log.printf("[WebDataManager] Verwende Fallback-Zertifikat für %s.\n", resource.url.c_str());
+            ca_cert = resource.root_ca_fallback;
+        } else {
+            Log.printf("[WebDataManager] WARNUNG: Kein Zertifikat gefunden. Verwende unsichere Verbindung für %s.\n", resource.url.c_str());
+        }
+    }
+
+    char error_buf[128];
+    error_buf[0] = '\0';
+    FetchSample sample;
+    PooledConnection* conn = nullptr;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (attempt > 0) sample.retries++;
+        conn = acquireConnection(target, ca_cert, error_buf, sizeof(error_buf), sample);
+        if (!conn) {
+            httpCode = -1;
+            break;
+        }
+        if (!conn->http->begin(conn->socket(), resource.url.c_str())) {
+            httpCode = -10;
+            break;
+        }
+        prepareResourceRequest(*conn->http, resource);
+        unsigned long requestMs = millis();
+        httpCode = conn->http->GET();
+        sample.phase_ms[FETCH_PHASE_TTFB] = millis() - requestMs;
+        // The server may have closed a kept-alive connection in the meantime: retry once on a new one
+        if (httpCode >= 0 || !conn->reused) break;
+        releaseConnection(conn, false);
+        conn = nullptr;
+    }
+
+    worker.stream.reset();
+    bool body_complete = false;
+
+    if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+        // Body unchanged: data is fresh again, but last_successful_update stays, so modules don't re-parse
+        if (xSemaphoreTake(resource.mutex, portMAX_DELAY) == pdTRUE) {
+            resource.is_data_stale = false;
+            resource.from_cache = false;
+            xSemaphoreGive(resource.mutex);
+        }
+        resource.not_modified_count++;
+        recordSuccess(resource);
+        Log.printf("[WebDataManager] %s unverändert (304).\n", resource.url.c_str());
+    } else if (httpCode == HTTP_CODE_OK && resource.stream_consumer) {
+        // Streaming resource: the body goes to the consumer chunk by chunk, nothing is buffered here
+        ConsumerStream sink(resource.stream_consumer);
+        // Content-Length of a compressed body says nothing about the size the consumer gets
+        resource.stream_consumer->onStreamBegin(hasContentCoding(*conn->http) ? -1 : conn->http->getSize());
+        size_t wire_bytes = 0;
+        String body_error;
+        unsigned long bodyMs = millis();
+        body_complete = writeResponseBody(*conn->http, &sink, wire_bytes, body_error) && !sink.aborted();
+        sample.phase_ms[FETCH_PHASE_BODY] = millis() - bodyMs;
+        sample.wire_bytes = wire_bytes;
+        sample.body_bytes = sink.total();
+        resource.stream_consumer->onStreamEnd(body_complete);
+        if (body_complete) {
+            if (xSemaphoreTake(resource.mutex, portMAX_DELAY) == pdTRUE) {
+                resource.data_size = sink.total();
+                resource.wire_size = wire_bytes;
+                resource.etag = conn->http->header("ETag").c_str();
+                resource.last_modified = conn->http->header("Last-Modified").c_str();
+                time(&resource.last_successful_update);
+                resource.is_data_stale = false;
+                // No body is kept, the version only tells listeners something arrived
+                resource.data_version++;
+                xSemaphoreGive(resource.mutex);
+            }
+            postUpdateEvent(resource);
+            Log.printf("[WebDataManager] ERFOLG: %s gestreamt (%u Bytes, %u übertragen).\n", resource.url.c_str(), (unsigned int)sink.total(), (unsigned int)wire_bytes);
+            recordSuccess(resource);
+        } else {
+            recordFailure(resource, sink.aborted() ? String("Stream vom Modul abgebrochen") : body_error);
+        }
+    } else if (httpCode == HTTP_CODE_OK) {
+        size_t wire_bytes = 0;
+        String body_error;
+        LOG_MEMORY_DETAILED("WebClient: Vor http.writeToStream in performUpdate");
+        unsigned long bodyMs = millis();
+        bool body_ok = writeResponseBody(*conn->http, &worker.stream, wire_bytes, body_error);
+        sample.phase_ms[FETCH_PHASE_BODY] = millis() - bodyMs;
+        sample.wire_bytes = wire_bytes;
+        sample.body_bytes = worker.stream.getSize();
+        sample.buffer_growths = worker.stream.growthCount();
+        LOG_MEMORY_DETAILED("WebClient: Nach http.writeToStream in performUpdate");
+        if (worker.stream.hasOverflowed()) {
+            // Larger than WEBCLIENT_MAX_BODY_KB or out of PSRAM: a second download would not fit either
+            recordFailure(resource, "Antwort passt nicht in den Download-Puffer (" + String((unsigned)worker.stream.getSize()) + " Bytes)");
+        } else if (!body_ok) {
+            recordFailure(resource, body_error);
+        } else {
+            size_t downloaded_size = worker.stream.getSize();
+            if (downloaded_size > 0) {
+                LOG_MEMORY_DETAILED("WebClient: Vor permanent ps_malloc in performUpdate");
+                time_t now;
+                time(&now);
+                ResourceData* new_data = ResourceData::create(downloaded_size, resource.data_version.load() + 1, now);
+                LOG_MEMORY_DETAILED("WebClient: Nach permanent ps_malloc in performUpdate");
+                if (new_data) {
+                    // The only copy of the body: the segments are compacted into the block the modules get
+                    worker.stream.copyTo(new_data->data());
+                    if (xSemaphoreTake(resource.mutex, portMAX_DELAY) == pdTRUE) {
+                        // Modules still holding the previous body keep it alive until they drop it
+                        ResourceData* old_data = resource.data;
+                        resource.data = new_data;
+                        resource.data_size = downloaded_size;
+                        resource.wire_size = wire_bytes;
+                        _dataBytes += downloaded_size;
+                        if (old_data) _dataBytes -= old_data->size;
+                        resource.data_version.store(new_data->version);
+                        resource.etag = conn->http->header("ETag").c_str();
+                        resource.last_modified = conn->http->header("Last-Modified").c_str();
+                        resource.last_successful_update = now;
+                        resource.is_data_stale = false;
+                        resource.from_cache = false;
+                        // Own reference for the flash cache, the budget may release the body meanwhile
+                        new_data->retain();
+                        xSemaphoreGive(resource.mutex);
+                        if (old_data) old_data->release();
+                        postUpdateEvent(resource);
+                        if (_dataBytes.load() > WEBCLIENT_DATA_BUDGET_KB * 1024UL) enforceDataBudget(&resource);
+                        Log.printf("[WebDataManager] ERFOLG: %s aktualisiert (%u Bytes, %u übertragen, Version %u).\n", resource.url.c_str(), (unsigned int)downloaded_size, (unsigned int)wire_bytes, (unsigned)new_data->version);
+                        if (deviceConfig->webCacheEnabled) persistResource(resource, new_data);
+                        if (_captureEnabled.load()) {
+                            captureResponse(resource.key, "GET", resource.url, resource.customHeaders, PsramString(),
+                                            httpCode, new_data->data(), downloaded_size);
+                        }
+                        new_data->release();
+                    } else {
+                        LOG_MEMORY_DETAILED("WebClient: Vor free new_data (failed mutex)");
+                        new_data->release();
+                        LOG_MEMORY_DETAILED("WebClient: Nach free new_data (failed mutex)");
+                    }
+                } else {
+                    Log.printf("[WebClientModule] FEHLER: Konnte keinen passgenauen Puffer für %s allozieren.\n", resource.url.c_str());
+                }
+            }
+            body_complete = true;
+            recordSuccess(resource);
         }
-        http.end();
-        max_growth_retries--;
-    } while (retry_with_larger_buffer && max_growth_retries > 0);
+    } else {
+        String errorMsg;
+        if (httpCode > 0) {
+            errorMsg = "HTTP-Code " + String(httpCode);
+        } else if (httpCode == -1) {
+            errorMsg = "Connect-Fehler: " + String(error_buf);
+        }
+        else {
+            errorMsg = HTTPClient::errorToString(httpCode);
+        }
+        recordFailure(resource, errorMsg);
+    }
+    releaseConnection(conn, body_complete || httpCode == HTTP_CODE_NOT_MODIFIED);
+    // Segments beyond the configured buffer size were only needed for this body
+    worker.stream.trim(deviceConfig->webClientBufferSize);
+    sample.http_code = httpCode;
+    if (resource.retry_delay_ms) sample.retries++;
+    recordTelemetry(&resource, sample);
     LOG_MEMORY_STRATEGIC("WebClient: End performUpdate");
+    return httpCode;
 }
 // User-Agent configuration methods
 void WebClientModule::setUserAgent(const String& userAgent) {
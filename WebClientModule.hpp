@@ -4,61 +4,474 @@
 #include <Arduino.h>
 #include <functional>
 #include <vector>
+#include <atomic>
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "PsramUtils.hpp"
 
+class HTTPClient;
+class WiFiClient;
+class WiFiClientSecure;
+
 // Default User-Agent string (can be overridden by defining DEFAULT_USER_AGENT before including this header)
 #ifndef DEFAULT_USER_AGENT
 #define DEFAULT_USER_AGENT "ESP32-PanelClock/1.0"
 #endif
 
+// Fetch worker pool: every worker holds at most one TLS session, which needs roughly
+// WEBCLIENT_TLS_SESSION_KB of internal heap. The pool size follows from the configured budget.
+#define WEBCLIENT_MAX_WORKERS 4
+#define WEBCLIENT_TLS_SESSION_KB 48
+
+// Kept-alive connections are closed after this idle time
+#define WEBCLIENT_SESSION_IDLE_MS 30000
+
+// Per-host rate limit (token bucket): burst size and refill interval of one token
+#define WEBCLIENT_HOST_BURST 3
+#define WEBCLIENT_HOST_REFILL_MS 5000
+
+// No downloads during the first seconds after begin()
+#define WEBCLIENT_START_DELAY_MS 10000
+
+// Failed resources are retried with exponential backoff: the base delay doubles with every
+// consecutive failure up to the cap, +-25 % jitter keeps resources of one host apart. A success resets it.
+#define WEBCLIENT_RETRY_BASE_MS 30000
+#define WEBCLIENT_RETRY_MAX_MS (30UL * 60 * 1000)
+
+// Circuit breaker per host: opens after this many consecutive failed requests (no connection,
+// timeout, 5xx, 429). After the cool-down a single probe request is let through; success closes
+// the breaker, a failed probe opens it again with twice the cool-down.
+#define WEBCLIENT_BREAKER_THRESHOLD 5
+#define WEBCLIENT_BREAKER_COOLDOWN_MS 60000
+#define WEBCLIENT_BREAKER_MAX_COOLDOWN_MS (15UL * 60 * 1000)
+
+// Workers sleep until the next deadline or a notification; without WiFi they poll the connection state
+#define WEBCLIENT_WAIT_FOREVER 0xFFFFFFFFUL
+#define WEBCLIENT_WIFI_POLL_MS 500
+
+// Update events from the workers to the main loop; listeners additionally get a tick event at this interval
+#define WEBCLIENT_UPDATE_QUEUE_LEN 16
+#define WEBCLIENT_UPDATE_TICK_MS 1000
+
+// Resource index: open addressing with linear probing, power-of-two size, grown at 3/4 load
+#define WEBCLIENT_INDEX_MIN_SLOTS 32
+
+// Resources nobody accessed for this many update intervals (at least the minimum time) go dormant:
+// their body is released and they are not fetched until the next access
+#define WEBCLIENT_IDLE_EVICT_INTERVALS 4
+#define WEBCLIENT_IDLE_EVICT_MIN_MS (2UL * 60 * 60 * 1000)
+#define WEBCLIENT_IDLE_CHECK_MS 60000
+
+// Download buffers grow in segments of this size; larger bodies are refused
+#define WEBCLIENT_SEGMENT_SIZE (32 * 1024)
+#define WEBCLIENT_MAX_BODY_KB 4096
+
+// Flash cache of the last good body per resource for warm starts (deviceConfig->webCacheEnabled).
+// Writes are limited per resource and per hour, files older than the max age are not served.
+#define WEBCLIENT_CACHE_DIR "/webcache"
+#define WEBCLIENT_CACHE_MIN_WRITE_INTERVAL_MS (30UL * 60 * 1000)
+#define WEBCLIENT_CACHE_WRITE_KB_PER_HOUR 512
+#define WEBCLIENT_CACHE_MAX_AGE_S (48UL * 60 * 60)
+#define WEBCLIENT_CACHE_MIN_FREE_KB 256
+
+// Capture mode for parser fixtures (stream page, not persisted): the first complete response of every
+// resource and job is written decoded to LittleFS, until the session limit is reached
+#define WEBCLIENT_CAPTURE_DIR "/capture"
+#define WEBCLIENT_CAPTURE_MAX_KB 1024
+
+// Budget for the bodies held by all resources, least recently accessed bodies are released first
+#define WEBCLIENT_DATA_BUDGET_KB 1536
+
 // Vorwärtsdeklarationen, um Header-Abhängigkeiten zu minimieren
 struct DeviceConfig;
 extern DeviceConfig* deviceConfig;
 
+/**
+ * @brief Download buffer made of a chain of fixed-size PSRAM segments.
+ *
+ * Grows segment by segment while the body arrives, nothing is ever reallocated or moved,
+ * so every response is downloaded exactly once whatever its size. Segments stay allocated
+ * between downloads (up to the retained capacity, see trim()). Consumers either walk the
+ * segments (segmentCount()/segment()) or compact the body once into a contiguous block (copyTo()).
+ */
 class PsramBufferStream : public Stream {
 public:
     PsramBufferStream();
-    void begin(char* buffer, size_t capacity);
+    ~PsramBufferStream();
+    /**
+     * @brief Allocate segments up front for at least capacity bytes
+     * @return false if PSRAM ran out
+     */
+    bool reserve(size_t capacity);
     void reset();
+    /**
+     * @brief Discard the body and free the segments beyond keepCapacity bytes (call between downloads)
+     */
+    void trim(size_t keepCapacity);
     size_t write(uint8_t data) override;
     size_t write(const uint8_t *buffer, size_t size) override;
-    bool hasOverflowed() const;
-    size_t getCapacity() const;
+    bool hasOverflowed() const;     ///< Body larger than WEBCLIENT_MAX_BODY_KB or PSRAM exhausted
+    size_t getCapacity() const;     ///< Bytes in allocated segments
     int available() override;
     int read() override;
     int peek() override;
     void flush() override;
-    char* getBuffer();
     size_t getSize();
+    size_t segmentCount() const;    ///< Segments holding body data
+    /**
+     * @brief Body data of one segment
+     * @param length Receives the number of body bytes in this segment
+     */
+    const char* segment(size_t index, size_t& length) const;
+    uint8_t growthCount() const;    ///< Segments allocated during the current body
+    /**
+     * @brief Copy the whole body into dest (getSize() bytes)
+     */
+    void copyTo(char* dest) const;
 
 private:
-    char* _buffer = nullptr;
-    size_t _capacity = 0;
+    PsramVector<char*> _segments;
     size_t _position = 0;
     bool _overflowed = false;
+    uint8_t _growths = 0;
+};
+
+/**
+ * @brief Immutable, reference-counted response body.
+ *
+ * One PSRAM block per successful download (this header, then the NUL-terminated body).
+ * The WebClient holds one reference while it is the resource's current data, every
+ * ResourceDataRef holds another; the block is freed with the last reference.
+ */
+struct ResourceData {
+    std::atomic<uint32_t> refs;
+    uint32_t version;      ///< Per resource, increases with every new body
+    time_t last_update;
+    size_t size;
+
+    const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+
+    /**
+     * @brief Allocate a block for size bytes of body (reference count 1)
+     */
+    static ResourceData* create(size_t size, uint32_t version, time_t lastUpdate);
+    void retain();
+    void release();
+};
+
+/**
+ * @brief Handle to a ResourceData (keeps the body alive, no copy).
+ */
+class ResourceDataRef {
+public:
+    ResourceDataRef() = default;
+    explicit ResourceDataRef(ResourceData* data);  // takes an additional reference
+    ResourceDataRef(const ResourceDataRef& other);
+    ResourceDataRef(ResourceDataRef&& other) noexcept;
+    ResourceDataRef& operator=(const ResourceDataRef& other);
+    ResourceDataRef& operator=(ResourceDataRef&& other) noexcept;
+    ~ResourceDataRef();
+
+    void reset();
+    explicit operator bool() const { return _data != nullptr; }
+    const char* data() const { return _data ? _data->data() : nullptr; }
+    size_t size() const { return _data ? _data->size : 0; }
+    uint32_t version() const { return _data ? _data->version : 0; }
+    time_t lastUpdate() const { return _data ? _data->last_update : 0; }
+
+private:
+    ResourceData* _data = nullptr;
+};
+
+struct ManagedResource;
+struct tinfl_decompressor_tag;
+
+// resource_id of the periodic tick event (real resources start at 1)
+#define RESOURCE_UPDATE_TICK 0
+
+/**
+ * @brief Posted by a fetch worker when a resource got a new body, delivered in the main loop.
+ */
+struct ResourceUpdateEvent {
+    uint32_t resource_id;   ///< ManagedResource::id, RESOURCE_UPDATE_TICK for the periodic tick
+    uint32_t version;       ///< New data version of the resource
+
+    bool isTick() const { return resource_id == RESOURCE_UPDATE_TICK; }
+};
+
+typedef std::function<void(const ResourceUpdateEvent& event)> ResourceUpdateListener;
+
+/**
+ * @brief A module's view on one resource, used with WebClientModule::takeNewData().
+ *
+ * Set the URL with setUrl() when it changes; the resource lookup is cached until resources
+ * are added or change their URL, so polling costs no string compares.
+ */
+struct ResourceSubscription {
+    PsramString url;
+    PsramString customHeaders;
+    uint32_t version = 0;                  ///< Version of the last body handed out
+    ManagedResource* resource = nullptr;   ///< Cached lookup (internal)
+    uint32_t resource_id = 0;              ///< Id of the cached resource, 0 = not resolved (internal)
+    uint32_t registry_generation = 0;      ///< 0 = not resolved yet (internal)
+
+    void setUrl(const PsramString& newUrl, const PsramString& headers = PsramString()) {
+        if (newUrl == url && headers == customHeaders) return;
+        url = newUrl;
+        customHeaders = headers;
+        registry_generation = 0;
+        resource_id = 0;
+    }
+
+    /**
+     * @brief Whether an update event may carry new data for this subscription (ticks and unresolved subscriptions always do)
+     */
+    bool concerns(const ResourceUpdateEvent& event) const {
+        return event.isTick() || resource_id == 0 || event.resource_id == resource_id;
+    }
+};
+
+/**
+ * @brief Receiver of a streamed response body.
+ *
+ * Resources registered with registerStreamingResource() hand the body of every successful
+ * update to their consumer chunk by chunk as it arrives; it is never held in memory as a whole.
+ * The callbacks run in a fetch worker task, implementations synchronize with their module
+ * themselves. A 304 response (body unchanged) does not call the consumer.
+ */
+class ResourceStreamConsumer {
+public:
+    virtual ~ResourceStreamConsumer() = default;
+
+    /**
+     * @brief A new body starts
+     * @param contentLength Size from the Content-Length header, -1 if unknown (chunked)
+     */
+    virtual void onStreamBegin(int contentLength) = 0;
+
+    /**
+     * @brief Next part of the body
+     * @return false aborts the download
+     */
+    virtual bool onStreamChunk(const char* data, size_t len) = 0;
+
+    /**
+     * @brief Body finished
+     * @param complete false if the download failed or was aborted
+     */
+    virtual void onStreamEnd(bool complete) = 0;
+};
+
+/**
+ * @brief Stream adapter passing what HTTPClient::writeToStream() writes on to a ResourceStreamConsumer.
+ */
+class ConsumerStream : public Stream {
+public:
+    explicit ConsumerStream(ResourceStreamConsumer* consumer);
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    bool aborted() const;
+    size_t total() const;
+
+private:
+    ResourceStreamConsumer* _consumer;
+    size_t _total = 0;
+    bool _aborted = false;
+};
+
+/**
+ * @brief Stream adapter that inflates a gzip or deflate coded response body on the fly.
+ *
+ * HTTPClient::writeToStream() only removes the chunked transfer coding; the coded bytes are
+ * written here and the decoded output is passed on to the target stream as it is produced.
+ * The decompressor state (~11 KB) is taken from internal RAM if possible, the 32 KB history
+ * window deflate requires lives in PSRAM; both exist only for the duration of one response.
+ * write() returns 0 on a format error or when the target does not take all bytes, which makes
+ * writeToStream() stop. zlib streams end with their Adler-32 (checked by tinfl), gzip members
+ * with CRC32 and length of the data: complete() requires them to match the last 8 bytes written,
+ * so a body cut off after the final deflate block is rejected as well.
+ */
+class InflateStream : public Stream {
+public:
+    enum Encoding : uint8_t {
+        ENCODING_GZIP,
+        ENCODING_DEFLATE   ///< zlib wrapped (RFC 1950) or, as some servers send it, raw deflate
+    };
+
+    InflateStream(Stream* target, Encoding encoding);
+    ~InflateStream();
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    bool failed() const;        ///< Allocation, format or target error
+    bool complete() const;      ///< End of the compressed data reached (gzip: trailer matches)
+    size_t compressedBytes() const;
+    size_t inflatedBytes() const;
+    const char* encodingName() const;
+
+    /**
+     * @brief Map a Content-Encoding header value
+     * @return false for identity or unsupported codings (the body is used as is)
+     */
+    static bool fromHeader(const String& contentEncoding, Encoding& encoding);
+
+private:
+    enum State : uint8_t {
+        STATE_GZIP_HEADER,
+        STATE_GZIP_EXTRA_LEN,
+        STATE_GZIP_EXTRA,
+        STATE_GZIP_NAME,
+        STATE_GZIP_COMMENT,
+        STATE_GZIP_HCRC,
+        STATE_ZLIB_PROBE,
+        STATE_BODY,
+        STATE_DONE,
+        STATE_FAILED
+    };
+
+    Stream* _target;
+    Encoding _encoding;
+    State _state;
+    tinfl_decompressor_tag* _decompressor = nullptr;
+    uint8_t* _window = nullptr;
+    size_t _windowPos = 0;
+    uint32_t _flags = 0;
+    uint8_t _header[10];        // Header bytes collected across writes
+    uint8_t _headerLen = 0;
+    uint8_t _gzipFlags = 0;
+    uint16_t _extraRemaining = 0;
+    size_t _compressed = 0;
+    size_t _inflated = 0;
+    uint32_t _crc = 0;          // CRC32 of the inflated gzip data (MZ_CRC32_INIT)
+    uint8_t _tail[8];           // Last 8 bytes written: the gzip trailer once the input is complete
+    bool _trailerOk = false;
+
+    size_t consumeHeader(const uint8_t* data, size_t size);
+    bool inflateBody(const uint8_t* data, size_t size);
+    void updateTail(const uint8_t* data, size_t size);
+    bool checkGzipTrailer() const;
+};
+
+// Ad-hoc jobs waiting for a worker (all classes together, coalesced requests not counted)
+#define WEBCLIENT_MAX_QUEUED_JOBS 16
+
+// Latency histograms: fixed buckets, see LatencyHistogram::bucketLimitsMs
+#define WEBCLIENT_HISTOGRAM_BUCKETS 10
+
+/**
+ * @brief Phases of a fetch measured by the telemetry.
+ *
+ * DNS, connect and TLS only happen for new connections. WiFiClientSecure does the TCP connect
+ * and the handshake in one call, so the TLS phase of https connections includes the TCP connect;
+ * the connect phase is measured for plain http only. TTFB runs from sending the request to the
+ * parsed response headers, body from there to the last body byte.
+ */
+enum FetchPhase : uint8_t {
+    FETCH_PHASE_DNS,
+    FETCH_PHASE_CONNECT,
+    FETCH_PHASE_TLS,
+    FETCH_PHASE_TTFB,
+    FETCH_PHASE_BODY,
+    FETCH_PHASE_COUNT
+};
+
+/**
+ * @brief Latency histogram with fixed buckets (ms).
+ */
+struct LatencyHistogram {
+    static const uint16_t bucketLimitsMs[WEBCLIENT_HISTOGRAM_BUCKETS - 1];  ///< Upper bounds, the last bucket takes the rest
+    uint32_t counts[WEBCLIENT_HISTOGRAM_BUCKETS] = {};
+    uint32_t total_ms = 0;
+    uint32_t max_ms = 0;
+
+    void add(uint32_t ms);
+    uint32_t samples() const;
+};
+
+/**
+ * @brief Measurements of one fetch, merged into a FetchTelemetry when the fetch is done.
+ */
+struct FetchSample {
+    int32_t phase_ms[FETCH_PHASE_COUNT] = { -1, -1, -1, -1, -1 };  ///< -1 = phase did not take place
+    int http_code = 0;            ///< HTTP status, <= 0 for transport errors
+    size_t wire_bytes = 0;
+    size_t body_bytes = 0;
+    uint8_t retries = 0;          ///< Reconnects after a dropped keep-alive connection, failures that scheduled a retry
+    uint8_t buffer_growths = 0;   ///< Download buffer segments added beyond the retained capacity
+};
+
+/**
+ * @brief Accumulated fetch telemetry of one resource (or of all ad-hoc jobs).
+ */
+struct FetchTelemetry {
+    LatencyHistogram phases[FETCH_PHASE_COUNT];
+    uint32_t fetches = 0;
+    uint64_t wire_bytes = 0;
+    uint64_t body_bytes = 0;
+    uint32_t status_classes[6] = {};  ///< [0] transport errors, [1..5] 1xx..5xx
+    uint32_t retries = 0;
+    uint32_t buffer_growths = 0;
+
+    void add(const FetchSample& sample);
+    static const char* phaseName(FetchPhase phase);
+};
+
+/**
+ * @brief Scheduling classes of managed resources, lower values are served first.
+ */
+enum ResourcePriority : uint8_t {
+    RESOURCE_PRIORITY_HIGH = 0,    ///< Live data (registered with_priority), not held back by the host token bucket
+    RESOURCE_PRIORITY_NORMAL = 1,
+    RESOURCE_PRIORITY_COUNT
 };
 
 struct ManagedResource {
+    uint32_t id = 0;            // Unique, never reused; identifies the resource in update events
+    uint64_t key = 0;           // 64-bit hash of url and customHeaders (resource index)
+    uint64_t host_key = 0;      // 64-bit hash of host
     PsramString url;
+    PsramString host;           // Host part of url (without port), used for the per-host rate limit
     PsramString customHeaders;  // Optional headers for this resource (format: "Header1: Value1\nHeader2: Value2")
     uint32_t update_interval_ms;
     const char* root_ca_fallback;
-    PsramString cert_filename;
-    char* data_buffer = nullptr;
+    PsramString cert_filename;      // Configured file in /certs (key of the certificate cache)
+    PsramString cert_file_used;     // File the last connection actually used (host match or cert_filename)
+    ResourceData* data = nullptr;   // Current body (immutable, shared with the modules)
+    std::atomic<uint32_t> data_version{0};
     size_t data_size = 0;
+    size_t wire_size = 0;       // Bytes received for the current body (less than data_size when it came compressed)
     time_t last_successful_update = 0;
     time_t last_check_attempt = 0;
-    unsigned long last_check_attempt_ms = 0;  // Millisecond-precise timestamp for second-precise intervals
+    unsigned long last_check_attempt_ms = 0;  // millis() of the last fetch start, 0 = never fetched
+    unsigned long next_due_ms = 0;            // Deadline in the scheduler heap (millis())
     SemaphoreHandle_t mutex;
-    uint8_t retry_count = 0;
-    bool is_in_retry_mode = false;
+    uint16_t failure_count = 0;      // Consecutive failed fetches
+    uint32_t retry_delay_ms = 0;     // Backoff before the next attempt (with jitter), 0 = regular interval
     bool is_data_stale = true;
     bool is_paused = false;          // When true, resource polling is paused
-    bool has_priority = false;       // When true, resource is checked with priority when due
-    bool use_ms_timing = false;      // When true, use millisecond-precise timing
+    bool is_dormant = false;         // Idle-evicted: no body, not scheduled until the next access (guarded by the schedule mutex)
+    bool removed = false;            // Unregistered while in flight, the worker frees it (guarded by the schedule mutex)
+    unsigned long last_access_ms = 0; // millis() of the last module access (main task)
+    ResourcePriority priority = RESOURCE_PRIORITY_NORMAL;
+    bool scheduled = false;          // Queued in the deadline heap of its class (guarded by the schedule mutex)
+    bool in_flight = false;          // A worker is currently fetching this resource (guarded by the schedule mutex)
+    PsramString etag;                // Validators of data for conditional GET (If-None-Match / If-Modified-Since)
+    PsramString last_modified;
+    uint32_t not_modified_count = 0; // Number of 304 responses (body unchanged, no re-parse)
+    uint64_t cache_hash = 0;         // Content hash of the body in the flash cache, 0 = none
+    unsigned long cache_written_ms = 0;  // millis() of the last flash cache write (or load)
+    bool from_cache = false;         // data was loaded from the flash cache and not refreshed yet
+    FetchTelemetry telemetry;        // Written after each fetch (guarded by the schedule mutex)
+    ResourceStreamConsumer* stream_consumer = nullptr;  // Streaming resource: body goes here, data stays empty
 
     ManagedResource(const PsramString& u, uint32_t interval, const char* ca);
     ManagedResource(const PsramString& u, const PsramString& headers, uint32_t interval, const char* ca);
@@ -66,6 +479,28 @@ struct ManagedResource {
     ManagedResource(ManagedResource&& other) noexcept;
 };
 
+/**
+ * @brief Scheduling classes of ad-hoc jobs (getRequest/postRequest), lower values are served first.
+ */
+enum JobPriority : uint8_t {
+    JOB_PRIORITY_INTERACTIVE = 0,  ///< A web UI request is waiting for the answer
+    JOB_PRIORITY_LIVE = 1,         ///< Shown on the panel right away (e.g. caller lookup)
+    JOB_PRIORITY_BACKGROUND = 2,   ///< Everything else
+    JOB_PRIORITY_COUNT
+};
+
+/**
+ * @brief One caller waiting for the result of a job.
+ */
+struct JobWaiter {
+    std::function<void(const char* buffer, size_t size)> callback;
+    std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback;
+    unsigned long enqueued_ms = 0;
+};
+
+/**
+ * @brief Ad-hoc request. Identical requests are coalesced: one download, every waiter gets the result.
+ */
 struct WebJob {
     enum JobType { GET, POST };
     JobType type;
@@ -73,8 +508,150 @@ struct WebJob {
     PsramString body;
     PsramString contentType;
     PsramString customHeaders;  // Format: "Header1: Value1\nHeader2: Value2"
-    std::function<void(const char* buffer, size_t size)> callback;
-    std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback;
+    JobPriority priority = JOB_PRIORITY_BACKGROUND;
+    uint64_t key = 0;           // Hash of method, url, headers and body
+    bool running = false;       // Taken by a worker (guarded by the schedule mutex)
+    bool delivered = false;     // Result handed out, nobody joins any more (guarded by the schedule mutex)
+    PsramVector<JobWaiter> waiters;  // Guarded by the schedule mutex until delivered
+};
+
+/**
+ * @brief Counters of the job queue per class (debug page, /api/webclient/stats).
+ */
+struct JobQueueStats {
+    uint32_t submitted[JOB_PRIORITY_COUNT] = {};
+    uint32_t coalesced[JOB_PRIORITY_COUNT] = {};  ///< Answered by an identical queued or running job
+    uint32_t queued[JOB_PRIORITY_COUNT] = {};     ///< Waiting for a worker right now
+    uint32_t rejected_full = 0;
+    LatencyHistogram wait[JOB_PRIORITY_COUNT];    ///< Submission until a worker starts the download
+
+    static const char* className(JobPriority priority);
+};
+
+/**
+ * @brief Token bucket and in-flight marker of one host.
+ *
+ * A host gets at most one concurrent request, so a slow host occupies a single
+ * worker while the other workers continue with other hosts.
+ */
+struct HostLimiter {
+    PsramString host;
+    float tokens = WEBCLIENT_HOST_BURST;
+    unsigned long last_refill_ms = 0;
+    bool busy = false;
+    bool contended = false;  // A worker skipped this host while busy, wake workers on release
+
+    // Circuit breaker
+    enum CircuitState : uint8_t { CIRCUIT_CLOSED, CIRCUIT_OPEN, CIRCUIT_PROBING };
+    CircuitState circuit = CIRCUIT_CLOSED;
+    uint16_t failures = 0;             // Consecutive failed requests
+    uint32_t cooldown_ms = 0;          // Cool-down of the current (or last) opening
+    unsigned long open_until_ms = 0;   // End of the cool-down while open (millis())
+    uint32_t trips = 0;                // How often the breaker opened
+    uint32_t rejected = 0;             // Jobs failed fast while open
+
+    // Connection statistics (debug page)
+    uint32_t handshakes = 0;
+    uint32_t reused = 0;
+    uint32_t handshake_ms_total = 0;
+    uint32_t handshake_ms_max = 0;
+};
+
+/**
+ * @brief Memory and access state of one resource (debug page).
+ */
+struct ResourceMemoryInfo {
+    PsramString url;
+    bool has_headers = false;
+    size_t bytes = 0;
+    size_t wire_bytes = 0;    ///< Bytes on the wire for the body (less than bytes when compressed)
+    uint32_t version = 0;
+    uint32_t idle_s = 0;      ///< Seconds since the last module access
+    bool dormant = false;
+    bool paused = false;
+    bool streaming = false;
+    bool from_cache = false;  ///< Body loaded from the flash cache, not refreshed yet
+    uint16_t failures = 0;    ///< Consecutive failed fetches
+    uint32_t retry_in_s = 0;  ///< Seconds until the backoff retry, 0 = regular interval
+};
+
+/**
+ * @brief Copy of the fetch telemetry of one resource (/api/webclient/stats).
+ */
+struct ResourceTelemetryInfo {
+    PsramString url;
+    bool has_headers = false;
+    uint32_t interval_s = 0;
+    FetchTelemetry telemetry;
+};
+
+/**
+ * @brief One slot of the resource index (also used by the host index).
+ *
+ * Removed entries leave a tombstone so probe sequences running past them stay intact;
+ * tombstones are dropped when the index is rebuilt.
+ */
+struct ResourceIndexSlot {
+    uint64_t key = 0;
+    ManagedResource* resource = nullptr;   ///< nullptr = free or tombstone
+    bool tombstone = false;
+};
+
+/**
+ * @brief Host, port and scheme of a request URL.
+ */
+struct RequestTarget {
+    PsramString host;
+    uint16_t port = 80;
+    bool https = false;
+};
+
+/**
+ * @brief A kept-alive connection to one host.
+ *
+ * The HTTPClient is kept together with its socket: its destructor would close the
+ * connection, and with setReuse(true) end() leaves the socket open for the next request.
+ * Exactly one of secure_client/plain_client is set. The CA certificate is copied
+ * because WiFiClientSecure only keeps the pointer.
+ */
+struct PooledConnection {
+    PsramString host;
+    uint16_t port = 0;
+    bool secure = false;
+    PsramString ca_cert;
+    WiFiClientSecure* secure_client = nullptr;
+    WiFiClient* plain_client = nullptr;
+    HTTPClient* http = nullptr;
+    unsigned long last_used_ms = 0;
+    bool in_use = false;
+    bool reused = false;    ///< Current request runs on a kept-alive connection
+
+    WiFiClient& socket();
+};
+
+/**
+ * @brief Cached CA certificate lookup of one host.
+ *
+ * An empty pem means "no certificate found", which is cached as well so hosts
+ * without a file in /certs do not scan the directory on every update.
+ */
+struct CachedCert {
+    PsramString host;
+    PsramString configured_file;  ///< Fallback file of the resource, part of the key
+    PsramString filename;         ///< File in /certs the PEM was read from
+    PsramString pem;
+};
+
+class WebClientModule;
+
+/**
+ * @brief One fetch worker: task and its own download buffer.
+ */
+struct FetchWorker {
+    WebClientModule* owner = nullptr;
+    uint8_t index = 0;
+    TaskHandle_t taskHandle = NULL;
+    PsramBufferStream stream;
 };
 
 class WebClientModule {
@@ -90,45 +667,242 @@ public:
     void registerResourceSeconds(const String& url, uint32_t update_interval_seconds, bool with_priority = false, bool force_new = false, const char* root_ca = nullptr);
     void registerResourceSecondsWithHeaders(const String& url, const String& customHeaders, uint32_t update_interval_seconds, bool with_priority = false, const char* root_ca = nullptr);
     
+    // Streaming registration: the body is handed to the consumer while downloading (one resource per consumer,
+    // calling again with another URL replaces it). accessResource() delivers no data for these resources.
+    void registerStreamingResource(const String& url, uint32_t update_interval_minutes, ResourceStreamConsumer* consumer, const char* root_ca = nullptr);
+
     void updateResourceUrl(const String& old_url, const String& new_url);
+
+    // Remove a resource and release its body (main task only; a running download finishes first)
+    void unregisterResource(const String& url);
+    void unregisterResource(const char* url);
+    void unregisterResourceWithHeaders(const String& url, const String& customHeaders);
+    void unregisterResourceWithHeaders(const char* url, const char* customHeaders);
+
+    // The const char* overloads look the resource up without building a String (per-tick callers)
     void accessResource(const String& url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback);
     void accessResource(const String& url, const String& customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback);
+    void accessResource(const char* url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback);
+    void accessResource(const char* url, const char* customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback);
+
+    /**
+     * @brief Hand out the resource's current body if it is newer than the last one taken (no copy)
+     * @param subscription The module's subscription (url set), remembers the version
+     * @param out Receives a reference to the body
+     * @return true if out holds a new version
+     */
+    bool takeNewData(ResourceSubscription& subscription, ResourceDataRef& out);
+
+    /**
+     * @brief Id of a registered resource, to filter update events for resources read with accessResource()
+     * @return 0 if no resource has this URL and headers
+     */
+    uint32_t getResourceId(const char* url, const char* customHeaders = "");
+    // Changes whenever resources are added, removed or renamed; ids looked up before stay valid until then
+    uint32_t getRegistryGeneration() const { return _registryGeneration.load(); }
+
+    /**
+     * @brief Register a listener for update events (call during setup, before the main loop runs)
+     *
+     * Listeners run in the main loop from dispatchUpdateEvents(): once per resource that got a
+     * new body, and once per WEBCLIENT_UPDATE_TICK_MS with a tick event for time-based work.
+     */
+    void addUpdateListener(ResourceUpdateListener listener);
+
+    /**
+     * @brief Deliver pending update events to the listeners. Called from the main loop.
+     * @return Number of events delivered
+     */
+    uint32_t dispatchUpdateEvents();
+    void getUpdateEventStats(uint32_t& posted, uint32_t& dropped, uint32_t& pollsAvoided);
     void updateResourceCertificateByHost(const String& host, const String& cert_filename);
     
     // Pause/Resume control for resources
     void pauseResource(const String& url);
+    void pauseResource(const char* url);
     void pauseResourceWithHeaders(const String& url, const String& customHeaders);
+    void pauseResourceWithHeaders(const char* url, const char* customHeaders);
     void resumeResource(const String& url);
+    void resumeResource(const char* url);
     void resumeResourceWithHeaders(const String& url, const String& customHeaders);
+    void resumeResourceWithHeaders(const char* url, const char* customHeaders);
     
-    void getRequest(const PsramString& url, std::function<void(const char* buffer, size_t size)> callback);
-    void getRequest(const PsramString& url, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback);
-    void getRequest(const PsramString& url, const PsramString& customHeaders, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback);
-    void postRequest(const PsramString& url, const PsramString& postBody, const PsramString& contentType, std::function<void(const char* buffer, size_t size)> callback);
+    // Ad-hoc requests, the callback runs in a worker task. Identical requests that are still queued
+    // (GET: or running) share one download.
+    void getRequest(const PsramString& url, std::function<void(const char* buffer, size_t size)> callback, JobPriority priority = JOB_PRIORITY_BACKGROUND);
+    void getRequest(const PsramString& url, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority priority = JOB_PRIORITY_BACKGROUND);
+    void getRequest(const PsramString& url, const PsramString& customHeaders, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority priority = JOB_PRIORITY_BACKGROUND);
+    void postRequest(const PsramString& url, const PsramString& postBody, const PsramString& contentType, std::function<void(const char* buffer, size_t size)> callback, JobPriority priority = JOB_PRIORITY_BACKGROUND);
     
     // User-Agent configuration
     void setUserAgent(const String& userAgent);
     String getUserAgent() const;
 
+    // Drop all cached CA certificates (call after files in /certs changed)
+    void invalidateCertCache();
+    void getCertCacheStats(uint32_t& hits, uint32_t& misses, size_t& entries);
+
+    // Connection statistics per host and number of open connections (debug page)
+    PsramVector<HostLimiter> getHostStats();
+    size_t getOpenConnectionCount();
+
+    // Per-resource memory and totals of the body budget (debug page)
+    PsramVector<ResourceMemoryInfo> getResourceMemoryStats();
+    void getDataBudgetStats(size_t& usedBytes, size_t& budgetBytes, uint32_t& budgetEvictions, uint32_t& idleEvictions);
+    // Flash cache counters since boot (debug page)
+    void getCacheStats(uint32_t& loads, uint32_t& writes, uint32_t& skippedUnchanged, uint32_t& rateLimited);
+
+    // Fetch telemetry per resource and of all ad-hoc jobs together (/api/webclient/stats)
+    PsramVector<ResourceTelemetryInfo> getResourceTelemetry();
+    FetchTelemetry getJobTelemetry();
+    // Job queue counters and wait times per class (debug page, /api/webclient/stats)
+    JobQueueStats getJobQueueStats();
+
+    // Capture mode: raw responses as replay fixtures in /capture. Enabling starts a new
+    // session (previous captures are deleted); not persisted, like the debug log file.
+    void setCaptureEnabled(bool enabled);
+    bool isCaptureEnabled() const { return _captureEnabled.load(); }
+    void getCaptureStats(uint32_t& files, size_t& bytes);
+
 private:
-    char* _downloadBuffer = nullptr;
-    size_t _bufferCapacity = 0;
-    PsramBufferStream _downloadStream;
-    std::vector<ManagedResource, PsramAllocator<ManagedResource>> resources;
-    TaskHandle_t workerTaskHandle;
-    QueueHandle_t jobQueue;
-
-    // Timing control: start delay and minimum pause between downloads (ms)
+    FetchWorker _workers[WEBCLIENT_MAX_WORKERS];
+    uint8_t _workerCount = 0;
+
+    // Resources are allocated individually (in PSRAM), so pointers stay valid while the list grows.
+    // The list, the deadline heaps, in_flight flags, job queues and host limiters are guarded by _scheduleMutex.
+    std::vector<ManagedResource*, PsramAllocator<ManagedResource*>> resources;
+    // One min-heap per priority class, ordered by next_due_ms. Paused and in-flight resources are not queued.
+    PsramVector<ManagedResource*> _dueHeaps[RESOURCE_PRIORITY_COUNT];
+    // Ad-hoc jobs: one FIFO per class; running jobs stay listed until delivered, so identical requests can join
+    PsramVector<WebJob*> _jobQueues[JOB_PRIORITY_COUNT];
+    PsramVector<WebJob*> _runningJobs;
+    JobQueueStats _jobStats;
+    PsramVector<HostLimiter> _hosts;
+    PsramVector<PooledConnection*> _connections;
+    size_t _maxSessions = 1;
+    SemaphoreHandle_t _scheduleMutex;
+    // Hash index over resources (key = url + headers), written under _scheduleMutex.
+    // Registration and lookups by URL run in the main task, which is the only writer.
+    PsramVector<ResourceIndexSlot> _index;
+    size_t _indexUsed = 0;   // Live entries + tombstones
+    // Same for hosts (key = host_key): the first registered resource of each host, for registerResource()
+    PsramVector<ResourceIndexSlot> _hostIndex;
+    size_t _hostIndexUsed = 0;
+    // Changes whenever resources are added or change URL, invalidates cached subscription lookups
+    std::atomic<uint32_t> _registryGeneration{1};
+    uint32_t _nextResourceId = 1;
+
+    // Update events: posted by the workers, delivered by dispatchUpdateEvents() (main loop only)
+    QueueHandle_t _updateQueue;
+    struct UpdateListener {
+        ResourceUpdateListener callback;
+        bool readsResources = false;   ///< Read a resource on some call (streaming-only modules never do)
+    };
+    PsramVector<UpdateListener> _updateListeners;
+    unsigned long _lastUpdateTickMs = 0;
+    std::atomic<uint32_t> _updateEventsPosted{0};
+    std::atomic<uint32_t> _updateEventsDropped{0};
+    // Calls of resource-reading listeners that read nothing (before update events they polled every loop)
+    uint32_t _pollsAvoided = 0;
+    std::atomic<uint32_t> _resourceReads{0};
+
+    // Bodies held by resources (modules may keep released ones alive a little longer)
+    std::atomic<size_t> _dataBytes{0};
+    std::atomic<uint32_t> _budgetEvictions{0};
+    uint32_t _idleEvictions = 0;
+    unsigned long _lastIdleCheckMs = 0;
+
+    // CA certificates by host, loaded from /certs on first use (guarded by _certMutex)
+    PsramVector<CachedCert> _certCache;
+    SemaphoreHandle_t _certMutex;
+    uint32_t _certCacheHits = 0;
+    uint32_t _certCacheMisses = 0;
+
+    // Flash cache: writes are serialized (one compressor at a time, capture files too) and budgeted per hour
+    SemaphoreHandle_t _cacheMutex;
+    unsigned long _cacheWindowStartMs = 0;
+    size_t _cacheBytesThisHour = 0;
+    uint32_t _cacheLoads = 0;
+    std::atomic<uint32_t> _cacheWrites{0};
+    std::atomic<uint32_t> _cacheSkippedUnchanged{0};
+    std::atomic<uint32_t> _cacheRateLimited{0};
+
+    // Telemetry of all ad-hoc jobs (guarded by _scheduleMutex)
+    FetchTelemetry _jobTelemetry;
+
+    // Capture session: keys already captured and bytes written (guarded by _cacheMutex)
+    std::atomic<bool> _captureEnabled{false};
+    PsramVector<uint64_t> _capturedKeys;
+    size_t _captureBytes = 0;
+
+    // Timing control: start delay (ms)
     unsigned long _startMs = 0;
-    unsigned long _lastDownloadMs = 0;
     
     // Configurable User-Agent string (initialized with default from define)
     PsramString _userAgent = DEFAULT_USER_AGENT;
 
-    bool reallocateBuffer(size_t new_size);
-    void performJob(const WebJob& job);
-    void performUpdate(ManagedResource& resource);
-    
+    ManagedResource* addResource(const PsramString& url, const PsramString& headers, uint32_t interval_ms, ResourcePriority priority, const char* root_ca);
+
+    // Resource index (insert/remove need _scheduleMutex and keep the host index in step)
+    ManagedResource* findResource(const char* url, const char* headers) const;
+    void indexInsert(ManagedResource* resource);
+    void indexRemove(ManagedResource* resource);
+    void rebuildIndex(size_t slots);
+    ManagedResource* findResourceByHost(const char* host, size_t length) const;
+    void hostIndexInsert(ManagedResource* resource);
+    void hostIndexRemove(ManagedResource* resource);
+    void rebuildHostIndex(size_t slots);
+    void resumeScheduling(ManagedResource& resource);
+    void wakeWorkers();
+    void setResourceUrl(ManagedResource& resource, const char* url);
+    // Both return the HTTP code (negative: transport error), which feeds the circuit breaker
+    int performJob(FetchWorker& worker, WebJob& job);
+    int performUpdate(FetchWorker& worker, ManagedResource& resource);
+    void rejectJob(WebJob& job);
+    bool enqueueJob(WebJob::JobType type, const PsramString& url, const PsramString& body, const PsramString& contentType,
+                    const PsramString& customHeaders, JobWaiter&& waiter, JobPriority priority, const char*& error);
+    void deliverJobResult(WebJob& job, bool ok, int httpCode, const char* payload, size_t len);
+    void prepareResourceRequest(HTTPClient& http, const ManagedResource& resource);
+    void recordFailure(ManagedResource& resource, const String& errorMsg);
+    void recordSuccess(ManagedResource& resource);
+    void postUpdateEvent(const ManagedResource& resource);
+    void deliverUpdateEvent(const ResourceUpdateEvent& event);
+    void recordTelemetry(ManagedResource* resource, const FetchSample& sample);  // nullptr = ad-hoc job
+
+    // Lifecycle: access marking, eviction and removal
+    void touchResource(ManagedResource& resource);
+    void releaseResourceData(ManagedResource& resource);
+    void evictIdleResources(unsigned long nowMs);
+    void enforceDataBudget(const ManagedResource* keep);
+    void destroyResource(ManagedResource* resource);
+
+    // Flash cache (load: main task before the resource is visible, persist: worker after a fetch)
+    bool loadCachedBody(ManagedResource& resource);
+    void persistResource(ManagedResource& resource, ResourceData* data);
+    void removeCachedBody(uint64_t key);
+    void captureResponse(uint64_t key, const char* method, const PsramString& url, const PsramString& headers,
+                         const PsramString& requestBody, int httpCode, const char* body, size_t size);
+    bool loadCaCert(const PsramString& host, const PsramString& configuredFile, PsramString& certData, PsramString& usedFile);
+
+    // Connection pool (acquire/release take _scheduleMutex themselves)
+    PooledConnection* acquireConnection(const RequestTarget& target, const char* caCert, char* error, size_t errorSize, FetchSample& sample);
+    void releaseConnection(PooledConnection* conn, bool reusable);
+    uint32_t closeIdleConnections(unsigned long nowMs);  // returns ms until the next idle connection expires
+    void recordConnection(const PsramString& host, bool handshake, uint32_t handshakeMs);
+    PooledConnection* createConnection(const RequestTarget& target, const char* caCert);  // mutex held
+    void destroyConnection(PooledConnection* conn);  // mutex held
+
+    // Scheduling (call with _scheduleMutex held). waitMs is lowered to the time until
+    // the next resource becomes due or the next host token is available.
+    void scheduleResource(ManagedResource& resource, unsigned long dueMs);
+    void unscheduleResource(ManagedResource& resource);
+    unsigned long nextDueMs(const ManagedResource& resource, unsigned long nowMs) const;
+    HostLimiter& hostLimiter(const PsramString& host);
+    bool tryAcquireHost(const PsramString& host, unsigned long nowMs, bool bypassRateLimit, uint32_t& waitMs);
+    bool releaseHost(const PsramString& host, int httpCode);  // returns true if other workers wait for this host
+    WebJob* takeRunnableJob(unsigned long nowMs, uint32_t& waitMs, bool& rejected);
+    ManagedResource* takeDueResource(unsigned long nowMs, uint32_t& waitMs);
+
     static void webWorkerTask(void* param);
 };
 #endif // WEBCLIENTMODULE_HPP
\ No newline at end of file
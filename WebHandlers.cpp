@@ -7,6 +7,8 @@
 #include "CountdownModule.hpp"
 #include "PanelManager.hpp"
 #include "Application.hpp"
+#include "PanelRecorder.hpp"
+#include "PanelSnapshot.hpp"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 #include <WiFi.h>
@@ -830,12 +832,201 @@ void handleDebugData() {
     }
 
     replaceAll(content, "{station_cache_table}", table_rows.c_str());
+
+    PsramString host_rows = "";
+    size_t open_connections = 0;
+    uint32_t cert_hits = 0, cert_misses = 0;
+    size_t cert_entries = 0;
+    uint32_t events_posted = 0, events_dropped = 0, polls_avoided = 0;
+    if (webClient) {
+        PsramVector<HostLimiter> hostStats = webClient->getHostStats();
+        open_connections = webClient->getOpenConnectionCount();
+        webClient->getCertCacheStats(cert_hits, cert_misses, cert_entries);
+        webClient->getUpdateEventStats(events_posted, events_dropped, polls_avoided);
+        unsigned long nowMs = millis();
+        for (const auto& stats : hostStats) {
+            if (stats.handshakes == 0 && stats.reused == 0 && stats.failures == 0 && stats.trips == 0) continue;
+            char circuit[64];
+            if (stats.circuit == HostLimiter::CIRCUIT_OPEN) {
+                long untilProbe = (long)(stats.open_until_ms - nowMs);
+                snprintf(circuit, sizeof(circuit), "<b style='color:red;'>offen</b>, Probe in %u s", (unsigned)(untilProbe > 0 ? untilProbe / 1000 : 0));
+            } else if (stats.circuit == HostLimiter::CIRCUIT_PROBING) {
+                snprintf(circuit, sizeof(circuit), "Probe l&auml;uft");
+            } else {
+                snprintf(circuit, sizeof(circuit), "geschlossen");
+            }
+            char cells[320];
+            snprintf(cells, sizeof(cells), "</td><td>%u</td><td>%u</td><td>%u ms</td><td>%u ms</td><td>%s</td><td>%u / %u / %u</td></tr>",
+                     (unsigned)stats.handshakes, (unsigned)stats.reused,
+                     (unsigned)(stats.handshakes ? stats.handshake_ms_total / stats.handshakes : 0),
+                     (unsigned)stats.handshake_ms_max, circuit,
+                     (unsigned)stats.failures, (unsigned)stats.trips, (unsigned)stats.rejected);
+            host_rows += "<tr><td>";
+            host_rows += stats.host;
+            host_rows += cells;
+        }
+    }
+    if (host_rows.empty()) {
+        host_rows = "<tr><td colspan='7'>Noch keine Verbindungen.</td></tr>";
+    }
+    replaceAll(content, "{webclient_host_table}", host_rows.c_str());
+
+    PsramString resource_rows = "";
+    size_t data_bytes = 0, data_budget = 0;
+    uint32_t budget_evictions = 0, idle_evictions = 0;
+    uint32_t cache_loads = 0, cache_writes = 0, cache_skipped = 0, cache_limited = 0;
+    uint32_t capture_files = 0;
+    size_t capture_bytes = 0;
+    PsramString job_queue = "";
+    if (webClient) {
+        // Per class: submitted, coalesced, waiting now, average and maximum wait for a worker
+        JobQueueStats jobStats = webClient->getJobQueueStats();
+        static const char* classLabels[JOB_PRIORITY_COUNT] = { "Interaktiv", "Live", "Hintergrund" };
+        for (uint8_t cls = 0; cls < JOB_PRIORITY_COUNT; cls++) {
+            uint32_t waited = jobStats.wait[cls].samples();
+            char line[160];
+            snprintf(line, sizeof(line), "%s%s: %u Jobs (%u zusammengefasst, %u wartend), Wartezeit &Oslash; %u ms, max. %u ms",
+                     cls ? "; " : "", classLabels[cls], (unsigned)jobStats.submitted[cls], (unsigned)jobStats.coalesced[cls],
+                     (unsigned)jobStats.queued[cls], (unsigned)(waited ? jobStats.wait[cls].total_ms / waited : 0),
+                     (unsigned)jobStats.wait[cls].max_ms);
+            job_queue += line;
+        }
+        char full[48];
+        snprintf(full, sizeof(full), "; %u abgewiesen (Queue voll)", (unsigned)jobStats.rejected_full);
+        job_queue += full;
+        webClient->getDataBudgetStats(data_bytes, data_budget, budget_evictions, idle_evictions);
+        webClient->getCacheStats(cache_loads, cache_writes, cache_skipped, cache_limited);
+        webClient->getCaptureStats(capture_files, capture_bytes);
+        PsramVector<ResourceMemoryInfo> resourceStats = webClient->getResourceMemoryStats();
+        for (const auto& info : resourceStats) {
+            const char* state = info.dormant ? "ruhend" : (info.paused ? "pausiert" : (info.streaming ? "Stream" : (info.from_cache ? "Flash-Cache" : "aktiv")));
+            // Compressed bodies: share of the decoded size that went over the wire
+            char wire[32];
+            if (info.wire_bytes > 0 && info.wire_bytes < info.bytes) {
+                snprintf(wire, sizeof(wire), "%u (%u %%)", (unsigned)info.wire_bytes, (unsigned)(info.wire_bytes * 100ULL / info.bytes));
+            } else {
+                snprintf(wire, sizeof(wire), "%u", (unsigned)info.wire_bytes);
+            }
+            // Failing resources: consecutive failures and time until the backoff retry
+            char backoff[64] = "";
+            if (info.failures > 0) {
+                snprintf(backoff, sizeof(backoff), ", %u Fehler, Retry in %u s", (unsigned)info.failures, (unsigned)info.retry_in_s);
+            }
+            char cells[256];
+            snprintf(cells, sizeof(cells), "</td><td>%u</td><td>%s</td><td>%u</td><td>vor %u s</td><td>%s%s</td></tr>",
+                     (unsigned)info.bytes, wire, (unsigned)info.version, (unsigned)info.idle_s, state, backoff);
+            resource_rows += "<tr><td>";
+            // Query strings may carry API keys, only the path is shown
+            size_t query = info.url.find('?');
+            resource_rows += (query == PsramString::npos) ? info.url : info.url.substr(0, query) + "?&hellip;";
+            if (info.has_headers) resource_rows += " (+Header)";
+            resource_rows += cells;
+        }
+    }
+    if (resource_rows.empty()) {
+        resource_rows = "<tr><td colspan='6'>Keine Ressourcen registriert.</td></tr>";
+    }
+    replaceAll(content, "{webclient_resource_table}", resource_rows.c_str());
+    replaceAll(content, "{resource_data_kb}", String((unsigned)(data_bytes / 1024)).c_str());
+    replaceAll(content, "{resource_budget_kb}", String((unsigned)(data_budget / 1024)).c_str());
+    replaceAll(content, "{resource_budget_evictions}", String((unsigned)budget_evictions).c_str());
+    replaceAll(content, "{resource_idle_evictions}", String((unsigned)idle_evictions).c_str());
+    replaceAll(content, "{web_cache_state}", (deviceConfig && deviceConfig->webCacheEnabled) ? "an" : "aus");
+    replaceAll(content, "{web_cache_loads}", String((unsigned)cache_loads).c_str());
+    replaceAll(content, "{web_cache_writes}", String((unsigned)cache_writes).c_str());
+    replaceAll(content, "{web_cache_skipped}", String((unsigned)cache_skipped).c_str());
+    replaceAll(content, "{web_cache_limited}", String((unsigned)cache_limited).c_str());
+    replaceAll(content, "{webclient_job_queue}", job_queue.c_str());
+    replaceAll(content, "{web_capture_state}", (webClient && webClient->isCaptureEnabled()) ? "an" : "aus");
+    replaceAll(content, "{web_capture_files}", String((unsigned)capture_files).c_str());
+    replaceAll(content, "{web_capture_kb}", String((unsigned)(capture_bytes / 1024)).c_str());
+    replaceAll(content, "{webclient_open_connections}", String((unsigned)open_connections).c_str());
+    replaceAll(content, "{cert_cache_entries}", String((unsigned)cert_entries).c_str());
+    replaceAll(content, "{cert_cache_hits}", String((unsigned)cert_hits).c_str());
+    replaceAll(content, "{cert_cache_misses}", String((unsigned)cert_misses).c_str());
+    replaceAll(content, "{update_events_posted}", String((unsigned)events_posted).c_str());
+    replaceAll(content, "{update_events_dropped}", String((unsigned)events_dropped).c_str());
+    replaceAll(content, "{update_polls_avoided}", String((unsigned)polls_avoided).c_str());
     page += content;
     page += (const char*)FPSTR(HTML_PAGE_FOOTER);
 
     server->send(200, "text/html", page.c_str());
 }
 
+// Fetch telemetry of one resource (or of all jobs) as JSON object
+static void addFetchTelemetry(JsonObject obj, const FetchTelemetry& telemetry) {
+    obj["fetches"] = telemetry.fetches;
+    obj["wire_bytes"] = telemetry.wire_bytes;
+    obj["body_bytes"] = telemetry.body_bytes;
+    obj["retries"] = telemetry.retries;
+    obj["buffer_growths"] = telemetry.buffer_growths;
+    JsonObject status = obj["status"].to<JsonObject>();
+    status["error"] = telemetry.status_classes[0];
+    static const char* classNames[] = { "1xx", "2xx", "3xx", "4xx", "5xx" };
+    for (int i = 1; i < 6; i++) status[classNames[i - 1]] = telemetry.status_classes[i];
+    JsonObject phases = obj["phases"].to<JsonObject>();
+    for (uint8_t phase = 0; phase < FETCH_PHASE_COUNT; phase++) {
+        const LatencyHistogram& histogram = telemetry.phases[phase];
+        JsonObject entry = phases[FetchTelemetry::phaseName((FetchPhase)phase)].to<JsonObject>();
+        uint32_t samples = histogram.samples();
+        entry["count"] = samples;
+        entry["avg_ms"] = samples ? histogram.total_ms / samples : 0;
+        entry["max_ms"] = histogram.max_ms;
+        JsonArray counts = entry["hist"].to<JsonArray>();
+        for (uint32_t count : histogram.counts) counts.add(count);
+    }
+}
+
+void handleWebClientStats() {
+    if (!server) return;
+    if (!webClient) {
+        server->send(500, "application/json", "{\"ok\":false, \"message\":\"WebClient nicht initialisiert\"}");
+        return;
+    }
+
+    SpiRamAllocator allocator;
+    JsonDocument doc(&allocator);
+    doc["uptime_s"] = millis() / 1000;
+    // Upper bounds of the histogram buckets, the last bucket has none
+    JsonArray buckets = doc["buckets_ms"].to<JsonArray>();
+    for (uint16_t limit : LatencyHistogram::bucketLimitsMs) buckets.add(limit);
+
+    JsonArray resourceArray = doc["resources"].to<JsonArray>();
+    PsramVector<ResourceTelemetryInfo> resourceStats = webClient->getResourceTelemetry();
+    for (const auto& info : resourceStats) {
+        JsonObject obj = resourceArray.add<JsonObject>();
+        // Query strings may carry API keys, only the path is shown
+        size_t query = info.url.find('?');
+        PsramString url = (query == PsramString::npos) ? info.url : info.url.substr(0, query) + "?...";
+        obj["url"] = url.c_str();
+        obj["headers"] = info.has_headers;
+        obj["interval_s"] = info.interval_s;
+        addFetchTelemetry(obj, info.telemetry);
+    }
+    addFetchTelemetry(doc["jobs"].to<JsonObject>(), webClient->getJobTelemetry());
+
+    // Job queue per class; wait = submission until a worker starts the download
+    JobQueueStats jobStats = webClient->getJobQueueStats();
+    JsonObject queue = doc["job_queue"].to<JsonObject>();
+    queue["rejected_full"] = jobStats.rejected_full;
+    for (uint8_t cls = 0; cls < JOB_PRIORITY_COUNT; cls++) {
+        const LatencyHistogram& wait = jobStats.wait[cls];
+        JsonObject entry = queue[JobQueueStats::className((JobPriority)cls)].to<JsonObject>();
+        entry["submitted"] = jobStats.submitted[cls];
+        entry["coalesced"] = jobStats.coalesced[cls];
+        entry["queued"] = jobStats.queued[cls];
+        uint32_t samples = wait.samples();
+        entry["wait_avg_ms"] = samples ? wait.total_ms / samples : 0;
+        entry["wait_max_ms"] = wait.max_ms;
+        JsonArray counts = entry["wait_hist"].to<JsonArray>();
+        for (uint32_t count : wait.counts) counts.add(count);
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server->send(200, "application/json", response.c_str());
+}
+
 void handleTankerkoenigSearchLive() {
     if (!server || !deviceConfig || !webClient) { server->send(500, "application/json", "{\"ok\":false, \"message\":\"Server, Config oder WebClient nicht initialisiert\"}"); return; }
     if (deviceConfig->userLatitude == 0.0 || deviceConfig->userLongitude == 0.0) { server->send(400, "application/json", "{\"ok\":false, \"message\":\"Kein Standort konfiguriert. Bitte zuerst 'Mein Standort' festlegen.\"}"); return; }
@@ -861,7 +1052,7 @@ void handleTankerkoenigSearchLive() {
         result.httpCode = httpCode;
         if (payload) { result.payload.assign(payload, len); }
         xSemaphoreGive(sem);
-    });
+    }, JOB_PRIORITY_INTERACTIVE);
 
     if (xSemaphoreTake(sem, pdMS_TO_TICKS(20000)) == pdTRUE) {
         if (result.httpCode == 200) {
@@ -945,6 +1136,10 @@ void handleStreamPage() {
     // Replace {debugFileChecked} placeholder
     const char* checked = deviceConfig->debugFileEnabled ? "checked" : "";
     htmlContent.replace("{debugFileChecked}", checked);
+    htmlContent.replace("{recorderChecked}", deviceConfig->recorderEnabled ? "checked" : "");
+    htmlContent.replace("{captureChecked}", (webClient && webClient->isCaptureEnabled()) ? "checked" : "");
+    htmlContent.replace("{recorderIntervalSec}", String(deviceConfig->recorderIntervalSec));
+    htmlContent.replace("{recorderMaxKBPerHour}", String(deviceConfig->recorderMaxKBPerHour));
     
     page += htmlContent;
     page += FPSTR(HTML_PAGE_FOOTER);
@@ -979,6 +1174,182 @@ void handleToggleDebugFile() {
     server->send(200, "application/json", "{\"success\":true}");
 }
 
+void handleWebClientCapture() {
+    if (!server) return;
+
+    if (!server->hasArg("plain")) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"No body\"}");
+        return;
+    }
+    if (!webClient) {
+        server->send(500, "application/json", "{\"success\":false,\"error\":\"WebClient not initialized\"}");
+        return;
+    }
+
+    JsonDocument doc;
+    if (deserializeJson(doc, server->arg("plain"))) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+
+    // Live only, like the debug file: a forgotten capture must not survive a restart
+    webClient->setCaptureEnabled(doc["enabled"] | false);
+    server->send(200, "application/json", "{\"success\":true}");
+}
+
+void handleRecorderConfig() {
+    if (!server) return;
+    
+    if (!server->hasArg("plain")) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"No body\"}");
+        return;
+    }
+    
+    JsonDocument doc;
+    if (deserializeJson(doc, server->arg("plain"))) {
+        server->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+    
+    deviceConfig->recorderEnabled = doc["enabled"] | deviceConfig->recorderEnabled;
+    deviceConfig->recorderIntervalSec = constrain((int)(doc["intervalSec"] | deviceConfig->recorderIntervalSec), 1, 3600);
+    deviceConfig->recorderMaxKBPerHour = constrain((int)(doc["maxKBPerHour"] | deviceConfig->recorderMaxKBPerHour), 16, 65536);
+    saveDeviceConfig();
+    
+    // Apply immediately via the existing applyLiveConfig function
+    applyLiveConfig();
+    
+    server->send(200, "application/json", "{\"success\":true}");
+}
+
+void handleRecorderData() {
+    if (!server) return;
+    
+    PanelStreamer* streamer = Application::_instance ? Application::_instance->getPanelStreamer() : nullptr;
+    PanelRecorder* recorder = streamer ? streamer->getRecorder() : nullptr;
+    if (!recorder) {
+        server->send(503, "text/plain", "Flugschreiber nicht verfügbar");
+        return;
+    }
+    
+    // Recording pauses while the segments are sent, so no segment is rotated underneath us
+    uint8_t order[PANEL_RECORDER_SEGMENTS];
+    uint32_t sizes[PANEL_RECORDER_SEGMENTS];
+    uint8_t count = 0;
+    if (!recorder->beginRead(order, sizes, count)) {
+        server->send(503, "text/plain", "Flugschreiber belegt, bitte erneut versuchen");
+        return;
+    }
+    
+    // Segment sizes let the client split the concatenated body
+    size_t total = 0;
+    String segmentSizes;
+    for (uint8_t i = 0; i < count; i++) {
+        total += sizes[i];
+        if (i > 0) segmentSizes += ',';
+        segmentSizes += String((unsigned long)sizes[i]);
+    }
+    
+    uint8_t* chunk = (uint8_t*)ps_malloc(4096);
+    if (!chunk) {
+        recorder->endRead();
+        server->send(500, "text/plain", "Out of memory");
+        return;
+    }
+    
+    server->sendHeader("X-Recorder-Segments", segmentSizes);
+    server->setContentLength(total);
+    server->send(200, "application/octet-stream", "");
+    
+    for (uint8_t i = 0; i < count; i++) {
+        char path[32];
+        PanelRecorder::segmentPath(order[i], path, sizeof(path));
+        File file = LittleFS.open(path, "r");
+        size_t remaining = sizes[i];
+        while (remaining > 0) {
+            size_t n = min(remaining, (size_t)4096);
+            size_t got = file ? file.read(chunk, n) : 0;
+            // Keep the announced length even if the file is shorter, the client stops at invalid records
+            if (got < n) memset(chunk + got, 0, n - got);
+            server->sendContent((const char*)chunk, n);
+            remaining -= n;
+        }
+        if (file) file.close();
+    }
+    
+    free(chunk);
+    recorder->endRead();
+}
+
+// Rows copied from the framebuffer per step, keeps the peak memory at a few KB
+#define SNAPSHOT_ROWS_PER_CHUNK 8
+
+static void sendPanelSnapshot(PanelSnapshotEncoder::Format format) {
+    if (!server) return;
+    
+    PanelManager* panelManager = Application::_instance ? Application::_instance->getPanelManager() : nullptr;
+    if (!panelManager) {
+        server->send(503, "text/plain", "PanelManager not initialized");
+        return;
+    }
+    
+    PanelSnapshotEncoder encoder(format, FULL_WIDTH, FULL_HEIGHT);
+    size_t outSize = encoder.maxPartSize() * SNAPSHOT_ROWS_PER_CHUNK;
+    uint16_t* rows = (uint16_t*)ps_malloc(FULL_WIDTH * SNAPSHOT_ROWS_PER_CHUNK * sizeof(uint16_t));
+    uint8_t* out = (uint8_t*)ps_malloc(outSize);
+    if (!rows || !out) {
+        if (rows) free(rows);
+        if (out) free(out);
+        server->send(500, "text/plain", "Out of memory");
+        return;
+    }
+    
+    // Handlers run in the same loop as render(), so the frame cannot change between the row copies
+    if (!panelManager->copyPanelRows(rows, 0, SNAPSHOT_ROWS_PER_CHUNK)) {
+        free(rows);
+        free(out);
+        server->send(503, "text/plain", "Panel buffer busy");
+        return;
+    }
+    
+    server->sendHeader("Cache-Control", "no-store");
+    server->setContentLength(encoder.contentLength());
+    server->send(200, encoder.mimeType(), "");
+    
+    size_t outLen = encoder.header(out);
+    for (int firstRow = 0; firstRow < FULL_HEIGHT; firstRow += SNAPSHOT_ROWS_PER_CHUNK) {
+        int rowCount = min(SNAPSHOT_ROWS_PER_CHUNK, FULL_HEIGHT - firstRow);
+        if (firstRow > 0 && !panelManager->copyPanelRows(rows, firstRow, rowCount)) {
+            // Length is already announced: keep the image well-formed with black rows
+            memset(rows, 0, FULL_WIDTH * rowCount * sizeof(uint16_t));
+        }
+        for (int row = 0; row < rowCount; row++) {
+            if (outLen + encoder.maxPartSize() > outSize) {
+                server->sendContent((const char*)out, outLen);
+                outLen = 0;
+            }
+            outLen += encoder.encodeRow(rows + row * FULL_WIDTH, out + outLen);
+        }
+    }
+    if (outLen + encoder.maxPartSize() > outSize) {
+        server->sendContent((const char*)out, outLen);
+        outLen = 0;
+    }
+    outLen += encoder.trailer(out + outLen);
+    server->sendContent((const char*)out, outLen);
+    
+    free(rows);
+    free(out);
+}
+
+void handleSnapshotPng() {
+    sendPanelSnapshot(PanelSnapshotEncoder::FORMAT_PNG);
+}
+
+void handleSnapshotBmp() {
+    sendPanelSnapshot(PanelSnapshotEncoder::FORMAT_BMP);
+}
+
 // =============================================================================
 // Backup & Restore Handlers
 // =============================================================================
@@ -1196,7 +1567,7 @@ void handleThemeParksList() {
             Log.printf("[ThemePark] Payload first 100 chars: %.100s\n", payload);
         }
         xSemaphoreGive(sem);
-    });
+    }, JOB_PRIORITY_INTERACTIVE);
     
     Log.println("[ThemePark] Waiting for response (20s timeout)...");
     
@@ -1322,7 +1693,7 @@ void handleSofascoreTournamentsList() {
             Log.printf("[SofaScore] Payload first 100 chars: %.100s\n", payload);
         }
         xSemaphoreGive(sem);
-    });
+    }, JOB_PRIORITY_INTERACTIVE);
     
     Log.println("[SofaScore] Waiting for response (20s timeout)...");
     
@@ -18,13 +18,19 @@ void handleConfigHardware();
 void handleSaveHardware();
 void handleNotFound();
 void handleDebugData();
+void handleWebClientStats();
 void handleDebugStationHistory();
 void handleToggleDebugFile();
+void handleWebClientCapture();
 void handleTankerkoenigSearchLive();
 void handleThemeParksList();
 void handleSofascoreTournamentsList();
 void handleSofascoreDebugSnapshot();
 void handleStreamPage();
+void handleRecorderConfig();
+void handleRecorderData();
+void handleSnapshotPng();
+void handleSnapshotBmp();
 
 // Countdown handlers
 void handleCountdownPage();
@@ -818,6 +818,48 @@ const char HTML_DEBUG_DATA[] PROGMEM = R"rawliteral(
         </tbody>
     </table>
 </div>
+<div class="group">
+    <h3>WebClient Verbindungen</h3>
+    <p>Verbindungen pro Host: vollst&auml;ndige (TLS-)Verbindungsaufbauten und wiederverwendete Keep-Alive-Verbindungen. Offene Verbindungen: {webclient_open_connections}</p>
+    <p>Circuit Breaker: nach mehreren Fehlern in Folge wird ein Host gesperrt, nach der Wartezeit pr&uuml;ft eine einzelne Anfrage, ob er wieder antwortet. Jobs an gesperrte Hosts werden sofort abgewiesen.</p>
+    <p>Zertifikat-Cache: {cert_cache_entries} Eintr&auml;ge, {cert_cache_hits} Treffer, {cert_cache_misses} Fehlzugriffe (Datei aus /certs gelesen)</p>
+    <p>Job-Queue: {webclient_job_queue}</p>
+    <p>Update-Events: {update_events_posted} gemeldet, {update_events_dropped} verworfen (Queue voll, Tick holt nach), {update_polls_avoided} Modul-Abfragen eingespart</p>
+    <table>
+        <thead>
+            <tr>
+                <th>Host</th>
+                <th>Handshakes</th>
+                <th>Wiederverwendet</th>
+                <th>&Oslash; Handshake</th>
+                <th>Max. Handshake</th>
+                <th>Circuit Breaker</th>
+                <th>Fehler / Ge&ouml;ffnet / Abgewiesen</th>
+            </tr>
+        </thead>
+        <tbody>
+            {webclient_host_table}
+        </tbody>
+    </table>
+    <p>Ressourcen-Puffer: {resource_data_kb} KB von {resource_budget_kb} KB, {resource_budget_evictions} wegen Budget verworfen, {resource_idle_evictions} wegen Inaktivit&auml;t ruhend gelegt</p>
+    <p>Flash-Cache ({web_cache_state}): {web_cache_loads} beim Start geladen, {web_cache_writes} geschrieben, {web_cache_skipped} unver&auml;ndert &uuml;bersprungen, {web_cache_limited} gedrosselt</p>
+    <p>HTTP-Mitschnitt ({web_capture_state}): {web_capture_files} Antworten, {web_capture_kb} KB in /capture</p>
+    <table>
+        <thead>
+            <tr>
+                <th>Ressource</th>
+                <th>Bytes</th>
+                <th>&Uuml;bertragen</th>
+                <th>Version</th>
+                <th>Letzter Zugriff</th>
+                <th>Status</th>
+            </tr>
+        </thead>
+        <tbody>
+            {webclient_resource_table}
+        </tbody>
+    </table>
+</div>
 <div class="footer-link"><a href="/">&laquo; Zur&uuml;ck zum Hauptmen&uuml;</a></div>
 )rawliteral";
 
@@ -860,6 +902,12 @@ const char HTML_STREAM_PAGE[] PROGMEM = R"rawliteral(
     <div style="margin-top: 15px;">
         <button id="connectBtn" class="button" onclick="toggleConnection()">Verbinden</button>
         <span id="statusText" style="margin-left: 15px; color: #bbb;">Getrennt</span>
+        <span id="streamStats" style="margin-left: 15px; color: #888; font-size: 12px;"></span>
+    </div>
+    <div style="margin-top: 10px;">
+        <button class="button" style="width: auto;" onclick="loadRecording()">Aufzeichnung laden</button>
+        <input type="range" id="replaySlider" min="0" max="0" value="0" disabled oninput="showReplayFrame(parseInt(this.value))" style="width: 400px; vertical-align: middle; margin-left: 15px;">
+        <span id="replayTime" style="margin-left: 15px; color: #bbb; font-size: 12px;"></span>
     </div>
 </div>
 
@@ -876,6 +924,32 @@ const char HTML_STREAM_PAGE[] PROGMEM = R"rawliteral(
             </p>
         </div>
     </div>
+    <div style="display: flex; justify-content: center; margin-bottom: 20px;">
+        <div style="max-width: 1000px; width: 100%; background: #2a2a2a; border: 1px solid #444; border-radius: 8px; padding: 20px;">
+            <label style="display: flex; align-items: center; justify-content: center; cursor: pointer;">
+                <input type="checkbox" id="recorderEnabled" {recorderChecked} onchange="saveRecorderConfig()" style="margin-right: 10px; transform: scale(1.5);">
+                <span style="color: #bbb;">Flugschreiber: Panel-Inhalt fortlaufend aufzeichnen (/recorder, Ringpuffer max 512KB)</span>
+            </label>
+            <div style="color: #bbb; margin-top: 10px;">
+                Intervall (s): <input type="number" id="recorderIntervalSec" value="{recorderIntervalSec}" min="1" max="3600" onchange="saveRecorderConfig()" style="width: 80px;">
+                &nbsp; Max. KB pro Stunde: <input type="number" id="recorderMaxKBPerHour" value="{recorderMaxKBPerHour}" min="16" max="65536" onchange="saveRecorderConfig()" style="width: 100px;">
+            </div>
+            <p style="color: #888; font-size: 12px; margin-top: 10px; margin-bottom: 0;">
+                Zeichnet nur geänderte Bereiche auf, auch ohne verbundenen Browser. Die ältesten Aufnahmen werden überschrieben. Mit "Aufzeichnung laden" kann die Aufnahme oben durchgespult werden.
+            </p>
+        </div>
+    </div>
+    <div style="display: flex; justify-content: center; margin-bottom: 20px;">
+        <div style="max-width: 1000px; width: 100%; background: #2a2a2a; border: 1px solid #444; border-radius: 8px; padding: 20px;">
+            <label style="display: flex; align-items: center; justify-content: center; cursor: pointer;">
+                <input type="checkbox" id="captureEnabled" {captureChecked} onchange="toggleCapture(this.checked)" style="margin-right: 10px; transform: scale(1.5);">
+                <span style="color: #bbb;">HTTP-Mitschnitt: Antworten als Testdaten speichern (/capture, max 1MB)</span>
+            </label>
+            <p style="color: #888; font-size: 12px; margin-top: 10px; margin-bottom: 0;">
+                Speichert die erste vollständige Antwort jeder Ressource und jedes Jobs (entpackt, mit URL und Headern) für die Wiedergabe in den Parsern. Beim Aktivieren wird der alte Mitschnitt gelöscht. Achtung: URLs und Header können API-Schlüssel enthalten.
+            </p>
+        </div>
+    </div>
     <h3>Log-Ausgabe</h3>
     <div style="display: flex; justify-content: center;">
         <div style="max-width: 1000px; width: 100%;">
@@ -894,9 +968,13 @@ let ctx = canvas.getContext('2d');
 let logOutput = document.getElementById('logOutput');
 let statusText = document.getElementById('statusText');
 let connectBtn = document.getElementById('connectBtn');
+let streamStats = document.getElementById('streamStats');
+let replaySlider = document.getElementById('replaySlider');
+let replayTime = document.getElementById('replayTime');
 
-const PANEL_WIDTH = 192;  // 64 * 3
-const PANEL_HEIGHT = 96;   // 32 * 3
+// Panel size, taken over from the frame header
+let PANEL_WIDTH = 192;  // 64 * 3
+let PANEL_HEIGHT = 96;  // 32 * 3
 const LED_SIZE = 4;        // Optimized for ~800px width
 const LED_SPACING = 6.75;  // Spacing increased by 1.5x (4.5 * 1.5 = 6.75) for more authentic look
 
@@ -959,6 +1037,9 @@ function connect() {
         connectBtn.textContent = 'Trennen';
         connectBtn.disabled = false;
         addLog('[System] WebSocket verbunden');
+        // Announce the codecs this page can decode
+        ws.send(JSON.stringify({ type: 'codecs', accept: ACCEPTED_CODECS }));
+        streamStatsTimer = setInterval(updateStreamStats, 1000);
     };
     
     ws.onclose = function(event) {
@@ -968,6 +1049,12 @@ function connect() {
         connectBtn.textContent = 'Verbinden';
         connectBtn.disabled = false;
         addLog('[System] WebSocket getrennt (Code: ' + event.code + ')');
+        haveKeyframe = false;
+        lastSequence = -1;
+        latencyBaseMs = null;
+        if (streamStatsTimer) clearInterval(streamStatsTimer);
+        streamStatsTimer = null;
+        streamStats.textContent = '';
     };
     
     ws.onerror = function(err) {
@@ -980,21 +1067,22 @@ function connect() {
     
     ws.onmessage = function(event) {
         if (typeof event.data === 'string') {
-            // Text message - log data
             console.log('[WebSocket] Text message received:', event.data.substring(0, 100));
-            try {
-                const msg = JSON.parse(event.data);
-                if (msg.type === 'log') {
-                    addLog(msg.data);
-                }
-            } catch (e) {
-                console.error('[WebSocket] JSON parse error:', e);
-                addLog('[Error] Failed to parse log message');
-            }
+            return;
+        }
+        const data = new Uint8Array(event.data);
+        const header = parseFrameHeader(data);
+        if (!header) {
+            if (!headerWarningShown) addLog('[Stream] Unbekanntes Nachrichtenformat oder Protokollversion');
+            headerWarningShown = true;
+            return;
+        }
+        if (header.type === FRAME_LOG) {
+            // Binary message - batch of log lines
+            decodeLogFrame(data, header);
         } else {
-            // Binary message - panel data (RLE compressed)
-            console.log('[WebSocket] Binary message received, size:', event.data.byteLength);
-            decodeAndRenderPanel(new Uint8Array(event.data));
+            // Binary message - panel data (keyframe or delta frame with compressed tiles)
+            decodeAndRenderPanel(data, header);
         }
     };
 }
@@ -1004,61 +1092,437 @@ function addLog(text) {
     logOutput.scrollTop = logOutput.scrollHeight;
 }
 
+// Message header (see PanelStreamer.hpp): "PC", version, header length, type, sequence,
+// capture time, pixel format, width, height, tile size, codec
+const STREAM_PROTOCOL_VERSION = 1;
+const STREAM_HEADER_SIZE = 20;
+let headerWarningShown = false;
+
+function readU32(data, pos) {
+    return ((data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3]) >>> 0;
+}
+
+function parseFrameHeader(data) {
+    if (data.length < STREAM_HEADER_SIZE || data[0] !== 0x50 || data[1] !== 0x43) return null;
+    if (data[2] !== STREAM_PROTOCOL_VERSION) return null;
+    // Newer firmware may append fields, the payload always starts after headerLen bytes
+    const headerLen = data[3];
+    if (headerLen < STREAM_HEADER_SIZE || headerLen > data.length) return null;
+    return {
+        type: data[4],
+        sequence: readU32(data, 5),
+        captureMs: readU32(data, 9),
+        pixelFormat: data[13],
+        width: (data[14] << 8) | data[15],
+        height: (data[16] << 8) | data[17],
+        tileSize: data[18],
+        codec: data[19],
+        payload: headerLen
+    };
+}
+
+// Log frames: header, [dropped high][dropped low] then records [flags][len high][len low][UTF-8 text]
+const FRAME_LOG = 0x10;
+const LOG_RECORD_CONTINUED = 0x01;
+const LOG_RECORD_TRUNCATED = 0x02;
+const logDecoder = new TextDecoder();
+let logPartial = '';
+
+function decodeLogFrame(data, header) {
+    const lines = [];
+    const dropped = (data[header.payload] << 8) | data[header.payload + 1];
+    let pos = header.payload + 2;
+    // A line cut off by the ring is closed by an empty TRUNCATED record, always the first one of a frame
+    if (pos + 3 <= data.length && (data[pos] & LOG_RECORD_TRUNCATED) !== 0) {
+        if (logPartial) {
+            lines.push(logPartial + logDecoder.decode() + ' [...]');
+        }
+        logPartial = '';
+        pos += 3 + ((data[pos + 1] << 8) | data[pos + 2]);
+    }
+    if (dropped > 0) {
+        lines.push('[Stream] ' + dropped + ' Log-Zeilen verworfen');
+    }
+    while (pos + 3 <= data.length) {
+        const continued = (data[pos] & LOG_RECORD_CONTINUED) !== 0;
+        const len = (data[pos + 1] << 8) | data[pos + 2];
+        pos += 3;
+        if (pos + len > data.length) break;
+        logPartial += logDecoder.decode(data.subarray(pos, pos + len), { stream: continued });
+        pos += len;
+        if (!continued) {
+            lines.push(logPartial);
+            logPartial = '';
+        }
+    }
+    if (lines.length > 0) {
+        addLog(lines.join('\n'));
+    }
+}
+
 function clearLogs() {
     logOutput.textContent = '';
 }
 
-function decodeAndRenderPanel(data) {
-    // Reset to dark background
-    initCanvas();
-    
-    let pos = 0;
+// Last known panel content (0xRRGGBB), updated tile by tile from delta frames
+let panelPixels = new Uint32Array(PANEL_WIDTH * PANEL_HEIGHT);
+let haveKeyframe = false;
+
+const FRAME_KEY = 0x01;
+const FRAME_DELTA = 0x02;
+
+// Pixel formats (see PanelPixelFormatId): bytes per pixel on the wire and component bit widths
+const PIXEL_FORMATS = [
+    { bytes: 2, rBits: 5, gBits: 6, bBits: 5 },  // RGB565
+    { bytes: 3, rBits: 8, gBits: 8, bBits: 8 }   // RGB888
+];
+
+// Codec IDs (see PanelStreamCodec.hpp), in order of preference
+const CODEC_RLE = 0;
+const CODEC_QOI = 1;
+const CODEC_LZ = 2;
+const CODEC_NAMES = ['RLE', 'QOI', 'LZ'];
+const ACCEPTED_CODECS = [CODEC_QOI, CODEC_LZ, CODEC_RLE];
+
+// Received bytes for the bandwidth display
+// Received bytes for the bandwidth display, lost frames (sequence gaps) and latency
+let streamBytes = 0;
+let streamCodec = -1;
+let streamStatsTimer = null;
+let lastSequence = -1;
+let lostFrames = 0;
+// Device and browser clocks are not synchronized: latency is measured relative to
+// the fastest frame seen so far, which shows queueing delay on the way
+let latencyBaseMs = null;
+let latencySum = 0;
+let latencyCount = 0;
+
+function readPixel(data, pos, bytes) {
+    let p = 0;
+    for (let i = 0; i < bytes; i++) p = (p * 256) + data[pos + i];
+    return p;
+}
+
+function decodeRLE(data, pos, end, out, fmt) {
+    // RLE format: [count][pixel] for colored runs, [0x00][skipHigh][skipLow] for black runs
     let pixelIndex = 0;
-    
-    while (pos < data.length - 2 && pixelIndex < PANEL_WIDTH * PANEL_HEIGHT) {
+    while (pos + 3 <= end && pixelIndex < out.length) {
         let count = data[pos++];
-        
-        // Check for skip marker (count == 0x00 means skip black pixels)
         if (count === 0x00) {
-            if (pos < data.length - 1) {
-                let skipHigh = data[pos++];
-                let skipLow = data[pos++];
-                let skipCount = (skipHigh << 8) | skipLow;
-                pixelIndex += skipCount;  // Skip these positions (leave them black)
-            }
+            let skipCount = (data[pos] << 8) | data[pos + 1];
+            pos += 2;
+            for (let i = 0; i < skipCount && pixelIndex < out.length; i++) out[pixelIndex++] = 0;
             continue;
         }
-        
-        let highByte = data[pos++];
-        let lowByte = data[pos++];
-        
-        // Reconstruct RGB565 pixel
-        let rgb565 = (highByte << 8) | lowByte;
-        
-        // Convert RGB565 to RGB888
-        let r = ((rgb565 >> 11) & 0x1F) * 255 / 31;
-        let g = ((rgb565 >> 5) & 0x3F) * 255 / 63;
-        let b = (rgb565 & 0x1F) * 255 / 31;
-        
-        // Draw the LEDs
-        ctx.fillStyle = 'rgb(' + Math.round(r) + ',' + Math.round(g) + ',' + Math.round(b) + ')';
-        
-        for (let i = 0; i < count && pixelIndex < PANEL_WIDTH * PANEL_HEIGHT; i++) {
-            let x = pixelIndex % PANEL_WIDTH;
-            let y = Math.floor(pixelIndex / PANEL_WIDTH);
-            
-            let cx = x * LED_SPACING + LED_SPACING / 2;
-            let cy = y * LED_SPACING + LED_SPACING / 2;
-            
+        if (pos + fmt.bytes > end) break;
+        let pixel = readPixel(data, pos, fmt.bytes);
+        pos += fmt.bytes;
+        for (let i = 0; i < count && pixelIndex < out.length; i++) out[pixelIndex++] = pixel;
+    }
+    // Pixels not covered by the payload are black
+    while (pixelIndex < out.length) out[pixelIndex++] = 0;
+}
+
+function decodeQOI(data, pos, end, out, fmt) {
+    // Mirrors QoiStreamCodec: INDEX / DIFF / LUMA / RUN / RGB ops, state reset per tile
+    const gShift = fmt.bBits;
+    const rShift = fmt.gBits + fmt.bBits;
+    const rMask = (1 << fmt.rBits) - 1;
+    const gMask = (1 << fmt.gBits) - 1;
+    const bMask = (1 << fmt.bBits) - 1;
+    let index = new Uint32Array(64);
+    let prev = 0;
+    let pixelIndex = 0;
+    const hash = (p) => ((((p >> rShift) & rMask) * 3 + ((p >> gShift) & gMask) * 5 + (p & bMask) * 7) & 63);
+    while (pos < end && pixelIndex < out.length) {
+        let op = data[pos++];
+        if (op === 0xFE) {
+            prev = readPixel(data, pos, fmt.bytes);
+            pos += fmt.bytes;
+            index[hash(prev)] = prev;
+        } else if ((op & 0xC0) === 0xC0) {
+            for (let i = 0; i <= (op & 0x3F) && pixelIndex < out.length; i++) out[pixelIndex++] = prev;
+            continue;
+        } else if ((op & 0xC0) === 0x00) {
+            prev = index[op];
+        } else {
+            let dr, dg, db;
+            if ((op & 0xC0) === 0x40) {
+                dr = ((op >> 4) & 3) - 2;
+                dg = ((op >> 2) & 3) - 2;
+                db = (op & 3) - 2;
+            } else {
+                let b2 = data[pos++];
+                dg = (op & 0x3F) - 32;
+                dr = dg + ((b2 >> 4) & 0x0F) - 8;
+                db = dg + (b2 & 0x0F) - 8;
+            }
+            let r = (((prev >> rShift) & rMask) + dr) & rMask;
+            let g = (((prev >> gShift) & gMask) + dg) & gMask;
+            let b = ((prev & bMask) + db) & bMask;
+            prev = ((r << rShift) | (g << gShift) | b) >>> 0;
+            index[hash(prev)] = prev;
+        }
+        out[pixelIndex++] = prev;
+    }
+    while (pixelIndex < out.length) out[pixelIndex++] = 0;
+}
+
+function decodeLZ(data, pos, end, out, fmt) {
+    // Mirrors LzStreamCodec: literal runs and (possibly overlapping) back references
+    let pixelIndex = 0;
+    while (pos < end && pixelIndex < out.length) {
+        let ctrl = data[pos++];
+        if (ctrl & 0x80) {
+            let len = (ctrl & 0x7F) + 2;
+            let offset = data[pos++] + 1;
+            for (let i = 0; i < len && pixelIndex < out.length; i++, pixelIndex++) {
+                out[pixelIndex] = pixelIndex >= offset ? out[pixelIndex - offset] : 0;
+            }
+        } else {
+            let n = ctrl + 1;
+            for (let i = 0; i < n && pixelIndex < out.length; i++) {
+                out[pixelIndex++] = readPixel(data, pos, fmt.bytes);
+                pos += fmt.bytes;
+            }
+        }
+    }
+    while (pixelIndex < out.length) out[pixelIndex++] = 0;
+}
+
+function decodeTile(codec, data, pos, end, out, fmt) {
+    if (codec === CODEC_QOI) decodeQOI(data, pos, end, out, fmt);
+    else if (codec === CODEC_LZ) decodeLZ(data, pos, end, out, fmt);
+    else decodeRLE(data, pos, end, out, fmt);
+}
+
+function updateStreamStats() {
+    let kbps = streamBytes / 1024;
+    streamBytes = 0;
+    let codecName = streamCodec >= 0 ? CODEC_NAMES[streamCodec] || '?' : '-';
+    let text = 'Codec: ' + codecName + ' | ' + kbps.toFixed(1) + ' kB/s | Verloren: ' + lostFrames;
+    if (latencyCount > 0) text += ' | Latenz: +' + Math.round(latencySum / latencyCount) + ' ms';
+    latencySum = 0;
+    latencyCount = 0;
+    streamStats.textContent = text;
+}
+
+function toRgb888(pixel, fmt) {
+    // Scale the components of any pixel format to 8 bit
+    const rMask = (1 << fmt.rBits) - 1;
+    const gMask = (1 << fmt.gBits) - 1;
+    const bMask = (1 << fmt.bBits) - 1;
+    let r = Math.round(((pixel >> (fmt.gBits + fmt.bBits)) & rMask) * 255 / rMask);
+    let g = Math.round(((pixel >> fmt.bBits) & gMask) * 255 / gMask);
+    let b = Math.round((pixel & bMask) * 255 / bMask);
+    return (r << 16) | (g << 8) | b;
+}
+
+function pixelToCss(rgb888) {
+    return 'rgb(' + ((rgb888 >> 16) & 0xFF) + ',' + ((rgb888 >> 8) & 0xFF) + ',' + (rgb888 & 0xFF) + ')';
+}
+
+function ensurePanelSize(width, height) {
+    if (width === PANEL_WIDTH && height === PANEL_HEIGHT) return;
+    PANEL_WIDTH = width;
+    PANEL_HEIGHT = height;
+    panelPixels = new Uint32Array(PANEL_WIDTH * PANEL_HEIGHT);
+    initCanvas();
+}
+
+function drawTile(tileX, tileY, tileSize) {
+    // Clear the tile area and redraw its LEDs from panelPixels
+    ctx.fillStyle = '#000';
+    ctx.fillRect(tileX * tileSize * LED_SPACING, tileY * tileSize * LED_SPACING, tileSize * LED_SPACING, tileSize * LED_SPACING);
+    let lastColor = -1;
+    for (let y = tileY * tileSize; y < (tileY + 1) * tileSize; y++) {
+        for (let x = tileX * tileSize; x < (tileX + 1) * tileSize; x++) {
+            let pixel = panelPixels[y * PANEL_WIDTH + x];
+            if (pixel !== lastColor) {
+                ctx.fillStyle = pixel === 0 ? '#222' : pixelToCss(pixel);
+                lastColor = pixel;
+            }
             ctx.beginPath();
-            ctx.arc(cx, cy, LED_SIZE / 2, 0, 2 * Math.PI);
+            ctx.arc(x * LED_SPACING + LED_SPACING / 2, y * LED_SPACING + LED_SPACING / 2, LED_SIZE / 2, 0, 2 * Math.PI);
             ctx.fill();
-            
-            pixelIndex++;
         }
     }
 }
 
+function applyPanelFrame(data, header, draw) {
+    // Decode the tile records of a stream frame into panelPixels
+    const fmt = PIXEL_FORMATS[header.pixelFormat];
+    if (!fmt || header.tileSize === 0) return false;
+    ensurePanelSize(header.width, header.height);
+    let tileSize = header.tileSize;
+    let tilesX = PANEL_WIDTH / tileSize;
+    let tilePixels = new Uint32Array(tileSize * tileSize);
+    let pos = header.payload;
+    
+    while (pos + 3 <= data.length) {
+        let tileIndex = data[pos];
+        let payloadLen = (data[pos + 1] << 8) | data[pos + 2];
+        pos += 3;
+        if (pos + payloadLen > data.length) break;
+        
+        decodeTile(header.codec, data, pos, pos + payloadLen, tilePixels, fmt);
+        pos += payloadLen;
+        
+        let tileX = tileIndex % tilesX;
+        let tileY = Math.floor(tileIndex / tilesX);
+        for (let row = 0; row < tileSize; row++) {
+            let dest = (tileY * tileSize + row) * PANEL_WIDTH + tileX * tileSize;
+            for (let col = 0; col < tileSize; col++) {
+                panelPixels[dest + col] = toRgb888(tilePixels[row * tileSize + col], fmt);
+            }
+        }
+        if (draw) drawTile(tileX, tileY, tileSize);
+    }
+    return true;
+}
+
+function decodeAndRenderPanel(data, header) {
+    let frameType = header.type;
+    streamBytes += data.length;
+    streamCodec = header.codec;
+    if (frameType !== FRAME_KEY && frameType !== FRAME_DELTA) return;
+    
+    // Every frame built for this client carries the next sequence number, gaps are frames lost on the way
+    if (lastSequence >= 0) {
+        let gap = (header.sequence - lastSequence - 1) >>> 0;
+        if (gap < 0x10000) lostFrames += gap;
+    }
+    lastSequence = header.sequence;
+    
+    let delay = performance.now() - header.captureMs;
+    if (latencyBaseMs === null || delay < latencyBaseMs) latencyBaseMs = delay;
+    latencySum += delay - latencyBaseMs;
+    latencyCount++;
+    
+    // Deltas are meaningless until the first keyframe arrived
+    if (frameType === FRAME_DELTA && !haveKeyframe) return;
+    
+    if (applyPanelFrame(data, header, true) && frameType === FRAME_KEY) haveKeyframe = true;
+}
+
+// Flight recorder replay, segment format see PanelRecorder.hpp
+const RECORDER_HEADER_SIZE = 16;
+const RECORDER_RECORD_HEADER_SIZE = 6;
+let replayFrames = [];
+
+function parseRecording(bytes, segmentSizes) {
+    const frames = [];
+    let segStart = 0;
+    for (const size of segmentSizes) {
+        const segEnd = Math.min(segStart + size, bytes.length);
+        let pos = segStart + RECORDER_HEADER_SIZE;
+        while (pos + RECORDER_RECORD_HEADER_SIZE <= segEnd) {
+            const time = readU32(bytes, pos);
+            const len = (bytes[pos + 4] << 8) | bytes[pos + 5];
+            pos += RECORDER_RECORD_HEADER_SIZE;
+            // Zero padding or a truncated record ends the segment
+            if (len < STREAM_HEADER_SIZE || pos + len > segEnd) break;
+            const data = bytes.subarray(pos, pos + len);
+            const header = parseFrameHeader(data);
+            if (!header || (header.type !== FRAME_KEY && header.type !== FRAME_DELTA)) break;
+            frames.push({ time: time, data: data, header: header, key: header.type === FRAME_KEY });
+            pos += len;
+        }
+        segStart += size;
+    }
+    return frames;
+}
+
+function loadRecording() {
+    // Live frames would overwrite the replay
+    if (ws && ws.readyState === WebSocket.OPEN) ws.close();
+    replayTime.textContent = 'Lade...';
+    fetch('/api/recorder/data')
+    .then(response => {
+        if (!response.ok) throw new Error('HTTP ' + response.status);
+        const sizes = (response.headers.get('X-Recorder-Segments') || '').split(',').filter(s => s.length > 0).map(Number);
+        return response.arrayBuffer().then(buffer => parseRecording(new Uint8Array(buffer), sizes));
+    })
+    .then(frames => {
+        replayFrames = frames;
+        replaySlider.max = Math.max(frames.length - 1, 0);
+        replaySlider.disabled = frames.length === 0;
+        if (frames.length === 0) {
+            replayTime.textContent = 'Keine Aufzeichnung vorhanden';
+            return;
+        }
+        replaySlider.value = frames.length - 1;
+        showReplayFrame(frames.length - 1);
+        addLog('[System] Aufzeichnung geladen: ' + frames.length + ' Frames');
+    })
+    .catch(err => {
+        replayTime.textContent = '';
+        addLog('[Error] Fehler: ' + err.message);
+    });
+}
+
+function showReplayFrame(index) {
+    if (index < 0 || index >= replayFrames.length) return;
+    // Rebuild the picture from the closest keyframe
+    let start = index;
+    while (start > 0 && !replayFrames[start].key) start--;
+    if (!replayFrames[start].key) return;
+    for (let i = start; i <= index; i++) applyPanelFrame(replayFrames[i].data, replayFrames[i].header, false);
+    
+    let tileSize = replayFrames[index].header.tileSize;
+    for (let tileY = 0; tileY < PANEL_HEIGHT / tileSize; tileY++) {
+        for (let tileX = 0; tileX < PANEL_WIDTH / tileSize; tileX++) drawTile(tileX, tileY, tileSize);
+    }
+    
+    let t = replayFrames[index].time;
+    // Without NTP the device stores seconds since boot
+    let label = t > 1600000000 ? new Date(t * 1000).toLocaleString() : ('+' + t + ' s');
+    replayTime.textContent = label + ' (' + (index + 1) + '/' + replayFrames.length + ')';
+}
+
+function saveRecorderConfig() {
+    const enabled = document.getElementById('recorderEnabled').checked;
+    fetch('/api/recorder/config', {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json' },
+        body: JSON.stringify({
+            enabled: enabled,
+            intervalSec: parseInt(document.getElementById('recorderIntervalSec').value),
+            maxKBPerHour: parseInt(document.getElementById('recorderMaxKBPerHour').value)
+        })
+    })
+    .then(response => response.json())
+    .then(data => {
+        if (data.success) {
+            addLog('[System] Flugschreiber ' + (enabled ? 'aktiviert' : 'deaktiviert'));
+        } else {
+            addLog('[Error] Fehler beim Speichern der Flugschreiber-Einstellungen');
+        }
+    })
+    .catch(err => {
+        addLog('[Error] Fehler: ' + err.message);
+    });
+}
+
+function toggleCapture(enabled) {
+    fetch('/api/webclient/capture', {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json' },
+        body: JSON.stringify({ enabled: enabled })
+    })
+    .then(response => response.json())
+    .then(data => {
+        if (data.success) {
+            addLog('[System] HTTP-Mitschnitt ' + (enabled ? 'gestartet' : 'beendet'));
+        } else {
+            addLog('[Error] Fehler beim Umschalten des HTTP-Mitschnitts');
+        }
+    })
+    .catch(err => {
+        addLog('[Error] Fehler: ' + err.message);
+    });
+}
+
 function toggleDebugFile(enabled) {
     fetch('/api/toggle_debug_file', {
         method: 'POST',
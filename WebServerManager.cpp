@@ -72,9 +72,15 @@ void setupWebServer(bool portalMode) {
     server->on("/debug", HTTP_GET, handleDebugData);
     server->on("/debug/station", HTTP_GET, handleDebugStationHistory);
     server->on("/api/toggle_debug_file", HTTP_POST, handleToggleDebugFile);
+    server->on("/api/webclient/stats", HTTP_GET, handleWebClientStats);
+    server->on("/api/webclient/capture", HTTP_POST, handleWebClientCapture);
     
     // Stream page for remote debugging
     server->on("/stream", HTTP_GET, handleStreamPage);
+    server->on("/api/recorder/config", HTTP_POST, handleRecorderConfig);
+    server->on("/api/recorder/data", HTTP_GET, handleRecorderData);
+    server->on("/api/snapshot.png", HTTP_GET, handleSnapshotPng);
+    server->on("/api/snapshot.bmp", HTTP_GET, handleSnapshotBmp);
 
     // File manager (UI + API) registers its own routes
     setupFileManagerRoutes();
@@ -0,0 +1,549 @@
+// Fetch pipeline simulation: the real WebClientModule (workers, host token buckets, circuit breaker,
+// keep-alive pool, conditional GET, gzip) against a fake HTTP backend on a scaled clock.
+//
+// Hosts and intervals follow the modules: Tankerkoenig, open-meteo, SofaScore live data with
+// priority, ThemePark resources keyed by header, darts rankings, the streamed ICS calendar.
+// slow.example.net answers after 8 s, down.example.net refuses connections. Ad-hoc jobs run
+// next to them like the web UI (interactive) and the modules (background) submit them.
+//
+// Reported per host: staleness (the server has newer content than the main loop, sampled every
+// simulated second) and the fetch phases from the module's telemetry; per job class the time
+// from submission until the callback. Without --no-check the run fails if the slow host held
+// back another host or an interactive job.
+//
+// Usage: fetch_pipeline_sim [--minutes N] [--scale X] [--tls-budget-kb N] [--verbose] [--no-check]
+// --tls-budget-kb 48 gives a single worker, which shows what the slow host does to everything else.
+
+#include "HostNet.hpp"
+#include "HostRuntime.hpp"
+#include "WebClientModule.hpp"
+#include "webconfig.hpp"
+#include "MultiLogger.hpp"
+#include "GeneralTimeConverter.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+const uint32_t NO_GEN = 0xFFFFFFFF;
+const unsigned long WARMUP_MS = 60000;   // Start delay and the first round of fetches
+const unsigned long LOOP_MS = 100;       // Main loop period
+const unsigned long SAMPLE_MS = 1000;
+
+struct SimHost {
+    std::string name;
+    uint32_t ttfbMs;
+    uint32_t bodyMs;
+    size_t bodyBytes;
+    bool gzip;              // Sends gzip when the request accepts it
+    bool slow = false;      // Excluded from the freshness check, must not affect the others
+    bool down = false;
+    uint32_t notModified = 0;   // 304 answers (guarded by g_serverMutex)
+};
+
+// One managed resource and what the main loop has seen of it
+struct SimResource {
+    SimHost* host;
+    std::string url;
+    std::string headers;
+    std::string park;       // ThemePark resources differ by the park header only
+    uint32_t intervalS;
+    bool priority = false;
+    uint32_t changeMs;      // The server publishes new content this often
+    uint32_t phaseMs;
+    bool streaming = false;
+
+    ResourceSubscription subscription;
+    uint32_t observedGen = NO_GEN;
+    uint32_t updates = 0;
+    uint32_t samples = 0;
+    uint32_t staleSamples = 0;
+    uint64_t staleSumMs = 0;
+    uint32_t maxStaleMs = 0;
+
+    uint32_t genAt(unsigned long ms) const { return (uint32_t)((ms + phaseMs) / changeMs); }
+    unsigned long publishedMs(uint32_t gen) const {
+        uint64_t t = (uint64_t)gen * changeMs;
+        return t > phaseMs ? (unsigned long)(t - phaseMs) : 0;
+    }
+};
+
+// Body of the calendar, handed over chunk by chunk like to the CalendarModule
+class SimStreamConsumer : public ResourceStreamConsumer {
+public:
+    void onStreamBegin(int) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _head.clear();
+    }
+    bool onStreamChunk(const char* data, size_t len) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_head.size() < 32) _head.append(data, std::min(len, (size_t)32));
+        return true;
+    }
+    void onStreamEnd(bool complete) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (complete) _completedGen = parseGen(_head.data(), _head.size());
+    }
+    uint32_t completedGen() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _completedGen;
+    }
+
+    static uint32_t parseGen(const char* data, size_t len) {
+        if (len < 6 || strncmp(data, "#gen ", 5) != 0) return NO_GEN;
+        return (uint32_t)strtoul(data + 5, nullptr, 10);
+    }
+
+private:
+    std::mutex _mutex;
+    std::string _head;
+    uint32_t _completedGen = NO_GEN;
+};
+
+struct JobRecord {
+    JobPriority priority;
+    std::string host;
+    unsigned long submittedMs;
+    unsigned long doneMs = 0;
+    int httpCode = 0;
+};
+
+struct Options {
+    double minutes = 20;
+    double scale = 100;
+    int tlsBudgetKB = -1;   // -1 = DeviceConfig default
+    bool verbose = false;
+    bool check = true;
+};
+
+std::mutex g_serverMutex;
+std::vector<std::unique_ptr<SimHost>> g_hosts;
+std::vector<std::unique_ptr<SimResource>> g_resources;
+std::map<std::string, SimResource*> g_byRequest;    // url + "|" + park header
+std::map<std::string, SimHost*> g_byHost;
+std::mutex g_jobMutex;
+std::vector<JobRecord> g_jobs;
+
+SimHost* addHost(const std::string& name, uint32_t ttfbMs, uint32_t bodyMs, size_t bodyBytes, bool gzip) {
+    g_hosts.emplace_back(new SimHost{ name, ttfbMs, bodyMs, bodyBytes, gzip });
+    SimHost* host = g_hosts.back().get();
+    g_byHost[name] = host;
+    return host;
+}
+
+SimResource* addResource(SimHost* host, const std::string& url, uint32_t intervalS, uint32_t changeS) {
+    g_resources.emplace_back(new SimResource());
+    SimResource* r = g_resources.back().get();
+    r->host = host;
+    r->url = url;
+    r->intervalS = intervalS;
+    r->changeMs = changeS * 1000;
+    r->phaseMs = (uint32_t)(esp_random() % r->changeMs);
+    return r;
+}
+
+void indexResource(SimResource* r) { g_byRequest[r->url + "|" + r->park] = r; }
+
+std::string hostOf(const std::string& url) {
+    size_t start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    size_t end = url.find_first_of(":/", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+std::string gzipBody(const std::string& body) {
+    z_stream stream = {};
+    deflateInit2(&stream, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, body.size()) + 32, '\0');
+    stream.next_in = (Bytef*)body.data();
+    stream.avail_in = (uInt)body.size();
+    stream.next_out = (Bytef*)&out[0];
+    stream.avail_out = (uInt)out.size();
+    deflate(&stream, Z_FINISH);
+    out.resize(out.size() - stream.avail_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// Repetitive text like the JSON and HTML the real APIs send, so gzip shrinks it realistically
+std::string makeBody(uint32_t gen, const std::string& what, size_t bytes) {
+    std::string body = "#gen " + std::to_string(gen) + "\n";
+    uint32_t n = 0;
+    while (body.size() < bytes) {
+        body += "{\"id\":" + std::to_string(n) + ",\"name\":\"" + what + "\",\"value\":" + std::to_string((n * 7919 + gen) % 1000) + "},\n";
+        n++;
+    }
+    body.resize(bytes);
+    return body;
+}
+
+HostNet::Response serve(const HostNet::Request& request) {
+    HostNet::Response response;
+    unsigned long nowMs = millis();
+    SimHost* host = nullptr;
+    SimResource* resource = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_serverMutex);
+        auto h = g_byHost.find(request.host);
+        if (h == g_byHost.end()) {
+            response.status = 404;
+            return response;
+        }
+        host = h->second;
+        auto r = g_byRequest.find(request.url + "|" + request.header("park"));
+        if (r != g_byRequest.end()) resource = r->second;
+    }
+    response.ttfbMs = host->ttfbMs;
+    response.bodyMs = host->bodyMs;
+
+    // Ad-hoc requests: fresh answer every time
+    uint32_t gen = resource ? resource->genAt(nowMs) : (uint32_t)(nowMs / 1000);
+    std::string etag = "\"" + std::to_string(std::hash<std::string>()(request.url + request.header("park")) & 0xFFFFFF) + "-" + std::to_string(gen) + "\"";
+    if (resource && request.header("If-None-Match") == etag) {
+        std::lock_guard<std::mutex> lock(g_serverMutex);
+        host->notModified++;
+        response.status = 304;
+        response.bodyMs = 0;
+        return response;
+    }
+    std::string body = makeBody(gen, request.path, resource ? host->bodyBytes : 512);
+    if (resource) response.headers.emplace_back("ETag", etag);
+    if (host->gzip && request.header("Accept-Encoding").find("gzip") != std::string::npos) {
+        body = gzipBody(body);
+        response.headers.emplace_back("Content-Encoding", "gzip");
+    }
+    response.body = std::move(body);
+    return response;
+}
+
+void setupScenario(WebClientModule& web, SimStreamConsumer& calendar) {
+    HostNet::HostBehaviour lan;
+    lan.connectMs = 10;
+    lan.tlsMs = 150;
+
+    SimHost* tanker = addHost("creativecommons.tankerkoenig.de", 180, 20, 2 * 1024, false);
+    SimHost* meteo = addHost("api.open-meteo.com", 120, 80, 24 * 1024, true);
+    SimHost* sofa = addHost("api.sofascore.com", 90, 60, 32 * 1024, true);
+    SimHost* parks = addHost("api.wartezeiten.app", 250, 60, 16 * 1024, true);
+    SimHost* darts = addHost("www.dartsrankings.com", 400, 1500, 120 * 1024, false);
+    SimHost* ics = addHost("calendar.example.org", 300, 3000, 300 * 1024, false);
+    SimHost* geo = addHost("nominatim.openstreetmap.org", 300, 20, 0, false);
+    SimHost* slow = addHost("slow.example.net", 8000, 500, 8 * 1024, false);
+    slow->slow = true;
+    SimHost* down = addHost("down.example.net", 0, 0, 0, false);
+    down->down = true;
+    for (auto& host : g_hosts) HostNet::setHostBehaviour(host->name, lan);
+    HostNet::HostBehaviour refused = lan;
+    refused.refuses = true;
+    HostNet::setHostBehaviour(down->name, refused);
+    (void)geo;
+
+    SimResource* r = addResource(tanker, "https://creativecommons.tankerkoenig.de/json/prices.php?ids=a,b,c&apikey=sim", 300, 600);
+    indexResource(r);
+    r = addResource(meteo, "https://api.open-meteo.com/v1/forecast?latitude=51.2&longitude=6.8&hourly=temperature_2m", 900, 900);
+    indexResource(r);
+    r = addResource(sofa, "https://api.sofascore.com/api/v1/sport/football/events/live", 30, 15);
+    r->priority = true;
+    indexResource(r);
+    for (int match = 0; match < 3; match++) {
+        r = addResource(sofa, "https://api.sofascore.com/api/v1/event/1200" + std::to_string(match) + "/statistics", 30, 15);
+        r->priority = true;
+        indexResource(r);
+    }
+    for (const char* park : { "phantasialand", "europapark" }) {
+        struct { const char* path; uint32_t intervalS; uint32_t changeS; } endpoints[] = {
+            { "waitingtimes", 600, 300 }, { "crowdlevel", 1800, 1800 }, { "openingtimes", 21600, 21600 } };
+        for (const auto& e : endpoints) {
+            r = addResource(parks, std::string("https://api.wartezeiten.app/v1/") + e.path, e.intervalS, e.changeS);
+            r->park = park;
+            r->headers = std::string("accept: application/json\npark: ") + park;
+            indexResource(r);
+        }
+    }
+    indexResource(addResource(darts, "https://www.dartsrankings.com/", 3600, 3600));
+    indexResource(addResource(darts, "https://www.dartsrankings.com/protour", 3600, 3600));
+    r = addResource(ics, "https://calendar.example.org/basic.ics", 900, 600);
+    r->streaming = true;
+    indexResource(r);
+    indexResource(addResource(slow, "https://slow.example.net/feed/1", 60, 60));
+    indexResource(addResource(slow, "https://slow.example.net/feed/2", 60, 60));
+    indexResource(addResource(down, "https://down.example.net/status", 60, 60));
+
+    HostNet::setHandler(serve);
+
+    // Registered like the modules do it
+    for (auto& res : g_resources) {
+        String url(res->url.c_str());
+        if (res->streaming) {
+            web.registerStreamingResource(url, res->intervalS / 60, &calendar);
+        } else if (!res->headers.empty()) {
+            web.registerResourceWithHeaders(url, String(res->headers.c_str()), res->intervalS / 60);
+        } else {
+            // force_new: several URLs per host (darts, SofaScore statistics)
+            web.registerResourceSeconds(url, res->intervalS, res->priority, true);
+        }
+        res->subscription.setUrl(PsramString(res->url.c_str()), PsramString(res->headers.c_str()));
+    }
+}
+
+void submitJob(WebClientModule& web, const std::string& url, JobPriority priority) {
+    size_t index;
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        index = g_jobs.size();
+        g_jobs.push_back(JobRecord{ priority, hostOf(url), millis() });
+    }
+    web.getRequest(PsramString(url.c_str()), [index](int httpCode, const char*, size_t) {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        g_jobs[index].doneMs = millis();
+        g_jobs[index].httpCode = httpCode;
+    }, priority);
+}
+
+void observe(WebClientModule& web, SimStreamConsumer& calendar) {
+    for (auto& res : g_resources) {
+        uint32_t gen = NO_GEN;
+        if (res->streaming) {
+            gen = calendar.completedGen();
+        } else {
+            ResourceDataRef data;
+            if (web.takeNewData(res->subscription, data)) gen = SimStreamConsumer::parseGen(data.data(), data.size());
+        }
+        if (gen != NO_GEN && gen != res->observedGen) {
+            res->observedGen = gen;
+            res->updates++;
+        }
+    }
+}
+
+void sample(unsigned long nowMs, unsigned long startMs) {
+    for (auto& res : g_resources) {
+        uint32_t serverGen = res->genAt(nowMs);
+        uint32_t staleMs = 0;
+        if (res->observedGen == NO_GEN) {
+            staleMs = (uint32_t)(nowMs - startMs);
+        } else if (res->observedGen < serverGen) {
+            staleMs = (uint32_t)(nowMs - res->publishedMs(res->observedGen + 1));
+        }
+        res->samples++;
+        res->staleSumMs += staleMs;
+        if (staleMs > 0) res->staleSamples++;
+        res->maxStaleMs = std::max(res->maxStaleMs, staleMs);
+    }
+}
+
+uint32_t percentile(std::vector<uint32_t> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    size_t i = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[std::min(i, values.size() - 1)];
+}
+
+double meanMs(const LatencyHistogram& h) { return h.samples() ? (double)h.total_ms / h.samples() : 0; }
+
+bool g_checksOk = true;
+
+void check(bool ok, const std::string& what) {
+    printf("  %-6s %s\n", ok ? "ok" : "FAILED", what.c_str());
+    if (!ok) g_checksOk = false;
+}
+
+int run(const Options& options) {
+    HostRuntime::setSerialEnabled(options.verbose);
+    HostRuntime::seedRandom(33);
+    HostRuntime::setClockScale(options.scale);
+
+    static DeviceConfig config;
+    if (options.tlsBudgetKB > 0) config.webClientTlsBudgetKB = options.tlsBudgetKB;
+    config.webClientBufferSize = 64 * 1024;
+    deviceConfig = &config;
+
+    static WebClientModule web;
+    static SimStreamConsumer calendar;
+    setupScenario(web, calendar);
+    bool pending = false;
+    web.addUpdateListener([&pending](const ResourceUpdateEvent&) { pending = true; });
+    unsigned long startMs = millis();
+    web.begin();
+
+    const unsigned long durationMs = (unsigned long)(options.minutes * 60000);
+    unsigned long nextSampleMs = startMs + WARMUP_MS;
+    unsigned long nextInteractiveMs = startMs + WARMUP_MS;
+    unsigned long nextBackgroundMs = startMs + WARMUP_MS + 5000;
+    uint32_t interactiveCount = 0;
+    while (millis() - startMs < durationMs) {
+        unsigned long nowMs = millis();
+        pending = false;
+        web.dispatchUpdateEvents();
+        if (pending || nowMs >= nextSampleMs) observe(web, calendar);
+        if (nowMs >= nextSampleMs) {
+            sample(nowMs, startMs);
+            nextSampleMs += SAMPLE_MS;
+        }
+        // Web UI: a geocoder lookup every 13 s (not in step with the intervals); modules: a park list and a slow-host report every minute
+        if (nowMs >= nextInteractiveMs) {
+            submitJob(web, "https://nominatim.openstreetmap.org/search?format=json&q=" + std::to_string(interactiveCount++), JOB_PRIORITY_INTERACTIVE);
+            nextInteractiveMs += 13000;
+        }
+        if (nowMs >= nextBackgroundMs) {
+            submitJob(web, "https://api.wartezeiten.app/v1/parks?n=" + std::to_string(nowMs / 60000), JOB_PRIORITY_BACKGROUND);
+            submitJob(web, "https://slow.example.net/report?n=" + std::to_string(nowMs / 60000), JOB_PRIORITY_BACKGROUND);
+            nextBackgroundMs += 60000;
+        }
+        delay(LOOP_MS);
+    }
+    HostNet::setWifiConnected(false);
+
+    // --- Report ---
+    int workers = std::min(std::max(config.webClientTlsBudgetKB / WEBCLIENT_TLS_SESSION_KB, 1), WEBCLIENT_MAX_WORKERS);
+    printf("Fetch pipeline simulation: %.0f min simulated, %d worker(s) (TLS budget %d KB), clock x%.0f\n\n",
+           options.minutes, workers, config.webClientTlsBudgetKB, options.scale);
+
+    printf("Staleness: the server had newer content than the main loop (sampled every second after %lu s)\n", WARMUP_MS / 1000);
+    printf("%-34s %4s %9s %8s %5s %7s %7s %7s\n", "host", "res", "interval", "updates", "304", "stale%", "mean s", "max s");
+    std::map<std::string, std::vector<SimResource*>> byHost;
+    for (auto& res : g_resources) byHost[res->host->name].push_back(res.get());
+    for (auto& host : g_hosts) {
+        auto it = byHost.find(host->name);
+        if (it == byHost.end()) continue;
+        uint32_t updates = 0, samples = 0, staleSamples = 0, maxStale = 0, minInterval = UINT32_MAX;
+        uint64_t staleSum = 0;
+        for (SimResource* res : it->second) {
+            updates += res->updates;
+            samples += res->samples;
+            staleSamples += res->staleSamples;
+            staleSum += res->staleSumMs;
+            maxStale = std::max(maxStale, res->maxStaleMs);
+            minInterval = std::min(minInterval, res->intervalS);
+        }
+        printf("%-34s %4zu %7us %8u %5u %6.1f%% %7.1f %7.1f\n", host->name.c_str(), it->second.size(), (unsigned)minInterval, updates,
+               host->notModified, samples ? 100.0 * staleSamples / samples : 0.0, samples ? staleSum / 1000.0 / samples : 0.0, maxStale / 1000.0);
+    }
+
+    printf("\nFetch latency (module telemetry, ms)\n");
+    printf("%-34s %7s %9s %6s %8s %8s %8s %8s\n", "host", "fetches", "handshake", "reused", "tls", "ttfb", "body", "max ttfb");
+    PsramVector<ResourceTelemetryInfo> telemetry = web.getResourceTelemetry();
+    PsramVector<HostLimiter> limiters = web.getHostStats();
+    for (auto& host : g_hosts) {
+        FetchTelemetry total;
+        for (const ResourceTelemetryInfo& info : telemetry) {
+            if (hostOf(info.url.c_str()) != host->name) continue;
+            const FetchTelemetry& t = info.telemetry;
+            total.fetches += t.fetches;
+            for (int p = 0; p < FETCH_PHASE_COUNT; p++) {
+                total.phases[p].total_ms += t.phases[p].total_ms;
+                total.phases[p].max_ms = std::max(total.phases[p].max_ms, t.phases[p].max_ms);
+                for (int b = 0; b < WEBCLIENT_HISTOGRAM_BUCKETS; b++) total.phases[p].counts[b] += t.phases[p].counts[b];
+            }
+        }
+        uint32_t handshakes = 0, reused = 0;
+        for (const HostLimiter& limiter : limiters) {
+            if (limiter.host.c_str() != host->name) continue;
+            handshakes = limiter.handshakes;
+            reused = limiter.reused;
+        }
+        if (total.fetches == 0 && handshakes == 0) continue;
+        printf("%-34s %7u %9u %6u %8.0f %8.0f %8.0f %8u\n", host->name.c_str(), (unsigned)total.fetches, (unsigned)handshakes, (unsigned)reused,
+               meanMs(total.phases[FETCH_PHASE_TLS]), meanMs(total.phases[FETCH_PHASE_TTFB]), meanMs(total.phases[FETCH_PHASE_BODY]),
+               (unsigned)total.phases[FETCH_PHASE_TTFB].max_ms);
+    }
+
+    printf("\nJobs (submission until callback, ms)\n");
+    printf("%-12s %-30s %5s %5s %8s %8s %8s\n", "class", "host", "jobs", "ok", "mean", "p95", "max");
+    std::map<std::pair<int, std::string>, std::vector<const JobRecord*>> jobGroups;
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        for (const JobRecord& job : g_jobs) jobGroups[std::make_pair((int)job.priority, job.host)].push_back(&job);
+    }
+    std::map<std::string, uint32_t> maxJobMs;
+    for (const auto& group : jobGroups) {
+        std::vector<uint32_t> latencies;
+        uint32_t ok = 0;
+        uint64_t sum = 0;
+        for (const JobRecord* job : group.second) {
+            if (!job->doneMs) continue;
+            uint32_t ms = (uint32_t)(job->doneMs - job->submittedMs);
+            latencies.push_back(ms);
+            sum += ms;
+            if (job->httpCode == 200) ok++;
+        }
+        uint32_t max = latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+        maxJobMs[group.first.second] = std::max(maxJobMs[group.first.second], max);
+        printf("%-12s %-30s %5zu %5u %8.0f %8u %8u\n", JobQueueStats::className((JobPriority)group.first.first), group.first.second.c_str(),
+               group.second.size(), ok, latencies.empty() ? 0.0 : (double)sum / latencies.size(), percentile(latencies, 0.95), max);
+    }
+
+    if (!options.check) return 0;
+
+    // A host gets one request at a time, so the slow host ties up one worker; with two or more
+    // the others must keep their intervals and the web UI must not wait for it
+    printf("\nChecks\n");
+    for (auto& res : g_resources) {
+        if (res->host->slow || res->host->down) continue;
+        // Resources due again within the run, plus slack for the token bucket and a worker busy with a long body
+        if ((unsigned long)res->intervalS * 1000 + WARMUP_MS > durationMs) continue;
+        uint32_t boundMs = res->intervalS * 1000 + 20000;
+        check(res->maxStaleMs <= boundMs, res->url + (res->park.empty() ? "" : " [" + res->park + "]") + ": stale at most " +
+              std::to_string(res->maxStaleMs / 1000) + " s (bound " + std::to_string(boundMs / 1000) + " s)");
+    }
+    uint32_t slowUpdates = 0;
+    for (auto& res : g_resources) {
+        if (res->host->slow) slowUpdates += res->updates;
+    }
+    check(slowUpdates > 0, "slow.example.net still delivers (" + std::to_string(slowUpdates) + " updates)");
+    uint32_t trips = 0;
+    for (const HostLimiter& limiter : limiters) {
+        if (limiter.host == "down.example.net") trips = limiter.trips;
+    }
+    check(trips > 0, "circuit breaker of down.example.net opened " + std::to_string(trips) + " time(s)");
+    check(maxJobMs["nominatim.openstreetmap.org"] <= 5000,
+          "interactive jobs answered within " + std::to_string(maxJobMs["nominatim.openstreetmap.org"]) + " ms (bound 5000 ms)");
+    size_t unanswered = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_jobMutex);
+        for (const JobRecord& job : g_jobs) {
+            if (!job.doneMs && job.host != "slow.example.net" && millis() - job.submittedMs > 30000) unanswered++;
+        }
+    }
+    check(unanswered == 0, std::to_string(unanswered) + " jobs to fast hosts without answer");
+    return g_checksOk ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--minutes" && i + 1 < argc) options.minutes = atof(argv[++i]);
+        else if (arg == "--scale" && i + 1 < argc) options.scale = atof(argv[++i]);
+        else if (arg == "--tls-budget-kb" && i + 1 < argc) options.tlsBudgetKB = atoi(argv[++i]);
+        else if (arg == "--verbose") options.verbose = true;
+        else if (arg == "--no-check") options.check = false;
+        else {
+            fprintf(stderr, "Usage: %s [--minutes N] [--scale X] [--tls-budget-kb N] [--verbose] [--no-check]\n", argv[0]);
+            return 2;
+        }
+    }
+    int rc = run(options);
+    // The worker tasks never return: leave without running static destructors under them
+    std::error_code ec;
+    std::filesystem::remove_all(HostRuntime::filesystemRoot(), ec);
+    fflush(stdout);
+    _exit(rc);
+}
@@ -0,0 +1,412 @@
+// Calendar download parse benchmark: the IcsTokenizer/IcsEventParser stream consumer against the
+// parser it replaced (a port of parseICS/parseVEvent from before the tokenizer), on synthetic ICS
+// files of 1 MB and 10 MB handed over in 1436-byte chunks like a fetch worker does.
+//
+// Per size and parser: median parse time, heap allocations, peak heap above the start (carry,
+// event vector, summaries). The check compares the events of both parsers on what the old one
+// could read (UID, start, duration, RRULE, first EXDATE) and fails on any difference.
+//
+// Usage: ics_parser_bench [--sizes 1,10] [--iterations N]
+
+#include "RRuleParser.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "AllocHook.hpp"
+#include "HostRuntime.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+
+namespace {
+
+const size_t kChunk = 1436;
+
+// --- Old parser (RRuleParser.cpp / CalendarModule.cpp before the tokenizer) ---
+
+namespace LegacyIcs {
+
+struct Event {
+    PsramString summary;
+    PsramString rrule;
+    PsramString uid;
+    time_t dtstart = 0;
+    time_t dtend = 0;
+    time_t recurrence_id = 0;
+    std::vector<time_t, PsramAllocator<time_t>> exdates;
+    bool isAllDay = false;
+    time_t duration = 0;
+};
+
+inline int parseDecimal(const char* p, size_t len) {
+    int v = 0;
+    for (size_t i = 0; i < len; ++i) {
+        char c = p[i];
+        if (c < '0' || c > '9') break;
+        v = v * 10 + (c - '0');
+    }
+    return v;
+}
+
+// parseICalDateTime(): reads the value up to the string's terminator, i.e. to the end of the VEVENT block
+time_t parseLegacyDateTime(const char* line, size_t len, bool& isAllDay, const GeneralTimeConverter* converter) {
+    isAllDay = false;
+    if (!line || len == 0) return 0;
+
+    const char* value_ptr = line;
+    const char* colon = (const char*)memchr(line, ':', len);
+    if (colon) value_ptr = colon + 1;
+
+    bool hasTZID = false;
+    const char* semicolon = (const char*)memchr(line, ';', len);
+    if (semicolon && semicolon < colon) {
+        if (strstr(semicolon, "VALUE=DATE")) isAllDay = true;
+        const char* tzid = strstr(semicolon, "TZID=");
+        if (tzid && tzid < colon && tzid >= semicolon) hasTZID = true;
+    }
+
+    const char* dt_str = value_ptr;
+    size_t dt_len = strlen(dt_str);
+    while (dt_len > 0 && !isalnum(dt_str[dt_len - 1])) dt_len--;
+    if (dt_len < 8) return 0;
+
+    int year = parseDecimal(dt_str, 4);
+    int month = parseDecimal(dt_str + 4, 2);
+    int day = parseDecimal(dt_str + 6, 2);
+    int hour = 0, minute = 0, second = 0;
+    if (dt_len > 8 && dt_str[8] == 'T') {
+        if (dt_len >= 15) {
+            hour = parseDecimal(dt_str + 9, 2);
+            minute = parseDecimal(dt_str + 11, 2);
+            second = parseDecimal(dt_str + 13, 2);
+        }
+    } else {
+        isAllDay = true;
+    }
+
+    struct tm t = {0};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    t.tm_sec = second;
+    t.tm_isdst = -1;
+
+    bool isUTC = (dt_len > 0 && dt_str[dt_len - 1] == 'Z');
+    if (isUTC) {
+        return timegm(&t);
+    } else if (hasTZID && converter) {
+        time_t as_if_utc = timegm(&t);
+        int initial_offset = converter->isDST(as_if_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
+        time_t approx_utc = as_if_utc - initial_offset;
+        int final_offset = converter->isDST(approx_utc) ? converter->getDstOffsetSec() : converter->getStdOffsetSec();
+        return as_if_utc - final_offset;
+    } else {
+        return mktime(&t);
+    }
+}
+
+void parseVEvent(const char* veventBlock, size_t len, Event& event, const GeneralTimeConverter* converter) {
+    if (!veventBlock || len == 0) return;
+    const char* p = veventBlock;
+    const char* end = veventBlock + len;
+    bool dtstart_is_allday = false;
+    bool dtend_is_allday = false;
+
+    while (p < end) {
+        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+        size_t lineLen = 0;
+        if (lineEnd) {
+            lineLen = lineEnd - p;
+        } else {
+            lineLen = end - p;
+            lineEnd = end;
+        }
+        if (lineLen > 0 && p[lineLen - 1] == '\r') --lineLen;
+
+        if (lineLen > 8 && strncmp(p, "SUMMARY:", 8) == 0) {
+            event.summary = PsramString(p + 8, lineLen - 8);
+        } else if (lineLen > 6 && strncmp(p, "RRULE:", 6) == 0) {
+            event.rrule = PsramString(p + 6, lineLen - 6);
+        } else if (lineLen > 4 && strncmp(p, "UID:", 4) == 0) {
+            event.uid = PsramString(p + 4, lineLen - 4);
+        } else if (strncmp(p, "DTSTART", 7) == 0) {
+            event.dtstart = parseLegacyDateTime(p, lineLen, dtstart_is_allday, converter);
+        } else if (strncmp(p, "DTEND", 5) == 0) {
+            event.dtend = parseLegacyDateTime(p, lineLen, dtend_is_allday, converter);
+        } else if (strncmp(p, "EXDATE", 6) == 0) {
+            bool dummy;
+            time_t ex = parseLegacyDateTime(p, lineLen, dummy, converter);
+            if (ex != 0) event.exdates.push_back(ex);
+        } else if (strncmp(p, "RECURRENCE-ID", 13) == 0) {
+            bool dummy;
+            event.recurrence_id = parseLegacyDateTime(p, lineLen, dummy, converter);
+        }
+        p = lineEnd + 1;
+    }
+
+    event.isAllDay = dtstart_is_allday;
+    if (event.dtend > event.dtstart) {
+        event.duration = event.dtend - event.dtstart;
+    } else if (event.isAllDay) {
+        event.duration = 86400;
+    } else {
+        event.duration = 0;
+    }
+}
+
+size_t parseICS(const char* icsData, size_t size, PsramVector<Event>& parsedEvents, const GeneralTimeConverter* converter) {
+    if (!icsData || size == 0) return 0;
+    PsramString ics(icsData, size);
+
+    size_t idx = 0;
+    const PsramString beginTag("BEGIN:VEVENT"), endTag("END:VEVENT");
+    while (true) {
+        size_t pos = ics.find(beginTag, idx);
+        if (pos == PsramString::npos) {
+            size_t keepFrom = (size > beginTag.length()) ? size - beginTag.length() : 0;
+            return (keepFrom > idx) ? keepFrom : idx;
+        }
+        size_t endPos = ics.find(endTag, pos);
+        if (endPos == PsramString::npos) return pos;
+        PsramString veventBlock = ics.substr(pos, (endPos + endTag.length()) - pos);
+        Event parsedEvent;
+        parseVEvent(veventBlock.c_str(), veventBlock.length(), parsedEvent, converter);
+        if (parsedEvent.dtstart > 0) parsedEvents.push_back(std::move(parsedEvent));
+        idx = endPos + endTag.length();
+        if (parsedEvents.size() % 50 == 0) delay(1);
+    }
+}
+
+// onStreamBegin/onStreamChunk/onStreamEnd of the old CalendarModule
+struct StreamConsumer {
+    explicit StreamConsumer(const GeneralTimeConverter* converter) : converter(converter) { _events.reserve(512); }
+
+    void feed(const char* data, size_t len) {
+        carry.append(data, len);
+        size_t consumed = parseICS(carry.c_str(), carry.length(), _events, converter);
+        if (consumed > 0) carry.erase(0, consumed);
+    }
+
+    void finish() {
+        carry.clear();
+        carry.shrink_to_fit();
+    }
+
+    PsramVector<Event>& events() { return _events; }
+
+    const GeneralTimeConverter* converter;
+    PsramString carry;
+    PsramVector<Event> _events;
+};
+
+} // namespace LegacyIcs
+
+// --- Current parser: IcsStreamParser as used by CalendarModule::onStreamBegin/onStreamChunk/onStreamEnd ---
+
+struct StreamConsumer : IcsStreamParser {
+    explicit StreamConsumer(const GeneralTimeConverter* converter) : IcsStreamParser(converter) { events().reserve(512); }
+};
+
+// --- Input ---
+
+// RFC 5545 line folding at 75 octets
+void appendFolded(std::string& out, const std::string& line) {
+    size_t pos = 0;
+    size_t width = 75;
+    while (line.size() - pos > width) {
+        out.append(line, pos, width);
+        out += "\r\n ";
+        pos += width;
+        width = 74;
+    }
+    out.append(line, pos, std::string::npos);
+    out += "\r\n";
+}
+
+// A Google-style calendar export as in replay/fixtures/make_fixtures.py, repeated until size bytes
+std::string makeCalendar(size_t size) {
+    static const char* const titles[] = {"Zahnarzt", "Elternabend", "Training", "Geburtstag Oma", "Müll: Gelbe Tonne",
+                                         "Chor", "Tierarzt", "Schwimmkurs", "Werkstatt Termin", "Team-Meeting"};
+    static const char* const words[] = {"bitte", "Unterlagen", "mitbringen", "Parkplatz", "hinten", "Raum 3.14",
+                                        "anrufen", "vorher", "bestätigen", "Ümläute"};
+    static const char* const days[] = {"MO", "TU,TH", "WE", "FR", "SA,SU"};
+    std::mt19937 rng(20250101);
+    auto pick = [&rng](int n) { return (int)(rng() % n); };
+
+    std::string ics;
+    ics.reserve(size + 4096);
+    ics += "BEGIN:VCALENDAR\r\nVERSION:2.0\r\nPRODID:-//Google Inc//Google Calendar 70.9054//EN\r\n"
+           "X-WR-TIMEZONE:Europe/Berlin\r\nBEGIN:VTIMEZONE\r\nTZID:Europe/Berlin\r\nBEGIN:STANDARD\r\n"
+           "TZOFFSETFROM:+0200\r\nTZOFFSETTO:+0100\r\nDTSTART:19701025T030000\r\nEND:STANDARD\r\nEND:VTIMEZONE\r\n";
+    char line[160];
+    for (int n = 0; ics.size() < size; n++) {
+        int year = 2023 + n % 4, month = 1 + pick(12), day = 1 + pick(28), hour = 7 + pick(12), minute = 15 * pick(4);
+        snprintf(line, sizeof(line), "BEGIN:VEVENT\r\nUID:%08x-%06d@google.com\r\nDTSTAMP:20251001T120000Z\r\n", (unsigned)rng(), n);
+        ics += line;
+        int kind = n % 6;
+        if (kind == 0) {
+            snprintf(line, sizeof(line), "DTSTART;VALUE=DATE:%04d%02d%02d\r\nDTEND;VALUE=DATE:%04d%02d%02d\r\n",
+                     year, month, day, year, month, day + 1);
+        } else if (kind == 1) {
+            snprintf(line, sizeof(line), "DTSTART:%04d%02d%02dT%02d%02d00Z\r\nDTEND:%04d%02d%02dT%02d%02d00Z\r\n",
+                     year, month, day, hour, minute, year, month, day, hour + 1, minute);
+        } else {
+            snprintf(line, sizeof(line), "DTSTART;TZID=Europe/Berlin:%04d%02d%02dT%02d%02d00\r\nDTEND;TZID=Europe/Berlin:%04d%02d%02dT%02d%02d00\r\n",
+                     year, month, day, hour, minute, year, month, day, hour + 1, minute);
+        }
+        ics += line;
+        if (kind == 2 || kind == 3) {
+            snprintf(line, sizeof(line), "RRULE:FREQ=WEEKLY;BYDAY=%s;UNTIL=%04d1231T235959Z\r\n", days[pick(5)], year + 1);
+            ics += line;
+            std::string exdate = "EXDATE;TZID=Europe/Berlin:";
+            int count = 1 + pick(4);
+            for (int k = 0; k < count; k++) {
+                snprintf(line, sizeof(line), "%s%04d%02d%02dT%02d%02d00", k ? "," : "", year, 1 + (month + k) % 12, 1 + pick(28), hour, minute);
+                exdate += line;
+            }
+            appendFolded(ics, exdate);
+        } else if (kind == 4) {
+            snprintf(line, sizeof(line), "RRULE:FREQ=MONTHLY;BYMONTHDAY=%d;COUNT=24\r\n", day);
+            ics += line;
+        } else if (kind == 5) {
+            ics += "RRULE:FREQ=YEARLY\r\n";
+        }
+        // Short summaries stay on one line, the old parser does not unfold
+        snprintf(line, sizeof(line), "SUMMARY:%s %d", titles[pick(10)], n);
+        appendFolded(ics, line);
+        std::string description = "DESCRIPTION:Notizen:";
+        for (int w = 10 + pick(60); w > 0; w--) {
+            description += ' ';
+            description += words[pick(10)];
+        }
+        appendFolded(ics, description);
+        snprintf(line, sizeof(line), "LOCATION:Hauptstraße %d\\, 46282 Dorsten\\, Deutschland", 1 + pick(200));
+        appendFolded(ics, line);
+        ics += "SEQUENCE:0\r\nSTATUS:CONFIRMED\r\nTRANSP:OPAQUE\r\n";
+        if (n % 3 == 0) {
+            ics += "BEGIN:VALARM\r\nACTION:DISPLAY\r\nDESCRIPTION:This is an event reminder\r\nTRIGGER:-P0DT0H30M0S\r\nEND:VALARM\r\n";
+        }
+        ics += "END:VEVENT\r\n";
+    }
+    ics += "END:VCALENDAR\r\n";
+    return ics;
+}
+
+// --- Measurement ---
+
+struct Result {
+    std::vector<double> ms;
+    uint64_t allocations = 0;
+    int64_t peakBytes = 0;
+    size_t events = 0;
+};
+
+template<typename Consumer, typename Events>
+Result run(const std::string& ics, const GeneralTimeConverter& converter, int iterations, Events& keep) {
+    Result result;
+    for (int i = 0; i < iterations; i++) {
+        AllocScope scope;
+        auto start = std::chrono::steady_clock::now();
+        {
+            Consumer consumer(&converter);
+            for (size_t pos = 0; pos < ics.size(); pos += kChunk) {
+                consumer.feed(ics.data() + pos, std::min(kChunk, ics.size() - pos));
+            }
+            consumer.finish();
+            result.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            // Peak and allocations up to here: the parsed events are what the module keeps
+            result.allocations = scope.allocations();
+            result.peakBytes = scope.peakBytes();
+            result.events = consumer.events().size();
+            if (i == 0) keep.swap(consumer.events());
+        }
+    }
+    std::sort(result.ms.begin(), result.ms.end());
+    return result;
+}
+
+// Events of both parsers, compared on the properties the old parser reads correctly (the current
+// parser's summaries point into a pool that is gone by now)
+bool sameEvents(const PsramVector<LegacyIcs::Event>& legacy, const PsramVector<Event>& current) {
+    if (legacy.size() != current.size()) {
+        printf("  event count differs: legacy %zu, current %zu\n", legacy.size(), current.size());
+        return false;
+    }
+    for (size_t i = 0; i < legacy.size(); i++) {
+        const LegacyIcs::Event& a = legacy[i];
+        const Event& b = current[i];
+        bool same = a.uid == b.uid && a.dtstart == b.dtstart && a.duration == b.duration && a.isAllDay == b.isAllDay &&
+                    a.rrule == b.rrule && a.exdates.empty() == b.exdates.empty() &&
+                    (a.exdates.empty() || a.exdates[0] == b.exdates[0]);
+        if (!same) {
+            printf("  event %zu (%s) differs\n", i, b.uid.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = {1, 10};
+    int iterations = 3;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc) {
+            sizes.clear();
+            for (char* p = argv[++i]; *p;) {
+                sizes.push_back(strtoul(p, &p, 10));
+                if (*p == ',') p++;
+                else if (*p) break;
+            }
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--sizes 1,10] [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations < 1) iterations = 1;
+    HostRuntime::setSerialEnabled(false);
+    HostRuntime::setClockScale(10000);  // delay(1) every 50 events yields on the device, no parse time
+    // Times without TZID go through mktime(); the old parser also takes UTC values there
+    setenv("TZ", "UTC", 1);
+    tzset();
+    GeneralTimeConverter converter("CET-1CEST,M3.5.0,M10.5.0/3");
+
+    bool ok = true;
+    printf("%6s  %-7s %8s %10s %9s %11s %9s\n", "MB", "parser", "events", "median ms", "min ms", "allocations", "peak KB");
+    for (size_t mb : sizes) {
+        std::string ics = makeCalendar(mb * 1024 * 1024);
+        PsramVector<LegacyIcs::Event> legacyEvents;
+        PsramVector<Event> currentEvents;
+        Result legacy = run<LegacyIcs::StreamConsumer>(ics, converter, iterations, legacyEvents);
+        Result current = run<StreamConsumer>(ics, converter, iterations, currentEvents);
+
+        for (const auto& [name, r] : {std::pair<const char*, const Result&>("legacy", legacy), {"current", current}}) {
+            printf("%6zu  %-7s %8zu %10.1f %9.1f %11llu %9.0f\n", mb, name, r.events, r.ms[r.ms.size() / 2], r.ms[0],
+                   (unsigned long long)r.allocations, r.peakBytes / 1024.0);
+        }
+        printf("%6s  %-7s %8s %9.1fx %9s %10.1fx %8.1fx\n", "", "ratio", "", legacy.ms[legacy.ms.size() / 2] / current.ms[current.ms.size() / 2], "",
+               (double)legacy.allocations / current.allocations, (double)legacy.peakBytes / current.peakBytes);
+        bool same = sameEvents(legacyEvents, currentEvents);
+        printf("%-6s  events of both parsers match\n", same ? "ok" : "FAILED");
+        ok = ok && same;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(HostRuntime::filesystemRoot(), ec);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,398 @@
+// IcsTokenizer and IcsEventParser (RRuleParser.cpp): folded lines, input split at every chunk
+// size, VALARM nesting, EXDATE lists and VALUE=DATE against VALUE=DATE-TIME
+
+#include <gtest/gtest.h>
+
+#include "HostRuntime.hpp"
+#include "RRuleParser.hpp"
+#include "GeneralTimeConverter.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+
+namespace {
+
+// Every feature of the parser once; CRLF line ends, the last line without one
+const char* const kCalendar =
+    "BEGIN:VCALENDAR\r\n"
+    "VERSION:2.0\r\n"
+    "BEGIN:VTIMEZONE\r\n"
+    "TZID:Europe/Berlin\r\n"
+    "BEGIN:STANDARD\r\n"
+    "DTSTART:19701025T030000\r\n"
+    "END:STANDARD\r\n"
+    "END:VTIMEZONE\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:folded@test\r\n"
+    "SUMMARY:Jahres\r\n"
+    " hauptversammlung im\r\n"
+    "\t Vereinsheim\\, Raum 2\r\n"
+    "DTSTART;TZID=Europe/\r\n"
+    " Berlin:20250115T190000\r\n"
+    "DTEND;TZID=Europe/Berlin:20250115T213000\r\n"
+    "BEGIN:VALARM\r\n"
+    "ACTION:DISPLAY\r\n"
+    "SUMMARY:Erinnerung\r\n"
+    "DESCRIPTION:Nicht der Termin\r\n"
+    "TRIGGER:-PT15M\r\n"
+    "END:VALARM\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:series@test\r\n"
+    "SUMMARY:Training\r\n"
+    "DTSTART;TZID=Europe/Berlin:20250107T180000\r\n"
+    "DTEND;TZID=Europe/Berlin:20250107T193000\r\n"
+    "RRULE:FREQ=WEEKLY;COUNT=20\r\n"
+    "EXDATE;TZID=Europe/Berlin:20250114T180000,20250121T180000\r\n"
+    "EXDATE;TZID=Europe/Berlin:20250701T180000\r\n"
+    "BEGIN:VALARM\r\n"
+    "TRIGGER:-PT1H\r\n"
+    "BEGIN:X-NESTED\r\n"
+    "SUMMARY:Noch tiefer\r\n"
+    "END:X-NESTED\r\n"
+    "DESCRIPTION:Alarm\r\n"
+    "END:VALARM\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:series@test\r\n"
+    "RECURRENCE-ID;TZID=Europe/Berlin:20250128T180000\r\n"
+    "SUMMARY:Training (verlegt)\r\n"
+    "DTSTART;TZID=Europe/Berlin:20250129T180000\r\n"
+    "DTEND;TZID=Europe/Berlin:20250129T193000\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:allday@test\r\n"
+    "SUMMARY:Betriebsausflug\r\n"
+    "DTSTART;VALUE=DATE:20250606\r\n"
+    "DTEND;VALUE=DATE:20250607\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:datetime@test\r\n"
+    "SUMMARY:Wartung\r\n"
+    "DTSTART;VALUE=DATE-TIME:20250310T080000Z\r\n"
+    "DTEND;VALUE=DATE-TIME:20250310T093000Z\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VEVENT\r\n"
+    "uid:lowercase@test\r\n"
+    "summary:Kleingeschrieben\r\n"
+    "dtstart:20250401T120000Z\r\n"
+    "END:VEVENT\r\n"
+    "END:VCALENDAR";
+
+time_t utc(int year, int month, int day, int hour = 0, int minute = 0) {
+    struct tm t = {};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    return timegm(&t);
+}
+
+std::vector<IcsProperty> tokenize(const char* data, size_t len, bool final, size_t* consumed = nullptr) {
+    IcsTokenizer tokenizer(data, len, final);
+    std::vector<IcsProperty> props;
+    IcsProperty prop;
+    while (tokenizer.next(prop)) props.push_back(prop);
+    if (consumed) *consumed = tokenizer.consumed();
+    return props;
+}
+
+std::string name(const IcsProperty& prop) { return std::string(prop.name, prop.nameLen); }
+std::string value(const IcsProperty& prop) { return std::string(prop.value, prop.valueLen); }
+
+class IcsParserTest : public ::testing::Test {
+protected:
+    void SetUp() override { HostRuntime::setSerialEnabled(false); }
+    void TearDown() override { HostRuntime::setSerialEnabled(true); }
+
+    const Event* find(const PsramVector<Event>& events, const char* uid, time_t recurrenceId = 0) {
+        for (const Event& event : events) {
+            if (event.uid == uid && event.recurrence_id == recurrenceId) return &event;
+        }
+        return nullptr;
+    }
+
+    GeneralTimeConverter converter{"CET-1CEST,M3.5.0,M10.5.0/3"};
+};
+
+// --- IcsTokenizer ---
+
+TEST_F(IcsParserTest, SplitsNameParamsAndValue) {
+    const char text[] = "DTSTART;TZID=\"Europe/Berlin:X\";VALUE=DATE-TIME:20250115T190000\nSUMMARY:a:b;c\n";
+    auto props = tokenize(text, strlen(text), true);
+    ASSERT_EQ(props.size(), 2u);
+    EXPECT_EQ(name(props[0]), "DTSTART");
+    EXPECT_EQ(std::string(props[0].params, props[0].paramsLen), ";TZID=\"Europe/Berlin:X\";VALUE=DATE-TIME");
+    EXPECT_EQ(value(props[0]), "20250115T190000");
+    EXPECT_EQ(name(props[1]), "SUMMARY");
+    EXPECT_EQ(props[1].params, nullptr);
+    EXPECT_EQ(value(props[1]), "a:b;c");
+    EXPECT_TRUE(props[1].is("summary"));
+}
+
+TEST_F(IcsParserTest, UnfoldsSpaceAndTabContinuations) {
+    const char text[] = "DESCRIPTION;LANGUAGE=de\r\n -DE:Erste\r\n  Zeile\r\n\tzweite\r\nUID:x\r\n";
+    IcsTokenizer tokenizer(text, strlen(text), true);
+    IcsProperty prop;
+    ASSERT_TRUE(tokenizer.next(prop));
+    EXPECT_TRUE(prop.folded);
+    EXPECT_TRUE(prop.is("DESCRIPTION"));
+    tokenizer.unfold(prop);
+    EXPECT_FALSE(prop.folded);
+    EXPECT_EQ(std::string(prop.params, prop.paramsLen), ";LANGUAGE=de-DE");
+    EXPECT_EQ(value(prop), "Erste Zeilezweite");
+    ASSERT_TRUE(tokenizer.next(prop));
+    EXPECT_FALSE(prop.folded);
+    EXPECT_EQ(value(prop), "x");
+    EXPECT_FALSE(tokenizer.next(prop));
+}
+
+TEST_F(IcsParserTest, AcceptsLfAndSkipsEmptyLines) {
+    const char text[] = "A:1\n\n\r\nB:2\r\n";
+    auto props = tokenize(text, strlen(text), true);
+    ASSERT_EQ(props.size(), 2u);
+    EXPECT_EQ(value(props[0]), "1");
+    EXPECT_EQ(value(props[1]), "2");
+}
+
+TEST_F(IcsParserTest, HoldsBackLinesUntilTheNextCharacterIsKnown) {
+    size_t consumed = 0;
+    // Without the next character, "A:1\r\n" could still be folded
+    EXPECT_TRUE(tokenize("A:1\r\n", 5, false, &consumed).empty());
+    EXPECT_EQ(consumed, 0u);
+    auto props = tokenize("A:1\r\nB", 6, false, &consumed);
+    ASSERT_EQ(props.size(), 1u);
+    EXPECT_EQ(consumed, 5u);
+    props = tokenize("A:1\r\n x", 7, false, &consumed);
+    EXPECT_TRUE(props.empty());
+    EXPECT_EQ(consumed, 0u);
+    // The last call of a download takes the rest, with or without line end
+    props = tokenize("A:1\r\n xB:2", 10, true, &consumed);
+    ASSERT_EQ(props.size(), 1u);
+    EXPECT_EQ(consumed, 10u);
+}
+
+TEST_F(IcsParserTest, MatchesWholeParameters) {
+    IcsProperty prop;
+    IcsTokenizer::splitLine("DTSTART;VALUE=DATE-TIME;TZID=Europe/Berlin:x", 44, prop);
+    EXPECT_FALSE(prop.hasParam("VALUE=DATE"));
+    EXPECT_TRUE(prop.hasParam("VALUE=DATE-TIME"));
+    EXPECT_TRUE(prop.hasParam("TZID="));
+    EXPECT_TRUE(prop.hasParam("tzid="));
+    IcsTokenizer::splitLine("DTSTART;X-VALUE=DATE:x", 22, prop);
+    EXPECT_FALSE(prop.hasParam("VALUE=DATE"));
+}
+
+TEST_F(IcsParserTest, UnescapesText) {
+    PsramString out;
+    const char text[] = "a\\, b\\; c\\\\ d\\ne\\Nf\\";
+    IcsTokenizer::unescapeText(text, strlen(text), out);
+    EXPECT_EQ(out, "a, b; c\\ d e f\\");
+}
+
+TEST_F(IcsParserTest, StringPoolStoresEachTextOnce) {
+    IcsStringPool pool;
+    const char* a = pool.intern("Training", 8);
+    EXPECT_EQ(pool.intern("Training!", 8), a);
+    EXPECT_NE(pool.intern("Spieltag", 8), a);
+    EXPECT_STREQ(a, "Training");
+    // Beyond the first block and the first table size
+    std::vector<const char*> texts;
+    for (int i = 0; i < 2000; i++) {
+        std::string text = "Termin " + std::to_string(i);
+        texts.push_back(pool.intern(text.c_str(), text.size()));
+    }
+    EXPECT_EQ(pool.size(), 2002u);
+    for (int i = 0; i < 2000; i++) {
+        std::string text = "Termin " + std::to_string(i);
+        EXPECT_EQ(pool.intern(text.c_str(), text.size()), texts[i]);
+        EXPECT_STREQ(texts[i], text.c_str());
+    }
+    EXPECT_STREQ(a, "Training");
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.bytes(), 0u);
+}
+
+// --- Date/time values ---
+
+TEST_F(IcsParserTest, ValueDateIsAllDayValueDateTimeIsNot) {
+    bool allDay = false;
+    EXPECT_EQ(parseICalDateTime("DTSTART;VALUE=DATE:20250606", 27, allDay, &converter), utc(2025, 6, 6));
+    EXPECT_TRUE(allDay);
+    EXPECT_EQ(parseICalDateTime("DTSTART;VALUE=DATE-TIME:20250310T080000Z", 40, allDay, &converter), utc(2025, 3, 10, 8));
+    EXPECT_FALSE(allDay);
+    // A date without time is all-day even without VALUE=DATE
+    EXPECT_EQ(parseICalDateTime("DTSTART:20250606", 16, allDay, &converter), utc(2025, 6, 6));
+    EXPECT_TRUE(allDay);
+}
+
+TEST_F(IcsParserTest, ConvertsTzidTimesWithTheConverter) {
+    bool allDay = true;
+    EXPECT_EQ(parseICalDateTime("DTSTART;TZID=Europe/Berlin:20250115T190000", 42, allDay, &converter), utc(2025, 1, 15, 18));
+    EXPECT_FALSE(allDay);
+    EXPECT_EQ(parseICalDateTime("DTSTART;TZID=Europe/Berlin:20250715T190000", 42, allDay, &converter), utc(2025, 7, 15, 17));
+}
+
+TEST_F(IcsParserTest, TimeCacheMatchesTheConverter) {
+    // Every hour around both transitions, across more years than the cache holds
+    IcsTimeCache cache;
+    char line[64];
+    for (int year : {2024, 2025, 2031, 2026, 2027, 2028, 2029, 2030, 2032, 2025, 2033}) {
+        for (int month : {1, 3, 7, 10, 12}) {
+            for (int day : {1, 24, 25, 26, 27, 28, 29, 30, 31}) {
+                for (int hour = 0; hour < 24; ++hour) {
+                    for (const char* prefix : {"DTSTART;TZID=Europe/Berlin:", "DTSTART:"}) {
+                        const char* suffix = prefix[7] == ';' ? "" : "Z";
+                        int len = snprintf(line, sizeof(line), "%s%04d%02d%02dT%02d3000%s", prefix, year, month, day, hour,
+                                           suffix);
+                        IcsProperty prop;
+                        IcsTokenizer::splitLine(line, len, prop);
+                        bool allDay = false;
+                        ASSERT_EQ(parseICalDateTime(prop, allDay, &converter, &cache),
+                                  parseICalDateTime(prop, allDay, &converter))
+                            << line;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(IcsParserTest, StaysWithinTheGivenLength) {
+    // The date of the next line must not be read as this line's value
+    const char text[] = "DTSTART:\nDTEND;VALUE=DATE:20250607";
+    bool allDay = true;
+    EXPECT_EQ(parseICalDateTime(text, 8, allDay, &converter), 0);
+    EXPECT_FALSE(allDay);
+}
+
+// --- IcsEventParser ---
+
+TEST_F(IcsParserTest, ParsesEveryFeature) {
+    IcsStreamParser stream(&converter);
+    stream.feed(kCalendar, strlen(kCalendar));
+    stream.finish();
+    const PsramVector<Event>& events = stream.events();
+    ASSERT_EQ(events.size(), 6u);
+
+    const Event* folded = find(events, "folded@test");
+    ASSERT_NE(folded, nullptr);
+    EXPECT_STREQ(folded->summary, "Jahreshauptversammlung im Vereinsheim, Raum 2");
+    EXPECT_EQ(folded->dtstart, utc(2025, 1, 15, 18));
+    EXPECT_EQ(folded->duration, 150 * 60);
+    EXPECT_FALSE(folded->isAllDay);
+
+    const Event* series = find(events, "series@test");
+    ASSERT_NE(series, nullptr);
+    EXPECT_STREQ(series->summary, "Training");
+    EXPECT_EQ(series->rrule, "FREQ=WEEKLY;COUNT=20");
+    ASSERT_EQ(series->exdates.size(), 3u);
+    EXPECT_EQ(series->exdates[0], utc(2025, 1, 14, 17));
+    EXPECT_EQ(series->exdates[1], utc(2025, 1, 21, 17));
+    EXPECT_EQ(series->exdates[2], utc(2025, 7, 1, 16));
+
+    const Event* moved = find(events, "series@test", utc(2025, 1, 28, 17));
+    ASSERT_NE(moved, nullptr);
+    EXPECT_STREQ(moved->summary, "Training (verlegt)");
+    EXPECT_EQ(moved->dtstart, utc(2025, 1, 29, 17));
+
+    const Event* allDay = find(events, "allday@test");
+    ASSERT_NE(allDay, nullptr);
+    EXPECT_TRUE(allDay->isAllDay);
+    EXPECT_EQ(allDay->dtstart, utc(2025, 6, 6));
+    EXPECT_EQ(allDay->duration, 86400);
+
+    const Event* dateTime = find(events, "datetime@test");
+    ASSERT_NE(dateTime, nullptr);
+    EXPECT_FALSE(dateTime->isAllDay);
+    EXPECT_EQ(dateTime->dtstart, utc(2025, 3, 10, 8));
+    EXPECT_EQ(dateTime->duration, 90 * 60);
+
+    const Event* lowercase = find(events, "lowercase@test");
+    ASSERT_NE(lowercase, nullptr);
+    EXPECT_STREQ(lowercase->summary, "Kleingeschrieben");
+    EXPECT_EQ(lowercase->duration, 0);
+}
+
+TEST_F(IcsParserTest, AlarmPropertiesDoNotOverwriteTheEvent) {
+    IcsStreamParser stream(&converter);
+    stream.feed(kCalendar, strlen(kCalendar));
+    stream.finish();
+    for (const Event& event : stream.events()) {
+        EXPECT_STRNE(event.summary, "Erinnerung");
+        EXPECT_STRNE(event.summary, "Noch tiefer");
+    }
+    // The doubly nested component closes without ending the series event early
+    const Event* series = find(stream.events(), "series@test");
+    ASSERT_NE(series, nullptr);
+    EXPECT_STREQ(series->summary, "Training");
+}
+
+TEST_F(IcsParserTest, IgnoresEventsWithoutStart) {
+    const char text[] = "BEGIN:VEVENT\nUID:a\nSUMMARY:Ohne Beginn\nEND:VEVENT\nBEGIN:VEVENT\nUID:b\nDTSTART:20250101T000000Z\nEND:VEVENT\n";
+    IcsStreamParser stream(&converter);
+    stream.feed(text, strlen(text));
+    stream.finish();
+    ASSERT_EQ(stream.events().size(), 1u);
+    EXPECT_EQ(stream.events()[0].uid, "b");
+}
+
+// Every chunk size from one byte to the whole file: a chunk boundary may fall inside a name, a
+// parameter, a value, between '\r' and '\n' and right before a fold's space
+TEST_F(IcsParserTest, SameEventsAtEveryChunkSize) {
+    const size_t length = strlen(kCalendar);
+    IcsStreamParser whole(&converter);
+    whole.feed(kCalendar, length);
+    whole.finish();
+    ASSERT_EQ(whole.events().size(), 6u);
+
+    for (size_t chunk = 1; chunk <= length; chunk++) {
+        SCOPED_TRACE("chunk size " + std::to_string(chunk));
+        IcsStreamParser stream(&converter);
+        for (size_t pos = 0; pos < length; pos += chunk) {
+            // Each piece in its own buffer, so reading past a chunk's end shows up under ASan
+            std::vector<char> piece(kCalendar + pos, kCalendar + std::min(length, pos + chunk));
+            stream.feed(piece.data(), piece.size());
+        }
+        stream.finish();
+
+        ASSERT_EQ(stream.events().size(), whole.events().size());
+        for (size_t i = 0; i < whole.events().size(); i++) {
+            const Event& expected = whole.events()[i];
+            const Event& actual = stream.events()[i];
+            EXPECT_STREQ(actual.summary, expected.summary);
+            EXPECT_EQ(actual.uid, expected.uid);
+            EXPECT_EQ(actual.rrule, expected.rrule);
+            EXPECT_EQ(actual.dtstart, expected.dtstart);
+            EXPECT_EQ(actual.dtend, expected.dtend);
+            EXPECT_EQ(actual.recurrence_id, expected.recurrence_id);
+            EXPECT_EQ(actual.isAllDay, expected.isAllDay);
+            EXPECT_EQ(actual.duration, expected.duration);
+            EXPECT_TRUE(actual.exdates == expected.exdates);
+        }
+        if (HasFailure()) break;
+    }
+}
+
+// An aborted download leaves a half event and a carried line behind; reset() must drop both
+TEST_F(IcsParserTest, ResetDropsAnAbortedDownload) {
+    const size_t length = strlen(kCalendar);
+    IcsStreamParser stream(&converter);
+    stream.feed(kCalendar, length / 2 + 3);
+    stream.reset();
+    EXPECT_TRUE(stream.events().empty());
+    EXPECT_EQ(stream.summaries().size(), 0u);
+
+    stream.feed(kCalendar, length);
+    stream.finish();
+    EXPECT_EQ(stream.events().size(), 6u);
+}
+
+} // namespace
@@ -0,0 +1,186 @@
+// InflateStream against the fixtures in fixtures/inflate (see make_fixtures.py): gzip, zlib and raw
+// deflate, written whole and in chunks down to single bytes, truncated and corrupted
+
+#include <gtest/gtest.h>
+
+#include "HostRuntime.hpp"
+#include "WebClientModule.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "webconfig.hpp"
+#include "rom/miniz.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+std::string readFixture(const char* name) {
+    std::ifstream in(std::string(INFLATE_FIXTURE_DIR) + "/" + name, std::ios::binary);
+    EXPECT_TRUE(in.good()) << name;
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Target of the inflated data; takes at most limit bytes in total
+class CollectStream : public Stream {
+public:
+    size_t write(uint8_t data) override { return write(&data, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        size_t n = std::min(size, limit - data.size());
+        data.append((const char*)buffer, n);
+        return n;
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+
+    std::string data;
+    size_t limit = SIZE_MAX;
+};
+
+struct Fixture {
+    const char* file;
+    InflateStream::Encoding encoding;
+};
+
+const Fixture FIXTURES[] = {
+    { "forecast.json.gz", InflateStream::ENCODING_GZIP },
+    { "forecast.json.headers.gz", InflateStream::ENCODING_GZIP },
+    { "forecast.json.zlib", InflateStream::ENCODING_DEFLATE },
+    { "forecast.json.deflate", InflateStream::ENCODING_DEFLATE },
+};
+
+// Writes input in pieces of chunk bytes (0 = all at once) until the stream refuses one
+size_t feed(InflateStream& inflater, const std::string& input, size_t chunk) {
+    if (chunk == 0) chunk = input.size();
+    size_t pos = 0;
+    while (pos < input.size()) {
+        size_t n = std::min(chunk, input.size() - pos);
+        if (inflater.write((const uint8_t*)input.data() + pos, n) != n) break;
+        pos += n;
+    }
+    return pos;
+}
+
+class InflateStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        HostRuntime::setSerialEnabled(false);
+        plain = readFixture("forecast.json");
+        ASSERT_GT(plain.size(), (size_t)TINFL_LZ_DICT_SIZE);  // the output window wraps
+    }
+    void TearDown() override { HostRuntime::setSerialEnabled(true); }
+
+    std::string plain;
+};
+
+TEST_F(InflateStreamTest, InflatesEveryFixtureAtAnyChunkSize) {
+    for (const Fixture& fixture : FIXTURES) {
+        std::string input = readFixture(fixture.file);
+        for (size_t chunk : { (size_t)0, (size_t)1, (size_t)2, (size_t)7, (size_t)9, (size_t)1436, (size_t)4096 }) {
+            SCOPED_TRACE(std::string(fixture.file) + ", chunk " + std::to_string(chunk));
+            CollectStream out;
+            InflateStream inflater(&out, fixture.encoding);
+            EXPECT_EQ(feed(inflater, input, chunk), input.size());
+            EXPECT_FALSE(inflater.failed());
+            EXPECT_TRUE(inflater.complete());
+            EXPECT_EQ(inflater.compressedBytes(), input.size());
+            EXPECT_EQ(inflater.inflatedBytes(), plain.size());
+            EXPECT_TRUE(out.data == plain);
+        }
+    }
+}
+
+TEST_F(InflateStreamTest, MapsContentEncodingHeaders) {
+    InflateStream::Encoding encoding;
+    EXPECT_TRUE(InflateStream::fromHeader("gzip", encoding));
+    EXPECT_EQ(encoding, InflateStream::ENCODING_GZIP);
+    EXPECT_TRUE(InflateStream::fromHeader("X-GZIP", encoding));
+    EXPECT_EQ(encoding, InflateStream::ENCODING_GZIP);
+    EXPECT_TRUE(InflateStream::fromHeader("deflate", encoding));
+    EXPECT_EQ(encoding, InflateStream::ENCODING_DEFLATE);
+    EXPECT_FALSE(InflateStream::fromHeader("identity", encoding));
+    EXPECT_FALSE(InflateStream::fromHeader("br", encoding));
+}
+
+TEST_F(InflateStreamTest, RejectsTruncatedInput) {
+    for (const Fixture& fixture : FIXTURES) {
+        std::string input = readFixture(fixture.file);
+        // Inside the header, inside the deflate data, and every cut in the last 9 bytes: for gzip that
+        // includes the end of the last deflate block with the whole trailer missing
+        std::vector<size_t> cuts = { 1, 5, 12, input.size() / 3, input.size() / 2 };
+        for (size_t missing = 1; missing <= 9; missing++) cuts.push_back(input.size() - missing);
+        for (size_t chunk : { (size_t)0, (size_t)1 }) {
+            for (size_t cut : cuts) {
+                SCOPED_TRACE(std::string(fixture.file) + ", cut at " + std::to_string(cut) + ", chunk " + std::to_string(chunk));
+                CollectStream out;
+                InflateStream inflater(&out, fixture.encoding);
+                feed(inflater, input.substr(0, cut), chunk);
+                EXPECT_FALSE(inflater.failed());
+                EXPECT_FALSE(inflater.complete());
+                EXPECT_TRUE(plain.compare(0, out.data.size(), out.data) == 0);
+            }
+        }
+    }
+}
+
+TEST_F(InflateStreamTest, RejectsWrongGzipTrailer) {
+    std::string input = readFixture("forecast.json.gz");
+    // CRC32 (first trailer byte) and ISIZE (last byte)
+    for (size_t offset : { input.size() - 8, input.size() - 1 }) {
+        SCOPED_TRACE("byte " + std::to_string(offset));
+        std::string corrupted = input;
+        corrupted[offset] ^= 0x01;
+        CollectStream out;
+        InflateStream inflater(&out, InflateStream::ENCODING_GZIP);
+        EXPECT_EQ(feed(inflater, corrupted, 0), corrupted.size());
+        EXPECT_FALSE(inflater.complete());
+        EXPECT_EQ(out.data.size(), plain.size());
+    }
+}
+
+TEST_F(InflateStreamTest, RejectsWrongAdler32) {
+    std::string input = readFixture("forecast.json.zlib");
+    input[input.size() - 1] ^= 0x01;
+    CollectStream out;
+    InflateStream inflater(&out, InflateStream::ENCODING_DEFLATE);
+    feed(inflater, input, 1436);
+    EXPECT_TRUE(inflater.failed());
+    EXPECT_FALSE(inflater.complete());
+}
+
+TEST_F(InflateStreamTest, FailsOnCorruptData) {
+    std::string input = readFixture("forecast.json.deflate");
+    // Block type 3 is reserved
+    input[0] = (char)0x07;
+    CollectStream out;
+    InflateStream inflater(&out, InflateStream::ENCODING_DEFLATE);
+    EXPECT_LT(feed(inflater, input, 512), input.size());
+    EXPECT_TRUE(inflater.failed());
+    EXPECT_EQ(inflater.write((const uint8_t*)input.data(), 1), 0u);
+
+    std::string gzip = readFixture("forecast.json.gz");
+    gzip[2] = 7;  // compression method other than deflate
+    InflateStream wrongMethod(&out, InflateStream::ENCODING_GZIP);
+    EXPECT_EQ(feed(wrongMethod, gzip, 0), 0u);
+    EXPECT_TRUE(wrongMethod.failed());
+}
+
+TEST_F(InflateStreamTest, FailsWhenTheTargetIsFull) {
+    std::string input = readFixture("forecast.json.gz");
+    CollectStream out;
+    out.limit = 10000;
+    InflateStream inflater(&out, InflateStream::ENCODING_GZIP);
+    EXPECT_LT(feed(inflater, input, 1436), input.size());
+    EXPECT_TRUE(inflater.failed());
+    EXPECT_FALSE(inflater.complete());
+}
+
+} // namespace
@@ -0,0 +1,134 @@
+// MultiLogger::readNewRecords against a port of the browser's decodeLogFrame (WebPages.hpp)
+
+#include <gtest/gtest.h>
+
+#include "HostRuntime.hpp"
+#include "MultiLogger.hpp"
+#include "GeneralTimeConverter.hpp"
+
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+
+namespace {
+
+// decodeLogFrame() of the log view, minus the frame header
+class LogView {
+public:
+    void decode(const uint8_t* data, size_t length, uint32_t dropped) {
+        size_t pos = 0;
+        if (pos + 3 <= length && (data[pos] & LOG_RECORD_TRUNCATED)) {
+            if (!partial.empty()) lines.push_back(partial + " [...]");
+            partial.clear();
+            pos += 3 + ((data[pos + 1] << 8) | data[pos + 2]);
+        }
+        if (dropped > 0) lines.push_back("[Stream] " + std::to_string(dropped) + " Log-Zeilen verworfen");
+        while (pos + 3 <= length) {
+            bool continued = data[pos] & LOG_RECORD_CONTINUED;
+            size_t len = (data[pos + 1] << 8) | data[pos + 2];
+            pos += 3;
+            ASSERT_LE(pos + len, length);
+            partial.append((const char*)data + pos, len);
+            pos += len;
+            if (!continued) {
+                lines.push_back(partial);
+                partial.clear();
+            }
+        }
+    }
+
+    std::vector<std::string> lines;
+    std::string partial;
+};
+
+// Log text without the "[millis] " prefix
+std::string text(const std::string& line) {
+    size_t end = line.find("] ");
+    return end == std::string::npos ? line : line.substr(end + 2);
+}
+
+class MultiLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override { HostRuntime::setSerialEnabled(false); }
+    void TearDown() override { HostRuntime::setSerialEnabled(true); }
+
+    void read(MultiLogger& logger, LogView& view, size_t capacity) {
+        std::vector<uint8_t> buffer(capacity);
+        uint32_t dropped = 0;
+        size_t n = logger.readNewRecords(buffer.data(), buffer.size(), dropped);
+        view.decode(buffer.data(), n, dropped);
+    }
+};
+
+TEST_F(MultiLoggerTest, CompleteLinesArriveInOrder) {
+    MultiLogger logger(8);
+    LogView view;
+    logger.println("eins");
+    logger.println("zwei");
+    read(logger, view, 256);
+    ASSERT_EQ(view.lines.size(), 2u);
+    EXPECT_EQ(text(view.lines[0]), "eins");
+    EXPECT_EQ(text(view.lines[1]), "zwei");
+    EXPECT_TRUE(view.partial.empty());
+}
+
+TEST_F(MultiLoggerTest, LongLineIsSplitIntoContinuedRecords) {
+    MultiLogger logger(8);
+    LogView view;
+    std::string longLine(100, 'x');
+    logger.println(longLine.c_str());
+    for (int i = 0; i < 10 && view.lines.empty(); i++) read(logger, view, 32);
+    ASSERT_EQ(view.lines.size(), 1u);
+    EXPECT_EQ(text(view.lines[0]), longLine);
+}
+
+TEST_F(MultiLoggerTest, PartlySentLineOverwrittenByRingIsTerminated) {
+    MultiLogger logger(4);
+    LogView view;
+    logger.println(std::string(100, 'a').c_str());
+    read(logger, view, 32);
+    ASSERT_TRUE(view.lines.empty());
+    ASSERT_FALSE(view.partial.empty());
+
+    // The reader falls behind: the half sent line is overwritten
+    for (int i = 0; i < 6; i++) logger.printf("neu %d\n", i);
+    read(logger, view, 1024);
+
+    ASSERT_GE(view.lines.size(), 3u);
+    EXPECT_EQ(view.lines[0].back(), ']');
+    EXPECT_NE(view.lines[0].find("[...]"), std::string::npos);
+    EXPECT_EQ(view.lines[0].find("neu"), std::string::npos) << "next line merged into the cut line";
+    EXPECT_EQ(view.lines[1].rfind("[Stream] ", 0), 0u);
+    for (size_t i = 2; i < view.lines.size(); i++) EXPECT_EQ(text(view.lines[i]).rfind("neu ", 0), 0u);
+    EXPECT_EQ(text(view.lines.back()), "neu 5");
+    EXPECT_TRUE(view.partial.empty());
+}
+
+TEST_F(MultiLoggerTest, PartlySentLineClearedIsTerminated) {
+    MultiLogger logger(4);
+    LogView view;
+    logger.println(std::string(100, 'b').c_str());
+    read(logger, view, 32);
+    logger.clearBuffer();
+    logger.println("danach");
+    read(logger, view, 256);
+    ASSERT_EQ(view.lines.size(), 2u);
+    EXPECT_NE(view.lines[0].find("[...]"), std::string::npos);
+    EXPECT_EQ(text(view.lines[1]), "danach");
+}
+
+TEST_F(MultiLoggerTest, TerminatorIsSentEvenWithoutNewLines) {
+    MultiLogger logger(4);
+    LogView view;
+    logger.println(std::string(100, 'c').c_str());
+    read(logger, view, 32);
+    logger.clearBuffer();
+    read(logger, view, 256);
+    ASSERT_EQ(view.lines.size(), 1u);
+    EXPECT_TRUE(view.partial.empty());
+}
+
+} // namespace
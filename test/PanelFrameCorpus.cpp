@@ -0,0 +1,250 @@
+#include "PanelFrameCorpus.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+static uint32_t readLE32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t readLE16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+
+bool loadPanelBmp(const std::string& path, PanelFrame& frame, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < 54 || data[0] != 'B' || data[1] != 'M') {
+        error = path + ": not a BMP file";
+        return false;
+    }
+    uint32_t offset = readLE32(&data[10]);
+    int32_t width = (int32_t)readLE32(&data[18]);
+    int32_t height = (int32_t)readLE32(&data[22]);
+    uint16_t bpp = readLE16(&data[28]);
+    uint32_t compression = readLE32(&data[30]);
+    if ((bpp != 24 && bpp != 32) || (compression != 0 && compression != 3) || width <= 0 || height == 0) {
+        error = path + ": only uncompressed 24/32 bit BMPs are supported";
+        return false;
+    }
+    bool topDown = height < 0;
+    uint32_t rows = (uint32_t)std::abs(height);
+    size_t stride = ((size_t)width * (bpp / 8) + 3) & ~(size_t)3;
+    if (offset + stride * rows > data.size()) {
+        error = path + ": truncated";
+        return false;
+    }
+
+    frame.name = std::filesystem::path(path).filename().string();
+    frame.width = (uint16_t)(width / PANEL_CORPUS_TILE_SIZE * PANEL_CORPUS_TILE_SIZE);
+    frame.height = (uint16_t)(rows / PANEL_CORPUS_TILE_SIZE * PANEL_CORPUS_TILE_SIZE);
+    if (frame.width == 0 || frame.height == 0) {
+        error = path + ": smaller than one tile";
+        return false;
+    }
+    frame.rgb.resize((size_t)frame.width * frame.height);
+    for (uint32_t y = 0; y < frame.height; y++) {
+        const uint8_t* row = &data[offset + stride * (topDown ? y : rows - 1 - y)];
+        for (uint32_t x = 0; x < frame.width; x++) {
+            const uint8_t* p = row + x * (bpp / 8);
+            frame.rgb[(size_t)y * frame.width + x] = ((uint32_t)p[2] << 16) | (p[1] << 8) | p[0];
+        }
+    }
+    return true;
+}
+
+bool loadPanelFrames(const std::string& path, std::vector<PanelFrame>& frames, std::string& error) {
+    std::vector<std::string> files;
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (entry.is_regular_file() && ext == ".bmp") files.push_back(entry.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        if (files.empty()) {
+            error = path + ": no .bmp files";
+            return false;
+        }
+    } else {
+        files.push_back(path);
+    }
+    for (const auto& file : files) {
+        PanelFrame frame;
+        if (!loadPanelBmp(file, frame, error)) return false;
+        frames.push_back(std::move(frame));
+    }
+    return true;
+}
+
+// --- Synthetic frames ---
+
+namespace {
+
+class Canvas {
+public:
+    explicit Canvas(const char* name) {
+        frame.name = name;
+        frame.width = PANEL_CORPUS_WIDTH;
+        frame.height = PANEL_CORPUS_HEIGHT;
+        frame.rgb.assign((size_t)frame.width * frame.height, 0);
+    }
+
+    void pixel(int x, int y, uint32_t color) {
+        if (x < 0 || y < 0 || x >= frame.width || y >= frame.height) return;
+        frame.rgb[(size_t)y * frame.width + x] = color;
+    }
+
+    void rect(int x, int y, int w, int h, uint32_t color) {
+        for (int j = 0; j < h; j++)
+            for (int i = 0; i < w; i++) pixel(x + i, y + j, color);
+    }
+
+    // 5x7 glyphs, one bitmap per character derived from its code: the exact shapes do not matter
+    // for compression, the stroke structure (short runs, isolated pixels, blank gaps) does
+    int text(int x, int y, const char* s, uint32_t color, int scale = 1) {
+        for (; *s; s++) {
+            if (*s != ' ') {
+                uint32_t bits = glyphBits((uint8_t)*s);
+                for (int row = 0; row < 7; row++)
+                    for (int col = 0; col < 5; col++)
+                        if (bits & (1u << ((row * 5 + col) % 32)) && (row != 3 || col % 2 == 0))
+                            rect(x + col * scale, y + row * scale, scale, scale, color);
+            }
+            x += 6 * scale;
+        }
+        return x;
+    }
+
+    PanelFrame frame;
+
+private:
+    static uint32_t glyphBits(uint8_t c) {
+        uint32_t h = 2166136261u ^ c;
+        h *= 16777619u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        // Vertical strokes on the left and right edge like most latin glyphs
+        return (h & 0x0E739CE7u) | 0x00842108u;
+    }
+};
+
+uint32_t rgb(int r, int g, int b) {
+    auto clamp = [](int v) { return (uint32_t)std::max(0, std::min(255, v)); };
+    return (clamp(r) << 16) | (clamp(g) << 8) | clamp(b);
+}
+
+PanelFrame clockFrame() {
+    Canvas c("synthetic-clock");
+    // Seven-segment digits "12:34" in the time area, date below
+    static const uint8_t segments[10] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+    const int digits[4] = { 1, 2, 3, 4 };
+    const uint32_t color = rgb(255, 200, 40);
+    int x = 24;
+    for (int i = 0; i < 4; i++) {
+        uint8_t s = segments[digits[i]];
+        if (s & 0x01) c.rect(x + 3, 2, 18, 3, color);
+        if (s & 0x02) c.rect(x + 21, 5, 3, 10, color);
+        if (s & 0x04) c.rect(x + 21, 17, 3, 10, color);
+        if (s & 0x08) c.rect(x + 3, 27, 18, 3, color);
+        if (s & 0x10) c.rect(x, 17, 3, 10, color);
+        if (s & 0x20) c.rect(x, 5, 3, 10, color);
+        if (s & 0x40) c.rect(x + 3, 15, 18, 2, color);
+        x += 32;
+        if (i == 1) {
+            c.rect(x, 10, 3, 3, color);
+            c.rect(x, 20, 3, 3, color);
+            x += 10;
+        }
+    }
+    c.text(40, 44, "DONNERSTAG 18.10.", rgb(200, 200, 200));
+    // Seconds progress bar
+    c.rect(10, 60, 140, 2, rgb(0, 120, 255));
+    c.text(60, 80, "KW 42", rgb(120, 120, 120));
+    return c.frame;
+}
+
+PanelFrame calendarFrame() {
+    Canvas c("synthetic-calendar");
+    const char* rows[] = { "18.10. 09:30 ZAHNARZT", "19.10. GANZTAEGIG", "21.10. 18:00 ELTERNABEND",
+                           "24.10. 07:45 FLUG MUC", "27.10. 10:00 GEBURTSTAG", "30.10. 20:15 KINO" };
+    for (int i = 0; i < 6; i++) {
+        int y = 4 + i * 15;
+        int x = c.text(2, y, std::string(rows[i]).substr(0, 6).c_str(), rgb(255, 255, 0));
+        c.text(x + 2, y, rows[i] + 7, rgb(255, 255, 255));
+        if (i == 0) c.rect(0, y - 2, 2, 11, rgb(255, 0, 0));
+    }
+    return c.frame;
+}
+
+PanelFrame weatherFrame() {
+    Canvas c("synthetic-weather");
+    // Sky gradient, sun with soft edge, temperature text
+    for (int y = 0; y < PANEL_CORPUS_HEIGHT; y++)
+        for (int x = 0; x < PANEL_CORPUS_WIDTH; x++) c.pixel(x, y, rgb(0, 40 + y, 90 + y));
+    for (int y = 0; y < 48; y++) {
+        for (int x = 0; x < 48; x++) {
+            double d = std::hypot(x - 24.0, y - 24.0);
+            if (d < 20) {
+                int fade = d < 14 ? 255 : (int)(255 * (20 - d) / 6);
+                c.pixel(12 + x, 12 + y, rgb(fade, fade * 4 / 5, fade / 5));
+            }
+        }
+    }
+    c.text(80, 20, "17", rgb(255, 255, 255), 3);
+    c.text(80, 60, "REGEN 20%", rgb(180, 220, 255));
+    return c.frame;
+}
+
+PanelFrame fireplaceFrame() {
+    Canvas c("synthetic-fireplace");
+    // Heat field smoothed upwards, mapped to the fire palette: the least compressible module
+    std::mt19937 rng(42);
+    std::vector<int> heat((size_t)PANEL_CORPUS_WIDTH * PANEL_CORPUS_HEIGHT, 0);
+    for (int x = 0; x < PANEL_CORPUS_WIDTH; x++) heat[(size_t)(PANEL_CORPUS_HEIGHT - 1) * PANEL_CORPUS_WIDTH + x] = 160 + (int)(rng() % 96);
+    for (int y = PANEL_CORPUS_HEIGHT - 2; y >= 0; y--) {
+        for (int x = 0; x < PANEL_CORPUS_WIDTH; x++) {
+            int below = heat[(size_t)(y + 1) * PANEL_CORPUS_WIDTH + x];
+            int left = heat[(size_t)(y + 1) * PANEL_CORPUS_WIDTH + std::max(0, x - 1)];
+            int right = heat[(size_t)(y + 1) * PANEL_CORPUS_WIDTH + std::min(PANEL_CORPUS_WIDTH - 1, x + 1)];
+            heat[(size_t)y * PANEL_CORPUS_WIDTH + x] = std::max(0, (below * 2 + left + right) / 4 - (int)(rng() % 6));
+        }
+    }
+    for (int y = 0; y < PANEL_CORPUS_HEIGHT; y++)
+        for (int x = 0; x < PANEL_CORPUS_WIDTH; x++) {
+            int h = heat[(size_t)y * PANEL_CORPUS_WIDTH + x];
+            c.pixel(x, y, rgb(h * 2, h - 40, h * 2 - 400));
+        }
+    return c.frame;
+}
+
+PanelFrame tableFrame() {
+    Canvas c("synthetic-table");
+    // Live scores: colored badges, separator lines, two text colors
+    const uint32_t badges[] = { rgb(200, 0, 0), rgb(0, 80, 200), rgb(255, 255, 255), rgb(0, 150, 60) };
+    c.text(2, 2, "BUNDESLIGA 12. SPIELTAG", rgb(0, 200, 255));
+    for (int i = 0; i < 5; i++) {
+        int y = 14 + i * 16;
+        c.rect(0, y - 2, PANEL_CORPUS_WIDTH, 1, rgb(60, 60, 60));
+        c.rect(2, y, 10, 10, badges[i % 4]);
+        c.text(16, y + 2, "HEIM FC", rgb(255, 255, 255));
+        c.text(90, y + 2, i == 2 ? "2:1" : "0:0", i == 2 ? rgb(0, 255, 0) : rgb(255, 255, 255));
+        c.rect(118, y, 10, 10, badges[(i + 1) % 4]);
+        c.text(132, y + 2, "GAST", rgb(255, 255, 255));
+    }
+    return c.frame;
+}
+
+PanelFrame idleFrame() {
+    Canvas c("synthetic-idle");
+    c.text(50, 44, "KEINE DATEN", rgb(90, 90, 90));
+    return c.frame;
+}
+
+} // namespace
+
+std::vector<PanelFrame> syntheticPanelFrames() {
+    return { clockFrame(), calendarFrame(), weatherFrame(), fireplaceFrame(), tableFrame(), idleFrame() };
+}
@@ -0,0 +1,74 @@
+#ifndef PANEL_FRAME_CORPUS_HPP
+#define PANEL_FRAME_CORPUS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PanelStreamCodec.hpp"
+
+// Panel geometry of the firmware (PanelManager.hpp: PANEL_RES_X * VDISP_NUM_COLS, PANEL_RES_Y * VDISP_NUM_ROWS)
+// and the stream tile size (PanelStreamer.hpp: PANEL_STREAM_TILE_SIZE). Those headers pull in the display
+// drivers, so the values are repeated here.
+static const uint16_t PANEL_CORPUS_WIDTH = 192;
+static const uint16_t PANEL_CORPUS_HEIGHT = 96;
+static const uint16_t PANEL_CORPUS_TILE_SIZE = 16;
+
+/**
+ * @brief One panel frame in 0xRRGGBB, independent of the stream pixel format.
+ */
+struct PanelFrame {
+    std::string name;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::vector<uint32_t> rgb;
+};
+
+/**
+ * @brief Load a panel snapshot as written by /api/snapshot.bmp (any 24/32 bit uncompressed BMP).
+ *
+ * The size is cropped to whole tiles.
+ */
+bool loadPanelBmp(const std::string& path, PanelFrame& frame, std::string& error);
+
+/**
+ * @brief Load every *.bmp of a directory (sorted by name) or a single file
+ */
+bool loadPanelFrames(const std::string& path, std::vector<PanelFrame>& frames, std::string& error);
+
+/**
+ * @brief Frames resembling what the modules draw: clock digits, text lists, icons on gradients,
+ *        the fireplace animation, tables with colored badges and an almost empty screen.
+ *
+ * Deterministic, used when no captured snapshots are given.
+ */
+std::vector<PanelFrame> syntheticPanelFrames();
+
+/**
+ * @brief Convert a frame into the stream pixel format (RGB565 keeps the high bits like the canvas)
+ */
+template<typename Pixel>
+std::vector<typename Pixel::Storage> framePixels(const PanelFrame& frame) {
+    std::vector<typename Pixel::Storage> pixels(frame.rgb.size());
+    for (size_t i = 0; i < frame.rgb.size(); i++) {
+        uint32_t c = frame.rgb[i];
+        uint8_t r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+        pixels[i] = Pixel::pack(r >> (8 - Pixel::redBits), g >> (8 - Pixel::greenBits), b >> (8 - Pixel::blueBits));
+    }
+    return pixels;
+}
+
+/**
+ * @brief Copy one tile in row-major order (same order as PanelStreamer::copyTile)
+ */
+template<typename T>
+void copyFrameTile(const std::vector<T>& pixels, uint16_t width, int tileX, int tileY, T* dest) {
+    size_t offset = (size_t)tileY * PANEL_CORPUS_TILE_SIZE * width + (size_t)tileX * PANEL_CORPUS_TILE_SIZE;
+    for (int row = 0; row < PANEL_CORPUS_TILE_SIZE; row++) {
+        for (int col = 0; col < PANEL_CORPUS_TILE_SIZE; col++) {
+            *dest++ = pixels[offset + col];
+        }
+        offset += width;
+    }
+}
+
+#endif // PANEL_FRAME_CORPUS_HPP
@@ -0,0 +1,125 @@
+// Panel stream codec benchmark: encodes keyframes of captured panel snapshots (or the synthetic
+// corpus) with every codec and pixel format and reports the wire size, the ratio against raw
+// pixels and the host encode time per frame.
+//
+// Usage: panel_stream_codec_bench [--iterations N] [snapshot.bmp | directory]...
+// Snapshots come from http://<panel>/api/snapshot.bmp, one per module.
+
+#include "PanelFrameCorpus.hpp"
+#include "PanelStreamCodec.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Wire overhead of a panel frame (PanelStreamer.cpp: message header, tile index + u16 length per tile)
+const size_t STREAM_HEADER_SIZE = 20;
+const size_t TILE_RECORD_OVERHEAD = 3;
+
+struct Result {
+    size_t rawBytes = 0;
+    size_t wireBytes = 0;
+    double encodeUs = 0;
+};
+
+struct Total {
+    std::string label;
+    size_t rawBytes = 0;
+    size_t wireBytes = 0;
+    double encodeUs = 0;
+    size_t frames = 0;
+};
+
+template<typename Pixel>
+Result encodeKeyframe(PanelStreamCodec<Pixel>& codec, const PanelFrame& frame, int iterations) {
+    typedef typename Pixel::Storage PixelType;
+    const size_t tilePixels = (size_t)PANEL_CORPUS_TILE_SIZE * PANEL_CORPUS_TILE_SIZE;
+    const int tilesX = frame.width / PANEL_CORPUS_TILE_SIZE;
+    const int tilesY = frame.height / PANEL_CORPUS_TILE_SIZE;
+
+    std::vector<PixelType> pixels = framePixels<Pixel>(frame);
+    std::vector<PixelType> tile(tilePixels);
+    std::vector<uint8_t> slot(codec.maxEncodedSize(tilePixels));
+
+    Result result;
+    result.rawBytes = STREAM_HEADER_SIZE + (size_t)tilesX * tilesY * (TILE_RECORD_OVERHEAD + tilePixels * Pixel::bytesPerPixel);
+    double bestUs = 0;
+    for (int it = 0; it < iterations; it++) {
+        size_t wire = STREAM_HEADER_SIZE;
+        auto start = std::chrono::steady_clock::now();
+        for (int ty = 0; ty < tilesY; ty++) {
+            for (int tx = 0; tx < tilesX; tx++) {
+                copyFrameTile(pixels, frame.width, tx, ty, tile.data());
+                size_t encoded = codec.encode(tile.data(), tilePixels, slot.data(), slot.size());
+                wire += TILE_RECORD_OVERHEAD + encoded;
+            }
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (it == 0 || us < bestUs) bestUs = us;
+        result.wireBytes = wire;
+    }
+    result.encodeUs = bestUs;
+    return result;
+}
+
+template<typename Pixel>
+void benchFormat(const char* formatName, const std::vector<PanelFrame>& frames, int iterations, std::vector<Total>& totals) {
+    std::vector<std::unique_ptr<PanelStreamCodec<Pixel>>> codecs;
+    codecs.emplace_back(new RleStreamCodec<Pixel>());
+    codecs.emplace_back(new QoiStreamCodec<Pixel>());
+    codecs.emplace_back(new LzStreamCodec<Pixel>(PANEL_CORPUS_TILE_SIZE));
+
+    for (auto& codec : codecs) {
+        Total total;
+        total.label = std::string(formatName) + " " + codec->name();
+        for (const PanelFrame& frame : frames) {
+            Result r = encodeKeyframe(*codec, frame, iterations);
+            printf("%-24s %-6s %-4s %8zu %8zu %7.2f %9.1f\n", frame.name.c_str(), formatName, codec->name(),
+                   r.rawBytes, r.wireBytes, (double)r.rawBytes / r.wireBytes, r.encodeUs);
+            total.rawBytes += r.rawBytes;
+            total.wireBytes += r.wireBytes;
+            total.encodeUs += r.encodeUs;
+            total.frames++;
+        }
+        totals.push_back(total);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 20;
+    std::vector<PanelFrame> frames;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, atoi(argv[++i]));
+            continue;
+        }
+        std::string error;
+        if (!loadPanelFrames(arg, frames, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+    if (frames.empty()) {
+        printf("No snapshots given, using the synthetic corpus\n");
+        frames = syntheticPanelFrames();
+    }
+
+    printf("%-24s %-6s %-4s %8s %8s %7s %9s\n", "frame", "format", "codec", "raw B", "wire B", "ratio", "enc us");
+    std::vector<Total> totals;
+    benchFormat<PixelRGB565>("RGB565", frames, iterations, totals);
+    benchFormat<PixelRGB888>("RGB888", frames, iterations, totals);
+
+    printf("\n%-12s %10s %10s %7s %12s\n", "codec", "raw B/fr", "wire B/fr", "ratio", "enc us/fr");
+    for (const Total& t : totals) {
+        printf("%-12s %10zu %10zu %7.2f %12.1f\n", t.label.c_str(), t.rawBytes / t.frames, t.wireBytes / t.frames,
+               (double)t.rawBytes / t.wireBytes, t.encodeUs / t.frames);
+    }
+    return 0;
+}
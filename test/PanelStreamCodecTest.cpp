@@ -0,0 +1,199 @@
+// Round trip of every stream codec through the browser decoders, and the maxEncodedSize() bound
+
+#include <gtest/gtest.h>
+
+#include "PanelStreamCodec.hpp"
+#include "PanelStreamDecoders.hpp"
+#include "PanelFrameCorpus.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t TILE_PIXELS = (size_t)PANEL_CORPUS_TILE_SIZE * PANEL_CORPUS_TILE_SIZE;
+const uint8_t CANARY = 0xA5;
+const size_t CANARY_BYTES = 64;
+
+template<typename P, template<typename> class C>
+struct CodecCase {
+    typedef P Pixel;
+    static std::unique_ptr<PanelStreamCodec<P>> make() { return std::unique_ptr<PanelStreamCodec<P>>(new C<P>()); }
+};
+
+template<typename P>
+struct LzCase {
+    typedef P Pixel;
+    static std::unique_ptr<PanelStreamCodec<P>> make() {
+        return std::unique_ptr<PanelStreamCodec<P>>(new LzStreamCodec<P>(PANEL_CORPUS_TILE_SIZE));
+    }
+};
+
+template<typename Case>
+class PanelStreamCodecTest : public ::testing::Test {
+protected:
+    typedef typename Case::Pixel Pixel;
+    typedef typename Pixel::Storage PixelType;
+
+    static PixelType color(uint32_t r, uint32_t g, uint32_t b) {
+        return Pixel::pack(r & ((1u << Pixel::redBits) - 1), g & ((1u << Pixel::greenBits) - 1), b & ((1u << Pixel::blueBits) - 1));
+    }
+
+    static PixelType maxComponent(int bits) { return (PixelType)((1u << bits) - 1); }
+
+    // Encode into exactly maxEncodedSize() bytes, guarded by a canary, and decode like the page
+    void roundTrip(const std::vector<PixelType>& pixels, const std::string& what) {
+        auto codec = Case::make();
+        size_t capacity = codec->maxEncodedSize(pixels.size());
+        std::vector<uint8_t> buffer(capacity + CANARY_BYTES, CANARY);
+        size_t encoded = codec->encode(pixels.data(), pixels.size(), buffer.data(), capacity);
+
+        ASSERT_GT(encoded, 0u) << what;
+        ASSERT_LE(encoded, capacity) << what;
+        for (size_t i = capacity; i < buffer.size(); i++) ASSERT_EQ(buffer[i], CANARY) << what << ": wrote past the buffer";
+
+        std::vector<uint32_t> decoded(pixels.size(), 0xDEADBEEF);
+        StreamTileDecoder decoder(buffer.data(), encoded);
+        StreamDecodeResult result = decoder.decode(codec->id(), 0, decoded, StreamPixelFormat::of<Pixel>());
+        EXPECT_FALSE(result.overrun) << what << ": decoder read past the payload";
+        EXPECT_EQ(result.pos, encoded) << what << ": payload not consumed exactly";
+        for (size_t i = 0; i < pixels.size(); i++) {
+            ASSERT_EQ(decoded[i], (uint32_t)pixels[i]) << what << ": pixel " << i << " of " << pixels.size();
+        }
+        lastEncoded = encoded;
+    }
+
+    std::vector<PixelType> randomTile(uint32_t seed, size_t count = TILE_PIXELS) {
+        std::mt19937 rng(seed);
+        std::vector<PixelType> tile(count);
+        for (auto& p : tile) p = color(rng(), rng(), rng());
+        return tile;
+    }
+
+    std::vector<PixelType> flatTile(PixelType p) { return std::vector<PixelType>(TILE_PIXELS, p); }
+
+    // Black background, 1 px strokes in two colors with antialiasing-like neighbours
+    std::vector<PixelType> textTile(uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<PixelType> tile(TILE_PIXELS, 0);
+        PixelType ink = color(rng(), rng(), rng());
+        PixelType shade = color(rng() >> 1, rng() >> 1, rng() >> 1);
+        for (int stroke = 0; stroke < 6; stroke++) {
+            int x = rng() % PANEL_CORPUS_TILE_SIZE, y = rng() % PANEL_CORPUS_TILE_SIZE;
+            bool vertical = rng() & 1;
+            for (int i = 0; i < 7; i++) {
+                int px = vertical ? x : (x + i) % PANEL_CORPUS_TILE_SIZE;
+                int py = vertical ? (y + i) % PANEL_CORPUS_TILE_SIZE : y;
+                tile[py * PANEL_CORPUS_TILE_SIZE + px] = (i % 3 == 2) ? shade : ink;
+            }
+        }
+        return tile;
+    }
+
+    std::vector<PixelType> gradientTile(bool vertical, int step) {
+        std::vector<PixelType> tile(TILE_PIXELS);
+        for (int y = 0; y < PANEL_CORPUS_TILE_SIZE; y++) {
+            for (int x = 0; x < PANEL_CORPUS_TILE_SIZE; x++) {
+                int v = (vertical ? y : x) * step;
+                tile[y * PANEL_CORPUS_TILE_SIZE + x] = color(v, 255 - v, v / 2 + 7);
+            }
+        }
+        return tile;
+    }
+
+    size_t lastEncoded = 0;
+};
+
+typedef ::testing::Types<CodecCase<PixelRGB565, RleStreamCodec>, CodecCase<PixelRGB888, RleStreamCodec>,
+                         CodecCase<PixelRGB565, QoiStreamCodec>, CodecCase<PixelRGB888, QoiStreamCodec>,
+                         LzCase<PixelRGB565>, LzCase<PixelRGB888>>
+    CodecCases;
+
+class CodecCaseNames {
+public:
+    template<typename Case>
+    static std::string GetName(int) {
+        auto codec = Case::make();
+        return std::string(codec->name()) + (Case::Pixel::formatId == PIXEL_FORMAT_RGB565 ? "_RGB565" : "_RGB888");
+    }
+};
+
+TYPED_TEST_SUITE(PanelStreamCodecTest, CodecCases, CodecCaseNames);
+
+TYPED_TEST(PanelStreamCodecTest, RandomTiles) {
+    for (uint32_t seed = 1; seed <= 50; seed++) this->roundTrip(this->randomTile(seed), "random " + std::to_string(seed));
+}
+
+TYPED_TEST(PanelStreamCodecTest, FlatTiles) {
+    typedef typename TestFixture::Pixel Pixel;
+    this->roundTrip(this->flatTile(0), "black");
+    EXPECT_LE(this->lastEncoded, 16u) << "black tile should collapse";
+    this->roundTrip(this->flatTile(this->color(3, 40, 17)), "flat color");
+    EXPECT_LE(this->lastEncoded, 16u) << "flat tile should collapse";
+    this->roundTrip(this->flatTile(Pixel::pack(this->maxComponent(Pixel::redBits), this->maxComponent(Pixel::greenBits),
+                                               this->maxComponent(Pixel::blueBits))), "white");
+}
+
+TYPED_TEST(PanelStreamCodecTest, TextLikeTiles) {
+    for (uint32_t seed = 1; seed <= 50; seed++) this->roundTrip(this->textTile(seed), "text " + std::to_string(seed));
+}
+
+TYPED_TEST(PanelStreamCodecTest, GradientTiles) {
+    for (int step : { 1, 2, 5, 16, 17 }) {
+        this->roundTrip(this->gradientTile(false, step), "horizontal gradient step " + std::to_string(step));
+        this->roundTrip(this->gradientTile(true, step), "vertical gradient step " + std::to_string(step));
+    }
+}
+
+TYPED_TEST(PanelStreamCodecTest, CorpusTiles) {
+    typedef typename TestFixture::Pixel Pixel;
+    typedef typename TestFixture::PixelType PixelType;
+    std::vector<PixelType> tile(TILE_PIXELS);
+    for (const PanelFrame& frame : syntheticPanelFrames()) {
+        std::vector<PixelType> pixels = framePixels<Pixel>(frame);
+        for (int ty = 0; ty < frame.height / PANEL_CORPUS_TILE_SIZE; ty++) {
+            for (int tx = 0; tx < frame.width / PANEL_CORPUS_TILE_SIZE; tx++) {
+                copyFrameTile(pixels, frame.width, tx, ty, tile.data());
+                this->roundTrip(tile, frame.name + " tile " + std::to_string(tx) + "," + std::to_string(ty));
+            }
+        }
+    }
+}
+
+// Inputs that defeat each codec: isolated pixels for RLE, no index hits and large deltas for QOI,
+// no repeats within the match window for LZ. The bound must hold for every pixel count.
+TYPED_TEST(PanelStreamCodecTest, MaxEncodedSizeHoldsForWorstCase) {
+    typedef typename TestFixture::PixelType PixelType;
+    for (size_t count : { (size_t)1, (size_t)2, (size_t)127, (size_t)128, (size_t)129, (size_t)255, TILE_PIXELS, (size_t)1000 }) {
+        this->roundTrip(this->randomTile(7, count), "random x" + std::to_string(count));
+
+        // Every pixel differs from its neighbour and from the row above, black pixels in between
+        std::vector<PixelType> alternating(count);
+        for (size_t i = 0; i < count; i++) {
+            alternating[i] = (i % 2) ? 0 : this->color((uint32_t)(i * 37 + 11), (uint32_t)(i * 53 + 29), (uint32_t)(i * 91 + 3));
+            if (alternating[i] == 0 && i % 2 == 0) alternating[i] = this->color(1, 1, 1);
+        }
+        this->roundTrip(alternating, "alternating black x" + std::to_string(count));
+
+        // Distinct colors with maximal component jumps
+        std::vector<PixelType> jumps(count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t v = (uint32_t)(i * 2654435761u);
+            jumps[i] = this->color(v >> 3, v >> 11, v >> 19) ^ (PixelType)((i & 1) ? ~0u : 0u);
+            jumps[i] &= (PixelType)((1ull << (TestFixture::Pixel::bytesPerPixel * 8)) - 1);
+        }
+        this->roundTrip(jumps, "jumps x" + std::to_string(count));
+    }
+}
+
+TYPED_TEST(PanelStreamCodecTest, WorstCaseUsesMostOfTheBound) {
+    // A bound far above reality wastes PSRAM in the tile cache; random tiles must come reasonably close
+    auto codec = TypeParam::make();
+    size_t bound = codec->maxEncodedSize(TILE_PIXELS);
+    this->roundTrip(this->randomTile(99), "random");
+    EXPECT_GE(this->lastEncoded * 10, bound * 8) << "encoded " << this->lastEncoded << " of bound " << bound;
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+#ifndef PANEL_STREAM_DECODERS_HPP
+#define PANEL_STREAM_DECODERS_HPP
+
+// C++ port of the browser decoders (WebPages.hpp: readPixel, decodeRLE, decodeQOI, decodeLZ).
+// Kept line by line close to the JavaScript, so a codec change that breaks the page breaks the tests.
+// Reads past `end` are reported through `overrun` instead of yielding NaN like in JavaScript.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PanelStreamCodec.hpp"
+
+/**
+ * @brief The `fmt` object of the page (bytes and component bits of the stream pixel format)
+ */
+struct StreamPixelFormat {
+    int bytes;
+    int rBits;
+    int gBits;
+    int bBits;
+
+    template<typename Pixel>
+    static StreamPixelFormat of() {
+        return { Pixel::bytesPerPixel, Pixel::redBits, Pixel::greenBits, Pixel::blueBits };
+    }
+};
+
+/**
+ * @brief Result of a tile decode: where the decoder stopped, and whether it had to read past the payload
+ */
+struct StreamDecodeResult {
+    size_t pos = 0;
+    bool overrun = false;
+};
+
+class StreamTileDecoder {
+public:
+    StreamTileDecoder(const uint8_t* data, size_t end) : _data(data), _end(end) {}
+
+    StreamDecodeResult decode(PanelStreamCodecId codec, size_t pos, std::vector<uint32_t>& out, const StreamPixelFormat& fmt) {
+        _overrun = false;
+        if (codec == CODEC_QOI) pos = decodeQOI(pos, out, fmt);
+        else if (codec == CODEC_LZ) pos = decodeLZ(pos, out, fmt);
+        else pos = decodeRLE(pos, out, fmt);
+        StreamDecodeResult result;
+        result.pos = pos;
+        result.overrun = _overrun;
+        return result;
+    }
+
+private:
+    uint8_t byteAt(size_t pos) {
+        if (pos >= _end) {
+            _overrun = true;
+            return 0;
+        }
+        return _data[pos];
+    }
+
+    uint32_t readPixel(size_t pos, int bytes) {
+        uint32_t p = 0;
+        for (int i = 0; i < bytes; i++) p = (p * 256) + byteAt(pos + i);
+        return p;
+    }
+
+    size_t decodeRLE(size_t pos, std::vector<uint32_t>& out, const StreamPixelFormat& fmt) {
+        size_t pixelIndex = 0;
+        while (pos + 3 <= _end && pixelIndex < out.size()) {
+            uint8_t count = byteAt(pos++);
+            if (count == 0x00) {
+                uint32_t skipCount = (byteAt(pos) << 8) | byteAt(pos + 1);
+                pos += 2;
+                for (uint32_t i = 0; i < skipCount && pixelIndex < out.size(); i++) out[pixelIndex++] = 0;
+                continue;
+            }
+            if (pos + fmt.bytes > _end) break;
+            uint32_t pixel = readPixel(pos, fmt.bytes);
+            pos += fmt.bytes;
+            for (uint32_t i = 0; i < count && pixelIndex < out.size(); i++) out[pixelIndex++] = pixel;
+        }
+        while (pixelIndex < out.size()) out[pixelIndex++] = 0;
+        return pos;
+    }
+
+    size_t decodeQOI(size_t pos, std::vector<uint32_t>& out, const StreamPixelFormat& fmt) {
+        const int gShift = fmt.bBits;
+        const int rShift = fmt.gBits + fmt.bBits;
+        const uint32_t rMask = (1u << fmt.rBits) - 1;
+        const uint32_t gMask = (1u << fmt.gBits) - 1;
+        const uint32_t bMask = (1u << fmt.bBits) - 1;
+        uint32_t index[64] = {};
+        uint32_t prev = 0;
+        size_t pixelIndex = 0;
+        auto hash = [&](uint32_t p) {
+            return (int)((((p >> rShift) & rMask) * 3 + ((p >> gShift) & gMask) * 5 + (p & bMask) * 7) & 63);
+        };
+        while (pos < _end && pixelIndex < out.size()) {
+            uint8_t op = byteAt(pos++);
+            if (op == 0xFE) {
+                prev = readPixel(pos, fmt.bytes);
+                pos += fmt.bytes;
+                index[hash(prev)] = prev;
+            } else if ((op & 0xC0) == 0xC0) {
+                for (int i = 0; i <= (op & 0x3F) && pixelIndex < out.size(); i++) out[pixelIndex++] = prev;
+                continue;
+            } else if ((op & 0xC0) == 0x00) {
+                prev = index[op];
+            } else {
+                int dr, dg, db;
+                if ((op & 0xC0) == 0x40) {
+                    dr = ((op >> 4) & 3) - 2;
+                    dg = ((op >> 2) & 3) - 2;
+                    db = (op & 3) - 2;
+                } else {
+                    uint8_t b2 = byteAt(pos++);
+                    dg = (op & 0x3F) - 32;
+                    dr = dg + ((b2 >> 4) & 0x0F) - 8;
+                    db = dg + (b2 & 0x0F) - 8;
+                }
+                uint32_t r = (((prev >> rShift) & rMask) + dr) & rMask;
+                uint32_t g = (((prev >> gShift) & gMask) + dg) & gMask;
+                uint32_t b = ((prev & bMask) + db) & bMask;
+                prev = (r << rShift) | (g << gShift) | b;
+                index[hash(prev)] = prev;
+            }
+            out[pixelIndex++] = prev;
+        }
+        while (pixelIndex < out.size()) out[pixelIndex++] = 0;
+        return pos;
+    }
+
+    size_t decodeLZ(size_t pos, std::vector<uint32_t>& out, const StreamPixelFormat& fmt) {
+        size_t pixelIndex = 0;
+        while (pos < _end && pixelIndex < out.size()) {
+            uint8_t ctrl = byteAt(pos++);
+            if (ctrl & 0x80) {
+                int len = (ctrl & 0x7F) + 2;
+                size_t offset = (size_t)byteAt(pos++) + 1;
+                for (int i = 0; i < len && pixelIndex < out.size(); i++, pixelIndex++) {
+                    out[pixelIndex] = pixelIndex >= offset ? out[pixelIndex - offset] : 0;
+                }
+            } else {
+                int n = ctrl + 1;
+                for (int i = 0; i < n && pixelIndex < out.size(); i++) {
+                    out[pixelIndex++] = readPixel(pos, fmt.bytes);
+                    pos += fmt.bytes;
+                }
+            }
+        }
+        while (pixelIndex < out.size()) out[pixelIndex++] = 0;
+        return pos;
+    }
+
+    const uint8_t* _data;
+    size_t _end;
+    bool _overrun = false;
+};
+
+#endif // PANEL_STREAM_DECODERS_HPP
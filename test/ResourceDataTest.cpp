@@ -0,0 +1,241 @@
+// Shared response bodies of WebClientModule: reference counting of ResourceData/ResourceDataRef and
+// the data versions takeNewData() hands out, for downloads, 304 answers and the flash cache (HostNet)
+
+#include <gtest/gtest.h>
+
+#include "HostRuntime.hpp"
+#include "HostNet.hpp"
+#include "AllocHook.hpp"
+#include "WebClientModule.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "webconfig.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+// done() is called until it returns true, never again afterwards (takeNewData() consumes the version)
+bool waitFor(const std::function<bool()>& done) {
+    for (int i = 0; i < 1000; i++) {
+        if (done()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+ResourceData* makeData(const char* body, uint32_t version) {
+    ResourceData* data = ResourceData::create(strlen(body), version, 1700000000);
+    memcpy(data->data(), body, strlen(body));
+    return data;
+}
+
+// Server content per path; the ETag follows the content, so an unchanged body is answered with 304
+std::mutex g_serverMutex;
+std::map<std::string, std::string> g_content;
+std::map<std::string, int> g_notModified;
+
+void publish(const std::string& path, const std::string& body) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    g_content[path] = body;
+}
+
+int notModifiedCount(const std::string& path) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    return g_notModified[path];
+}
+
+HostNet::Response serve(const HostNet::Request& request) {
+    std::lock_guard<std::mutex> lock(g_serverMutex);
+    HostNet::Response response;
+    auto it = g_content.find(request.path);
+    if (it == g_content.end()) {
+        response.status = 404;
+        return response;
+    }
+    std::string etag = "\"" + std::to_string(std::hash<std::string>()(it->second)) + "\"";
+    response.headers.emplace_back("ETag", etag);
+    if (request.header("If-None-Match") == etag) {
+        g_notModified[request.path]++;
+        response.status = 304;
+        return response;
+    }
+    response.body = it->second;
+    return response;
+}
+
+DeviceConfig& testConfig() {
+    static DeviceConfig config;
+    config.webClientBufferSize = 16 * 1024;
+    config.webCacheEnabled = true;
+    return config;
+}
+
+// Worker threads cannot be stopped on the host, a started module lives until the process ends
+WebClientModule& startedModule() {
+    WebClientModule* module = new WebClientModule();
+    module->begin();
+    return *module;
+}
+
+class ResourceDataTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        HostRuntime::setSerialEnabled(false);
+        // Compresses the start delay of the workers and the update intervals
+        HostRuntime::setClockScale(50.0);
+        HostNet::reset();
+        HostNet::setHandler(serve);
+        deviceConfig = &testConfig();
+    }
+
+    void TearDown() override {
+        HostNet::reset();
+        HostRuntime::setClockScale(1.0);
+        HostRuntime::setSerialEnabled(true);
+    }
+
+    static PsramString url(const char* path) {
+        return PsramString("http://data.test") + path;
+    }
+};
+
+// --- Reference counting (no workers) ---
+
+TEST_F(ResourceDataTest, RefsShareTheBlockWithoutCopies) {
+    ResourceData* data = makeData("payload", 3);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->refs.load(), 1u);
+
+    ResourceDataRef first(data);
+    EXPECT_EQ(data->refs.load(), 2u);
+    EXPECT_EQ(first.data(), data->data());
+    EXPECT_EQ(first.size(), 7u);
+    EXPECT_EQ(first.version(), 3u);
+    EXPECT_EQ(first.lastUpdate(), 1700000000);
+
+    ResourceDataRef copy(first);
+    EXPECT_EQ(data->refs.load(), 3u);
+    ResourceDataRef moved(std::move(copy));
+    EXPECT_EQ(data->refs.load(), 3u);
+    EXPECT_FALSE(copy);
+    EXPECT_EQ(copy.version(), 0u);
+
+    ResourceDataRef assigned;
+    assigned = first;
+    EXPECT_EQ(data->refs.load(), 4u);
+    assigned = assigned;
+    EXPECT_EQ(data->refs.load(), 4u);
+    assigned.reset();
+    moved.reset();
+    EXPECT_EQ(data->refs.load(), 2u);
+    data->release();
+    EXPECT_EQ(data->refs.load(), 1u);
+    EXPECT_STREQ(first.data(), "payload");
+}
+
+TEST_F(ResourceDataTest, LastReferenceFreesTheBlock) {
+    AllocScope scope;
+    {
+        ResourceData* data = makeData("body of the old version", 1);
+        ResourceDataRef held(data);
+        // The WebClient drops its reference when a newer body arrives, the module still reads the old one
+        data->release();
+        EXPECT_STREQ(held.data(), "body of the old version");
+        EXPECT_GT(scope.retainedBytes(), 0);
+
+        ResourceData* newer = makeData("new", 2);
+        ResourceDataRef other(newer);
+        newer->release();
+        held = std::move(other);   // Releases the old block
+        EXPECT_EQ(held.version(), 2u);
+        EXPECT_EQ(newer->refs.load(), 1u);
+    }
+    EXPECT_EQ(scope.retainedBytes(), 0);
+}
+
+// --- Versions (workers and HostNet) ---
+
+TEST_F(ResourceDataTest, TakeNewDataHandsOutEachVersionOnce) {
+    WebClientModule& web = startedModule();
+    publish("/versions", "first");
+    web.registerResourceSeconds(url("/versions").c_str(), 1);
+
+    ResourceSubscription subscription;
+    subscription.setUrl(url("/versions"));
+    ResourceDataRef data;
+    ASSERT_TRUE(waitFor([&] { return web.takeNewData(subscription, data); }));
+    EXPECT_EQ(data.version(), 1u);
+    EXPECT_STREQ(data.data(), "first");
+    EXPECT_FALSE(web.takeNewData(subscription, data));
+    EXPECT_STREQ(data.data(), "first");   // Untouched without a new version
+
+    // Unchanged body (304): no new version, nothing to re-parse
+    int before = notModifiedCount("/versions");
+    ASSERT_TRUE(waitFor([&] { return notModifiedCount("/versions") >= before + 2; }));
+    EXPECT_FALSE(web.takeNewData(subscription, data));
+    EXPECT_EQ(subscription.version, 1u);
+
+    publish("/versions", "second");
+    ResourceDataRef newer;
+    ASSERT_TRUE(waitFor([&] { return web.takeNewData(subscription, newer); }));
+    EXPECT_EQ(newer.version(), 2u);
+    EXPECT_STREQ(newer.data(), "second");
+    EXPECT_STREQ(data.data(), "first");   // The old block stays valid while referenced
+    EXPECT_FALSE(web.takeNewData(subscription, newer));
+
+    // A second subscriber gets the current version once as well
+    ResourceSubscription late;
+    late.setUrl(url("/versions"));
+    ResourceDataRef lateData;
+    EXPECT_TRUE(web.takeNewData(late, lateData));
+    EXPECT_EQ(lateData.version(), 2u);
+    EXPECT_FALSE(web.takeNewData(late, lateData));
+
+    web.unregisterResource(url("/versions").c_str());
+}
+
+TEST_F(ResourceDataTest, CachedBodyIsAVersionAndA304KeepsIt) {
+    // Writes the flash cache
+    WebClientModule& writer = startedModule();
+    publish("/cached", "from the cache");
+    writer.registerResourceSeconds(url("/cached").c_str(), 600);
+    uint32_t loads, writes, skipped, limited;
+    ASSERT_TRUE(waitFor([&] {
+        writer.getCacheStats(loads, writes, skipped, limited);
+        return writes >= 1;
+    }));
+
+    // After a restart the body comes from flash before the first download
+    WebClientModule& web = startedModule();
+    web.registerResourceSeconds(url("/cached").c_str(), 1);
+    web.getCacheStats(loads, writes, skipped, limited);
+    EXPECT_EQ(loads, 1u);
+
+    ResourceSubscription subscription;
+    subscription.setUrl(url("/cached"));
+    ResourceDataRef data;
+    ASSERT_TRUE(web.takeNewData(subscription, data));
+    EXPECT_EQ(data.version(), 1u);
+    EXPECT_STREQ(data.data(), "from the cache");
+
+    // The cached validators let the server answer 304: still version 1
+    ASSERT_TRUE(waitFor([&] { return notModifiedCount("/cached") >= 2; }));
+    EXPECT_FALSE(web.takeNewData(subscription, data));
+
+    publish("/cached", "downloaded");
+    ASSERT_TRUE(waitFor([&] { return web.takeNewData(subscription, data); }));
+    EXPECT_EQ(data.version(), 2u);
+    EXPECT_STREQ(data.data(), "downloaded");
+}
+
+} // namespace
@@ -0,0 +1,170 @@
+// Resource registry benchmark: time and heap allocations of the WebClientModule lookups that the
+// modules call every tick (accessResource, pause/resume, registerResource for a known host) with
+// registries of 16 to 256 resources, laid out like the firmware's: one resource per host for the
+// plain modules, SofaScore-style priority resources sharing one host, ThemePark-style resources
+// told apart by headers.
+//
+// Usage: webclient_registry_bench [--calls N] [--no-check]
+// With checks on, the run fails when a const char* lookup or the known-host registerResource()
+// allocates.
+
+#include "WebClientModule.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "webconfig.hpp"
+#include "AllocHook.hpp"
+#include "HostRuntime.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+bool g_checksOk = true;
+
+struct Registry {
+    std::vector<std::string> plainUrls;     // registerResource(), one host each
+    std::vector<std::string> priorityUrls;  // registerResourceSeconds(..., force_new), shared host
+    std::vector<std::string> headerUrls;    // registerResourceWithHeaders(), shared URL
+    std::vector<std::string> headers;
+};
+
+Registry fillRegistry(WebClientModule& web, size_t count) {
+    Registry registry;
+    for (size_t i = 0; registry.plainUrls.size() + registry.priorityUrls.size() + registry.headerUrls.size() < count; i++) {
+        char url[128];
+        switch (i % 3) {
+            case 0:
+                snprintf(url, sizeof(url), "https://api%zu.example.org/v1/data?station=%zu", i, i);
+                web.registerResource(String(url), 15);
+                registry.plainUrls.push_back(url);
+                break;
+            case 1:
+                snprintf(url, sizeof(url), "https://api.sofascore.com/api/v1/event/%zu/statistics", 12000 + i);
+                web.registerResourceSeconds(String(url), 30, true, true);
+                registry.priorityUrls.push_back(url);
+                break;
+            default: {
+                char header[64];
+                snprintf(header, sizeof(header), "park: %zu", i);
+                snprintf(url, sizeof(url), "https://api.wartezeiten.app/v1/waitingtimes");
+                web.registerResourceWithHeaders(String(url), String(header), 10);
+                registry.headerUrls.push_back(url);
+                registry.headers.push_back(header);
+                break;
+            }
+        }
+    }
+    return registry;
+}
+
+struct Measurement {
+    double nsPerCall = 0;
+    double allocationsPerCall = 0;
+};
+
+template<typename Fn>
+Measurement measure(size_t calls, Fn&& fn) {
+    fn(0);  // warm up (first use of the logger, lazily created state)
+    AllocScope scope;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < calls; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Measurement m;
+    m.nsPerCall = std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+    m.allocationsPerCall = (double)scope.allocations() / calls;
+    return m;
+}
+
+void report(size_t resources, const char* operation, const Measurement& m, bool mustNotAllocate) {
+    bool ok = !mustNotAllocate || m.allocationsPerCall == 0;
+    printf("%9zu  %-44s %10.0f %10.2f%s\n", resources, operation, m.nsPerCall, m.allocationsPerCall, ok ? "" : "  FAILED");
+    if (!ok) g_checksOk = false;
+}
+
+void runRegistry(size_t count, size_t calls, bool check) {
+    WebClientModule web;
+    Registry registry = fillRegistry(web, count);
+    // Captures one pointer like the module callbacks, so std::function stores it inline
+    size_t seen = 0;
+    auto callback = [&seen](const char*, size_t, time_t, bool) { seen++; };
+
+    report(count, "accessResource(const char*)", measure(calls, [&](size_t i) {
+        web.accessResource(registry.priorityUrls[i % registry.priorityUrls.size()].c_str(), callback);
+    }), check);
+    report(count, "accessResource(const char*, const char*)", measure(calls, [&](size_t i) {
+        size_t n = i % registry.headerUrls.size();
+        web.accessResource(registry.headerUrls[n].c_str(), registry.headers[n].c_str(), callback);
+    }), check);
+    report(count, "accessResource(const String&)", measure(calls, [&](size_t i) {
+        web.accessResource(String(registry.priorityUrls[i % registry.priorityUrls.size()].c_str()), callback);
+    }), false);
+    report(count, "accessResource(const String&, const String&)", measure(calls, [&](size_t i) {
+        size_t n = i % registry.headerUrls.size();
+        web.accessResource(String(registry.headerUrls[n].c_str()), String(registry.headers[n].c_str()), callback);
+    }), false);
+
+    // The String argument is built outside the measured call, as a module keeps it
+    std::vector<String> plain;
+    for (const auto& url : registry.plainUrls) plain.emplace_back(url.c_str());
+    report(count, "registerResource() of a known host", measure(calls, [&](size_t i) {
+        web.registerResource(plain[i % plain.size()], 15);
+    }), check);
+
+    // pause/resume log every call, so only the time is of interest here
+    report(count, "pauseResource + resumeResource(const char*)", measure(calls / 4, [&](size_t i) {
+        const char* url = registry.priorityUrls[i % registry.priorityUrls.size()].c_str();
+        web.pauseResource(url);
+        web.resumeResource(url);
+    }), false);
+}
+
+// registerResource() replaces the URL of the first resource of a host; after that one is
+// unregistered, the next resource of the host takes its place in the host index
+void checkHostHandover() {
+    WebClientModule web;
+    web.registerResourceSeconds(String("https://h.example.org/a"), 60);
+    web.registerResourceSeconds(String("https://h.example.org/b"), 60, false, true);
+    web.unregisterResource("https://h.example.org/a");
+    web.registerResource(String("https://h.example.org/c"), 1);
+    web.registerResource(String("https://other.example.org/x"), 1);
+    PsramVector<ResourceTelemetryInfo> list = web.getResourceTelemetry();
+    bool ok = list.size() == 2 && list[0].url == "https://h.example.org/c" && list[1].url == "https://other.example.org/x";
+    printf("\n%-6s host index hands a host on to its next resource\n", ok ? "ok" : "FAILED");
+    if (!ok) g_checksOk = false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t calls = 20000;
+    bool check = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--calls" && i + 1 < argc) calls = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--no-check") check = false;
+        else {
+            fprintf(stderr, "Usage: %s [--calls N] [--no-check]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (calls < 4) calls = 4;
+    HostRuntime::setSerialEnabled(false);
+    static DeviceConfig config;
+    deviceConfig = &config;
+
+    printf("%9s  %-44s %10s %10s\n", "resources", "operation", "ns/call", "allocs");
+    for (size_t count : {16, 64, 256}) runRegistry(count, calls, check);
+    checkHostHandover();
+
+    std::error_code ec;
+    std::filesystem::remove_all(HostRuntime::filesystemRoot(), ec);
+    return g_checksOk ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+// Request coalescing of WebClientModule::enqueueJob() through the public getRequest()/postRequest()
+// API: queue-only cases on a module without workers, running jobs on one with workers and HostNet
+
+#include <gtest/gtest.h>
+
+#include "HostRuntime.hpp"
+#include "HostNet.hpp"
+#include "WebClientModule.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "webconfig.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+// Holds requests to one host in the handler until release(), so their job stays running
+class Gate {
+public:
+    void enter() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _entered++;
+        _cv.notify_all();
+        _cv.wait(lock, [this] { return _open; });
+    }
+    bool waitForRequests(int count) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, std::chrono::seconds(10), [&] { return _entered >= count; });
+    }
+    void release() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _open = true;
+        _cv.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int _entered = 0;
+    bool _open = false;
+};
+
+// Result of one getRequest()/postRequest() callback, written by a worker
+struct Result {
+    std::atomic<int> calls{0};
+    std::string body;
+    std::mutex mutex;
+
+    std::function<void(const char*, size_t)> callback() {
+        return [this](const char* data, size_t size) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                body = data ? std::string(data, size) : std::string();
+            }
+            calls++;
+        };
+    }
+};
+
+bool waitFor(const std::function<bool()>& done) {
+    for (int i = 0; i < 1000 && !done(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return done();
+}
+
+std::atomic<Gate*> g_gate{nullptr};
+std::string g_gatedHost;
+
+// Answers with method, path and body; requests to g_gatedHost wait at the gate first
+HostNet::Response serve(const HostNet::Request& request) {
+    Gate* gate = g_gate.load();
+    if (gate && request.host == g_gatedHost) gate->enter();
+    HostNet::Response response;
+    response.body = request.method + " " + request.path + (request.body.empty() ? "" : " " + request.body);
+    return response;
+}
+
+DeviceConfig& testConfig() {
+    static DeviceConfig config;
+    config.webClientBufferSize = 16 * 1024;
+    return config;
+}
+
+// Worker threads cannot be stopped on the host, the running module lives until the process ends
+WebClientModule& runningModule() {
+    static WebClientModule* web = [] {
+        WebClientModule* module = new WebClientModule();
+        module->begin();
+        return module;
+    }();
+    return *web;
+}
+
+class WebJobQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        HostRuntime::setSerialEnabled(false);
+        // Compresses the start delay of the workers (WEBCLIENT_START_DELAY_MS) and the fake latencies
+        HostRuntime::setClockScale(50.0);
+        HostNet::reset();
+        HostNet::setHandler(serve);
+        deviceConfig = &testConfig();
+    }
+    void holdRequestsTo(const char* host) {
+        g_gatedHost = host;
+        g_gate = &gate;
+    }
+
+    void TearDown() override {
+        if (Gate* gate = g_gate.exchange(nullptr)) gate->release();
+        HostNet::reset();
+        HostRuntime::setClockScale(1.0);
+        HostRuntime::setSerialEnabled(true);
+    }
+
+    Gate gate;  // Outlives the test body, TearDown() opens it for requests still waiting
+
+    static PsramString url(const char* host, const char* path = "/data") {
+        return PsramString("http://") + host + path;
+    }
+};
+
+// --- Queued jobs (no workers: nothing leaves the queue) ---
+
+TEST_F(WebJobQueueTest, IdenticalGetJoinsTheQueuedJob) {
+    WebClientModule web;
+    Result first, second, other;
+    web.getRequest(url("queue.test"), first.callback());
+    web.getRequest(url("queue.test"), second.callback());
+    web.getRequest(url("queue.test", "/other"), other.callback());
+
+    JobQueueStats stats = web.getJobQueueStats();
+    EXPECT_EQ(stats.submitted[JOB_PRIORITY_BACKGROUND], 3u);
+    EXPECT_EQ(stats.coalesced[JOB_PRIORITY_BACKGROUND], 1u);
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_BACKGROUND], 2u);
+}
+
+TEST_F(WebJobQueueTest, MoreUrgentCallerPromotesTheQueuedJob) {
+    WebClientModule web;
+    Result background, live, later;
+    web.getRequest(url("queue.test"), background.callback(), JOB_PRIORITY_BACKGROUND);
+    web.getRequest(url("queue.test"), live.callback(), JOB_PRIORITY_LIVE);
+
+    JobQueueStats stats = web.getJobQueueStats();
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_BACKGROUND], 0u);
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_LIVE], 1u);
+    EXPECT_EQ(stats.coalesced[JOB_PRIORITY_LIVE], 1u);
+
+    // A less urgent caller joins without moving the job back down
+    web.getRequest(url("queue.test"), later.callback(), JOB_PRIORITY_BACKGROUND);
+    stats = web.getJobQueueStats();
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_LIVE], 1u);
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_BACKGROUND], 0u);
+    EXPECT_EQ(stats.coalesced[JOB_PRIORITY_BACKGROUND], 1u);
+}
+
+TEST_F(WebJobQueueTest, PostJoinsOnlyAnIdenticalQueuedPost) {
+    WebClientModule web;
+    Result a, b, c, d;
+    web.postRequest(url("queue.test"), "x=1", "application/x-www-form-urlencoded", a.callback());
+    web.postRequest(url("queue.test"), "x=1", "application/x-www-form-urlencoded", b.callback());
+    web.postRequest(url("queue.test"), "x=2", "application/x-www-form-urlencoded", c.callback());
+    // Same URL as GET is a different request
+    web.getRequest(url("queue.test"), d.callback());
+
+    JobQueueStats stats = web.getJobQueueStats();
+    EXPECT_EQ(stats.coalesced[JOB_PRIORITY_BACKGROUND], 1u);
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_BACKGROUND], 3u);
+}
+
+TEST_F(WebJobQueueTest, RejectsNewJobsBeyondTheQueueLimit) {
+    WebClientModule web;
+    std::vector<Result> results(WEBCLIENT_MAX_QUEUED_JOBS);
+    for (size_t i = 0; i < results.size(); i++) {
+        web.getRequest(url("queue.test", ("/" + std::to_string(i)).c_str()), results[i].callback());
+    }
+    Result rejected, joined;
+    web.getRequest(url("queue.test", "/full"), rejected.callback());
+    // Joining needs no queue slot
+    web.getRequest(url("queue.test", "/0"), joined.callback());
+
+    EXPECT_EQ(rejected.calls.load(), 1);  // answered right away, without data
+    EXPECT_TRUE(rejected.body.empty());
+    EXPECT_EQ(joined.calls.load(), 0);
+    JobQueueStats stats = web.getJobQueueStats();
+    EXPECT_EQ(stats.rejected_full, 1u);
+    EXPECT_EQ(stats.queued[JOB_PRIORITY_BACKGROUND], (uint32_t)WEBCLIENT_MAX_QUEUED_JOBS);
+    EXPECT_EQ(stats.coalesced[JOB_PRIORITY_BACKGROUND], 1u);
+}
+
+// --- Running jobs (workers and HostNet) ---
+
+TEST_F(WebJobQueueTest, GetJoinsTheRunningJob) {
+    WebClientModule& web = runningModule();
+    holdRequestsTo("running-get.test");
+
+    Result first, second;
+    web.getRequest(url("running-get.test"), first.callback());
+    ASSERT_TRUE(gate.waitForRequests(1));
+    web.getRequest(url("running-get.test"), second.callback());
+    gate.release();
+
+    ASSERT_TRUE(waitFor([&] { return first.calls == 1 && second.calls == 1; }));
+    EXPECT_EQ(first.body, "GET /data");
+    EXPECT_EQ(second.body, "GET /data");
+    EXPECT_EQ(HostNet::stats("running-get.test").requests, 1u);
+}
+
+TEST_F(WebJobQueueTest, PostIsSentAgainWhileAnIdenticalOneRuns) {
+    WebClientModule& web = runningModule();
+    holdRequestsTo("running-post.test");
+
+    // The first POST may already have had its effect on the server
+    Result first, second;
+    web.postRequest(url("running-post.test"), "on=1", "text/plain", first.callback());
+    ASSERT_TRUE(gate.waitForRequests(1));
+    web.postRequest(url("running-post.test"), "on=1", "text/plain", second.callback());
+    gate.release();
+
+    ASSERT_TRUE(waitFor([&] { return first.calls == 1 && second.calls == 1; }));
+    EXPECT_EQ(first.body, "POST /data on=1");
+    EXPECT_EQ(second.body, "POST /data on=1");
+    EXPECT_EQ(HostNet::stats("running-post.test").requests, 2u);
+}
+
+TEST_F(WebJobQueueTest, DeliveredJobIsNotJoined) {
+    WebClientModule& web = runningModule();
+
+    // Submitted from the first callback: the job still runs but has handed out its result
+    Result first, second;
+    web.getRequest(url("delivered.test"), [&](const char* data, size_t size) {
+        first.callback()(data, size);
+        web.getRequest(url("delivered.test"), second.callback());
+    });
+
+    ASSERT_TRUE(waitFor([&] { return first.calls == 1 && second.calls == 1; }));
+    EXPECT_EQ(second.body, "GET /data");
+    EXPECT_EQ(HostNet::stats("delivered.test").requests, 2u);
+}
+
+} // namespace
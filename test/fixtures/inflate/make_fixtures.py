@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+# Regenerates the InflateStream fixtures: a 64 KB Open-Meteo style forecast (larger than the 32 KB
+# deflate window) as gzip, zlib and raw deflate, plus a gzip member with every optional header field.
+import gzip
+import json
+import random
+import struct
+import zlib
+
+r = random.Random(43)
+hours = []
+for i in range(400):
+    hours.append({"time": "2026-10-%02dT%02d:00" % (1 + i // 24, i % 24), "temperature_2m": round(r.uniform(-5, 25), 1),
+                  "precipitation": round(max(0, r.gauss(0, 1.2)), 2), "weather_code": r.choice([0, 1, 2, 3, 45, 61, 63, 80, 95]),
+                  "wind_speed_10m": round(r.uniform(0, 40), 1), "id": "%08x" % r.getrandbits(32)})
+plain = json.dumps({"latitude": 50.94, "longitude": 6.96, "timezone": "Europe/Berlin", "hourly": hours}, indent=1).encode()
+open("forecast.json", "wb").write(plain)
+
+co = zlib.compressobj(9, zlib.DEFLATED, -15)
+raw = co.compress(plain) + co.flush()
+open("forecast.json.deflate", "wb").write(raw)
+open("forecast.json.zlib", "wb").write(zlib.compress(plain, 9))
+open("forecast.json.gz", "wb").write(gzip.compress(plain, 9, mtime=0))
+
+# FHCRC, FEXTRA, FNAME and FCOMMENT
+header = bytes([0x1F, 0x8B, 8, 0x02 | 0x04 | 0x08 | 0x10]) + struct.pack("<I", 0) + bytes([2, 3])
+extra = b"PC" + struct.pack("<H", 4) + b"test"
+header += struct.pack("<H", len(extra)) + extra + b"forecast.json\0" + b"captured from api.open-meteo.com\0"
+header += struct.pack("<H", zlib.crc32(header) & 0xFFFF)
+open("forecast.json.headers.gz", "wb").write(header + raw + struct.pack("<II", zlib.crc32(plain), len(plain)))
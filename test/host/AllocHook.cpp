@@ -0,0 +1,110 @@
+#include "AllocHook.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+
+// Replacements of the glibc malloc family: the program's definitions take precedence over the
+// C library's, the real work is forwarded to the __libc_* entry points. Counting has to stay
+// allocation-free and lock-free, it runs inside malloc.
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_frees{0};
+std::atomic<int64_t> g_current{0};
+std::atomic<int64_t> g_peak{0};
+
+inline void countAlloc(void* ptr) {
+    if (!ptr) return;
+    int64_t size = (int64_t)malloc_usable_size(ptr);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    int64_t now = g_current.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = g_peak.load(std::memory_order_relaxed);
+    while (now > peak && !g_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+inline void countFree(void* ptr) {
+    if (!ptr) return;
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+    g_current.fetch_sub((int64_t)malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+} // namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    countAlloc(ptr);
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    countAlloc(ptr);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (!ptr) return malloc(size);
+    if (size == 0) {
+        free(ptr);
+        return nullptr;
+    }
+    int64_t oldSize = (int64_t)malloc_usable_size(ptr);
+    void* result = __libc_realloc(ptr, size);
+    if (!result) return nullptr;
+    // A realloc counts as a new allocation, the old block as freed
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+    g_current.fetch_sub(oldSize, std::memory_order_relaxed);
+    countAlloc(result);
+    return result;
+}
+
+void free(void* ptr) {
+    countFree(ptr);
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    countAlloc(ptr);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    void* ptr = memalign(alignment, size);
+    if (!ptr) return ENOMEM;
+    *result = ptr;
+    return 0;
+}
+
+} // extern "C"
+
+AllocStats AllocHook::snapshot() {
+    AllocStats stats;
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    stats.frees = g_frees.load(std::memory_order_relaxed);
+    stats.currentBytes = g_current.load(std::memory_order_relaxed);
+    stats.peakBytes = g_peak.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocHook::resetPeak() {
+    g_peak.store(g_current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
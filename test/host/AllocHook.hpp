@@ -0,0 +1,51 @@
+#ifndef HOST_ALLOC_HOOK_HPP
+#define HOST_ALLOC_HOOK_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Heap counters of the process, maintained by the malloc family replacements in AllocHook.cpp.
+ *
+ * Every allocation path of the firmware ends in malloc (ps_malloc, heap_caps_malloc, operator new,
+ * std::allocator, PsramAllocator), so these counters cover all of them. Sizes are the usable sizes
+ * reported by the C library, which is what a block really occupies.
+ */
+struct AllocStats {
+    uint64_t allocations = 0;   ///< malloc/calloc/realloc/new calls that returned a block
+    uint64_t frees = 0;
+    int64_t currentBytes = 0;   ///< Bytes in use right now
+    int64_t peakBytes = 0;      ///< Highest currentBytes since the last resetPeak()
+};
+
+namespace AllocHook {
+
+AllocStats snapshot();
+
+/**
+ * @brief Start a new peak measurement at the current usage
+ */
+void resetPeak();
+
+} // namespace AllocHook
+
+/**
+ * @brief Measures the allocations of a code section (all threads).
+ *
+ * Construct before the section, read after it: allocations() and peakBytes() are relative to the start.
+ */
+class AllocScope {
+public:
+    AllocScope() {
+        AllocHook::resetPeak();
+        _start = AllocHook::snapshot();
+    }
+
+    uint64_t allocations() const { return AllocHook::snapshot().allocations - _start.allocations; }
+    int64_t peakBytes() const { return AllocHook::snapshot().peakBytes - _start.currentBytes; }
+    int64_t retainedBytes() const { return AllocHook::snapshot().currentBytes - _start.currentBytes; }
+
+private:
+    AllocStats _start;
+};
+
+#endif // HOST_ALLOC_HOOK_HPP
@@ -0,0 +1,360 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host (Linux) replacement for the Arduino-ESP32 core, just enough to build firmware
+// sources into tests and benchmarks. Behaviour follows the ESP32 core where the
+// firmware relies on it; see HostRuntime.hpp for the knobs tests can turn.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define FPSTR(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define IRAM_ATTR
+#define DEC 10
+#define HEX 16
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+class __FlashStringHelper;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// PSRAM allocations come from the normal heap (counted by the allocation hook like everything else)
+void* ps_malloc(size_t size);
+void* ps_calloc(size_t count, size_t size);
+void* ps_realloc(void* ptr, size_t size);
+
+long random(long maxValue);
+long random(long minValue, long maxValue);
+void randomSeed(unsigned long seed);
+
+using std::min;
+using std::max;
+
+template<class T, class L, class H>
+inline typename std::common_type<T, L, H>::type constrain(T value, L low, H high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+inline bool isDigit(int c) { return std::isdigit(c) != 0; }
+inline bool isAlpha(int c) { return std::isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return std::isalnum(c) != 0; }
+inline bool isSpace(int c) { return std::isspace(c) != 0; }
+
+/**
+ * @brief Arduino String on top of std::string.
+ */
+class String {
+public:
+    String() = default;
+    String(const char* s) : _s(s ? s : "") {}
+    String(const char* s, size_t len) : _s(s ? s : "", s ? len : 0) {}
+    String(const __FlashStringHelper* s) : _s(reinterpret_cast<const char*>(s)) {}
+    String(const std::string& s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    String(int v, unsigned char base = 10) : _s(toBase((long long)v, base)) {}
+    String(unsigned int v, unsigned char base = 10) : _s(toBase((unsigned long long)v, base)) {}
+    String(long v, unsigned char base = 10) : _s(toBase((long long)v, base)) {}
+    String(unsigned long v, unsigned char base = 10) : _s(toBase((unsigned long long)v, base)) {}
+    String(long long v, unsigned char base = 10) : _s(toBase(v, base)) {}
+    String(unsigned long long v, unsigned char base = 10) : _s(toBase(v, base)) {}
+    String(float v, unsigned int decimals = 2) : _s(fixed(v, decimals)) {}
+    String(double v, unsigned int decimals = 2) : _s(fixed(v, decimals)) {}
+
+    const char* c_str() const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+    void clear() { _s.clear(); }
+
+    bool concat(const String& s) { _s += s._s; return true; }
+    bool concat(const char* s) { if (s) _s += s; return true; }
+    bool concat(const char* s, unsigned int len) { if (s) _s.append(s, len); return true; }
+    bool concat(char c) { _s += c; return true; }
+    String& operator+=(const String& s) { _s += s._s; return *this; }
+    String& operator+=(const char* s) { if (s) _s += s; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+    String& operator+=(int v) { _s += std::to_string(v); return *this; }
+    String& operator+=(unsigned int v) { _s += std::to_string(v); return *this; }
+    String& operator+=(long v) { _s += std::to_string(v); return *this; }
+    String& operator+=(unsigned long v) { _s += std::to_string(v); return *this; }
+    String& operator+=(double v) { _s += fixed(v, 2); return *this; }
+
+    bool operator==(const String& o) const { return _s == o._s; }
+    bool operator==(const char* o) const { return _s == (o ? o : ""); }
+    bool operator!=(const String& o) const { return _s != o._s; }
+    bool operator!=(const char* o) const { return !(*this == o); }
+    bool operator<(const String& o) const { return _s < o._s; }
+    bool operator>(const String& o) const { return _s > o._s; }
+    int compareTo(const String& o) const { return _s.compare(o._s); }
+    bool equals(const String& o) const { return _s == o._s; }
+    bool equals(const char* o) const { return *this == o; }
+    bool equalsIgnoreCase(const String& o) const {
+        return _s.size() == o._s.size() && strncasecmp(_s.c_str(), o._s.c_str(), _s.size()) == 0;
+    }
+    bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+    bool startsWith(const String& prefix, unsigned int offset) const {
+        return offset <= _s.size() && _s.compare(offset, prefix._s.size(), prefix._s) == 0;
+    }
+    bool endsWith(const String& suffix) const {
+        return _s.size() >= suffix._s.size() && _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+    }
+
+    char charAt(unsigned int index) const { return index < _s.size() ? _s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < _s.size()) _s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return _s[index]; }
+
+    int indexOf(char c, unsigned int from = 0) const { return found(_s.find(c, from)); }
+    int indexOf(const String& s, unsigned int from = 0) const { return found(_s.find(s._s, from)); }
+    int indexOf(const char* s, unsigned int from = 0) const { return found(_s.find(s ? s : "", from)); }
+    int lastIndexOf(char c) const { return found(_s.rfind(c)); }
+    int lastIndexOf(char c, unsigned int from) const { return found(_s.rfind(c, from)); }
+    int lastIndexOf(const String& s) const { return found(_s.rfind(s._s)); }
+    int lastIndexOf(const String& s, unsigned int from) const { return found(_s.rfind(s._s, from)); }
+
+    String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= _s.size()) return String();
+        return String(_s.substr(from, std::min<size_t>(to, _s.size()) - from));
+    }
+
+    void replace(char find, char replaceWith) { std::replace(_s.begin(), _s.end(), find, replaceWith); }
+    void replace(const String& find, const String& replaceWith) {
+        if (find._s.empty()) return;
+        size_t pos = 0;
+        while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+            _s.replace(pos, find._s.size(), replaceWith._s);
+            pos += replaceWith._s.size();
+        }
+    }
+    void remove(unsigned int index) { if (index < _s.size()) _s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _s.size()) _s.erase(index, count); }
+    void toLowerCase() { for (char& c : _s) c = (char)std::tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : _s) c = (char)std::toupper((unsigned char)c); }
+    void trim() {
+        size_t start = 0;
+        while (start < _s.size() && std::isspace((unsigned char)_s[start])) start++;
+        size_t end = _s.size();
+        while (end > start && std::isspace((unsigned char)_s[end - 1])) end--;
+        _s = _s.substr(start, end - start);
+    }
+
+    long toInt() const { return std::strtol(_s.c_str(), nullptr, 10); }
+    float toFloat() const { return std::strtof(_s.c_str(), nullptr); }
+    double toDouble() const { return std::strtod(_s.c_str(), nullptr); }
+
+    void getBytes(unsigned char* buf, unsigned int size, unsigned int index = 0) const { copyOut((char*)buf, size, index); }
+    void toCharArray(char* buf, unsigned int size, unsigned int index = 0) const { copyOut(buf, size, index); }
+
+    const std::string& str() const { return _s; }
+
+private:
+    std::string _s;
+
+    static int found(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+    void copyOut(char* buf, unsigned int size, unsigned int index) const {
+        if (!buf || size == 0) return;
+        size_t n = index < _s.size() ? std::min<size_t>(size - 1, _s.size() - index) : 0;
+        if (n) memcpy(buf, _s.data() + index, n);
+        buf[n] = '\0';
+    }
+    template<class T>
+    static std::string toBase(T v, unsigned char base) {
+        if (base == 10) return std::to_string(v);
+        bool negative = v < 0;
+        unsigned long long u = negative ? (unsigned long long)(-(long long)v) : (unsigned long long)v;
+        std::string out;
+        do {
+            unsigned digit = (unsigned)(u % base);
+            out += (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            u /= base;
+        } while (u);
+        if (negative) out += '-';
+        std::reverse(out.begin(), out.end());
+        return out;
+    }
+    static std::string fixed(double v, unsigned int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        return buf;
+    }
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+inline bool operator==(const char* a, const String& b) { return b == a; }
+
+/**
+ * @brief Arduino Print with the overloads the firmware uses.
+ */
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (n < size && write(buffer[n])) n++;
+        return n;
+    }
+    size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() {}
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(unsigned int v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(unsigned long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(long long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(unsigned long long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+    size_t print(double v, int decimals = 2) { return print(String(v, (unsigned int)decimals)); }
+    template<class T>
+    size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template<class T>
+    size_t println(const T& v, int format) { size_t n = print(v, format); return n + println(); }
+    size_t println() { return write((const uint8_t*)"\n", 1); }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/**
+ * @brief Arduino Stream (blocking reads are not emulated, timeouts are ignored).
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+    size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[n++] = (char)c;
+        }
+        return n;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    String readString() {
+        String s;
+        int c;
+        while ((c = read()) >= 0) s += (char)c;
+        return s;
+    }
+    String readStringUntil(char terminator) {
+        String s;
+        int c;
+        while ((c = read()) >= 0 && c != terminator) s += (char)c;
+        return s;
+    }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+/**
+ * @brief Serial port: output goes to stdout (see HostRuntime::setSerialEnabled), no input.
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    operator bool() const { return true; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override;
+};
+
+extern HardwareSerial Serial;
+
+class IPAddress {
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr{a, b, c, d} {}
+    explicit IPAddress(uint32_t address) { memcpy(_addr, &address, 4); }
+    uint8_t operator[](int index) const { return _addr[index]; }
+    operator uint32_t() const { uint32_t v; memcpy(&v, _addr, 4); return v; }
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _addr[0], _addr[1], _addr[2], _addr[3]);
+        return String(buf);
+    }
+
+private:
+    uint8_t _addr[4] = {0, 0, 0, 0};
+};
+
+/**
+ * @brief The parts of the ESP object the firmware reads.
+ */
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getFreePsram();
+    uint32_t getPsramSize();
+    uint32_t getMinFreePsram();
+    uint32_t getMaxAllocPsram();
+    uint32_t getCpuFreqMHz() { return 240; }
+    const char* getSdkVersion() { return "host"; }
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
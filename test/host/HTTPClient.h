@@ -0,0 +1,94 @@
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+// HTTPClient of the ESP32 core on the fake network (HostNet). Error codes, header collection,
+// keep-alive (setReuse) and writeToStream() behave like the original.
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "HostNet.hpp"
+
+#include <string>
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+    HTTP_CODE_CONTINUE = 100,
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_CREATED = 201,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_PARTIAL_CONTENT = 206,
+    HTTP_CODE_MOVED_PERMANENTLY = 301,
+    HTTP_CODE_FOUND = 302,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_FORBIDDEN = 403,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_TOO_MANY_REQUESTS = 429,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_BAD_GATEWAY = 502,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503,
+    HTTP_CODE_GATEWAY_TIMEOUT = 504
+} t_http_codes;
+
+class HTTPClient {
+public:
+    HTTPClient() = default;
+    ~HTTPClient() { end(); }
+
+    bool begin(WiFiClient& client, const char* url);
+    bool begin(WiFiClient& client, const String& url) { return begin(client, url.c_str()); }
+    void end();
+
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setUserAgent(const String& userAgent) { _userAgent = userAgent.c_str(); }
+    void setAcceptEncoding(const String& acceptEncoding) { _acceptEncoding = acceptEncoding.c_str(); }
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void setConnectTimeout(int32_t) {}
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+
+    int GET();
+    int POST(const char* payload) { return sendRequest("POST", (const uint8_t*)payload, payload ? strlen(payload) : 0); }
+    int POST(const String& payload) { return POST(payload.c_str()); }
+    int POST(uint8_t* payload, size_t size) { return sendRequest("POST", payload, size); }
+    int sendRequest(const char* type, const uint8_t* payload = nullptr, size_t size = 0);
+
+    int getSize() { return _size; }
+    String getString();
+    int writeToStream(Stream* stream);
+    bool connected() { return _client && _client->connected(); }
+
+    static String errorToString(int error);
+
+private:
+    WiFiClient* _client = nullptr;
+    std::string _url;
+    HostNet::Request _request;
+    HostNet::Headers _requestHeaders;
+    std::string _userAgent = "ESP32HTTPClient";
+    std::string _acceptEncoding = "identity;q=1,chunked;q=0.1,*;q=0";
+    std::vector<std::string> _collect;
+    HostNet::Response _response;
+    bool _haveResponse = false;
+    bool _reuse = true;
+    bool _canReuse = false;
+    uint16_t _timeout = 5000;
+    int _size = -1;
+};
+
+#endif // HOST_HTTPCLIENT_H
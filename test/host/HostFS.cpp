@@ -0,0 +1,227 @@
+#include "FS.h"
+#include "LittleFS.h"
+#include "HostRuntime.hpp"
+
+#include <filesystem>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+fs::FS LittleFS("littlefs");
+
+namespace {
+
+std::mutex g_fsMutex;
+std::string g_root;
+size_t g_fsSize = 0x2A0000;
+
+// Removes the default root at exit, a root set by the test belongs to the test
+struct TempRoot {
+    std::string path;
+    ~TempRoot() {
+        std::error_code ec;
+        if (!path.empty()) stdfs::remove_all(path, ec);
+    }
+} g_tempRoot;
+
+} // namespace
+
+void HostRuntime::setFilesystemRoot(const std::string& path) {
+    std::lock_guard<std::mutex> lock(g_fsMutex);
+    g_root = path;
+    stdfs::create_directories(g_root);
+}
+
+const std::string& HostRuntime::filesystemRoot() {
+    std::lock_guard<std::mutex> lock(g_fsMutex);
+    if (g_root.empty()) {
+        g_root = (stdfs::temp_directory_path() / ("panelclock-host-" + std::to_string(getpid()))).string();
+        stdfs::remove_all(g_root);
+        stdfs::create_directories(g_root);
+        g_tempRoot.path = g_root;
+    }
+    return g_root;
+}
+
+void HostRuntime::setFilesystemSize(size_t bytes) { g_fsSize = bytes; }
+size_t HostRuntime::filesystemSize() { return g_fsSize; }
+
+namespace fs {
+
+class FileImpl {
+public:
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (file) fclose(file);
+        file = nullptr;
+    }
+
+    FILE* file = nullptr;
+    std::string path;       // Firmware path ("/dir/name")
+    std::string hostPath;
+    bool directory = false;
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+};
+
+size_t File::write(uint8_t c) { return write(&c, 1); }
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!_impl || !_impl->file) return 0;
+    return fwrite(buffer, 1, size, _impl->file);
+}
+
+int File::available() {
+    if (!_impl || !_impl->file) return 0;
+    return (int)(size() - position());
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    if (!_impl || !_impl->file) return -1;
+    int c = fgetc(_impl->file);
+    if (c != EOF) ungetc(c, _impl->file);
+    return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+    if (_impl && _impl->file) fflush(_impl->file);
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!_impl || !_impl->file) return 0;
+    return fread(buffer, 1, size, _impl->file);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_impl || !_impl->file) return false;
+    int whence = mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END);
+    return fseek(_impl->file, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!_impl || !_impl->file) return 0;
+    long pos = ftell(_impl->file);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!_impl) return 0;
+    if (_impl->file) fflush(_impl->file);
+    std::error_code ec;
+    auto bytes = stdfs::file_size(_impl->hostPath, ec);
+    return ec ? 0 : (size_t)bytes;
+}
+
+void File::close() {
+    if (_impl) _impl->close();
+    _impl.reset();
+}
+
+File::operator bool() const { return _impl && (_impl->file || _impl->directory); }
+
+const char* File::path() const { return _impl ? _impl->path.c_str() : ""; }
+
+const char* File::name() const {
+    if (!_impl) return "";
+    size_t slash = _impl->path.rfind('/');
+    return _impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const { return _impl && _impl->directory; }
+
+File File::openNextFile(const char* mode) {
+    if (!_impl || !_impl->directory || _impl->nextEntry >= _impl->entries.size()) return File();
+    std::string child = _impl->path;
+    if (child.empty() || child.back() != '/') child += '/';
+    child += _impl->entries[_impl->nextEntry++];
+    return LittleFS.open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+    if (_impl) _impl->nextEntry = 0;
+}
+
+bool FS::begin(bool, const char*, uint8_t, const char*) {
+    HostRuntime::filesystemRoot();
+    return true;
+}
+
+bool FS::format() {
+    const std::string& root = HostRuntime::filesystemRoot();
+    for (const auto& entry : stdfs::directory_iterator(root)) stdfs::remove_all(entry.path());
+    return true;
+}
+
+std::string FS::hostPath(const char* path) const {
+    std::string p = path ? path : "";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return HostRuntime::filesystemRoot() + p;
+}
+
+File FS::open(const char* path, const char* mode, bool) {
+    auto impl = std::make_shared<FileImpl>();
+    impl->path = path ? path : "/";
+    impl->hostPath = hostPath(path);
+    std::error_code ec;
+    if (stdfs::is_directory(impl->hostPath, ec)) {
+        impl->directory = true;
+        for (const auto& entry : stdfs::directory_iterator(impl->hostPath)) impl->entries.push_back(entry.path().filename().string());
+        std::sort(impl->entries.begin(), impl->entries.end());
+        return File(impl);
+    }
+    // LittleFS creates missing parent directories on write
+    std::string m = mode ? mode : "r";
+    if (m[0] != 'r') stdfs::create_directories(stdfs::path(impl->hostPath).parent_path(), ec);
+    std::string stdioMode = m + (m.find('b') == std::string::npos ? "b" : "");
+    impl->file = fopen(impl->hostPath.c_str(), stdioMode.c_str());
+    if (!impl->file) return File();
+    return File(impl);
+}
+
+bool FS::exists(const char* path) {
+    std::error_code ec;
+    return stdfs::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char* path) {
+    std::error_code ec;
+    return stdfs::is_regular_file(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+bool FS::rename(const char* from, const char* to) {
+    std::error_code ec;
+    stdfs::rename(hostPath(from), hostPath(to), ec);
+    return !ec;
+}
+
+bool FS::mkdir(const char* path) {
+    std::error_code ec;
+    stdfs::create_directories(hostPath(path), ec);
+    return !ec;
+}
+
+bool FS::rmdir(const char* path) {
+    std::error_code ec;
+    return stdfs::is_directory(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+size_t FS::totalBytes() { return HostRuntime::filesystemSize(); }
+
+size_t FS::usedBytes() {
+    size_t used = 0;
+    std::error_code ec;
+    for (const auto& entry : stdfs::recursive_directory_iterator(HostRuntime::filesystemRoot(), ec)) {
+        if (entry.is_regular_file(ec)) used += (size_t)entry.file_size(ec);
+    }
+    return used;
+}
+
+} // namespace fs
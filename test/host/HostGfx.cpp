@@ -0,0 +1,173 @@
+#include "Adafruit_GFX.h"
+#include "U8g2_for_Adafruit_GFX.h"
+
+#include <cstdlib>
+
+// --- Fonts: glyph width, ascent, descent ---
+
+const uint8_t u8g2_font_4x6_tf[] = { 4, 5, 1 };
+const uint8_t u8g2_font_5x8_tf[] = { 5, 6, 2 };
+const uint8_t u8g2_font_6x10_tf[] = { 6, 7, 2 };
+const uint8_t u8g2_font_6x13_me[] = { 6, 9, 2 };
+const uint8_t u8g2_font_6x13_tf[] = { 6, 9, 2 };
+const uint8_t u8g2_font_7x13_tr[] = { 7, 9, 2 };
+const uint8_t u8g2_font_7x14B_tf[] = { 7, 10, 3 };
+const uint8_t u8g2_font_7x14_tf[] = { 7, 10, 3 };
+const uint8_t u8g2_font_9x15_tf[] = { 9, 10, 3 };
+const uint8_t u8g2_font_fub20_tf[] = { 14, 20, 5 };
+const uint8_t u8g2_font_helvB08_tr[] = { 6, 8, 2 };
+const uint8_t u8g2_font_helvB10_tr[] = { 7, 10, 3 };
+const uint8_t u8g2_font_helvB12_tf[] = { 8, 12, 3 };
+const uint8_t u8g2_font_helvB14_tf[] = { 10, 14, 3 };
+const uint8_t u8g2_font_helvR08_tr[] = { 5, 8, 2 };
+const uint8_t u8g2_font_logisoso16_tf[] = { 9, 16, 0 };
+const uint8_t u8g2_font_logisoso18_tn[] = { 10, 18, 0 };
+const uint8_t u8g2_font_profont10_tf[] = { 5, 7, 2 };
+const uint8_t u8g2_font_profont12_tf[] = { 6, 9, 2 };
+const uint8_t u8g2_font_profont15_tf[] = { 7, 11, 3 };
+
+// --- Adafruit_GFX ---
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++) {
+        for (int16_t i = x; i < x + w; i++) drawPixel(i, j, color);
+    }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+    for (;;) {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int16_t y = -r; y <= r; y++) {
+        for (int16_t x = -r; x <= r; x++) {
+            int16_t d = x * x + y * y;
+            if (d <= r * r && d > (r - 1) * (r - 1)) drawPixel(x0 + x, y0 + y, color);
+        }
+    }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int16_t y = -r; y <= r; y++) {
+        for (int16_t x = -r; x <= r; x++) {
+            if (x * x + y * y <= r * r) drawPixel(x0 + x, y0 + y, color);
+        }
+    }
+}
+
+void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    // Outline only, layout code does not depend on the fill
+    drawTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t h) {
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) drawPixel(x + i, y + j, bitmap[j * w + i]);
+    }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7))) drawPixel(x + i, y + j, color);
+        }
+    }
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    size_t n = str ? strlen(str) : 0;
+    if (x1) *x1 = x;
+    if (y1) *y1 = y;
+    if (w) *w = (uint16_t)(n * 6 * _textSize);
+    if (h) *h = (uint16_t)(8 * _textSize);
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        _cursorX = 0;
+        _cursorY += 8 * _textSize;
+    } else if (c != '\r') {
+        _cursorX += 6 * _textSize;
+    }
+    return 1;
+}
+
+// --- GFXcanvas16 ---
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    _buffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+GFXcanvas16::~GFXcanvas16() { free(_buffer); }
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (!_buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    _buffer[y * _width + x] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+    if (!_buffer) return;
+    for (size_t i = 0; i < (size_t)_width * _height; i++) _buffer[i] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+    if (!_buffer || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return _buffer[y * _width + x];
+}
+
+// --- U8G2_FOR_ADAFRUIT_GFX ---
+
+int16_t U8G2_FOR_ADAFRUIT_GFX::getUTF8Width(const char* str) const {
+    if (!str) return 0;
+    int16_t glyphs = 0;
+    // Continuation bytes of multi-byte sequences do not start a glyph
+    for (const char* p = str; *p; p++) {
+        if (((uint8_t)*p & 0xC0) != 0x80) glyphs++;
+    }
+    return glyphs * glyphWidth();
+}
+
+int16_t U8G2_FOR_ADAFRUIT_GFX::drawUTF8(int16_t x, int16_t y, const char* str) {
+    int16_t width = getUTF8Width(str);
+    _cursorX = x + width;
+    _cursorY = y;
+    return width;
+}
+
+int16_t U8G2_FOR_ADAFRUIT_GFX::drawGlyph(int16_t x, int16_t y, uint16_t) {
+    _cursorX = x + glyphWidth();
+    _cursorY = y;
+    return glyphWidth();
+}
+
+size_t U8G2_FOR_ADAFRUIT_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        _cursorX = 0;
+    } else if ((c & 0xC0) != 0x80) {
+        _cursorX += glyphWidth();
+    }
+    return 1;
+}
@@ -0,0 +1,152 @@
+#include "rom/miniz.h"
+
+#include <zlib.h>
+#include <cstring>
+
+static_assert(sizeof(z_stream) <= sizeof(((tinfl_decompressor*)nullptr)->m_stream), "z_stream does not fit");
+static_assert(sizeof(z_stream) <= sizeof(((tdefl_compressor*)nullptr)->m_stream), "z_stream does not fit");
+
+namespace {
+
+struct Arena {
+    unsigned char* base;
+    size_t size;
+    size_t* used;
+};
+
+// zlib allocates its state and window once per stream; a bump allocator is enough
+voidpf arenaAlloc(voidpf opaque, uInt items, uInt size) {
+    Arena* arena = (Arena*)opaque;
+    size_t bytes = ((size_t)items * size + 15) & ~(size_t)15;
+    if (*arena->used + bytes > arena->size) return Z_NULL;
+    void* p = arena->base + *arena->used;
+    *arena->used += bytes;
+    return p;
+}
+
+void arenaFree(voidpf, voidpf) {}
+
+// The Arena descriptor lives at the start of the arena itself
+z_stream* setupStream(unsigned char* streamMem, unsigned char* arenaMem, size_t arenaSize, size_t* used) {
+    Arena* arena = (Arena*)arenaMem;
+    arena->base = arenaMem;
+    arena->size = arenaSize;
+    arena->used = used;
+    *used = (sizeof(Arena) + 15) & ~(size_t)15;
+    z_stream* stream = (z_stream*)streamMem;
+    memset(stream, 0, sizeof(z_stream));
+    stream->zalloc = arenaAlloc;
+    stream->zfree = arenaFree;
+    stream->opaque = arena;
+    return stream;
+}
+
+} // namespace
+
+mz_ulong mz_adler32(mz_ulong adler, const unsigned char* ptr, size_t buf_len) {
+    if (!ptr) return MZ_ADLER32_INIT;
+    return adler32_z(adler, ptr, buf_len);
+}
+
+mz_ulong mz_crc32(mz_ulong crc, const unsigned char* ptr, size_t buf_len) {
+    if (!ptr) return MZ_CRC32_INIT;
+    return crc32_z(crc, ptr, buf_len);
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size, mz_uint8* pOut_buf_start,
+                              mz_uint8* pOut_buf_next, size_t* pOut_buf_size, const mz_uint32 decomp_flags) {
+    (void)pOut_buf_start;
+    z_stream* stream = (z_stream*)r->m_stream;
+    if (r->m_state == 0) {
+        stream = setupStream(r->m_stream, r->m_arena, sizeof(r->m_arena), &r->m_arenaUsed);
+        int windowBits = (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? 15 : -15;
+        if (inflateInit2(stream, windowBits) != Z_OK) {
+            *pIn_buf_size = *pOut_buf_size = 0;
+            return TINFL_STATUS_BAD_PARAM;
+        }
+        r->m_state = 1;
+    }
+    if (r->m_state == 2) {
+        *pIn_buf_size = *pOut_buf_size = 0;
+        return TINFL_STATUS_DONE;
+    }
+
+    size_t inSize = *pIn_buf_size;
+    size_t outSize = *pOut_buf_size;
+    stream->next_in = (Bytef*)pIn_buf_next;
+    stream->avail_in = (uInt)inSize;
+    stream->next_out = pOut_buf_next;
+    stream->avail_out = (uInt)outSize;
+    int rc = inflate(stream, Z_NO_FLUSH);
+    *pIn_buf_size = inSize - stream->avail_in;
+    *pOut_buf_size = outSize - stream->avail_out;
+
+    if (rc == Z_STREAM_END) {
+        r->m_state = 2;
+        inflateEnd(stream);
+        return TINFL_STATUS_DONE;
+    }
+    if (rc == Z_DATA_ERROR) {
+        bool checksum = stream->msg && strcmp(stream->msg, "incorrect data check") == 0;
+        inflateEnd(stream);
+        r->m_state = 2;
+        return checksum ? TINFL_STATUS_ADLER32_MISMATCH : TINFL_STATUS_FAILED;
+    }
+    if (rc != Z_OK && rc != Z_BUF_ERROR) {
+        inflateEnd(stream);
+        r->m_state = 2;
+        return TINFL_STATUS_FAILED;
+    }
+    if (stream->avail_out == 0) return TINFL_STATUS_HAS_MORE_OUTPUT;
+    if (stream->avail_in == 0) {
+        return (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) ? TINFL_STATUS_NEEDS_MORE_INPUT : TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+    }
+    return TINFL_STATUS_FAILED;
+}
+
+tdefl_status tdefl_init(tdefl_compressor* d, tdefl_put_buf_func_ptr pPut_buf_func, void* pPut_buf_user, int flags) {
+    d->m_pPut_buf_func = pPut_buf_func;
+    d->m_pPut_buf_user = pPut_buf_user;
+    d->m_flags = (mz_uint)flags;
+    d->m_finished = 0;
+    z_stream* stream = setupStream(d->m_stream, d->m_arena, sizeof(d->m_arena), &d->m_arenaUsed);
+    // Probe count to zlib level: the ROM compressor's speed/ratio trade-off, roughly
+    int probes = flags & TDEFL_MAX_PROBES_MASK;
+    int level = probes == 0 ? 1 : (probes <= 16 ? 1 : (probes <= TDEFL_DEFAULT_MAX_PROBES ? 6 : 9));
+    int strategy = probes == 0 ? Z_HUFFMAN_ONLY : Z_DEFAULT_STRATEGY;
+    int windowBits = (flags & TDEFL_WRITE_ZLIB_HEADER) ? 15 : -15;
+    if (deflateInit2(stream, level, Z_DEFLATED, windowBits, 8, strategy) != Z_OK) return TDEFL_STATUS_BAD_PARAM;
+    return TDEFL_STATUS_OKAY;
+}
+
+tdefl_status tdefl_compress_buffer(tdefl_compressor* d, const void* pIn_buf, size_t in_buf_size, tdefl_flush flush) {
+    if (d->m_finished) return TDEFL_STATUS_BAD_PARAM;
+    z_stream* stream = (z_stream*)d->m_stream;
+    stream->next_in = (Bytef*)pIn_buf;
+    stream->avail_in = (uInt)in_buf_size;
+    int zflush = flush == TDEFL_FINISH ? Z_FINISH : (flush == TDEFL_NO_FLUSH ? Z_NO_FLUSH : (flush == TDEFL_FULL_FLUSH ? Z_FULL_FLUSH : Z_SYNC_FLUSH));
+    unsigned char out[4096];
+    for (;;) {
+        stream->next_out = out;
+        stream->avail_out = sizeof(out);
+        int rc = deflate(stream, zflush);
+        size_t produced = sizeof(out) - stream->avail_out;
+        if (produced > 0 && !d->m_pPut_buf_func(out, (int)produced, d->m_pPut_buf_user)) {
+            deflateEnd(stream);
+            d->m_finished = 1;
+            return TDEFL_STATUS_PUT_BUF_FAILED;
+        }
+        if (rc == Z_STREAM_END) {
+            deflateEnd(stream);
+            d->m_finished = 1;
+            return TDEFL_STATUS_DONE;
+        }
+        if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            deflateEnd(stream);
+            d->m_finished = 1;
+            return TDEFL_STATUS_BAD_PARAM;
+        }
+        // All input taken and nothing left in zlib's buffers for this flush mode
+        if (stream->avail_in == 0 && stream->avail_out != 0) return TDEFL_STATUS_OKAY;
+    }
+}
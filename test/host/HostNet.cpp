@@ -0,0 +1,314 @@
+#include "HostNet.hpp"
+#include "HTTPClient.h"
+#include "WiFi.h"
+#include "WiFiClientSecure.h"
+
+#include <map>
+#include <mutex>
+#include <strings.h>
+
+WiFiClass WiFi;
+
+namespace {
+
+std::mutex g_netMutex;
+HostNet::Handler g_handler;
+std::map<std::string, HostNet::HostBehaviour> g_behaviours;
+std::map<std::string, HostNet::Stats> g_stats;
+bool g_wifiConnected = true;
+
+HostNet::Handler currentHandler() {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    return g_handler;
+}
+
+bool headerIs(const std::string& name, const char* other) { return strcasecmp(name.c_str(), other) == 0; }
+
+} // namespace
+
+// --- HostNet ---
+
+std::string HostNet::Request::header(const char* name) const {
+    for (const auto& h : headers) {
+        if (headerIs(h.first, name)) return h.second;
+    }
+    return std::string();
+}
+
+void HostNet::setHandler(Handler handler) {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_handler = std::move(handler);
+}
+
+void HostNet::setHostBehaviour(const std::string& host, const HostBehaviour& behaviour) {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_behaviours[host] = behaviour;
+}
+
+HostNet::HostBehaviour HostNet::hostBehaviour(const std::string& host) {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    auto it = g_behaviours.find(host);
+    return it == g_behaviours.end() ? HostBehaviour() : it->second;
+}
+
+void HostNet::setWifiConnected(bool connected) {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_wifiConnected = connected;
+}
+
+bool HostNet::wifiConnected() {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    return g_wifiConnected;
+}
+
+HostNet::Stats HostNet::stats(const std::string& host) {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    auto it = g_stats.find(host);
+    return it == g_stats.end() ? Stats() : it->second;
+}
+
+void HostNet::reset() {
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_handler = nullptr;
+    g_behaviours.clear();
+    g_stats.clear();
+    g_wifiConnected = true;
+}
+
+bool HostNet::lookup(const std::string& host) {
+    HostBehaviour behaviour = hostBehaviour(host);
+    delay(behaviour.dnsMs);
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_stats[host].lookups++;
+    return g_wifiConnected && !behaviour.dnsFails;
+}
+
+bool HostNet::connect(const std::string& host, bool https) {
+    HostBehaviour behaviour = hostBehaviour(host);
+    if (!wifiConnected() || behaviour.dnsFails) return false;
+    delay(behaviour.connectMs);
+    if (behaviour.refuses) return false;
+    if (https) delay(behaviour.tlsMs);
+    std::lock_guard<std::mutex> lock(g_netMutex);
+    g_stats[host].connects++;
+    return true;
+}
+
+bool HostNet::exchange(const Request& request, Response& response) {
+    Handler handler = currentHandler();
+    {
+        std::lock_guard<std::mutex> lock(g_netMutex);
+        g_stats[request.host].requests++;
+    }
+    if (!handler) {
+        response = Response();
+        response.status = 404;
+        return true;
+    }
+    response = handler(request);
+    return true;
+}
+
+// --- WiFi ---
+
+wl_status_t WiFiClass::status() { return HostNet::wifiConnected() ? WL_CONNECTED : WL_DISCONNECTED; }
+
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+    if (!HostNet::lookup(host ? host : "")) return 0;
+    result = IPAddress(10, 0, 0, 1);
+    return 1;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+    if (!HostNet::connect(host ? host : "", false)) return 0;
+    _host = host;
+    _port = port;
+    _open = true;
+    touch();
+    return 1;
+}
+
+uint8_t WiFiClient::connected() {
+    if (!_open) return 0;
+    // The server closed the idle connection meanwhile
+    if (millis() - _lastActivityMs >= HostNet::hostBehaviour(_host).keepAliveMs || !HostNet::wifiConnected()) _open = false;
+    return _open ? 1 : 0;
+}
+
+void WiFiClient::stop() { _open = false; }
+
+void WiFiClient::touch() { _lastActivityMs = millis(); }
+
+int WiFiClientSecure::connect(const char* host, uint16_t port) {
+    stop();
+    _lastError = 0;
+    if (!HostNet::connect(host ? host : "", true)) {
+        _lastError = -1;
+        return 0;
+    }
+    _host = host;
+    _port = port;
+    _open = true;
+    touch();
+    return 1;
+}
+
+int WiFiClientSecure::lastError(char* buffer, const size_t size) {
+    if (buffer && size > 0) snprintf(buffer, size, _lastError ? "TLS-Verbindung zu %s fehlgeschlagen" : "", _host.c_str());
+    return _lastError;
+}
+
+// --- HTTPClient ---
+
+bool HTTPClient::begin(WiFiClient& client, const char* url) {
+    if (!url) return false;
+    std::string u = url;
+    size_t scheme = u.find("://");
+    if (scheme == std::string::npos) return false;
+    HostNet::Request request;
+    request.https = u.compare(0, scheme, "https") == 0;
+    if (!request.https && u.compare(0, scheme, "http") != 0) return false;
+    size_t hostStart = scheme + 3;
+    size_t pathStart = u.find('/', hostStart);
+    std::string authority = u.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    request.path = pathStart == std::string::npos ? "/" : u.substr(pathStart);
+    size_t colon = authority.find(':');
+    request.host = authority.substr(0, colon);
+    request.port = colon == std::string::npos ? (request.https ? 443 : 80) : (uint16_t)atoi(authority.c_str() + colon + 1);
+    request.url = u;
+    _client = &client;
+    _url = u;
+    _request = request;
+    return true;
+}
+
+void HTTPClient::end() {
+    if (_client && _haveResponse && !(_reuse && _canReuse)) _client->stop();
+    _requestHeaders.clear();
+    _response = HostNet::Response();
+    _haveResponse = false;
+    _canReuse = false;
+    _size = -1;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value, bool first, bool replace) {
+    // The core sets these itself
+    if (name.equalsIgnoreCase("Connection") || name.equalsIgnoreCase("User-Agent") || name.equalsIgnoreCase("Host")) return;
+    if (replace) {
+        for (auto& h : _requestHeaders) {
+            if (headerIs(h.first, name.c_str())) {
+                h.second = value.c_str();
+                return;
+            }
+        }
+    }
+    if (first) {
+        _requestHeaders.insert(_requestHeaders.begin(), std::make_pair(std::string(name.c_str()), std::string(value.c_str())));
+    } else {
+        _requestHeaders.emplace_back(name.c_str(), value.c_str());
+    }
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _collect.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) _collect.push_back(headerKeys[i]);
+}
+
+String HTTPClient::header(const char* name) {
+    bool collected = false;
+    for (const auto& key : _collect) collected = collected || headerIs(key, name);
+    if (!collected || !_haveResponse) return String();
+    for (const auto& h : _response.headers) {
+        if (headerIs(h.first, name)) return String(h.second.c_str());
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) { return header(name).length() > 0; }
+
+int HTTPClient::GET() { return sendRequest("GET"); }
+
+int HTTPClient::sendRequest(const char* type, const uint8_t* payload, size_t size) {
+    if (!_client) return HTTPC_ERROR_NOT_CONNECTED;
+    _response = HostNet::Response();
+    _haveResponse = false;
+    if (!_client->connected() && !_client->connect(_request.host.c_str(), _request.port)) return HTTPC_ERROR_CONNECTION_REFUSED;
+
+    HostNet::Request request = _request;
+    request.method = type;
+    request.headers.emplace_back("Host", request.host);
+    request.headers.emplace_back("User-Agent", _userAgent);
+    request.headers.emplace_back("Connection", _reuse ? "keep-alive" : "close");
+    if (!_acceptEncoding.empty()) request.headers.emplace_back("Accept-Encoding", _acceptEncoding);
+    for (const auto& h : _requestHeaders) request.headers.push_back(h);
+    if (payload && size) request.body.assign((const char*)payload, size);
+
+    HostNet::Response response;
+    HostNet::exchange(request, response);
+    if (response.ttfbMs > _timeout) {
+        delay(_timeout);
+        _client->stop();
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+    delay(response.ttfbMs);
+    if (response.status <= 0) {
+        _client->stop();
+        return HTTPC_ERROR_CONNECTION_LOST;
+    }
+    _client->touch();
+    _response = std::move(response);
+    _haveResponse = true;
+    _canReuse = !_response.close && _reuse;
+    _size = _response.chunked ? -1 : (int)_response.body.size();
+    return _response.status;
+}
+
+String HTTPClient::getString() {
+    if (!_haveResponse) return String();
+    std::string body = _response.body.substr(0, std::min(_response.body.size(), _response.truncateAt));
+    return String(body);
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+    if (!stream) return HTTPC_ERROR_NO_STREAM;
+    if (!_client || !_haveResponse || !_client->connected()) return HTTPC_ERROR_NOT_CONNECTED;
+    const std::string& body = _response.body;
+    size_t available = std::min(body.size(), _response.truncateAt);
+    // The body arrives in a few bursts spread over bodyMs
+    const size_t steps = 4;
+    size_t chunk = std::max<size_t>(1436, (available + steps - 1) / steps);
+    size_t written = 0;
+    while (written < available) {
+        size_t n = std::min(chunk, available - written);
+        delay(_response.bodyMs / steps);
+        if (stream->write((const uint8_t*)body.data() + written, n) != n) {
+            _client->stop();
+            return HTTPC_ERROR_STREAM_WRITE;
+        }
+        written += n;
+        _client->touch();
+    }
+    if (available < body.size()) {
+        _client->stop();
+        return HTTPC_ERROR_CONNECTION_LOST;
+    }
+    return (int)written;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED: return F("connection refused");
+        case HTTPC_ERROR_SEND_HEADER_FAILED: return F("send header failed");
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return F("send payload failed");
+        case HTTPC_ERROR_NOT_CONNECTED: return F("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST: return F("connection lost");
+        case HTTPC_ERROR_NO_STREAM: return F("no stream");
+        case HTTPC_ERROR_NO_HTTP_SERVER: return F("no HTTP server");
+        case HTTPC_ERROR_TOO_LESS_RAM: return F("too less ram");
+        case HTTPC_ERROR_ENCODING: return F("Transfer-Encoding not supported");
+        case HTTPC_ERROR_STREAM_WRITE: return F("Stream write error");
+        case HTTPC_ERROR_READ_TIMEOUT: return F("read Timeout");
+        default: return String();
+    }
+}
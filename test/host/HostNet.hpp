@@ -0,0 +1,83 @@
+#ifndef HOST_NET_HPP
+#define HOST_NET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fake network behind the WiFi/WiFiClient/HTTPClient shims.
+ *
+ * Requests go to one handler the test installs; latencies are spent with delay(), so they
+ * follow HostRuntime::setClockScale() like the firmware's own timing.
+ */
+namespace HostNet {
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+struct Request {
+    std::string method;
+    std::string url;
+    std::string host;
+    uint16_t port = 80;
+    bool https = false;
+    std::string path;       ///< Path and query
+    Headers headers;
+    std::string body;
+
+    /**
+     * @brief Value of a request header (case-insensitive name), empty if absent
+     */
+    std::string header(const char* name) const;
+};
+
+struct Response {
+    int status = 200;
+    std::string body;
+    Headers headers;          ///< Content-Length is added by the client shim
+    uint32_t ttfbMs = 0;      ///< Request sent until response headers
+    uint32_t bodyMs = 0;      ///< Spread over the body transfer
+    bool chunked = false;     ///< No Content-Length (getSize() returns -1)
+    bool close = false;       ///< Server closes the connection after this response
+    size_t truncateAt = (size_t)-1;  ///< Connection drops after this many body bytes
+};
+
+typedef std::function<Response(const Request& request)> Handler;
+
+/**
+ * @brief Connection level behaviour of one host
+ */
+struct HostBehaviour {
+    uint32_t dnsMs = 5;
+    uint32_t connectMs = 20;
+    uint32_t tlsMs = 250;          ///< Handshake on top of connectMs for https
+    uint32_t keepAliveMs = 60000;  ///< Server closes idle connections after this time
+    bool dnsFails = false;
+    bool refuses = false;
+};
+
+struct Stats {
+    uint32_t lookups = 0;
+    uint32_t connects = 0;   ///< Successful TCP connects (https: with handshake)
+    uint32_t requests = 0;
+};
+
+void setHandler(Handler handler);
+void setHostBehaviour(const std::string& host, const HostBehaviour& behaviour);
+HostBehaviour hostBehaviour(const std::string& host);
+void setWifiConnected(bool connected);
+bool wifiConnected();
+Stats stats(const std::string& host);
+void reset();
+
+// Used by the shims
+bool lookup(const std::string& host);
+bool connect(const std::string& host, bool https);
+bool exchange(const Request& request, Response& response);
+
+} // namespace HostNet
+
+#endif // HOST_NET_HPP
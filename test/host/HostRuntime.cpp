@@ -0,0 +1,175 @@
+#include "HostRuntime.hpp"
+#include "AllocHook.hpp"
+#include "Arduino.h"
+#include "esp_heap_caps.h"
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// --- Clock ---
+
+namespace {
+
+std::mutex g_clockMutex;
+std::chrono::steady_clock::time_point g_clockBase = std::chrono::steady_clock::now();
+double g_clockBaseMs = 0;
+double g_clockScale = 1.0;
+
+double simulatedNowMs() {
+    std::lock_guard<std::mutex> lock(g_clockMutex);
+    std::chrono::duration<double, std::milli> real = std::chrono::steady_clock::now() - g_clockBase;
+    return g_clockBaseMs + real.count() * g_clockScale;
+}
+
+bool g_serialEnabled = true;
+
+std::mutex g_randomMutex;
+std::mt19937 g_random(1);
+
+size_t g_internalHeapBytes = 320 * 1024;
+size_t g_psramBytes = 8 * 1024 * 1024;
+
+size_t psramFreeBytes() {
+    int64_t used = AllocHook::snapshot().currentBytes;
+    return used >= (int64_t)g_psramBytes ? 0 : g_psramBytes - (size_t)used;
+}
+
+} // namespace
+
+void HostRuntime::setClockScale(double simulatedMsPerRealMs) {
+    double now = simulatedNowMs();
+    std::lock_guard<std::mutex> lock(g_clockMutex);
+    g_clockBaseMs = now;
+    g_clockBase = std::chrono::steady_clock::now();
+    g_clockScale = simulatedMsPerRealMs > 0 ? simulatedMsPerRealMs : 1.0;
+}
+
+double HostRuntime::clockScale() {
+    std::lock_guard<std::mutex> lock(g_clockMutex);
+    return g_clockScale;
+}
+
+uint64_t HostRuntime::realMicros(uint64_t simulatedMs) {
+    return (uint64_t)((double)simulatedMs * 1000.0 / clockScale());
+}
+
+void HostRuntime::setSerialEnabled(bool enabled) { g_serialEnabled = enabled; }
+
+void HostRuntime::seedRandom(uint32_t seed) {
+    std::lock_guard<std::mutex> lock(g_randomMutex);
+    g_random.seed(seed);
+}
+
+void HostRuntime::setHeapSizes(size_t internalBytes, size_t psramBytes) {
+    g_internalHeapBytes = internalBytes;
+    g_psramBytes = psramBytes;
+}
+
+unsigned long millis() { return (unsigned long)simulatedNowMs(); }
+unsigned long micros() { return (unsigned long)(simulatedNowMs() * 1000.0); }
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::microseconds(HostRuntime::realMicros(ms)));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds((uint64_t)(us / HostRuntime::clockScale())));
+}
+
+void yield() { std::this_thread::yield(); }
+
+// --- Memory ---
+
+void* ps_malloc(size_t size) { return malloc(size); }
+void* ps_calloc(size_t count, size_t size) { return calloc(count, size); }
+void* ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+
+void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+void* heap_caps_calloc(size_t count, size_t size, uint32_t) { return calloc(count, size); }
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t) { return realloc(ptr, size); }
+void heap_caps_free(void* ptr) { free(ptr); }
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? g_psramBytes : g_internalHeapBytes;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? psramFreeBytes() : g_internalHeapBytes;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) { return heap_caps_get_free_size(caps); }
+size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) {
+    if (!info) return;
+    AllocStats stats = AllocHook::snapshot();
+    info->total_free_bytes = heap_caps_get_free_size(caps);
+    info->total_allocated_bytes = (size_t)stats.currentBytes;
+    info->largest_free_block = info->total_free_bytes;
+    info->minimum_free_bytes = info->total_free_bytes;
+    info->allocated_blocks = (size_t)(stats.allocations - stats.frees);
+    info->free_blocks = 1;
+    info->total_blocks = info->allocated_blocks + 1;
+}
+
+bool heap_caps_check_integrity_all(bool) { return true; }
+
+uint32_t EspClass::getFreeHeap() { return (uint32_t)g_internalHeapBytes; }
+uint32_t EspClass::getHeapSize() { return (uint32_t)g_internalHeapBytes; }
+uint32_t EspClass::getMinFreeHeap() { return (uint32_t)g_internalHeapBytes; }
+uint32_t EspClass::getMaxAllocHeap() { return (uint32_t)g_internalHeapBytes; }
+uint32_t EspClass::getFreePsram() { return (uint32_t)psramFreeBytes(); }
+uint32_t EspClass::getPsramSize() { return (uint32_t)g_psramBytes; }
+uint32_t EspClass::getMinFreePsram() { return (uint32_t)psramFreeBytes(); }
+uint32_t EspClass::getMaxAllocPsram() { return (uint32_t)psramFreeBytes(); }
+void EspClass::restart() { esp_restart(); }
+
+uint32_t esp_get_free_heap_size() { return (uint32_t)g_internalHeapBytes; }
+
+void esp_restart() {
+    fprintf(stderr, "[host] esp_restart() called\n");
+    abort();
+}
+
+// --- Random ---
+
+uint32_t esp_random() {
+    std::lock_guard<std::mutex> lock(g_randomMutex);
+    return (uint32_t)g_random();
+}
+
+long random(long maxValue) { return maxValue > 0 ? (long)(esp_random() % (uint32_t)maxValue) : 0; }
+long random(long minValue, long maxValue) { return maxValue > minValue ? minValue + random(maxValue - minValue) : minValue; }
+void randomSeed(unsigned long seed) { HostRuntime::seedRandom((uint32_t)seed); }
+
+// --- Print / Serial ---
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(stackBuffer)) return write((const uint8_t*)stackBuffer, (size_t)len);
+
+    std::string buffer((size_t)len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&buffer[0], buffer.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)buffer.data(), (size_t)len);
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (g_serialEnabled) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+void HardwareSerial::flush() { fflush(stdout); }
@@ -0,0 +1,55 @@
+#ifndef HOST_RUNTIME_HPP
+#define HOST_RUNTIME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Knobs of the host runtime behind the Arduino/FreeRTOS/ESP-IDF shims.
+ */
+namespace HostRuntime {
+
+/**
+ * @brief Let millis() run faster than real time (simulations). Sleeps, delays and FreeRTOS
+ *        timeouts shrink by the same factor, so firmware timing logic sees consistent time.
+ * @param simulatedMsPerRealMs 1.0 = real time
+ */
+void setClockScale(double simulatedMsPerRealMs);
+double clockScale();
+
+/**
+ * @brief Convert a duration in firmware milliseconds into real microseconds to sleep
+ */
+uint64_t realMicros(uint64_t simulatedMs);
+
+/**
+ * @brief Serial output to stdout on/off (benchmarks turn the firmware logs off)
+ */
+void setSerialEnabled(bool enabled);
+
+/**
+ * @brief Seed esp_random()/random() for reproducible runs
+ */
+void seedRandom(uint32_t seed);
+
+/**
+ * @brief Heap sizes reported by heap_caps_* and ESP (defaults: 320 KB internal, 8 MB PSRAM)
+ */
+void setHeapSizes(size_t internalBytes, size_t psramBytes);
+
+/**
+ * @brief Host directory that backs LittleFS (default: a fresh directory below the system temp dir)
+ */
+void setFilesystemRoot(const std::string& path);
+const std::string& filesystemRoot();
+
+/**
+ * @brief Size reported by LittleFS.totalBytes() (default 2.625 MB, the data partition of partitions_8MB.csv)
+ */
+void setFilesystemSize(size_t bytes);
+size_t filesystemSize();
+
+} // namespace HostRuntime
+
+#endif // HOST_RUNTIME_HPP
@@ -0,0 +1,68 @@
+#ifndef HOST_U8G2_FOR_ADAFRUIT_GFX_H
+#define HOST_U8G2_FOR_ADAFRUIT_GFX_H
+
+// U8g2 text on an Adafruit GFX target, host version: glyphs are not rendered, every font is a
+// fixed-pitch box (width, ascent, descent from HostGfx.cpp), so text widths and cursor movement
+// stay plausible for layout code.
+
+#include "Adafruit_GFX.h"
+
+// Font blobs: byte 0 glyph width, byte 1 ascent, byte 2 descent (positive)
+#define HOST_U8G2_FONT(name) extern const uint8_t name[];
+HOST_U8G2_FONT(u8g2_font_4x6_tf)
+HOST_U8G2_FONT(u8g2_font_5x8_tf)
+HOST_U8G2_FONT(u8g2_font_6x10_tf)
+HOST_U8G2_FONT(u8g2_font_6x13_me)
+HOST_U8G2_FONT(u8g2_font_6x13_tf)
+HOST_U8G2_FONT(u8g2_font_7x13_tr)
+HOST_U8G2_FONT(u8g2_font_7x14B_tf)
+HOST_U8G2_FONT(u8g2_font_7x14_tf)
+HOST_U8G2_FONT(u8g2_font_9x15_tf)
+HOST_U8G2_FONT(u8g2_font_fub20_tf)
+HOST_U8G2_FONT(u8g2_font_helvB08_tr)
+HOST_U8G2_FONT(u8g2_font_helvB10_tr)
+HOST_U8G2_FONT(u8g2_font_helvB12_tf)
+HOST_U8G2_FONT(u8g2_font_helvB14_tf)
+HOST_U8G2_FONT(u8g2_font_helvR08_tr)
+HOST_U8G2_FONT(u8g2_font_logisoso16_tf)
+HOST_U8G2_FONT(u8g2_font_logisoso18_tn)
+HOST_U8G2_FONT(u8g2_font_profont10_tf)
+HOST_U8G2_FONT(u8g2_font_profont12_tf)
+HOST_U8G2_FONT(u8g2_font_profont15_tf)
+#undef HOST_U8G2_FONT
+
+class U8G2_FOR_ADAFRUIT_GFX : public Print {
+public:
+    void begin(Adafruit_GFX& gfx) { _gfx = &gfx; }
+    void setFont(const uint8_t* font) { _font = font; }
+    void setFontMode(uint8_t) {}
+    void setFontDirection(uint8_t) {}
+    void setForegroundColor(uint16_t color) { _foreground = color; }
+    void setBackgroundColor(uint16_t color) { _background = color; }
+    void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+    int16_t getCursorX() const { return _cursorX; }
+    int16_t getCursorY() const { return _cursorY; }
+
+    int16_t drawUTF8(int16_t x, int16_t y, const char* str);
+    int16_t drawStr(int16_t x, int16_t y, const char* str) { return drawUTF8(x, y, str); }
+    int16_t drawGlyph(int16_t x, int16_t y, uint16_t encoding);
+    int16_t getUTF8Width(const char* str) const;
+    int16_t getStrWidth(const char* str) const { return getUTF8Width(str); }
+    int8_t getFontAscent() const { return _font ? (int8_t)_font[1] : 6; }
+    int8_t getFontDescent() const { return _font ? -(int8_t)_font[2] : -2; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+private:
+    uint8_t glyphWidth() const { return _font ? _font[0] : 6; }
+
+    Adafruit_GFX* _gfx = nullptr;
+    const uint8_t* _font = nullptr;
+    uint16_t _foreground = 0xFFFF;
+    uint16_t _background = 0;
+    int16_t _cursorX = 0;
+    int16_t _cursorY = 0;
+};
+
+#endif // HOST_U8G2_FOR_ADAFRUIT_GFX_H
@@ -0,0 +1,6 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include "Arduino.h"
+
+#endif // HOST_WSTRING_H
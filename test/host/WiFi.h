@@ -0,0 +1,34 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+/**
+ * @brief Station interface of the fake network (HostNet::setWifiConnected)
+ */
+class WiFiClass {
+public:
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    int hostByName(const char* host, IPAddress& result);
+    IPAddress localIP() { return IPAddress(192, 168, 178, 50); }
+    int8_t RSSI() { return -55; }
+    String SSID() { return String("host"); }
+    String macAddress() { return String("02:00:00:00:00:01"); }
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,43 @@
+#ifndef HOST_WIFICLIENT_H
+#define HOST_WIFICLIENT_H
+
+#include "Arduino.h"
+#include <string>
+
+/**
+ * @brief TCP socket to the fake network (HostNet). Payload bytes are exchanged by HTTPClient,
+ *        the socket only tracks the connection and the server's keep-alive timeout.
+ */
+class WiFiClient : public Stream {
+public:
+    virtual ~WiFiClient() = default;
+
+    virtual int connect(const char* host, uint16_t port);
+    int connect(IPAddress ip, uint16_t port) { return connect(ip.toString().c_str(), port); }
+    virtual uint8_t connected();
+    virtual void stop();
+    operator bool() { return connected(); }
+
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t size) override { return size; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+
+    // HTTPClient shim
+    const std::string& remoteHost() const { return _host; }
+    uint16_t remotePort() const { return _port; }
+    void touch();
+    void serverClose() { _open = false; }
+    virtual bool isSecure() const { return false; }
+
+protected:
+    std::string _host;
+    uint16_t _port = 0;
+    bool _open = false;
+    unsigned long _lastActivityMs = 0;
+};
+
+#endif // HOST_WIFICLIENT_H
@@ -0,0 +1,22 @@
+#ifndef HOST_WIFICLIENTSECURE_H
+#define HOST_WIFICLIENTSECURE_H
+
+#include "WiFiClient.h"
+
+/**
+ * @brief TLS socket: connect() adds the host's handshake time, certificates are not checked.
+ */
+class WiFiClientSecure : public WiFiClient {
+public:
+    int connect(const char* host, uint16_t port) override;
+    void setCACert(const char* rootCA) { _caCert = rootCA; }
+    void setInsecure() { _caCert = nullptr; }
+    int lastError(char* buffer, const size_t size);
+    bool isSecure() const override { return true; }
+
+private:
+    const char* _caCert = nullptr;
+    int _lastError = 0;
+};
+
+#endif // HOST_WIFICLIENTSECURE_H
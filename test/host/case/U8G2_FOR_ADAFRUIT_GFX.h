@@ -0,0 +1,8 @@
+#ifndef HOST_U8G2_FOR_ADAFRUIT_GFX_UPPER_H
+#define HOST_U8G2_FOR_ADAFRUIT_GFX_UPPER_H
+
+// Spelling used by CuriousHolidaysModule. Kept in its own include directory: on a case-insensitive
+// file system it would be the same file as ../U8g2_for_Adafruit_GFX.h, which is found first there.
+#include "U8g2_for_Adafruit_GFX.h"
+
+#endif // HOST_U8G2_FOR_ADAFRUIT_GFX_UPPER_H
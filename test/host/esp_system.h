@@ -0,0 +1,11 @@
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include <cstdint>
+
+// Deterministic per run (seed with HostRuntime::seedRandom()), like the hardware RNG it is only used for jitter and ids
+uint32_t esp_random();
+void esp_restart();
+uint32_t esp_get_free_heap_size();
+
+#endif // HOST_ESP_SYSTEM_H
@@ -0,0 +1,116 @@
+#ifndef HOST_ROM_MINIZ_H
+#define HOST_ROM_MINIZ_H
+
+// The tinfl/tdefl subset of the ESP32 ROM miniz, implemented on top of zlib (HostMiniz.cpp).
+// Same flags, status codes and streaming semantics; the decompressor and compressor keep
+// zlib's state inside the struct, so free() without a matching end call does not leak.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef unsigned char mz_uint8;
+typedef unsigned int mz_uint;
+typedef uint32_t mz_uint32;
+typedef int mz_bool;
+typedef unsigned long mz_ulong;
+
+#define MZ_FALSE (0)
+#define MZ_TRUE (1)
+
+#define MZ_ADLER32_INIT (1)
+#define MZ_CRC32_INIT (0)
+mz_ulong mz_adler32(mz_ulong adler, const unsigned char* ptr, size_t buf_len);
+mz_ulong mz_crc32(mz_ulong crc, const unsigned char* ptr, size_t buf_len);
+
+// --- tinfl ---
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum {
+    TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS = -4,
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+// zlib's inflate state and 32 KB window come from the arena
+#define HOST_TINFL_ARENA_SIZE (48 * 1024)
+
+struct tinfl_decompressor_tag {
+    mz_uint32 m_state;  // 0 = zlib stream not started yet
+    alignas(16) unsigned char m_stream[128];
+    size_t m_arenaUsed;
+    alignas(16) unsigned char m_arena[HOST_TINFL_ARENA_SIZE];
+};
+typedef struct tinfl_decompressor_tag tinfl_decompressor;
+
+inline void tinfl_init(tinfl_decompressor* r) {
+    r->m_state = 0;
+    r->m_arenaUsed = 0;
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size, mz_uint8* pOut_buf_start,
+                              mz_uint8* pOut_buf_next, size_t* pOut_buf_size, const mz_uint32 decomp_flags);
+
+// --- tdefl ---
+
+enum {
+    TDEFL_HUFFMAN_ONLY = 0,
+    TDEFL_DEFAULT_MAX_PROBES = 128,
+    TDEFL_MAX_PROBES_MASK = 0xFFF
+};
+
+enum {
+    TDEFL_WRITE_ZLIB_HEADER = 0x01000,
+    TDEFL_COMPUTE_ADLER32 = 0x02000,
+    TDEFL_GREEDY_PARSING_FLAG = 0x04000,
+    TDEFL_NONDETERMINISTIC_PARSING_FLAG = 0x08000,
+    TDEFL_RLE_MATCHES = 0x10000,
+    TDEFL_FILTER_MATCHES = 0x20000,
+    TDEFL_FORCE_ALL_STATIC_BLOCKS = 0x40000,
+    TDEFL_FORCE_ALL_RAW_BLOCKS = 0x80000
+};
+
+typedef enum {
+    TDEFL_STATUS_BAD_PARAM = -2,
+    TDEFL_STATUS_PUT_BUF_FAILED = -1,
+    TDEFL_STATUS_OKAY = 0,
+    TDEFL_STATUS_DONE = 1
+} tdefl_status;
+
+typedef enum {
+    TDEFL_NO_FLUSH = 0,
+    TDEFL_SYNC_FLUSH = 2,
+    TDEFL_FULL_FLUSH = 3,
+    TDEFL_FINISH = 4
+} tdefl_flush;
+
+typedef mz_bool (*tdefl_put_buf_func_ptr)(const void* pBuf, int len, void* pUser);
+
+// deflateInit2(windowBits 15, memLevel 8) needs ~260 KB, the ROM compressor ~300 KB
+#define HOST_TDEFL_ARENA_SIZE (288 * 1024)
+
+typedef struct {
+    tdefl_put_buf_func_ptr m_pPut_buf_func;
+    void* m_pPut_buf_user;
+    mz_uint m_flags;
+    int m_finished;
+    alignas(16) unsigned char m_stream[128];
+    size_t m_arenaUsed;
+    alignas(16) unsigned char m_arena[HOST_TDEFL_ARENA_SIZE];
+} tdefl_compressor;
+
+tdefl_status tdefl_init(tdefl_compressor* d, tdefl_put_buf_func_ptr pPut_buf_func, void* pPut_buf_user, int flags);
+tdefl_status tdefl_compress_buffer(tdefl_compressor* d, const void* pIn_buf, size_t in_buf_size, tdefl_flush flush);
+
+#endif // HOST_ROM_MINIZ_H
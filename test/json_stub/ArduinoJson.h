@@ -0,0 +1,7 @@
+#ifndef HOST_ARDUINOJSON_STUB_H
+#define HOST_ARDUINOJSON_STUB_H
+
+// Stands in for ArduinoJson in targets whose sources include it without using it
+// (webconfig.hpp). Targets that parse JSON need the real library (ARDUINOJSON_INCLUDE_DIR).
+
+#endif // HOST_ARDUINOJSON_STUB_H
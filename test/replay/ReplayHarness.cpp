@@ -0,0 +1,405 @@
+// Replay of captured responses (WebClientModule capture mode, /capture/*.http) through the real
+// module parsers. Every fixture goes to the module whose own registration claims its URL (calendar:
+// any iCalendar body), then the module takes it as in the firmware: streamed in 1436-byte chunks
+// for the calendar, queueData()/processData() for the others. Module construction and the body
+// block are outside the measurement; the numbers cover delivery, parsing and building the model.
+//
+// Usage: replay_harness [--iterations N] [--no-check] [fixture files or directories...]
+// Default input is the fixtures directory next to this file. With checks on, the run fails when a
+// fixture is claimed by no module or the module does not report an update.
+//
+// Per fixture: median and fastest run time, heap allocations, peak heap above the start (body
+// block not included) and bytes the module still holds afterwards (its parsed model).
+
+#include "ReplayWebClient.hpp"
+#include "AllocHook.hpp"
+#include "HostRuntime.hpp"
+#include "GeneralTimeConverter.hpp"
+#include "webconfig.hpp"
+#include "CalendarModule.hpp"
+#include "DartsRankingModule.hpp"
+#include "CuriousHolidaysModule.hpp"
+#ifdef REPLAY_WITH_JSON
+#include "SofaScoreLiveModule.hpp"
+#include "WeatherModule.hpp"
+#include "ThemeParkModule.hpp"
+#include "TankerkoenigModule.hpp"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Defined by Panelclock.ino / Application.cpp in the firmware
+SemaphoreHandle_t serialMutex = nullptr;
+GeneralTimeConverter* timeConverter = nullptr;
+DeviceConfig* deviceConfig = nullptr;
+
+namespace {
+
+// Segment size of a typical TLS record payload, what the fetch worker hands on per write
+const size_t STREAM_CHUNK = 1436;
+
+/**
+ * @brief One capture file (format written by WebClientModule::captureResponse())
+ */
+struct Capture {
+    std::string file;
+    std::string method;
+    std::string url;
+    std::string headers;   // "Name: value" lines joined with '\n', as the resource has them
+    int status = 0;
+    std::string requestBody;
+    std::string body;
+};
+
+bool loadCapture(const std::filesystem::path& path, Capture& capture) {
+    std::ifstream in(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t pos = 0;
+    size_t requestLength = 0, length = 0;
+    bool magic = false, haveLength = false;
+    while (pos < content.size()) {
+        size_t eol = content.find('\n', pos);
+        if (eol == std::string::npos) return false;
+        std::string line = content.substr(pos, eol - pos);
+        pos = eol + 1;
+        if (line.empty()) break;
+        if (!magic) {
+            if (line != "PCFX 1") return false;
+            magic = true;
+            continue;
+        }
+        size_t colon = line.find(": ");
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon), value = line.substr(colon + 2);
+        if (name == "method") capture.method = value;
+        else if (name == "url") capture.url = value;
+        else if (name == "header") capture.headers += (capture.headers.empty() ? "" : "\n") + value;
+        else if (name == "status") capture.status = atoi(value.c_str());
+        else if (name == "request-length") requestLength = strtoul(value.c_str(), nullptr, 10);
+        else if (name == "length") { length = strtoul(value.c_str(), nullptr, 10); haveLength = true; }
+    }
+    if (!magic || !haveLength || capture.url.empty() || pos + requestLength + length > content.size()) return false;
+    capture.file = path.filename().string();
+    capture.requestBody = content.substr(pos, requestLength);
+    capture.body = content.substr(pos + requestLength, length);
+    return true;
+}
+
+/**
+ * @brief Display and time shared by all modules
+ */
+struct Environment {
+    GFXcanvas16 canvas{192, 66};
+    U8G2_FOR_ADAFRUIT_GFX u8g2;
+    GeneralTimeConverter converter{"CET-1CEST,M3.5.0,M10.5.0/3"};
+    DeviceConfig config;
+
+    Environment() { u8g2.begin(canvas); }
+};
+
+/**
+ * @brief A module set up the way Application configures it, for one delivery.
+ */
+class ModuleDriver {
+public:
+    virtual ~ModuleDriver() = default;
+    virtual const char* name() const = 0;
+    /// Pull modules: queueData() and processData(); streaming modules are fed by the harness before
+    virtual void process() = 0;
+    /// Pushed by a streaming resource (the harness streams instead of publishing)
+    virtual bool streaming() const { return false; }
+    uint32_t updates = 0;
+};
+
+typedef std::unique_ptr<ModuleDriver> (*DriverFactory)(Environment& env, WebClientModule& web, const Capture& capture);
+
+class CalendarDriver : public ModuleDriver {
+public:
+    CalendarDriver(Environment& env, WebClientModule& web, const Capture& capture)
+        : _module(env.u8g2, env.canvas, env.converter, &web, &env.config) {
+        _module.onUpdate([this]() { updates++; });
+        _module.setConfig(capture.url.c_str(), 60, 30, 50, "#FFFF00", "#FFFFFF");
+    }
+    const char* name() const override { return "Calendar"; }
+    void process() override { _module.processData(); }
+    bool streaming() const override { return true; }
+
+private:
+    CalendarModule _module;
+};
+
+class DartsDriver : public ModuleDriver {
+public:
+    DartsDriver(Environment& env, WebClientModule& web, const Capture&)
+        : _module(env.u8g2, env.canvas, &web, &env.config) {
+        _module.onUpdate([this](DartsRankingType) { updates++; });
+        _module.setConfig(true, true, 5, 10, "Luke Littler, Luke Humphries");
+    }
+    const char* name() const override { return "DartsRanking"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    DartsRankingModule _module;
+};
+
+class HolidaysDriver : public ModuleDriver {
+public:
+    HolidaysDriver(Environment& env, WebClientModule& web, const Capture&)
+        : _module(env.u8g2, env.canvas, env.converter, &web, &env.config) {
+        _module.onUpdate([this]() { updates++; });
+        _module.begin();
+    }
+    const char* name() const override { return "CuriousHolidays"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    CuriousHolidaysModule _module;
+};
+
+#ifdef REPLAY_WITH_JSON
+class SofaScoreDriver : public ModuleDriver {
+public:
+    SofaScoreDriver(Environment& env, WebClientModule& web, const Capture&)
+        : _module(env.u8g2, env.canvas, env.converter, &web, &env.config) {
+        _module.onUpdate([this]() { updates++; });
+        _module.setConfig(true, 2, 20, "", false, false, 0, false, 120, 60, true);
+        _module.queueData();  // registers the daily and live resources
+    }
+    const char* name() const override { return "SofaScoreLive"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    SofaScoreLiveModule _module;
+};
+
+class WeatherDriver : public ModuleDriver {
+public:
+    WeatherDriver(Environment& env, WebClientModule& web, const Capture&)
+        : _module(env.u8g2, env.canvas, env.converter, &web) {
+        env.config.weatherEnabled = true;
+        _module.onUpdate([this]() { updates++; });
+        _module.setConfig(&env.config);
+        _module.queueData();  // builds the dated URLs and subscribes
+    }
+    const char* name() const override { return "Weather"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    WeatherModule _module;
+};
+
+class ThemeParkDriver : public ModuleDriver {
+public:
+    ThemeParkDriver(Environment& env, WebClientModule& web, const Capture& capture)
+        : _module(env.u8g2, env.canvas, &web) {
+        // The park comes from the captured request headers
+        size_t park = capture.headers.find("park: ");
+        env.config.themeParkEnabled = true;
+        env.config.themeParkIds = park == std::string::npos ? "" : capture.headers.substr(park + 6, capture.headers.find('\n', park) - park - 6).c_str();
+        _module.onUpdate([this]() { updates++; });
+        _module.begin();
+        _module.setConfig(&env.config);
+    }
+    const char* name() const override { return "ThemePark"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    ThemeParkModule _module;
+};
+
+class TankerkoenigDriver : public ModuleDriver {
+public:
+    TankerkoenigDriver(Environment& env, WebClientModule& web, const Capture& capture)
+        : _module(env.u8g2, env.canvas, env.converter, 0, &web, &env.config) {
+        // Station ids and key from the captured URL (...prices.php?ids=a,b&apikey=k)
+        std::string ids = queryValue(capture.url, "ids"), key = queryValue(capture.url, "apikey");
+        _module.onUpdate([this]() { updates++; });
+        _module.begin();
+        _module.setConfig(key.c_str(), ids.c_str(), 5, 10);
+    }
+    const char* name() const override { return "Tankerkoenig"; }
+    void process() override { _module.queueData(); _module.processData(); }
+
+private:
+    static std::string queryValue(const std::string& url, const char* name) {
+        std::string key = std::string(name) + "=";
+        size_t start = url.find(key);
+        if (start == std::string::npos) return "";
+        start += key.size();
+        return url.substr(start, url.find('&', start) - start);
+    }
+
+    TankerkoenigModule _module;
+};
+#endif
+
+template<typename T>
+std::unique_ptr<ModuleDriver> make(Environment& env, WebClientModule& web, const Capture& capture) {
+    return std::unique_ptr<ModuleDriver>(new T(env, web, capture));
+}
+
+bool isCalendar(const Capture& capture) {
+    size_t start = capture.body.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    return capture.body.compare(start, 15, "BEGIN:VCALENDAR") == 0;
+}
+
+const DriverFactory FACTORIES[] = {
+    make<DartsDriver>,
+    make<HolidaysDriver>,
+#ifdef REPLAY_WITH_JSON
+    make<SofaScoreDriver>,
+    make<WeatherDriver>,
+    make<ThemeParkDriver>,
+    make<TankerkoenigDriver>,
+#endif
+};
+
+/**
+ * @brief The fixture handed to a freshly configured module
+ */
+struct Delivery {
+    std::unique_ptr<WebClientModule> web;
+    std::unique_ptr<ModuleDriver> driver;
+    Replay::Registration* registration = nullptr;  // nullptr: answers a getRequest() job
+};
+
+bool setUpDelivery(Environment& env, const Capture& capture, DriverFactory factory, Delivery& delivery) {
+    delivery.driver.reset();
+    delivery.web.reset(new WebClientModule());
+    delivery.driver = factory(env, *delivery.web, capture);
+    delivery.registration = Replay::resolve(*delivery.web, capture.url.c_str(), capture.headers.c_str());
+    if (delivery.registration) {
+        if (delivery.driver->streaming()) return delivery.registration->consumer != nullptr;
+        return Replay::publish(*delivery.registration, capture.body.data(), capture.body.size(), time(nullptr));
+    }
+    return false;
+}
+
+bool claim(Environment& env, const Capture& capture, DriverFactory& factory) {
+    if (isCalendar(capture)) {
+        factory = make<CalendarDriver>;
+        return true;
+    }
+    for (DriverFactory candidate : FACTORIES) {
+        Delivery delivery;
+        if (setUpDelivery(env, capture, candidate, delivery)) {
+            factory = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Result {
+    const char* module = "";
+    std::vector<double> ms;
+    uint64_t allocations = 0;
+    int64_t peakBytes = 0;
+    int64_t retainedBytes = 0;
+    bool updated = true;
+};
+
+Result replay(Environment& env, const Capture& capture, DriverFactory factory, int iterations) {
+    Result result;
+    for (int i = 0; i < iterations; i++) {
+        Delivery delivery;
+        setUpDelivery(env, capture, factory, delivery);
+        uint32_t before = delivery.driver->updates;
+        result.module = delivery.driver->name();
+
+        AllocScope scope;
+        auto start = std::chrono::steady_clock::now();
+        if (delivery.driver->streaming()) {
+            Replay::stream(*delivery.registration, capture.body.data(), capture.body.size(), STREAM_CHUNK);
+        }
+        delivery.driver->process();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        result.ms.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+        // Heap figures of the first run: later runs only differ by lazily created logger state
+        if (i == 0) {
+            result.allocations = scope.allocations();
+            result.peakBytes = scope.peakBytes();
+            result.retainedBytes = scope.retainedBytes();
+        }
+        result.updated = result.updated && delivery.driver->updates > before;
+    }
+    return result;
+}
+
+void collect(const std::filesystem::path& path, std::vector<std::filesystem::path>& files) {
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.path().extension() == ".http") files.push_back(entry.path());
+        }
+    } else {
+        files.push_back(path);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    bool check = true;
+    std::vector<std::filesystem::path> files;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) iterations = atoi(argv[++i]);
+        else if (arg == "--no-check") check = false;
+        else if (arg.rfind("--", 0) == 0) {
+            fprintf(stderr, "Usage: %s [--iterations N] [--no-check] [fixture files or directories...]\n", argv[0]);
+            return 2;
+        } else collect(arg, files);
+    }
+    if (files.empty()) collect(REPLAY_FIXTURE_DIR, files);
+    std::sort(files.begin(), files.end());
+    if (iterations < 1) iterations = 1;
+
+    HostRuntime::setSerialEnabled(false);
+    HostRuntime::seedRandom(1);
+    // The parsers yield with vTaskDelay(1) between rows; beyond 1000 simulated ms per real ms
+    // such a delay rounds to no sleep at all, so it does not end up in the parse times
+    HostRuntime::setClockScale(10000.0);
+    serialMutex = xSemaphoreCreateMutex();
+    static Environment env;
+    timeConverter = &env.converter;
+    deviceConfig = &env.config;
+
+    bool ok = true;
+    printf("%-34s %-16s %9s %9s %9s %8s %9s %10s %s\n", "fixture", "module", "bytes", "median ms", "min ms",
+           "allocs", "peak KB", "retained", "");
+    for (const auto& path : files) {
+        Capture capture;
+        if (!loadCapture(path, capture)) {
+            printf("%-34s unreadable\n", path.filename().c_str());
+            ok = false;
+            continue;
+        }
+        DriverFactory factory = nullptr;
+        if (!claim(env, capture, factory)) {
+            printf("%-34s %-16s %9zu  no module registers %s\n", capture.file.c_str(), "-", capture.body.size(), capture.url.c_str());
+            ok = false;
+            continue;
+        }
+        Result result = replay(env, capture, factory, iterations);
+        std::vector<double> sorted = result.ms;
+        std::sort(sorted.begin(), sorted.end());
+        printf("%-34s %-16s %9zu %9.3f %9.3f %8llu %9.1f %10lld %s\n", capture.file.c_str(), result.module,
+               capture.body.size(), sorted[sorted.size() / 2], sorted.front(), (unsigned long long)result.allocations,
+               result.peakBytes / 1024.0, (long long)result.retainedBytes, result.updated ? "" : "NO UPDATE");
+        if (!result.updated) ok = false;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(HostRuntime::filesystemRoot(), ec);
+    return ok || !check ? 0 : 1;
+}
@@ -0,0 +1,385 @@
+// WebClientModule for the replay harness: the registration and data access API of the real module
+// over a plain registry, fed by the harness instead of fetch workers. The body blocks are
+// ResourceData as in the firmware, so modules keep and release them exactly as they do there.
+
+#include "ReplayWebClient.hpp"
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace {
+
+struct Job {
+    std::string url;
+    std::string headers;
+    std::function<void(const char* buffer, size_t size)> callback;
+    std::function<void(int httpCode, const char* payload, size_t len)> detailedCallback;
+};
+
+struct State {
+    std::list<Replay::Registration> registrations;  // list: Registration pointers stay valid
+    std::list<Job> jobs;
+};
+
+// Keyed by instance, the class layout is the firmware's and has no room for the registry
+std::map<const WebClientModule*, State> g_states;
+std::recursive_mutex g_mutex;
+
+State& stateOf(const WebClientModule* web) {
+    std::lock_guard<std::recursive_mutex> lock(g_mutex);
+    return g_states[web];
+}
+
+std::string hostOf(const std::string& url) {
+    size_t start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    size_t end = url.find_first_of("/:?", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+Replay::Registration* find(State& state, const char* url, const char* headers) {
+    for (auto& registration : state.registrations) {
+        if (registration.url == url && registration.headers == (headers ? headers : "")) return &registration;
+    }
+    return nullptr;
+}
+
+Replay::Registration* findByHost(State& state, const std::string& host) {
+    for (auto& registration : state.registrations) {
+        if (hostOf(registration.url) == host) return &registration;
+    }
+    return nullptr;
+}
+
+void dropData(Replay::Registration& registration) {
+    if (registration.data) registration.data->release();
+    registration.data = nullptr;
+}
+
+Replay::Registration& add(State& state, const char* url, const char* headers) {
+    state.registrations.emplace_back();
+    Replay::Registration& registration = state.registrations.back();
+    registration.url = url;
+    registration.headers = headers ? headers : "";
+    return registration;
+}
+
+void unregister(State& state, const char* url, const char* headers) {
+    for (auto it = state.registrations.begin(); it != state.registrations.end(); ++it) {
+        if (it->url == url && it->headers == (headers ? headers : "")) {
+            dropData(*it);
+            state.registrations.erase(it);
+            return;
+        }
+    }
+}
+
+void access(const WebClientModule* web, const char* url, const char* headers,
+            const std::function<void(const char*, size_t, time_t, bool)>& callback) {
+    Replay::Registration* registration = find(stateOf(web), url, headers);
+    if (!registration) return;
+    ResourceData* data = registration->data;
+    callback(data ? data->data() : nullptr, data ? data->size : 0, data ? data->last_update : 0, data == nullptr);
+}
+
+} // namespace
+
+// --- Body blocks (as in WebClientModule.cpp) ---
+
+ResourceData* ResourceData::create(size_t size, uint32_t version, time_t lastUpdate) {
+    void* mem = ps_malloc(sizeof(ResourceData) + size + 1);
+    if (!mem) return nullptr;
+    ResourceData* block = new (mem) ResourceData();
+    block->refs.store(1);
+    block->version = version;
+    block->last_update = lastUpdate;
+    block->size = size;
+    block->data()[size] = '\0';
+    return block;
+}
+
+void ResourceData::retain() {
+    refs.fetch_add(1);
+}
+
+void ResourceData::release() {
+    if (refs.fetch_sub(1) == 1) {
+        this->~ResourceData();
+        free(this);
+    }
+}
+
+ResourceDataRef::ResourceDataRef(ResourceData* data) : _data(data) {
+    if (_data) _data->retain();
+}
+
+ResourceDataRef::ResourceDataRef(const ResourceDataRef& other) : _data(other._data) {
+    if (_data) _data->retain();
+}
+
+ResourceDataRef::ResourceDataRef(ResourceDataRef&& other) noexcept : _data(other._data) {
+    other._data = nullptr;
+}
+
+ResourceDataRef& ResourceDataRef::operator=(const ResourceDataRef& other) {
+    if (this != &other) {
+        if (other._data) other._data->retain();
+        reset();
+        _data = other._data;
+    }
+    return *this;
+}
+
+ResourceDataRef& ResourceDataRef::operator=(ResourceDataRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        _data = other._data;
+        other._data = nullptr;
+    }
+    return *this;
+}
+
+ResourceDataRef::~ResourceDataRef() {
+    reset();
+}
+
+void ResourceDataRef::reset() {
+    if (_data) {
+        _data->release();
+        _data = nullptr;
+    }
+}
+
+// --- Download buffer of the (unused) fetch workers ---
+
+PsramBufferStream::PsramBufferStream() = default;
+PsramBufferStream::~PsramBufferStream() {}
+bool PsramBufferStream::reserve(size_t) { return false; }
+void PsramBufferStream::reset() {}
+void PsramBufferStream::trim(size_t) {}
+size_t PsramBufferStream::write(uint8_t) { return 0; }
+size_t PsramBufferStream::write(const uint8_t*, size_t) { return 0; }
+bool PsramBufferStream::hasOverflowed() const { return false; }
+size_t PsramBufferStream::getCapacity() const { return 0; }
+int PsramBufferStream::available() { return 0; }
+int PsramBufferStream::read() { return -1; }
+int PsramBufferStream::peek() { return -1; }
+void PsramBufferStream::flush() {}
+size_t PsramBufferStream::getSize() { return 0; }
+size_t PsramBufferStream::segmentCount() const { return 0; }
+const char* PsramBufferStream::segment(size_t, size_t& length) const { length = 0; return nullptr; }
+uint8_t PsramBufferStream::growthCount() const { return 0; }
+void PsramBufferStream::copyTo(char*) const {}
+
+// --- WebClientModule ---
+
+WebClientModule::WebClientModule() : _scheduleMutex(NULL), _updateQueue(NULL), _certMutex(NULL), _cacheMutex(NULL), _startMs(0) {
+    stateOf(this);
+}
+
+WebClientModule::~WebClientModule() {
+    std::lock_guard<std::recursive_mutex> lock(g_mutex);
+    for (auto& registration : g_states[this].registrations) dropData(registration);
+    g_states.erase(this);
+}
+
+void WebClientModule::begin() {}
+
+void WebClientModule::registerResource(const String& url, uint32_t update_interval_minutes, const char*) {
+    if (url.isEmpty() || update_interval_minutes == 0) return;
+    State& state = stateOf(this);
+    // A resource of the same host takes the new URL
+    Replay::Registration* registration = findByHost(state, hostOf(url.c_str()));
+    if (registration) {
+        if (registration->url != url.c_str()) {
+            registration->url = url.c_str();
+            dropData(*registration);
+        }
+        return;
+    }
+    add(state, url.c_str(), "");
+}
+
+void WebClientModule::registerResourceWithHeaders(const String& url, const String& customHeaders, uint32_t update_interval_minutes, const char*) {
+    if (url.isEmpty() || update_interval_minutes == 0) return;
+    State& state = stateOf(this);
+    if (!find(state, url.c_str(), customHeaders.c_str())) add(state, url.c_str(), customHeaders.c_str());
+}
+
+void WebClientModule::registerResourceSeconds(const String& url, uint32_t update_interval_seconds, bool, bool force_new, const char*) {
+    if (url.isEmpty() || update_interval_seconds == 0) return;
+    State& state = stateOf(this);
+    if (!force_new && find(state, url.c_str(), "")) return;
+    add(state, url.c_str(), "");
+}
+
+void WebClientModule::registerResourceSecondsWithHeaders(const String& url, const String& customHeaders, uint32_t update_interval_seconds, bool, const char*) {
+    if (url.isEmpty() || update_interval_seconds == 0) return;
+    State& state = stateOf(this);
+    if (!find(state, url.c_str(), customHeaders.c_str())) add(state, url.c_str(), customHeaders.c_str());
+}
+
+void WebClientModule::registerStreamingResource(const String& url, uint32_t update_interval_minutes, ResourceStreamConsumer* consumer, const char*) {
+    if (url.isEmpty() || update_interval_minutes == 0 || !consumer) return;
+    State& state = stateOf(this);
+    for (auto& registration : state.registrations) {
+        if (registration.consumer == consumer) {
+            registration.url = url.c_str();
+            return;
+        }
+    }
+    add(state, url.c_str(), "").consumer = consumer;
+}
+
+void WebClientModule::updateResourceUrl(const String& old_url, const String& new_url) {
+    Replay::Registration* registration = find(stateOf(this), old_url.c_str(), "");
+    if (!registration) return;
+    registration->url = new_url.c_str();
+    dropData(*registration);
+}
+
+void WebClientModule::unregisterResource(const String& url) { unregisterResource(url.c_str()); }
+void WebClientModule::unregisterResource(const char* url) { unregister(stateOf(this), url, ""); }
+void WebClientModule::unregisterResourceWithHeaders(const String& url, const String& customHeaders) {
+    unregisterResourceWithHeaders(url.c_str(), customHeaders.c_str());
+}
+void WebClientModule::unregisterResourceWithHeaders(const char* url, const char* customHeaders) {
+    unregister(stateOf(this), url, customHeaders);
+}
+
+void WebClientModule::accessResource(const String& url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    access(this, url.c_str(), "", callback);
+}
+void WebClientModule::accessResource(const String& url, const String& customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    access(this, url.c_str(), customHeaders.c_str(), callback);
+}
+void WebClientModule::accessResource(const char* url, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    access(this, url, "", callback);
+}
+void WebClientModule::accessResource(const char* url, const char* customHeaders, std::function<void(const char* data, size_t size, time_t last_update, bool is_stale)> callback) {
+    access(this, url, customHeaders, callback);
+}
+
+bool WebClientModule::takeNewData(ResourceSubscription& subscription, ResourceDataRef& out) {
+    Replay::Registration* registration = find(stateOf(this), subscription.url.c_str(), subscription.customHeaders.c_str());
+    if (!registration || !registration->data || registration->data->version == subscription.version) return false;
+    subscription.version = registration->data->version;
+    out = ResourceDataRef(registration->data);
+    return true;
+}
+
+uint32_t WebClientModule::getResourceId(const char* url, const char* customHeaders) {
+    State& state = stateOf(this);
+    uint32_t id = 1;
+    for (auto& registration : state.registrations) {
+        if (registration.url == url && registration.headers == (customHeaders ? customHeaders : "")) return id;
+        id++;
+    }
+    return 0;
+}
+
+void WebClientModule::addUpdateListener(ResourceUpdateListener listener) {}
+uint32_t WebClientModule::dispatchUpdateEvents() { return 0; }
+
+void WebClientModule::pauseResource(const String&) {}
+void WebClientModule::pauseResource(const char*) {}
+void WebClientModule::pauseResourceWithHeaders(const String&, const String&) {}
+void WebClientModule::pauseResourceWithHeaders(const char*, const char*) {}
+void WebClientModule::resumeResource(const String&) {}
+void WebClientModule::resumeResource(const char*) {}
+void WebClientModule::resumeResourceWithHeaders(const String&, const String&) {}
+void WebClientModule::resumeResourceWithHeaders(const char*, const char*) {}
+
+void WebClientModule::getRequest(const PsramString& url, std::function<void(const char* buffer, size_t size)> callback, JobPriority) {
+    std::lock_guard<std::recursive_mutex> lock(g_mutex);
+    Job job;
+    job.url = url.c_str();
+    job.callback = std::move(callback);
+    stateOf(this).jobs.push_back(std::move(job));
+}
+
+void WebClientModule::getRequest(const PsramString& url, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority priority) {
+    getRequest(url, PsramString(), std::move(detailed_callback), priority);
+}
+
+void WebClientModule::getRequest(const PsramString& url, const PsramString& customHeaders, std::function<void(int httpCode, const char* payload, size_t len)> detailed_callback, JobPriority) {
+    std::lock_guard<std::recursive_mutex> lock(g_mutex);
+    Job job;
+    job.url = url.c_str();
+    job.headers = customHeaders.c_str();
+    job.detailedCallback = std::move(detailed_callback);
+    stateOf(this).jobs.push_back(std::move(job));
+}
+
+void WebClientModule::postRequest(const PsramString& url, const PsramString&, const PsramString&, std::function<void(const char* buffer, size_t size)> callback, JobPriority priority) {
+    getRequest(url, std::move(callback), priority);
+}
+
+// --- Replay control ---
+
+namespace Replay {
+
+Registration* resolve(WebClientModule& web, const char* url, const char* headers) {
+    State& state = stateOf(&web);
+    if (Registration* exact = find(state, url, headers)) return exact;
+    std::string host = hostOf(url);
+    Registration* match = nullptr;
+    for (auto& registration : state.registrations) {
+        if (hostOf(registration.url) != host) continue;
+        if (match) return nullptr;  // ambiguous
+        match = &registration;
+    }
+    return match;
+}
+
+bool publish(Registration& registration, const char* body, size_t size, time_t lastUpdate) {
+    if (registration.consumer) return false;
+    ResourceData* data = ResourceData::create(size, ++registration.version, lastUpdate);
+    if (!data) return false;
+    memcpy(data->data(), body, size);
+    dropData(registration);
+    registration.data = data;
+    return true;
+}
+
+bool stream(Registration& registration, const char* body, size_t size, size_t chunk) {
+    ResourceStreamConsumer* consumer = registration.consumer;
+    if (!consumer) return false;
+    if (chunk == 0) chunk = size ? size : 1;
+    consumer->onStreamBegin((int)size);
+    for (size_t pos = 0; pos < size; pos += chunk) {
+        if (!consumer->onStreamChunk(body + pos, std::min(chunk, size - pos))) {
+            consumer->onStreamEnd(false);
+            return false;
+        }
+    }
+    consumer->onStreamEnd(true);
+    return true;
+}
+
+size_t answerJobs(WebClientModule& web, const char* url, const char* headers, int httpCode, const char* body, size_t size) {
+    std::list<Job> matching;
+    {
+        std::lock_guard<std::recursive_mutex> lock(g_mutex);
+        std::list<Job>& jobs = stateOf(&web).jobs;
+        for (auto it = jobs.begin(); it != jobs.end();) {
+            auto next = std::next(it);
+            if (it->url == url && it->headers == (headers ? headers : "")) matching.splice(matching.end(), jobs, it);
+            it = next;
+        }
+    }
+    // Callbacks run without the registry lock, like in a fetch worker
+    for (Job& job : matching) {
+        bool ok = httpCode >= 200 && httpCode < 300;
+        if (job.detailedCallback) job.detailedCallback(httpCode, body, size);
+        else if (job.callback) job.callback(ok ? body : nullptr, ok ? size : 0);
+    }
+    return matching.size();
+}
+
+size_t registrationCount(WebClientModule& web) {
+    return stateOf(&web).registrations.size();
+}
+
+} // namespace Replay
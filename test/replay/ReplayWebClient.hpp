@@ -0,0 +1,59 @@
+#ifndef REPLAY_WEB_CLIENT_HPP
+#define REPLAY_WEB_CLIENT_HPP
+
+#include "WebClientModule.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Control of the replay WebClientModule (ReplayWebClient.cpp).
+ *
+ * The replay build links ReplayWebClient.cpp instead of WebClientModule.cpp: same class, same
+ * header, but no workers and no network. Modules register their resources as in the firmware;
+ * the harness then hands captured bodies to those registrations, which the modules pick up through
+ * takeNewData()/accessResource() or, for streaming resources, get pushed chunk by chunk.
+ */
+namespace Replay {
+
+struct Registration {
+    std::string url;
+    std::string headers;
+    ResourceStreamConsumer* consumer = nullptr;  ///< Streaming resource
+    ResourceData* data = nullptr;                ///< Current body (not for streaming resources)
+    uint32_t version = 0;
+};
+
+/**
+ * @brief Registration a captured request answers: the one with this URL and headers, otherwise the
+ *        only registration of the same host (URLs with a date or month in the path)
+ * @return nullptr if none or several registrations of the host match
+ */
+Registration* resolve(WebClientModule& web, const char* url, const char* headers);
+
+/**
+ * @brief Make body the registration's current data (new version, last_update = lastUpdate)
+ *
+ * Allocates the body block like a fetch worker does; call it outside the measured section.
+ */
+bool publish(Registration& registration, const char* body, size_t size, time_t lastUpdate);
+
+/**
+ * @brief Pass body to the registration's consumer in pieces of chunk bytes, as a fetch worker does
+ */
+bool stream(Registration& registration, const char* body, size_t size, size_t chunk);
+
+/**
+ * @brief Answer the queued getRequest() jobs whose URL and headers match, from this thread
+ * @return Number of jobs answered
+ */
+size_t answerJobs(WebClientModule& web, const char* url, const char* headers, int httpCode, const char* body, size_t size);
+
+/**
+ * @brief Number of registrations of web (all modules)
+ */
+size_t registrationCount(WebClientModule& web);
+
+} // namespace Replay
+
+#endif // REPLAY_WEB_CLIENT_HPP
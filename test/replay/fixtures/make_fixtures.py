@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""Writes the replay fixtures in the capture format of WebClientModule (PCFX 1).
+
+Real captures (stream page, capture mode) go into the same directory as they are; these synthetic
+ones follow the structure the parsers look for:
+
+  calendar.http          iCalendar, ~320 KB: VTIMEZONE, folded lines, VALARM, RRULE with EXDATE lists,
+                         all-day (VALUE=DATE) and timed events, CRLF line ends
+  darts_oom.http         dartsrankings.com Order of Merit table (Rk, +/-, Name, Prize Money)
+  darts_protour.http     dartsrankings.com Pro Tour table during a tournament (round columns)
+  holidays.http          kuriose-feiertage.de calendar page; one section per day of the year, so the
+                         entries of today and tomorrow exist whenever the replay runs
+  json/*.http            SofaScore, Open-Meteo, wartezeiten.app and Tankerkoenig responses for the
+                         modules that need ArduinoJson
+
+Run from this directory; the output is deterministic.
+"""
+
+import json
+import os
+import random
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CAPTURE_TIME = 1760000000
+
+
+def write_capture(name, url, body, headers=(), method="GET", status=200):
+    if isinstance(body, str):
+        body = body.encode("utf-8")
+    head = ["PCFX 1", "method: " + method, "url: " + url]
+    head += ["header: " + h for h in headers]
+    head += ["status: %d" % status, "time: %d" % CAPTURE_TIME, "request-length: 0", "length: %d" % len(body), "", ""]
+    path = os.path.join(HERE, name)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "wb") as f:
+        f.write("\n".join(head).encode("utf-8"))
+        f.write(body)
+
+
+def fold(line):
+    # RFC 5545: at most 75 octets per line, continuation lines start with a space
+    out = []
+    while len(line) > 75:
+        out.append(line[:75])
+        line = " " + line[75:]
+    out.append(line)
+    return "\r\n".join(out)
+
+
+def calendar(rng):
+    lines = [
+        "BEGIN:VCALENDAR", "VERSION:2.0", "PRODID:-//Google Inc//Google Calendar 70.9054//EN",
+        "CALSCALE:GREGORIAN", "METHOD:PUBLISH", "X-WR-CALNAME:Familie", "X-WR-TIMEZONE:Europe/Berlin",
+        "BEGIN:VTIMEZONE", "TZID:Europe/Berlin", "X-LIC-LOCATION:Europe/Berlin",
+        "BEGIN:DAYLIGHT", "TZOFFSETFROM:+0100", "TZOFFSETTO:+0200", "TZNAME:CEST",
+        "DTSTART:19700329T020000", "RRULE:FREQ=YEARLY;BYMONTH=3;BYDAY=-1SU", "END:DAYLIGHT",
+        "BEGIN:STANDARD", "TZOFFSETFROM:+0200", "TZOFFSETTO:+0100", "TZNAME:CET",
+        "DTSTART:19701025T030000", "RRULE:FREQ=YEARLY;BYMONTH=10;BYDAY=-1SU", "END:STANDARD",
+        "END:VTIMEZONE",
+    ]
+    titles = ["Zahnarzt", "Elternabend", "Training", "Geburtstag Oma", "Müll: Gelbe Tonne", "Chor",
+              "Tierarzt", "Schwimmkurs", "Werkstatt Termin", "Team-Meeting", "Yoga", "Klavierstunde"]
+    for n in range(400):
+        year = 2023 + n % 4
+        month = 1 + rng.randrange(12)
+        day = 1 + rng.randrange(28)
+        hour = 7 + rng.randrange(12)
+        minute = rng.choice([0, 15, 30, 45])
+        lines += ["BEGIN:VEVENT", "UID:%08x-%04d@google.com" % (rng.getrandbits(32), n),
+                  "DTSTAMP:20251001T120000Z", "CREATED:20220101T100000Z", "LAST-MODIFIED:20250901T080000Z"]
+        kind = n % 6
+        if kind == 0:
+            lines += ["DTSTART;VALUE=DATE:%04d%02d%02d" % (year, month, day),
+                      "DTEND;VALUE=DATE:%04d%02d%02d" % (year, month, day + 1)]
+        elif kind == 1:
+            lines += ["DTSTART:%04d%02d%02dT%02d%02d00Z" % (year, month, day, hour, minute),
+                      "DTEND:%04d%02d%02dT%02d%02d00Z" % (year, month, day, hour + 1, minute)]
+        else:
+            lines += ["DTSTART;TZID=Europe/Berlin:%04d%02d%02dT%02d%02d00" % (year, month, day, hour, minute),
+                      "DTEND;TZID=Europe/Berlin:%04d%02d%02dT%02d%02d00" % (year, month, day, hour + 1, minute)]
+        if kind in (2, 3):
+            lines.append("RRULE:FREQ=WEEKLY;BYDAY=%s;UNTIL=%04d1231T235959Z" % (rng.choice(["MO", "TU,TH", "WE", "FR", "SA,SU"]), year + 1))
+            exdates = ["%04d%02d%02dT%02d%02d00" % (year, 1 + (month + k) % 12, 1 + rng.randrange(28), hour, minute) for k in range(1 + rng.randrange(4))]
+            lines.append("EXDATE;TZID=Europe/Berlin:" + ",".join(exdates))
+        elif kind == 4:
+            lines.append("RRULE:FREQ=MONTHLY;BYMONTHDAY=%d;COUNT=24" % day)
+        elif kind == 5:
+            lines.append("RRULE:FREQ=YEARLY")
+        title = rng.choice(titles)
+        lines.append(fold("SUMMARY:%s %d" % (title, n)))
+        description = "Notizen: " + " ".join(rng.choice(["bitte", "Unterlagen", "mitbringen", "Parkplatz", "hinten",
+                                                          "Raum 3.14", "anrufen", "vorher", "bestätigen", "Ümläute"])
+                                             for _ in range(10 + rng.randrange(60)))
+        lines.append(fold("DESCRIPTION:" + description.replace(",", "\\,")))
+        lines.append(fold("LOCATION:Hauptstraße %d\\, 46282 Dorsten\\, Deutschland" % (1 + rng.randrange(200))))
+        lines += ["SEQUENCE:0", "STATUS:CONFIRMED", "TRANSP:OPAQUE"]
+        if n % 3 == 0:
+            lines += ["BEGIN:VALARM", "ACTION:DISPLAY", "DESCRIPTION:This is an event reminder",
+                      "TRIGGER:-P0DT0H30M0S", "END:VALARM"]
+        lines.append("END:VEVENT")
+    lines.append("END:VCALENDAR")
+    return "\r\n".join(lines) + "\r\n"
+
+
+FIRST = ["Luke", "Michael", "Gerwyn", "Rob", "Danny", "Stephen", "Jonny", "Nathan", "Peter", "Dave",
+         "Ross", "Gary", "Damon", "Martin", "Ricardo", "Dimitri", "Gabriel", "Josh", "Chris", "Ryan"]
+LAST = ["Littler", "van Gerwen", "Price", "Cross", "Noppert", "Bunting", "Clayton", "Aspinall", "Wright",
+        "Chisnall", "Smith", "Anderson", "Heta", "Schindler", "Pietreczko", "Van den Bergh", "Clemens",
+        "Rock", "Dobey", "Searle"]
+
+
+def player(rng, n):
+    return "%s %s" % (FIRST[n % len(FIRST)], LAST[(n * 7 + n // len(FIRST)) % len(LAST)])
+
+
+def darts_page(rows, thead, title, subtitle):
+    return ("<!DOCTYPE html><html><head><title>Darts Rankings</title></head><body>\n"
+            "<nav><ul><li><a href=\"/\">PDC Order of Merit</a></li><li><a href=\"/protour\">Pro Tour</a></li></ul></nav>\n"
+            "<div id=\"intr\"><h2>%s</h2><p><b>%s</b> <span style=\"color:rgb(160, 43, 43)\">Stand: heute</span></p></div>\n"
+            "<table class=\"rankings\"><thead><tr>%s</tr></thead><tbody>\n%s</tbody></table>\n"
+            "<footer>dartsrankings.com</footer></body></html>\n") % (title, subtitle, thead, "".join(rows))
+
+
+def darts_oom(rng):
+    rows = []
+    money = 2500000
+    for n in range(1, 251):
+        money -= rng.randrange(500, 12000)
+        change = rng.randrange(-5, 6)
+        cls = "change-up" if change > 0 else "change-down" if change < 0 else "change-same"
+        rows.append("<tr><td>%d</td><td class=\"%s\">%d</td><td><a href=\"/player/%d\">%s</a></td>"
+                    "<td>&pound;%s</td></tr>\n" % (n, cls, abs(change), n, player(rng, n), format(max(money, 1000), ",")))
+    thead = "<th>Rk</th><th>+/-</th><th>Name</th><th>Prize Money</th>"
+    return darts_page(rows, thead, "PDC Order of Merit", "Two-year ranking")
+
+
+def darts_protour(rng):
+    rounds = ["R1", "R2", "R3", "R4", "QF", "SF", "F"]
+    rows = []
+    for n in range(1, 129):
+        reached = min(len(rounds) - 1, int(rng.expovariate(0.7)))
+        still_in = reached >= 3 and rng.random() < 0.5
+        cells = []
+        for i, _ in enumerate(rounds):
+            if i < reached:
+                cells.append("<td class=\"projpast\">&#10003;</td>")
+            elif i == reached:
+                cells.append("<td class=\"%s\">&bull;</td>" % ("proj now" if still_in else "projout"))
+            else:
+                cells.append("<td></td>")
+        rows.append("<tr%s><td>%d</td><td><a href=\"/player/%d\">%s</a></td>%s<td>&pound;%s</td></tr>\n" % (
+            " class=\"stillin\"" if still_in else "", n, n, player(rng, n), "".join(cells), format(120000 - n * 800, ",")))
+    thead = "<th>Rk</th><th>Name</th>" + "".join("<th>%s</th>" % r for r in rounds) + "<th>Prize Money</th>"
+    return darts_page(rows, thead, "Pro Tour Order of Merit", "Players Championship 27 live")
+
+
+MONTHS = ["Januar", "Februar", "März", "April", "Mai", "Juni", "Juli", "August", "September", "Oktober",
+          "November", "Dezember"]
+DAYS = [31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31]
+
+
+def holidays(rng):
+    nouns = ["Tag des Kaffees", "Tag der Socke", "Welt-Keks-Tag", "Tag des Butterbrots", "Tag der Brezel",
+             "Tag des Regenschirms", "Tag der Ente", "Tag des Bleistifts", "Tag der Nudel", "Tag des Knopfes"]
+    parts = ["<!DOCTYPE html><html lang=\"de\"><head><meta charset=\"UTF-8\"><title>Kuriose Feiertage</title></head><body>\n"]
+    for month, days in enumerate(DAYS):
+        for day in range(1, days + 1):
+            parts.append("<h2>%d. %s</h2>\n<ul class=\"lcp_catlist\" id=\"lcp_instance_%d\">\n" % (day, MONTHS[month], month * 31 + day))
+            for k in range(1 + rng.randrange(4)):
+                name = rng.choice(nouns)
+                parts.append("<li><a href=\"https://www.kuriose-feiertage.de/%d-%d-%d/\" title=\"%s\">%s &#8211; "
+                             "Kurioser Feiertag am %d. %s in den USA, %s</a></li>\n" % (
+                                 month, day, k, name, name, day, MONTHS[month],
+                                 " ".join(rng.choice(["ein", "ganz", "besonderer", "Tag", "für", "alle", "Fans"]) for _ in range(8))))
+            parts.append("</ul>\n")
+    parts.append("</body></html>\n")
+    return "".join(parts)
+
+
+def sofascore_live(rng):
+    events = []
+    for n in range(24):
+        events.append({
+            "id": 12800000 + n,
+            "tournament": {"name": "PDC World Championship", "slug": "pdc-world-championship-2026",
+                           "uniqueTournament": {"name": "PDC World Championship", "slug": "pdc-world-championship", "id": 616}},
+            "status": {"code": 6, "description": "1st set", "type": "inprogress"},
+            "homeTeam": {"name": player(rng, n * 2 + 1), "shortName": player(rng, n * 2 + 1), "id": 300000 + n},
+            "awayTeam": {"name": player(rng, n * 2 + 2), "shortName": player(rng, n * 2 + 2), "id": 310000 + n},
+            "homeScore": {"current": rng.randrange(4), "display": rng.randrange(4), "period1": rng.randrange(4)},
+            "awayScore": {"current": rng.randrange(4), "display": rng.randrange(4), "period1": rng.randrange(4)},
+            "startTimestamp": CAPTURE_TIME - 1800,
+        })
+    return json.dumps({"events": events})
+
+
+def open_meteo(rng):
+    hours = 24 * 4
+    hourly_keys = ["temperature_2m", "apparent_temperature", "precipitation_probability", "precipitation", "rain",
+                   "snowfall", "weather_code", "cloud_cover", "wind_speed_10m", "wind_gusts_10m", "uv_index",
+                   "relative_humidity_2m", "is_day"]
+    hourly = {"time": ["2025-10-%02dT%02d:00" % (9 + h // 24, h % 24) for h in range(hours)]}
+    for key in hourly_keys:
+        hourly[key] = [round(rng.uniform(0, 25), 1) for _ in range(hours)]
+    daily = {"time": ["2025-10-%02d" % (9 + d) for d in range(4)],
+             "sunrise": ["2025-10-%02dT07:%02d" % (9 + d, 50 + d) for d in range(4)],
+             "sunset": ["2025-10-%02dT18:%02d" % (9 + d, 40 - d) for d in range(4)]}
+    for key in ["weather_code", "temperature_2m_max", "temperature_2m_min", "precipitation_probability_max",
+                "rain_sum", "snowfall_sum", "sunshine_duration", "uv_index", "wind_speed_10m_max"]:
+        daily[key] = [round(rng.uniform(0, 25), 1) for _ in range(4)]
+    current = {"time": "2025-10-09T12:00", "temperature_2m": 14.2, "apparent_temperature": 12.9, "is_day": 1,
+               "precipitation": 0.0, "rain": 0.0, "snowfall": 0.0, "weather_code": 3, "cloud_cover": 88,
+               "wind_speed_10m": 11.5, "wind_gusts_10m": 25.2, "relative_humidity_2m": 71, "uv_index": 2.1}
+    return json.dumps({"latitude": 51.58, "longitude": 6.73, "timezone": "GMT", "current": current,
+                       "hourly": hourly, "daily": daily})
+
+
+def wartezeiten(rng):
+    attractions = [{"name": "Attraktion %d" % n, "waitingtime": rng.randrange(0, 90, 5),
+                    "status": rng.choice(["opened", "opened", "closed", "maintenance"]), "code": "a%d" % n}
+                   for n in range(60)]
+    return json.dumps(attractions)
+
+
+def tankerkoenig(rng):
+    ids = ["005056ba-7cb6-1ed2-bceb-82ea369c0d2d", "51d4b55e-a095-1aa0-e100-80009459e03a",
+           "474e5046-deaf-4f9b-9a32-9797b778f047"]
+    prices = {i: {"status": "open", "e5": round(rng.uniform(1.6, 1.9), 3), "e10": round(rng.uniform(1.5, 1.8), 3),
+                  "diesel": round(rng.uniform(1.5, 1.8), 3)} for i in ids}
+    return ids, json.dumps({"ok": True, "license": "CC BY 4.0 -  https://creativecommons.tankerkoenig.de",
+                            "data": "MTS-K", "prices": prices})
+
+
+def main():
+    rng = random.Random(48)
+    write_capture("calendar.http", "https://calendar.google.com/calendar/ical/familie%40example.org/private-0123/basic.ics", calendar(rng))
+    write_capture("darts_oom.http", "https://www.dartsrankings.com/", darts_oom(rng))
+    write_capture("darts_protour.http", "https://www.dartsrankings.com/protour", darts_protour(rng))
+    write_capture("holidays.http", "https://www.kuriose-feiertage.de/kalender/oktober/", holidays(rng))
+
+    write_capture("json/sofascore_live.http", "https://api.sofascore.com/api/v1/sport/darts/events/live", sofascore_live(rng))
+    write_capture("json/open_meteo_forecast.http",
+                  "https://api.open-meteo.com/v1/forecast?latitude=51.58&longitude=6.73&start_date=2025-10-09&end_date=2025-10-12",
+                  open_meteo(rng))
+    write_capture("json/wartezeiten_waitingtimes.http", "https://api.wartezeiten.app/v1/waitingtimes", wartezeiten(rng),
+                  headers=["accept: application/json", "park: phantasialand", "language: de"])
+    ids, body = tankerkoenig(rng)
+    write_capture("json/tankerkoenig_prices.http",
+                  "https://creativecommons.tankerkoenig.de/json/prices.php?ids=%s&apikey=00000000-0000-0000-0000-000000000002" % ",".join(ids),
+                  body)
+
+
+if __name__ == "__main__":
+    main()
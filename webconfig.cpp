@@ -76,6 +76,9 @@ void loadDeviceConfig() {
                 deviceConfig->dartsSofascoreLiveCheckIntervalSec = doc["dartsSofascoreLiveCheckIntervalSec"] | 120;
                 deviceConfig->dartsSofascoreLiveDataFetchIntervalSec = doc["dartsSofascoreLiveDataFetchIntervalSec"] | 60;
                 // debugFileEnabled is not persisted for security reasons - always starts as false
+                deviceConfig->recorderEnabled = doc["recorderEnabled"] | false;
+                deviceConfig->recorderIntervalSec = doc["recorderIntervalSec"] | 2;
+                deviceConfig->recorderMaxKBPerHour = doc["recorderMaxKBPerHour"] | 512;
 
                 deviceConfig->fritzboxEnabled = doc["fritzboxEnabled"] | false;
                 deviceConfig->fritzboxIp = doc["fritzboxIp"] | "";
@@ -105,6 +108,10 @@ void loadDeviceConfig() {
                 deviceConfig->googleCertFile = doc["googleCertFile"] | "";
 
                 deviceConfig->webClientBufferSize = doc["webClientBufferSize"] | (512 * 1024);
+                deviceConfig->webClientTlsBudgetKB = doc["webClientTlsBudgetKB"] | 96;
+                deviceConfig->webCacheEnabled = doc["webCacheEnabled"] | false;
+                deviceConfig->webCacheSkipUnchanged = doc["webCacheSkipUnchanged"] | true;
+                deviceConfig->streamMaxClients = doc["streamMaxClients"] | 4;
 
                 deviceConfig->mwaveSensorEnabled = doc["mwaveSensorEnabled"] | false;
                 deviceConfig->mwaveOffCheckDuration = doc["mwaveOffCheckDuration"] | 300;
@@ -248,6 +255,9 @@ void saveDeviceConfig() {
     doc["dartsSofascoreLiveCheckIntervalSec"] = deviceConfig->dartsSofascoreLiveCheckIntervalSec;
     doc["dartsSofascoreLiveDataFetchIntervalSec"] = deviceConfig->dartsSofascoreLiveDataFetchIntervalSec;
     // debugFileEnabled is not persisted for security reasons
+    doc["recorderEnabled"] = deviceConfig->recorderEnabled;
+    doc["recorderIntervalSec"] = deviceConfig->recorderIntervalSec;
+    doc["recorderMaxKBPerHour"] = deviceConfig->recorderMaxKBPerHour;
 
     doc["fritzboxEnabled"] = deviceConfig->fritzboxEnabled;
     doc["fritzboxIp"] = deviceConfig->fritzboxIp.c_str();
@@ -277,6 +287,10 @@ void saveDeviceConfig() {
     doc["googleCertFile"] = deviceConfig->googleCertFile.c_str();
 
     doc["webClientBufferSize"] = deviceConfig->webClientBufferSize;
+    doc["webClientTlsBudgetKB"] = deviceConfig->webClientTlsBudgetKB;
+    doc["webCacheEnabled"] = deviceConfig->webCacheEnabled;
+    doc["webCacheSkipUnchanged"] = deviceConfig->webCacheSkipUnchanged;
+    doc["streamMaxClients"] = deviceConfig->streamMaxClients;
 
     doc["mwaveSensorEnabled"] = deviceConfig->mwaveSensorEnabled;
     doc["mwaveOffCheckDuration"] = deviceConfig->mwaveOffCheckDuration;
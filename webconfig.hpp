@@ -94,6 +94,12 @@ struct DeviceConfig {
     bool sofascoreDebugEnabled = false;
     /// @brief Debug-Logging in Datei aktivieren (alle Module via MultiLogger).
     bool debugFileEnabled = false;
+    /// @brief Flugschreiber: Panel-Inhalt periodisch als Ringaufzeichnung in LittleFS speichern.
+    bool recorderEnabled = false;
+    /// @brief Aufnahmeintervall des Flugschreibers in Sekunden.
+    int recorderIntervalSec = 2;
+    /// @brief Maximale Schreibmenge des Flugschreibers in KB pro Stunde (Flash-Schonung).
+    int recorderMaxKBPerHour = 512;
 
     /// @brief Schaltet das Fritz!Box Anrufmonitor-Modul ein/aus.
     bool fritzboxEnabled = false;
@@ -157,8 +163,17 @@ struct DeviceConfig {
     /// @brief Der Dateiname des PEM-Zertifikats für Google Kalender.
     PsramString googleCertFile;
 
-    /// @brief Die Puffergröße für den WebClient, um heruntergeladene Daten zwischenzuspeichern.
+    /// @brief Download-Puffer, den jeder WebClient-Worker zwischen zwei Downloads behält; größere Antworten wachsen segmentweise darüber hinaus.
     size_t webClientBufferSize = 512 * 1024;
+    /// @brief Speicherbudget (KB internes RAM) für gleichzeitige TLS-Verbindungen des WebClients; bestimmt die Anzahl der Fetch-Worker (ca. 48 KB pro Worker).
+    int webClientTlsBudgetKB = 96;
+    /// @brief Letzte gültige Antwort jeder Ressource komprimiert im Flash ablegen und nach dem Neustart sofort (als veraltet) anzeigen.
+    bool webCacheEnabled = false;
+    /// @brief Unveränderte Antworten (gleicher Inhalts-Hash) nicht erneut in den Flash-Cache schreiben.
+    bool webCacheSkipUnchanged = true;
+
+    /// @brief Maximale Anzahl gleichzeitiger Live-Stream-Clients (WebSocket, Port 81).
+    uint8_t streamMaxClients = 4;
 
     /// @brief Aktiviert/Deaktiviert den Mikrowellen-Bewegungssensor.
     bool mwaveSensorEnabled = false;